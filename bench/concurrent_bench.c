@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/concurrent_hashtable.h"
+#include "thread/thread_pool.h"
+
+HASHTABLE_DECLARE_EX(u64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE(u64, u64)
+CONCURRENT_HASHTABLE_DECLARE(u64, u64)
+CONCURRENT_HASHTABLE_DEFINE(u64, u64)
+
+#define BENCH_DEFAULT_COUNT 4000000
+
+// One in BENCH_WRITE_EVERY operations of the mixed phase is an upsert, the rest are lookups
+#define BENCH_WRITE_EVERY   10
+
+typedef struct {
+    const u64* keys;
+    u32 count;
+    u8 mixed;
+
+    // The baseline, one HASHTABLE behind one mutex
+    pthread_mutex_t mutex;
+    HASHTABLE_u64_u64* locked;
+
+    CONCURRENT_HASHTABLE_u64_u64* striped;
+} BENCH_JOB;
+
+static f64 BENCH_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static u64 BENCH_next(u64* state) {
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void BENCH_locked(void* context, const u32 worker, const u32 workers) {
+    BENCH_JOB* job = (BENCH_JOB*)context;
+    const u32 begin = THREAD_POOL_split(job->count, worker, workers);
+    const u32 end = THREAD_POOL_split(job->count, worker + 1, workers);
+
+    for (u32 i = begin; i < end; i++) {
+        const u64 key = job->keys[i];
+        pthread_mutex_lock(&job->mutex);
+        if (job->mixed == 0 || i % BENCH_WRITE_EVERY == 0) HASHTABLE_u64_u64_upsert(job->locked, key, i);
+        else HASHTABLE_u64_u64_contains(job->locked, key);
+        pthread_mutex_unlock(&job->mutex);
+    }
+}
+
+static void BENCH_striped(void* context, const u32 worker, const u32 workers) {
+    BENCH_JOB* job = (BENCH_JOB*)context;
+    const u32 begin = THREAD_POOL_split(job->count, worker, workers);
+    const u32 end = THREAD_POOL_split(job->count, worker + 1, workers);
+
+    for (u32 i = begin; i < end; i++) {
+        const u64 key = job->keys[i];
+        if (job->mixed == 0 || i % BENCH_WRITE_EVERY == 0) CONCURRENT_HASHTABLE_u64_u64_upsert(job->striped, key, i);
+        else CONCURRENT_HASHTABLE_u64_u64_contains(job->striped, key);
+    }
+}
+
+static void BENCH_run(const char* name, BENCH_JOB* job, THREAD_POOL* pool, const THREAD_POOL_TASK_F task) {
+    const f64 start = BENCH_now();
+    THREAD_POOL_run(pool, task, job);
+    const f64 seconds = BENCH_now() - start;
+
+    printf("%-28s %u threads %8.2f Mops/s\n", name, THREAD_POOL_workers(pool), job->count / seconds * 1e-6);
+}
+
+int main(int argc, char** argv) {
+    const u32 count = argc > 1 ? (u32)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_COUNT;
+    const u32 threads = argc > 2 ? (u32)strtoul(argv[2], NULL, 10) : 0;
+    if (count == 0) return 1;
+
+    u64* keys = (u64*)malloc(sizeof(u64) * count);
+    THREAD_POOL* pool = THREAD_POOL_create(threads);
+    if (keys == NULL || pool == NULL) return 1;
+
+    u64 state = 0x2545F4914F6CDD1DULL;
+    for (u32 i = 0; i < count; i++) keys[i] = BENCH_next(&state);
+
+    BENCH_JOB job = { .keys = keys, .count = count, .mixed = 0 };
+    pthread_mutex_init(&job.mutex, NULL);
+    job.locked = HASHTABLE_u64_u64_create(HASHTABLE_MIN_CAPACITY);
+    job.striped = CONCURRENT_HASHTABLE_u64_u64_create(0, 0);
+    if (job.locked == NULL || job.striped == NULL) return 1;
+
+    BENCH_run("insert, one mutex", &job, pool, BENCH_locked);
+    BENCH_run("insert, lock-striped", &job, pool, BENCH_striped);
+
+    // Lookups of keys already present with a write every BENCH_WRITE_EVERY operations
+    job.mixed = 1;
+    BENCH_run("90% lookups, one mutex", &job, pool, BENCH_locked);
+    BENCH_run("90% lookups, lock-striped", &job, pool, BENCH_striped);
+
+    HASHTABLE_u64_u64_destroy(job.locked);
+    CONCURRENT_HASHTABLE_u64_u64_destroy(job.striped);
+    pthread_mutex_destroy(&job.mutex);
+    THREAD_POOL_destroy(pool);
+    free(keys);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/swiss_hashtable.h"
+#include "hash/robin_hashtable.h"
+
+// Same key type under other names so every engine can be instantiated side by side
+typedef u64 key64;
+typedef u64 robin64;
+
+HASHTABLE_DECLARE_EX(u64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE(u64, u64)
+
+HASHTABLE_DECLARE_SWISS_EX(key64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE_SWISS(key64, u64)
+
+HASHTABLE_DECLARE_ROBIN_EX(robin64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE_ROBIN(robin64, u64)
+
+#define BENCH_DEFAULT_COUNT 1000000
+
+static f64 BENCH_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static u64 BENCH_next(u64* state) {
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void BENCH_report(const char* engine, const char* op, const u32 count, const f64 seconds, const u64 check) {
+    printf("%-8s %-12s %8.2f ns/op  (check %llu)\n", engine, op, seconds * 1e9 / count, (unsigned long long)check);
+}
+
+#define BENCH_RUN(NAME, K)                                                                                  \
+    static void BENCH_run_##K(const u64* keys, const u64* misses, const u32 count) {                        \
+        HASHTABLE_##K##_u64* hashtable = HASHTABLE_##K##_u64##_create(16);                                  \
+        if (hashtable == NULL) return;                                                                      \
+                                                                                                            \
+        u64 check = 0;                                                                                      \
+        f64 start = BENCH_now();                                                                            \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_add(hashtable, keys[i], i);          \
+        BENCH_report(NAME, "insert", count, BENCH_now() - start, check);                                    \
+                                                                                                            \
+        check = 0;                                                                                          \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) {                                                                   \
+            const HASHTABLE_ENTRY_##K##_u64* entry = HASHTABLE_##K##_u64##_find(hashtable, keys[i]);        \
+            if (entry != NULL) check += entry->value;                                                       \
+        }                                                                                                   \
+        BENCH_report(NAME, "find hit", count, BENCH_now() - start, check);                                  \
+                                                                                                            \
+        check = 0;                                                                                          \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_contains(hashtable, misses[i]);      \
+        BENCH_report(NAME, "find miss", count, BENCH_now() - start, check);                                 \
+                                                                                                            \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i += 2) HASHTABLE_##K##_u64##_remove(hashtable, keys[i]);                \
+        BENCH_report(NAME, "remove", count / 2, BENCH_now() - start, hashtable->size);                      \
+                                                                                                            \
+        check = 0;                                                                                          \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_contains(hashtable, keys[i]);        \
+        BENCH_report(NAME, "find mixed", count, BENCH_now() - start, check);                                \
+                                                                                                            \
+        HASHTABLE_##K##_u64##_destroy(hashtable);                                                           \
+    }
+
+BENCH_RUN("classic", u64)
+BENCH_RUN("swiss", key64)
+BENCH_RUN("robin", robin64)
+
+int main(int argc, char** argv) {
+    const u32 count = argc > 1 ? (u32)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_COUNT;
+    if (count == 0) return 1;
+
+    u64* keys = (u64*)malloc(sizeof(u64) * count);
+    u64* misses = (u64*)malloc(sizeof(u64) * count);
+    if (keys == NULL || misses == NULL) return 1;
+
+    // Even keys are inserted, odd keys always miss
+    u64 state = 0x2545F4914F6CDD1DULL;
+    for (u32 i = 0; i < count; i++) {
+        const u64 x = BENCH_next(&state);
+        keys[i] = x & ~1ULL;
+        misses[i] = x | 1ULL;
+    }
+
+    printf("%u keys\n", count);
+    BENCH_run_u64(keys, misses, count);
+    BENCH_run_key64(keys, misses, count);
+    BENCH_run_robin64(keys, misses, count);
+
+    free(keys);
+    free(misses);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashset.h"
+#include "hash/hashtable.h"
+#include "hash/compact_hashset.h"
+#include "hash/compact_hashtable.h"
+
+// Same key types under other names so both layouts can be instantiated side by side
+typedef u8 cu8;
+typedef u32 cu32;
+typedef u32 hu32;
+typedef u64 cu64;
+typedef u64 hu64;
+
+HASHSET_DECLARE_EX(u8, HASH_u32, HASH_EQUAL)
+HASHSET_DEFINE(u8)
+HASHSET_DECLARE_EX(u32, HASH_u32, HASH_EQUAL)
+HASHSET_DEFINE(u32)
+HASHTABLE_DECLARE_EX(u64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE(u64, u64)
+
+HASHSET_DECLARE_COMPACT_EX(cu8, HASH_u32, HASH_EQUAL)
+HASHSET_DEFINE_COMPACT(cu8)
+HASHSET_DECLARE_COMPACT_EX(cu32, HASH_u32, HASH_EQUAL)
+HASHSET_DEFINE_COMPACT(cu32)
+HASHSET_DECLARE_COMPACT_EX(hu32, HASH_u32, HASH_EQUAL)
+HASHSET_DEFINE_COMPACT_HASHED(hu32)
+HASHTABLE_DECLARE_COMPACT_EX(cu64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE_COMPACT(cu64, u64)
+HASHTABLE_DECLARE_COMPACT_EX(hu64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE_COMPACT_HASHED(hu64, u64)
+
+#define BENCH_DEFAULT_COUNT 1000000
+
+static f64 BENCH_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static u64 BENCH_next(u64* state) {
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void BENCH_report(const char* name, const f64 slot_bytes, const u32 size, const u32 capacity,
+    const f64 hit_seconds, const f64 miss_seconds, const u32 lookups, const u32 check) {
+
+    printf("%-26s %6.2f B/slot %7.2f B/element %8.2f ns/hit %8.2f ns/miss  (check %u)\n", name, slot_bytes,
+        slot_bytes * capacity / size, hit_seconds * 1e9 / lookups, miss_seconds * 1e9 / lookups, check);
+}
+
+// Classic entries, the pack pragma around the DECLARE macros does not reach the expanded structs
+#define BENCH_CLASSIC_SET(NAME, K)                                                                          \
+    static void BENCH_run_##K(const u64* keys, const u64* misses, const u32 count) {                        \
+        HASHSET_##K* hashset = HASHSET_##K##_create(HASHSET_MIN_CAPACITY);                                  \
+        if (hashset == NULL) return;                                                                        \
+        for (u32 i = 0; i < count; i++) HASHSET_##K##_add(hashset, (K)keys[i]);                             \
+                                                                                                            \
+        u32 check = 0;                                                                                      \
+        f64 start = BENCH_now();                                                                            \
+        for (u32 i = 0; i < count; i++) check += HASHSET_##K##_contains(hashset, (K)keys[i]);               \
+        const f64 hit = BENCH_now() - start;                                                                \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) check += HASHSET_##K##_contains(hashset, (K)misses[i]);             \
+        const f64 miss = BENCH_now() - start;                                                               \
+                                                                                                            \
+        BENCH_report(NAME, (f64)sizeof(HASHSET_ENTRY_##K), hashset->size, hashset->capacity, hit, miss,     \
+            count, check);                                                                                  \
+        HASHSET_##K##_destroy(hashset);                                                                     \
+    }
+
+#define BENCH_COMPACT_SET(NAME, K, STORE_HASH)                                                              \
+    static void BENCH_run_##K(const u64* keys, const u64* misses, const u32 count) {                        \
+        HASHSET_##K* hashset = HASHSET_##K##_create(0);                                                     \
+        if (hashset == NULL) return;                                                                        \
+        for (u32 i = 0; i < count; i++) HASHSET_##K##_add(hashset, (K)keys[i]);                             \
+                                                                                                            \
+        u32 check = 0;                                                                                      \
+        f64 start = BENCH_now();                                                                            \
+        for (u32 i = 0; i < count; i++) check += HASHSET_##K##_contains(hashset, (K)keys[i]);               \
+        const f64 hit = BENCH_now() - start;                                                                \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) check += HASHSET_##K##_contains(hashset, (K)misses[i]);             \
+        const f64 miss = BENCH_now() - start;                                                               \
+                                                                                                            \
+        const f64 slot_bytes = sizeof(K) + (STORE_HASH ? sizeof(u32) : 0) + 0.25;                           \
+        BENCH_report(NAME, slot_bytes, hashset->size, hashset->capacity, hit, miss, count, check);          \
+        HASHSET_##K##_destroy(hashset);                                                                     \
+    }
+
+#define BENCH_CLASSIC_TABLE(NAME, K)                                                                        \
+    static void BENCH_run_##K(const u64* keys, const u64* misses, const u32 count) {                        \
+        HASHTABLE_##K##_u64* hashtable = HASHTABLE_##K##_u64##_create(HASHTABLE_MIN_CAPACITY);              \
+        if (hashtable == NULL) return;                                                                      \
+        for (u32 i = 0; i < count; i++) HASHTABLE_##K##_u64##_add(hashtable, keys[i], i);                   \
+                                                                                                            \
+        u32 check = 0;                                                                                      \
+        f64 start = BENCH_now();                                                                            \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_contains(hashtable, keys[i]);        \
+        const f64 hit = BENCH_now() - start;                                                                \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_contains(hashtable, misses[i]);      \
+        const f64 miss = BENCH_now() - start;                                                               \
+                                                                                                            \
+        BENCH_report(NAME, (f64)sizeof(HASHTABLE_ENTRY_##K##_u64), hashtable->size, hashtable->capacity,    \
+            hit, miss, count, check);                                                                       \
+        HASHTABLE_##K##_u64##_destroy(hashtable);                                                           \
+    }
+
+#define BENCH_COMPACT_TABLE(NAME, K, STORE_HASH)                                                            \
+    static void BENCH_run_##K(const u64* keys, const u64* misses, const u32 count) {                        \
+        HASHTABLE_##K##_u64* hashtable = HASHTABLE_##K##_u64##_create(0);                                   \
+        if (hashtable == NULL) return;                                                                      \
+        for (u32 i = 0; i < count; i++) HASHTABLE_##K##_u64##_add(hashtable, keys[i], i);                   \
+                                                                                                            \
+        u32 check = 0;                                                                                      \
+        f64 start = BENCH_now();                                                                            \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_contains(hashtable, keys[i]);        \
+        const f64 hit = BENCH_now() - start;                                                                \
+        start = BENCH_now();                                                                                \
+        for (u32 i = 0; i < count; i++) check += HASHTABLE_##K##_u64##_contains(hashtable, misses[i]);      \
+        const f64 miss = BENCH_now() - start;                                                               \
+                                                                                                            \
+        const f64 slot_bytes = sizeof(K) + sizeof(u64) + (STORE_HASH ? sizeof(u32) : 0) + 0.25;             \
+        BENCH_report(NAME, slot_bytes, hashtable->size, hashtable->capacity, hit, miss, count, check);      \
+        HASHTABLE_##K##_u64##_destroy(hashtable);                                                           \
+    }
+
+BENCH_CLASSIC_SET("HASHSET_u8 classic", u8)
+BENCH_COMPACT_SET("HASHSET_u8 compact", cu8, 0)
+BENCH_CLASSIC_SET("HASHSET_u32 classic", u32)
+BENCH_COMPACT_SET("HASHSET_u32 compact", cu32, 0)
+BENCH_COMPACT_SET("HASHSET_u32 compact+hash", hu32, 1)
+BENCH_CLASSIC_TABLE("HASHTABLE_u64_u64 classic", u64)
+BENCH_COMPACT_TABLE("HASHTABLE_u64_u64 compact", cu64, 0)
+BENCH_COMPACT_TABLE("HASHTABLE_u64_u64 c+hash", hu64, 1)
+
+int main(int argc, char** argv) {
+    const u32 count = argc > 1 ? (u32)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_COUNT;
+    if (count == 0) return 1;
+
+    u64* keys = (u64*)malloc(sizeof(u64) * count);
+    u64* misses = (u64*)malloc(sizeof(u64) * count);
+    if (keys == NULL || misses == NULL) return 1;
+
+    // Even keys are inserted, odd keys always miss (u8 sets saturate at 128 keys)
+    u64 state = 0x2545F4914F6CDD1DULL;
+    for (u32 i = 0; i < count; i++) {
+        const u64 x = BENCH_next(&state);
+        keys[i] = x & ~1ULL;
+        misses[i] = x | 1ULL;
+    }
+
+    printf("%u keys, B/slot is what every slot costs, B/element adds the unused capacity\n", count);
+    BENCH_run_u8(keys, misses, count);
+    BENCH_run_cu8(keys, misses, count);
+    BENCH_run_u32(keys, misses, count);
+    BENCH_run_cu32(keys, misses, count);
+    BENCH_run_hu32(keys, misses, count);
+    BENCH_run_u64(keys, misses, count);
+    BENCH_run_cu64(keys, misses, count);
+    BENCH_run_hu64(keys, misses, count);
+
+    free(keys);
+    free(misses);
+    return 0;
+}
\ No newline at end of file
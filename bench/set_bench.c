@@ -0,0 +1,86 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashset.h"
+#include "hash/parallel_hashset.h"
+#include "thread/thread_pool.h"
+
+HASHSET_DECLARE_EX(u64, HASH_u64, HASH_EQUAL)
+HASHSET_DEFINE(u64)
+HASHSET_DECLARE_PARALLEL(u64)
+HASHSET_DEFINE_PARALLEL(u64)
+
+#define BENCH_DEFAULT_COUNT 10000000
+
+static f64 BENCH_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static u64 BENCH_next(u64* state) {
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+typedef HASHSET_u64* (*BENCH_SERIAL_F)(const HASHSET_u64* a, const HASHSET_u64* b);
+typedef HASHSET_u64* (*BENCH_PARALLEL_F)(const HASHSET_u64* a, const HASHSET_u64* b, THREAD_POOL* pool);
+
+static void BENCH_run(const char* name, const HASHSET_u64* a, const HASHSET_u64* b, const BENCH_SERIAL_F serial,
+    const BENCH_PARALLEL_F parallel, THREAD_POOL* pool) {
+
+    f64 start = BENCH_now();
+    HASHSET_u64* c = serial(a, b);
+    const f64 serial_seconds = BENCH_now() - start;
+
+    start = BENCH_now();
+    HASHSET_u64* d = parallel(a, b, pool);
+    const f64 parallel_seconds = BENCH_now() - start;
+
+    if (c != NULL && d != NULL) {
+        printf("%-13s %10u keys %9.1f ms serial %9.1f ms on %u threads  %5.2fx\n", name, d->size,
+            serial_seconds * 1e3, parallel_seconds * 1e3, THREAD_POOL_workers(pool), serial_seconds / parallel_seconds);
+    }
+
+    HASHSET_u64_destroy(c);
+    HASHSET_u64_destroy(d);
+}
+
+int main(int argc, char** argv) {
+    const u32 count = argc > 1 ? (u32)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_COUNT;
+    const u32 threads = argc > 2 ? (u32)strtoul(argv[2], NULL, 10) : 0;
+    if (count == 0) return 1;
+
+    THREAD_POOL* pool = THREAD_POOL_create(threads);
+    HASHSET_u64* a = HASHSET_u64_create(0);
+    HASHSET_u64* b = HASHSET_u64_create(0);
+    if (pool == NULL || a == NULL || b == NULL) return 1;
+
+    // Half of the keys of each set are shared with the other one
+    u64 state = 0x2545F4914F6CDD1DULL;
+    HASHSET_u64_reserve(a, count);
+    HASHSET_u64_reserve(b, count);
+    for (u32 i = 0; i < count; i++) {
+        const u64 x = BENCH_next(&state);
+        HASHSET_u64_add(a, x);
+        HASHSET_u64_add(b, (i & 1) == 0 ? x : ~x);
+    }
+
+    BENCH_run("union", a, b, HASHSET_u64_union, HASHSET_u64_union_parallel, pool);
+    BENCH_run("intersection", a, b, HASHSET_u64_intersection, HASHSET_u64_intersection_parallel, pool);
+    BENCH_run("difference", a, b, HASHSET_u64_difference, HASHSET_u64_difference_parallel, pool);
+
+    HASHSET_u64_destroy(a);
+    HASHSET_u64_destroy(b);
+    THREAD_POOL_destroy(pool);
+    return 0;
+}
\ No newline at end of file
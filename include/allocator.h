@@ -0,0 +1,47 @@
+#ifndef NESQUIK_ALLOCATOR_H
+#define NESQUIK_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Where a container gets its memory from, passed to the *_init_allocator and *_create_allocator calls. The three
+// calls follow malloc, realloc and free, with the user context first. A container keeps the pointer, so the
+// allocator must outlive it. NULL stands for libc, which is what the plain *_init and *_create calls use.
+typedef struct NESQUIK_ALLOCATOR {
+    void* (*alloc)(void* context, size_t size);
+    void* (*realloc)(void* context, void* pointer, size_t size);
+    void (*free)(void* context, void* pointer);
+    void* context;
+} NESQUIK_ALLOCATOR;
+
+// malloc, realloc and free behind the allocator interface
+extern const NESQUIK_ALLOCATOR NESQUIK_ALLOCATOR_LIBC;
+
+static inline void* NESQUIK_alloc(const NESQUIK_ALLOCATOR* allocator, const size_t size) {
+    if (allocator == NULL) return malloc(size);
+    return allocator->alloc(allocator->context, size);
+}
+
+// calloc on top of alloc, NULL when count * size overflows
+static inline void* NESQUIK_calloc(const NESQUIK_ALLOCATOR* allocator, const size_t count, const size_t size) {
+    if (allocator == NULL) return calloc(count, size);
+    if (size != 0 && count > (size_t)-1 / size) return NULL;
+
+    void* pointer = allocator->alloc(allocator->context, count * size);
+    if (pointer != NULL) memset(pointer, 0, count * size);
+    return pointer;
+}
+
+static inline void* NESQUIK_realloc(const NESQUIK_ALLOCATOR* allocator, void* pointer, const size_t size) {
+    if (allocator == NULL) return realloc(pointer, size);
+    return allocator->realloc(allocator->context, pointer, size);
+}
+
+static inline void NESQUIK_free(const NESQUIK_ALLOCATOR* allocator, void* pointer) {
+    if (pointer == NULL) return;
+    if (allocator == NULL) free(pointer);
+    else allocator->free(allocator->context, pointer);
+}
+
+#endif //NESQUIK_ALLOCATOR_H
\ No newline at end of file
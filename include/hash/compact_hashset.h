@@ -0,0 +1,348 @@
+#ifndef NESQUIK_COMPACT_HASHSET_H
+#define NESQUIK_COMPACT_HASHSET_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashset.h"
+#include "hash/compact_status.h"
+
+// Compact layout behind the HASHSET API. Statuses live in a 2 bit per slot bitmap and keys and (optionally)
+// hashes in their own naturally aligned arrays, so there is no per entry struct: _find hands back a
+// pointer to the key instead of an entry.
+#define HASHSET_DECLARE_COMPACT_TYPES(K)                                                    \
+    typedef struct HASHSET_##K {                                                            \
+        u64* status;                                                                        \
+        K* keys;                                                                            \
+        u32* hashes;                                                                        \
+        u32 size;                                                                           \
+        u32 capacity;                                                                       \
+        u32 tombstones;                                                                     \
+        const NESQUIK_ALLOCATOR* allocator;                                                 \
+    } HASHSET_##K;                                                                          \
+                                                                                            \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, u32 capacity);                              \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, u32 capacity,                     \
+        const NESQUIK_ALLOCATOR* allocator);                                                \
+    HASHSET_##K* HASHSET_##K##_create(u32 capacity);                                        \
+    HASHSET_##K* HASHSET_##K##_create_allocator(u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator);                                                \
+                                                                                            \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset);                                        \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset);                                       \
+                                                                                            \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset);                                            \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, K key);                                      \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, u32 hash, K key);                      \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, K key);                                 \
+                                                                                            \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, K key);                           \
+    K* HASHSET_##K##_find(const HASHSET_##K* hashset, K key);                               \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, u32 hash, K key);          \
+    K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, u32 hash, K key);              \
+                                                                                            \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b);           \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b);    \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b);
+
+#define HASHSET_DECLARE_COMPACT_HASH(K, HASH_F)     \
+    HASHSET_DECLARE_COMPACT_TYPES(K)                \
+    HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define HASHSET_DECLARE_COMPACT_EX(K, HASH_FN, EQ_FN)       \
+    HASHSET_DECLARE_COMPACT_TYPES(K)                        \
+    HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+#define HASHSET_DECLARE_COMPACT(K) HASHSET_DECLARE_COMPACT_HASH(K, HASH_fnv1a)
+
+// STORE_HASH (0 or 1) keeps the 32 bit hash of every slot. It saves rehashing on grow and lets probes
+// skip key compares, worth it for keys that are expensive to hash or compare.
+#define HASHSET_DEFINE_COMPACT_LAYOUT(K, STORE_HASH)                                                            \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, const u32 capacity) {                                           \
+        return HASHSET_##K##_init_allocator(hashset, capacity, NULL);                                           \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, const u32 capacity,                                   \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                   \
+                                                                                                                \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        hashset->allocator = allocator;                                                                         \
+        hashset->size = 0;                                                                                      \
+        hashset->capacity = COMPACT_capacity(capacity);                                                         \
+        hashset->tombstones = 0;                                                                                \
+                                                                                                                \
+        const u32 words = COMPACT_status_words(hashset->capacity);                                              \
+        hashset->status = (u64*)NESQUIK_alloc(allocator, sizeof(u64) * words);                                  \
+        hashset->keys = (K*)NESQUIK_alloc(allocator, sizeof(K) * hashset->capacity);                            \
+        hashset->hashes = STORE_HASH ? (u32*)NESQUIK_alloc(allocator, sizeof(u32) * hashset->capacity) : NULL;  \
+                                                                                                                \
+        if (hashset->status == NULL || hashset->keys == NULL ||                                                 \
+            (STORE_HASH && hashset->hashes == NULL)) {                                                          \
+            HASHSET_##K##_deinit(hashset);                                                                      \
+            return 0;                                                                                           \
+        }                                                                                                       \
+                                                                                                                \
+        memset(hashset->status, 0, sizeof(u64) * words);                                                        \
+                                                                                                                \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_create(const u32 capacity) {                                                     \
+        return HASHSET_##K##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {       \
+        HASHSET_##K* hashset = (HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_##K));                     \
+        if (hashset == NULL) return NULL;                                                                       \
+                                                                                                                \
+        const u8 r = HASHSET_##K##_init_allocator(hashset, capacity, allocator);                                \
+        if (r == 0) {                                                                                           \
+            NESQUIK_free(allocator, hashset);                                                                   \
+            return NULL;                                                                                        \
+        }                                                                                                       \
+                                                                                                                \
+        return hashset;                                                                                         \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset) {                                                           \
+        if (hashset == NULL) return;                                                                            \
+        hashset->size = 0;                                                                                      \
+        hashset->capacity = 0;                                                                                  \
+        hashset->tombstones = 0;                                                                                \
+                                                                                                                \
+        NESQUIK_free(hashset->allocator, hashset->status);                                                      \
+        NESQUIK_free(hashset->allocator, hashset->keys);                                                        \
+        NESQUIK_free(hashset->allocator, hashset->hashes);                                                      \
+                                                                                                                \
+        hashset->status = NULL;                                                                                 \
+        hashset->keys = NULL;                                                                                   \
+        hashset->hashes = NULL;                                                                                 \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset) {                                                          \
+        if (hashset == NULL) return;                                                                            \
+                                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                                \
+        HASHSET_##K##_deinit(hashset);                                                                          \
+        NESQUIK_free(allocator, hashset);                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    static u32 HASHSET_##K##_slot(const HASHSET_##K* hashset, const u32 hash, const K key) {                    \
+        const u32 mask = hashset->capacity - 1;                                                                 \
+        u32 i = hash & mask;                                                                                    \
+                                                                                                                \
+        for (u32 n = 0; n < hashset->capacity; n++) {                                                           \
+            const u8 status = COMPACT_status_get(hashset->status, i);                                           \
+            if (status == COMPACT_STATUS_EMPTY) break;                                                          \
+                                                                                                                \
+            if (status == COMPACT_STATUS_FILLED && (!STORE_HASH || hashset->hashes[i] == hash) &&               \
+                HASHSET_##K##_key_equal(hashset->keys[i], key) == 1) return i;                                  \
+                                                                                                                \
+            i = (i + 1) & mask;                                                                                 \
+        }                                                                                                       \
+                                                                                                                \
+        return hashset->capacity;                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset) {                                                               \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        u32 new_capacity = hashset->capacity;                                                                   \
+        if (hashset->size + 1 > COMPACT_MAX_LOAD(hashset->capacity) / 2) {                                      \
+            if (hashset->capacity & 0x80000000) return 0;                                                       \
+            new_capacity = hashset->capacity << 1;                                                              \
+        }                                                                                                       \
+                                                                                                                \
+        HASHSET_##K new_hashset;                                                                                \
+        const u8 r = HASHSET_##K##_init_allocator(&new_hashset, new_capacity, hashset->allocator);              \
+        if (r == 0) return 0;                                                                                   \
+                                                                                                                \
+        const u32 mask = new_capacity - 1;                                                                      \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                           \
+            if (COMPACT_status_get(hashset->status, i) != COMPACT_STATUS_FILLED) continue;                      \
+                                                                                                                \
+            const u32 hash = STORE_HASH ? hashset->hashes[i] : HASHSET_##K##_key_hash(hashset->keys[i]);        \
+            u32 j = hash & mask;                                                                                \
+            while (COMPACT_status_get(new_hashset.status, j) != COMPACT_STATUS_EMPTY) j = (j + 1) & mask;       \
+                                                                                                                \
+            COMPACT_status_set(new_hashset.status, j, COMPACT_STATUS_FILLED);                                   \
+            new_hashset.keys[j] = hashset->keys[i];                                                             \
+            if (STORE_HASH) new_hashset.hashes[j] = hash;                                                       \
+        }                                                                                                       \
+                                                                                                                \
+        new_hashset.size = hashset->size;                                                                       \
+                                                                                                                \
+        HASHSET_##K##_deinit(hashset);                                                                          \
+        *hashset = new_hashset;                                                                                 \
+                                                                                                                \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, const u32 hash, const K key) {                             \
+        if (hashset == NULL) return 0;                                                                          \
+        if (hashset->capacity == 0) return 0;                                                                   \
+                                                                                                                \
+        if (hashset->size + hashset->tombstones + 1 > COMPACT_MAX_LOAD(hashset->capacity)) {                    \
+            const u8 r = HASHSET_##K##_grow(hashset);                                                           \
+            if (r == 0) return 0;                                                                               \
+        }                                                                                                       \
+                                                                                                                \
+        const u32 mask = hashset->capacity - 1;                                                                 \
+        u32 i = hash & mask;                                                                                    \
+        u32 found = hashset->capacity;                                                                          \
+                                                                                                                \
+        for (;;) {                                                                                              \
+            const u8 status = COMPACT_status_get(hashset->status, i);                                           \
+            if (status == COMPACT_STATUS_EMPTY) {                                                               \
+                if (found == hashset->capacity) found = i;                                                      \
+                break;                                                                                          \
+            }                                                                                                   \
+                                                                                                                \
+            if (status == COMPACT_STATUS_TOMBSTONE) {                                                           \
+                if (found == hashset->capacity) found = i;                                                      \
+            }                                                                                                   \
+            else if ((!STORE_HASH || hashset->hashes[i] == hash) &&                                             \
+                HASHSET_##K##_key_equal(hashset->keys[i], key) == 1) return 0;                                  \
+                                                                                                                \
+            i = (i + 1) & mask;                                                                                 \
+        }                                                                                                       \
+                                                                                                                \
+        if (COMPACT_status_get(hashset->status, found) == COMPACT_STATUS_TOMBSTONE) hashset->tombstones--;      \
+                                                                                                                \
+        COMPACT_status_set(hashset->status, found, COMPACT_STATUS_FILLED);                                      \
+        hashset->keys[found] = key;                                                                             \
+        if (STORE_HASH) hashset->hashes[found] = hash;                                                          \
+                                                                                                                \
+        hashset->size++;                                                                                        \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, const K key) {                                                   \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
+        return HASHSET_##K##_quick_add(hashset, hash, key);                                                     \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, const K key) {                                              \
+        if (hashset == NULL) return;                                                                            \
+        if (hashset->capacity == 0) return;                                                                     \
+                                                                                                                \
+        const u32 i = HASHSET_##K##_slot(hashset, HASHSET_##K##_key_hash(key), key);                            \
+        if (i == hashset->capacity) return;                                                                     \
+                                                                                                                \
+        COMPACT_status_set(hashset->status, i, COMPACT_STATUS_TOMBSTONE);                                       \
+        hashset->size--;                                                                                        \
+        hashset->tombstones++;                                                                                  \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, const K key) {                                        \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const K* found = HASHSET_##K##_find(hashset, key);                                                      \
+        if (found == NULL) return 0;                                                                            \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    K* HASHSET_##K##_find(const HASHSET_##K* hashset, const K key) {                                            \
+        if (hashset == NULL) return NULL;                                                                       \
+                                                                                                                \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
+        return HASHSET_##K##_find_hashed(hashset, hash, key);                                                   \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {                 \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const K* found = HASHSET_##K##_find_hashed(hashset, hash, key);                                         \
+        if (found == NULL) return 0;                                                                            \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {                     \
+        if (hashset == NULL) return NULL;                                                                       \
+        if (hashset->capacity == 0) return NULL;                                                                \
+                                                                                                                \
+        const u32 i = HASHSET_##K##_slot(hashset, hash, key);                                                   \
+        if (i == hashset->capacity) return NULL;                                                                \
+        return hashset->keys + i;                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    static inline u32 HASHSET_##K##_slot_hash(const HASHSET_##K* hashset, const u32 i) {                        \
+        return STORE_HASH ? hashset->hashes[i] : HASHSET_##K##_key_hash(hashset->keys[i]);                      \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b) {                              \
+        if (a == NULL || b == NULL) return NULL;                                                                \
+                                                                                                                \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(a->capacity + b->capacity, a->allocator);               \
+        if (c == NULL) return NULL;                                                                             \
+                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                              \
+            if (COMPACT_status_get(a->status, ai) == COMPACT_STATUS_FILLED)                                     \
+                HASHSET_##K##_quick_add(c, HASHSET_##K##_slot_hash(a, ai), a->keys[ai]);                        \
+        }                                                                                                       \
+                                                                                                                \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                              \
+            if (COMPACT_status_get(b->status, bi) == COMPACT_STATUS_FILLED)                                     \
+                HASHSET_##K##_quick_add(c, HASHSET_##K##_slot_hash(b, bi), b->keys[bi]);                        \
+        }                                                                                                       \
+                                                                                                                \
+        return c;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b) {                       \
+        if (a == NULL || b == NULL) return NULL;                                                                \
+                                                                                                                \
+        const HASHSET_##K* smaller;                                                                             \
+        const HASHSET_##K* larger;                                                                              \
+        if (a->capacity < b->capacity) {                                                                        \
+            smaller = a;                                                                                        \
+            larger = b;                                                                                         \
+        }                                                                                                       \
+        else {                                                                                                  \
+            smaller = b;                                                                                        \
+            larger = a;                                                                                         \
+        }                                                                                                       \
+                                                                                                                \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(smaller->capacity, a->allocator);                       \
+        if (c == NULL) return NULL;                                                                             \
+                                                                                                                \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                           \
+            if (COMPACT_status_get(smaller->status, i) == COMPACT_STATUS_FILLED) {                              \
+                const u32 hash = HASHSET_##K##_slot_hash(smaller, i);                                           \
+                if (HASHSET_##K##_contains_hashed(larger, hash, smaller->keys[i]) == 1) {                       \
+                    HASHSET_##K##_quick_add(c, hash, smaller->keys[i]);                                         \
+                }                                                                                               \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        return c;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b) {                         \
+        if (a == NULL || b == NULL) return NULL;                                                                \
+                                                                                                                \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(a->capacity, a->allocator);                             \
+        if (c == NULL) return NULL;                                                                             \
+                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                              \
+            if (COMPACT_status_get(a->status, ai) == COMPACT_STATUS_FILLED) {                                   \
+                const u32 hash = HASHSET_##K##_slot_hash(a, ai);                                                \
+                if (HASHSET_##K##_contains_hashed(b, hash, a->keys[ai]) == 0) {                                 \
+                    HASHSET_##K##_quick_add(c, hash, a->keys[ai]);                                              \
+                }                                                                                               \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        return c;                                                                                               \
+    }
+
+#define HASHSET_DEFINE_COMPACT(K) HASHSET_DEFINE_COMPACT_LAYOUT(K, 0)
+#define HASHSET_DEFINE_COMPACT_HASHED(K) HASHSET_DEFINE_COMPACT_LAYOUT(K, 1)
+
+#endif // NESQUIK_COMPACT_HASHSET_H
\ No newline at end of file
@@ -0,0 +1,283 @@
+#ifndef NESQUIK_COMPACT_HASHTABLE_H
+#define NESQUIK_COMPACT_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/compact_status.h"
+
+// Compact layout behind the HASHTABLE API. Statuses live in a 2 bit per slot bitmap and keys, values and
+// (optionally) hashes in their own naturally aligned arrays, so there is no per entry struct: _find hands
+// back a pointer to the value instead of an entry.
+#define HASHTABLE_DECLARE_COMPACT_TYPES(K, V)                                                           \
+    typedef struct HASHTABLE_##K##_##V {                                                                \
+        u64* status;                                                                                    \
+        K* keys;                                                                                        \
+        V* values;                                                                                      \
+        u32* hashes;                                                                                    \
+        u32 size;                                                                                       \
+        u32 capacity;                                                                                   \
+        u32 tombstones;                                                                                 \
+        const NESQUIK_ALLOCATOR* allocator;                                                             \
+    } HASHTABLE_##K##_##V;                                                                              \
+                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, u32 capacity);                        \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, u32 capacity,               \
+        const NESQUIK_ALLOCATOR* allocator);                                                            \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(u32 capacity);                                    \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(u32 capacity,                           \
+        const NESQUIK_ALLOCATOR* allocator);                                                            \
+                                                                                                        \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable);                                  \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable);                                 \
+                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable);                                      \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, K key, V value);                       \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);       \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, K key);                           \
+                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, K key);                     \
+    V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, K key);                         \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash, K key);    \
+    V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash, K key);
+
+#define HASHTABLE_DECLARE_COMPACT_HASH(K, V, HASH_F)    \
+    HASHTABLE_DECLARE_COMPACT_TYPES(K, V)               \
+    HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define HASHTABLE_DECLARE_COMPACT_EX(K, V, HASH_FN, EQ_FN)      \
+    HASHTABLE_DECLARE_COMPACT_TYPES(K, V)                       \
+    HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define HASHTABLE_DECLARE_COMPACT(K, V) HASHTABLE_DECLARE_COMPACT_HASH(K, V, HASH_fnv1a)
+
+// STORE_HASH (0 or 1) keeps the 32 bit hash of every slot. It saves rehashing on grow and lets probes
+// skip key compares, worth it for keys that are expensive to hash or compare.
+#define HASHTABLE_DEFINE_COMPACT_LAYOUT(K, V, STORE_HASH)                                                               \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, const u32 capacity) {                                 \
+        return HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, NULL);                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, const u32 capacity,                         \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        hashtable->allocator = allocator;                                                                               \
+        hashtable->size = 0;                                                                                            \
+        hashtable->capacity = COMPACT_capacity(capacity);                                                               \
+        hashtable->tombstones = 0;                                                                                      \
+                                                                                                                        \
+        const u32 words = COMPACT_status_words(hashtable->capacity);                                                    \
+        hashtable->status = (u64*)NESQUIK_alloc(allocator, sizeof(u64) * words);                                        \
+        hashtable->keys = (K*)NESQUIK_alloc(allocator, sizeof(K) * hashtable->capacity);                                \
+        hashtable->values = (V*)NESQUIK_alloc(allocator, sizeof(V) * hashtable->capacity);                              \
+        hashtable->hashes = STORE_HASH ? (u32*)NESQUIK_alloc(allocator, sizeof(u32) * hashtable->capacity) : NULL;      \
+                                                                                                                        \
+        if (hashtable->status == NULL || hashtable->keys == NULL || hashtable->values == NULL ||                        \
+            (STORE_HASH && hashtable->hashes == NULL)) {                                                                \
+            HASHTABLE_##K##_##V##_deinit(hashtable);                                                                    \
+            return 0;                                                                                                   \
+        }                                                                                                               \
+                                                                                                                        \
+        memset(hashtable->status, 0, sizeof(u64) * words);                                                              \
+                                                                                                                        \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(const u32 capacity) {                                             \
+        return HASHTABLE_##K##_##V##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                     \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        HASHTABLE_##K##_##V* hashtable = (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                 \
+            sizeof(HASHTABLE_##K##_##V));                                                                               \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, allocator);                              \
+        if (r == 0) {                                                                                                   \
+            NESQUIK_free(allocator, hashtable);                                                                         \
+            return NULL;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        return hashtable;                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable) {                                                 \
+        if (hashtable == NULL) return;                                                                                  \
+        hashtable->size = 0;                                                                                            \
+        hashtable->capacity = 0;                                                                                        \
+        hashtable->tombstones = 0;                                                                                      \
+                                                                                                                        \
+        NESQUIK_free(hashtable->allocator, hashtable->status);                                                          \
+        NESQUIK_free(hashtable->allocator, hashtable->keys);                                                            \
+        NESQUIK_free(hashtable->allocator, hashtable->values);                                                          \
+        NESQUIK_free(hashtable->allocator, hashtable->hashes);                                                          \
+                                                                                                                        \
+        hashtable->status = NULL;                                                                                       \
+        hashtable->keys = NULL;                                                                                         \
+        hashtable->values = NULL;                                                                                       \
+        hashtable->hashes = NULL;                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable) {                                                \
+        if (hashtable == NULL) return;                                                                                  \
+                                                                                                                        \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                      \
+        HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
+        NESQUIK_free(allocator, hashtable);                                                                             \
+    }                                                                                                                   \
+                                                                                                                        \
+    static u32 HASHTABLE_##K##_##V##_slot(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {          \
+        const u32 mask = hashtable->capacity - 1;                                                                       \
+        u32 i = hash & mask;                                                                                            \
+                                                                                                                        \
+        for (u32 n = 0; n < hashtable->capacity; n++) {                                                                 \
+            const u8 status = COMPACT_status_get(hashtable->status, i);                                                 \
+            if (status == COMPACT_STATUS_EMPTY) break;                                                                  \
+                                                                                                                        \
+            if (status == COMPACT_STATUS_FILLED && (!STORE_HASH || hashtable->hashes[i] == hash) &&                     \
+                HASHTABLE_##K##_##V##_key_equal(hashtable->keys[i], key) == 1) return i;                                \
+                                                                                                                        \
+            i = (i + 1) & mask;                                                                                         \
+        }                                                                                                               \
+                                                                                                                        \
+        return hashtable->capacity;                                                                                     \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable) {                                                     \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        u32 new_capacity = hashtable->capacity;                                                                         \
+        if (hashtable->size + 1 > COMPACT_MAX_LOAD(hashtable->capacity) / 2) {                                          \
+            if (hashtable->capacity & 0x80000000) return 0;                                                             \
+            new_capacity = hashtable->capacity << 1;                                                                    \
+        }                                                                                                               \
+                                                                                                                        \
+        HASHTABLE_##K##_##V new_hashtable;                                                                              \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);          \
+        if (r == 0) return 0;                                                                                           \
+                                                                                                                        \
+        const u32 mask = new_capacity - 1;                                                                              \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                 \
+            if (COMPACT_status_get(hashtable->status, i) != COMPACT_STATUS_FILLED) continue;                            \
+                                                                                                                        \
+            const u32 hash = STORE_HASH ? hashtable->hashes[i] : HASHTABLE_##K##_##V##_key_hash(hashtable->keys[i]);    \
+            u32 j = hash & mask;                                                                                        \
+            while (COMPACT_status_get(new_hashtable.status, j) != COMPACT_STATUS_EMPTY) j = (j + 1) & mask;             \
+                                                                                                                        \
+            COMPACT_status_set(new_hashtable.status, j, COMPACT_STATUS_FILLED);                                         \
+            new_hashtable.keys[j] = hashtable->keys[i];                                                                 \
+            new_hashtable.values[j] = hashtable->values[i];                                                             \
+            if (STORE_HASH) new_hashtable.hashes[j] = hash;                                                             \
+        }                                                                                                               \
+                                                                                                                        \
+        new_hashtable.size = hashtable->size;                                                                           \
+                                                                                                                        \
+        HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
+        *hashtable = new_hashtable;                                                                                     \
+                                                                                                                        \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) {    \
+        if (hashtable == NULL) return 0;                                                                                \
+        if (hashtable->capacity == 0) return 0;                                                                         \
+                                                                                                                        \
+        if (hashtable->size + hashtable->tombstones + 1 > COMPACT_MAX_LOAD(hashtable->capacity)) {                      \
+            const u8 r = HASHTABLE_##K##_##V##_grow(hashtable);                                                         \
+            if (r == 0) return 0;                                                                                       \
+        }                                                                                                               \
+                                                                                                                        \
+        const u32 mask = hashtable->capacity - 1;                                                                       \
+        u32 i = hash & mask;                                                                                            \
+        u32 found = hashtable->capacity;                                                                                \
+                                                                                                                        \
+        for (;;) {                                                                                                      \
+            const u8 status = COMPACT_status_get(hashtable->status, i);                                                 \
+            if (status == COMPACT_STATUS_EMPTY) {                                                                       \
+                if (found == hashtable->capacity) found = i;                                                            \
+                break;                                                                                                  \
+            }                                                                                                           \
+                                                                                                                        \
+            if (status == COMPACT_STATUS_TOMBSTONE) {                                                                   \
+                if (found == hashtable->capacity) found = i;                                                            \
+            }                                                                                                           \
+            else if ((!STORE_HASH || hashtable->hashes[i] == hash) &&                                                   \
+                HASHTABLE_##K##_##V##_key_equal(hashtable->keys[i], key) == 1) return 0;                                \
+                                                                                                                        \
+            i = (i + 1) & mask;                                                                                         \
+        }                                                                                                               \
+                                                                                                                        \
+        if (COMPACT_status_get(hashtable->status, found) == COMPACT_STATUS_TOMBSTONE) hashtable->tombstones--;          \
+                                                                                                                        \
+        COMPACT_status_set(hashtable->status, found, COMPACT_STATUS_FILLED);                                            \
+        hashtable->keys[found] = key;                                                                                   \
+        hashtable->values[found] = value;                                                                               \
+        if (STORE_HASH) hashtable->hashes[found] = hash;                                                                \
+                                                                                                                        \
+        hashtable->size++;                                                                                              \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, const K key, const V value) {                          \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                            \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, const K key) {                                    \
+        if (hashtable == NULL) return;                                                                                  \
+        if (hashtable->capacity == 0) return;                                                                           \
+                                                                                                                        \
+        const u32 i = HASHTABLE_##K##_##V##_slot(hashtable, HASHTABLE_##K##_##V##_key_hash(key), key);                  \
+        if (i == hashtable->capacity) return;                                                                           \
+                                                                                                                        \
+        COMPACT_status_set(hashtable->status, i, COMPACT_STATUS_TOMBSTONE);                                             \
+        hashtable->size--;                                                                                              \
+        hashtable->tombstones++;                                                                                        \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, const K key) {                              \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const V* value = HASHTABLE_##K##_##V##_find(hashtable, key);                                                    \
+        if (value == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, const K key) {                                  \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {       \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const V* value = HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                       \
+        if (value == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {           \
+        if (hashtable == NULL) return NULL;                                                                             \
+        if (hashtable->capacity == 0) return NULL;                                                                      \
+                                                                                                                        \
+        const u32 i = HASHTABLE_##K##_##V##_slot(hashtable, hash, key);                                                 \
+        if (i == hashtable->capacity) return NULL;                                                                      \
+        return hashtable->values + i;                                                                                   \
+    }
+
+#define HASHTABLE_DEFINE_COMPACT(K, V) HASHTABLE_DEFINE_COMPACT_LAYOUT(K, V, 0)
+#define HASHTABLE_DEFINE_COMPACT_HASHED(K, V) HASHTABLE_DEFINE_COMPACT_LAYOUT(K, V, 1)
+
+#endif // NESQUIK_COMPACT_HASHTABLE_H
\ No newline at end of file
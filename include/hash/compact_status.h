@@ -0,0 +1,37 @@
+#ifndef NESQUIK_COMPACT_STATUS_H
+#define NESQUIK_COMPACT_STATUS_H
+
+#include "types.h"
+
+// Slot statuses of the *_DEFINE_COMPACT engines, 2 bits per slot packed 32 to a word.
+// The values match the *_ENTRY_STATUS_* constants of the classic containers.
+#define COMPACT_STATUS_EMPTY        0
+#define COMPACT_STATUS_FILLED       1
+#define COMPACT_STATUS_TOMBSTONE    2
+
+#define COMPACT_SLOTS_PER_WORD      32
+
+#define COMPACT_MIN_CAPACITY        8
+#define COMPACT_MAX_LOAD(capacity)  ((capacity) - (capacity) / 4)
+
+static inline u32 COMPACT_capacity(const u32 capacity) {
+    u32 new_capacity = COMPACT_MIN_CAPACITY;
+    while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;
+    return new_capacity;
+}
+
+static inline u32 COMPACT_status_words(const u32 capacity) {
+    return (capacity + COMPACT_SLOTS_PER_WORD - 1) / COMPACT_SLOTS_PER_WORD;
+}
+
+static inline u8 COMPACT_status_get(const u64* status, const u32 i) {
+    return (u8)((status[i / COMPACT_SLOTS_PER_WORD] >> ((i % COMPACT_SLOTS_PER_WORD) * 2)) & 3);
+}
+
+static inline void COMPACT_status_set(u64* status, const u32 i, const u8 value) {
+    const u32 shift = (i % COMPACT_SLOTS_PER_WORD) * 2;
+    u64* word = status + i / COMPACT_SLOTS_PER_WORD;
+    *word = (*word & ~(3ULL << shift)) | ((u64)value << shift);
+}
+
+#endif //NESQUIK_COMPACT_STATUS_H
\ No newline at end of file
@@ -0,0 +1,255 @@
+#ifndef NESQUIK_CONCURRENT_HASHTABLE_H
+#define NESQUIK_CONCURRENT_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+
+// Lock-striped front-end over the classic HASHTABLE, expanded next to HASHTABLE_DECLARE/HASHTABLE_DEFINE.
+// The top hash bits pick one of a power of two segments, each an independent HASHTABLE behind its own
+// reader-writer lock. A segment grows or purges its tombstones under its own write lock while the others keep
+// serving, so there is never a stop-the-world rehash. Values are copied in and out because entry pointers
+// would not outlive the segment lock, _update runs a callback on the value while the lock is held.
+// Segments grow concurrently, so an allocator given to _init_allocator must be thread safe. The cache line
+// aligned segment array itself always comes from aligned_alloc. pthread_rwlock_t and aligned_alloc need POSIX.1-2008
+// and C11: under a strict -std=c11 a file expanding these macros defines _POSIX_C_SOURCE 200809L before its
+// first include, as src/hash/concurrent_hashtable.c does.
+#define CONCURRENT_HASHTABLE_DEFAULT_SEGMENTS   64
+#define CONCURRENT_HASHTABLE_MAX_SEGMENTS       65536
+
+// Segments are aligned so that two locks never share a cache line
+#define CONCURRENT_HASHTABLE_CACHE_LINE         64
+
+static inline u8 CONCURRENT_HASHTABLE_shift(const u32 segments) {
+    u8 shift = 0;
+    while ((1u << shift) < segments && (1u << shift) < CONCURRENT_HASHTABLE_MAX_SEGMENTS) shift++;
+    return shift;
+}
+
+#define CONCURRENT_HASHTABLE_DECLARE(K, V)                                                                      \
+    typedef void (*CONCURRENT_HASHTABLE_UPDATE_F_##K##_##V)(V* value, u8 inserted, void* context);              \
+                                                                                                                \
+    typedef struct CONCURRENT_HASHTABLE_SEGMENT_##K##_##V {                                                     \
+        _Alignas(CONCURRENT_HASHTABLE_CACHE_LINE) pthread_rwlock_t lock;                                        \
+        HASHTABLE_##K##_##V hashtable;                                                                          \
+    } CONCURRENT_HASHTABLE_SEGMENT_##K##_##V;                                                                   \
+                                                                                                                \
+    typedef struct CONCURRENT_HASHTABLE_##K##_##V {                                                             \
+        CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segments;                                                       \
+        u32 segment_count;                                                                                      \
+        u8 shift;                                                                                               \
+        const NESQUIK_ALLOCATOR* allocator;                                                                     \
+    } CONCURRENT_HASHTABLE_##K##_##V;                                                                           \
+                                                                                                                \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_init(CONCURRENT_HASHTABLE_##K##_##V* hashtable, u32 capacity,           \
+        u32 segments);                                                                                          \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_init_allocator(CONCURRENT_HASHTABLE_##K##_##V* hashtable, u32 capacity, \
+        u32 segments, const NESQUIK_ALLOCATOR* allocator);                                                      \
+    CONCURRENT_HASHTABLE_##K##_##V* CONCURRENT_HASHTABLE_##K##_##V##_create(u32 capacity, u32 segments);        \
+    CONCURRENT_HASHTABLE_##K##_##V* CONCURRENT_HASHTABLE_##K##_##V##_create_allocator(u32 capacity,             \
+        u32 segments,                                                                                           \
+        const NESQUIK_ALLOCATOR* allocator);                                                                    \
+                                                                                                                \
+    void CONCURRENT_HASHTABLE_##K##_##V##_deinit(CONCURRENT_HASHTABLE_##K##_##V* hashtable);                    \
+    void CONCURRENT_HASHTABLE_##K##_##V##_destroy(CONCURRENT_HASHTABLE_##K##_##V* hashtable);                   \
+                                                                                                                \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_add(CONCURRENT_HASHTABLE_##K##_##V* hashtable, K key, V value);         \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_upsert(CONCURRENT_HASHTABLE_##K##_##V* hashtable, K key, V value);      \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_update(CONCURRENT_HASHTABLE_##K##_##V* hashtable, K key,                \
+        CONCURRENT_HASHTABLE_UPDATE_F_##K##_##V update_f, void* context);                                       \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_remove(CONCURRENT_HASHTABLE_##K##_##V* hashtable, K key);               \
+                                                                                                                \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_get(CONCURRENT_HASHTABLE_##K##_##V* hashtable, K key, V* value);        \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_contains(CONCURRENT_HASHTABLE_##K##_##V* hashtable, K key);             \
+    u32 CONCURRENT_HASHTABLE_##K##_##V##_size(CONCURRENT_HASHTABLE_##K##_##V* hashtable);
+
+#define CONCURRENT_HASHTABLE_DEFINE(K, V)                                                                                   \
+    static inline CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* CONCURRENT_HASHTABLE_##K##_##V##_segment(                         \
+        const CONCURRENT_HASHTABLE_##K##_##V* hashtable, const u32 hash) {                                                  \
+                                                                                                                            \
+        return hashtable->segments + (u32)((u64)hash >> (32 - hashtable->shift));                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_init(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const u32 capacity,                 \
+        const u32 segments) {                                                                                               \
+                                                                                                                            \
+        return CONCURRENT_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, segments, NULL);                        \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_init_allocator(CONCURRENT_HASHTABLE_##K##_##V* hashtable,                           \
+        const u32 capacity,                                                                                                 \
+        const u32 segments, const NESQUIK_ALLOCATOR* allocator) {                                                           \
+                                                                                                                            \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        hashtable->allocator = allocator;                                                                                   \
+        hashtable->shift = CONCURRENT_HASHTABLE_shift(segments == 0 ? CONCURRENT_HASHTABLE_DEFAULT_SEGMENTS : segments);    \
+        hashtable->segment_count = 1u << hashtable->shift;                                                                  \
+                                                                                                                            \
+        hashtable->segments = (CONCURRENT_HASHTABLE_SEGMENT_##K##_##V*)aligned_alloc(CONCURRENT_HASHTABLE_CACHE_LINE,       \
+            sizeof(CONCURRENT_HASHTABLE_SEGMENT_##K##_##V) * hashtable->segment_count);                                     \
+        if (hashtable->segments == NULL) {                                                                                  \
+            hashtable->segment_count = 0;                                                                                   \
+            return 0;                                                                                                       \
+        }                                                                                                                   \
+                                                                                                                            \
+        const u32 segment_capacity = capacity / hashtable->segment_count;                                                   \
+        for (u32 i = 0; i < hashtable->segment_count; i++) {                                                                \
+            CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = hashtable->segments + i;                                      \
+                                                                                                                            \
+            u8 r = HASHTABLE_##K##_##V##_init_allocator(&segment->hashtable, segment_capacity, allocator);                  \
+            if (r == 1 && pthread_rwlock_init(&segment->lock, NULL) != 0) {                                                 \
+                HASHTABLE_##K##_##V##_deinit(&segment->hashtable);                                                          \
+                r = 0;                                                                                                      \
+            }                                                                                                               \
+                                                                                                                            \
+            if (r == 0) {                                                                                                   \
+                hashtable->segment_count = i;                                                                               \
+                CONCURRENT_HASHTABLE_##K##_##V##_deinit(hashtable);                                                         \
+                return 0;                                                                                                   \
+            }                                                                                                               \
+        }                                                                                                                   \
+                                                                                                                            \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    CONCURRENT_HASHTABLE_##K##_##V* CONCURRENT_HASHTABLE_##K##_##V##_create(const u32 capacity, const u32 segments) {       \
+        return CONCURRENT_HASHTABLE_##K##_##V##_create_allocator(capacity, segments, NULL);                                 \
+    }                                                                                                                       \
+                                                                                                                            \
+    CONCURRENT_HASHTABLE_##K##_##V* CONCURRENT_HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                   \
+        const u32 segments, const NESQUIK_ALLOCATOR* allocator) {                                                           \
+                                                                                                                            \
+        CONCURRENT_HASHTABLE_##K##_##V* hashtable =                                                                         \
+            (CONCURRENT_HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator, sizeof(CONCURRENT_HASHTABLE_##K##_##V));              \
+        if (hashtable == NULL) return NULL;                                                                                 \
+                                                                                                                            \
+        const u8 r = CONCURRENT_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, segments, allocator);             \
+        if (r == 0) {                                                                                                       \
+            NESQUIK_free(allocator, hashtable);                                                                             \
+            return NULL;                                                                                                    \
+        }                                                                                                                   \
+                                                                                                                            \
+        return hashtable;                                                                                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    void CONCURRENT_HASHTABLE_##K##_##V##_deinit(CONCURRENT_HASHTABLE_##K##_##V* hashtable) {                               \
+        if (hashtable == NULL) return;                                                                                      \
+                                                                                                                            \
+        for (u32 i = 0; i < hashtable->segment_count; i++) {                                                                \
+            CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = hashtable->segments + i;                                      \
+            pthread_rwlock_destroy(&segment->lock);                                                                         \
+            HASHTABLE_##K##_##V##_deinit(&segment->hashtable);                                                              \
+        }                                                                                                                   \
+                                                                                                                            \
+        free(hashtable->segments);                                                                                          \
+        hashtable->segments = NULL;                                                                                         \
+        hashtable->segment_count = 0;                                                                                       \
+    }                                                                                                                       \
+                                                                                                                            \
+    void CONCURRENT_HASHTABLE_##K##_##V##_destroy(CONCURRENT_HASHTABLE_##K##_##V* hashtable) {                              \
+        if (hashtable == NULL) return;                                                                                      \
+                                                                                                                            \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                          \
+        CONCURRENT_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                 \
+        NESQUIK_free(allocator, hashtable);                                                                                 \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_add(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const K key, const V value) {        \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = CONCURRENT_HASHTABLE_##K##_##V##_segment(hashtable, hash);        \
+                                                                                                                            \
+        pthread_rwlock_wrlock(&segment->lock);                                                                              \
+        const u8 r = HASHTABLE_##K##_##V##_quick_add(&segment->hashtable, hash, key, value);                                \
+        pthread_rwlock_unlock(&segment->lock);                                                                              \
+                                                                                                                            \
+        return r;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_upsert(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const K key,                      \
+        const V value) {                                                                                                    \
+                                                                                                                            \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = CONCURRENT_HASHTABLE_##K##_##V##_segment(hashtable, hash);        \
+                                                                                                                            \
+        pthread_rwlock_wrlock(&segment->lock);                                                                              \
+        const u8 r = HASHTABLE_##K##_##V##_quick_upsert(&segment->hashtable, hash, key, value);                             \
+        pthread_rwlock_unlock(&segment->lock);                                                                              \
+                                                                                                                            \
+        return r;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_update(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const K key,                      \
+        const CONCURRENT_HASHTABLE_UPDATE_F_##K##_##V update_f, void* context) {                                            \
+                                                                                                                            \
+        if (hashtable == NULL || update_f == NULL) return 0;                                                                \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = CONCURRENT_HASHTABLE_##K##_##V##_segment(hashtable, hash);        \
+                                                                                                                            \
+        u8 inserted = 0;                                                                                                    \
+        pthread_rwlock_wrlock(&segment->lock);                                                                              \
+        V* value = HASHTABLE_##K##_##V##_quick_get_or_insert(&segment->hashtable, hash, key, &inserted);                    \
+        if (value != NULL) update_f(value, inserted, context);                                                              \
+        pthread_rwlock_unlock(&segment->lock);                                                                              \
+                                                                                                                            \
+        return value != NULL;                                                                                               \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_remove(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const K key) {                    \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = CONCURRENT_HASHTABLE_##K##_##V##_segment(hashtable, hash);        \
+                                                                                                                            \
+        pthread_rwlock_wrlock(&segment->lock);                                                                              \
+        const u32 size = segment->hashtable.size;                                                                           \
+        HASHTABLE_##K##_##V##_remove(&segment->hashtable, key);                                                             \
+        const u8 removed = segment->hashtable.size != size;                                                                 \
+        pthread_rwlock_unlock(&segment->lock);                                                                              \
+                                                                                                                            \
+        return removed;                                                                                                     \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_get(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const K key, V* value) {             \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = CONCURRENT_HASHTABLE_##K##_##V##_segment(hashtable, hash);        \
+                                                                                                                            \
+        pthread_rwlock_rdlock(&segment->lock);                                                                              \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(&segment->hashtable, hash, key);         \
+        if (entry != NULL && value != NULL) *value = entry->value;                                                          \
+        pthread_rwlock_unlock(&segment->lock);                                                                              \
+                                                                                                                            \
+        return entry != NULL;                                                                                               \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 CONCURRENT_HASHTABLE_##K##_##V##_contains(CONCURRENT_HASHTABLE_##K##_##V* hashtable, const K key) {                  \
+        return CONCURRENT_HASHTABLE_##K##_##V##_get(hashtable, key, NULL);                                                  \
+    }                                                                                                                       \
+                                                                                                                            \
+    u32 CONCURRENT_HASHTABLE_##K##_##V##_size(CONCURRENT_HASHTABLE_##K##_##V* hashtable) {                                  \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        u32 size = 0;                                                                                                       \
+        for (u32 i = 0; i < hashtable->segment_count; i++) {                                                                \
+            CONCURRENT_HASHTABLE_SEGMENT_##K##_##V* segment = hashtable->segments + i;                                      \
+            pthread_rwlock_rdlock(&segment->lock);                                                                          \
+            size += segment->hashtable.size;                                                                                \
+            pthread_rwlock_unlock(&segment->lock);                                                                          \
+        }                                                                                                                   \
+                                                                                                                            \
+        return size;                                                                                                        \
+    }
+
+#endif //NESQUIK_CONCURRENT_HASHTABLE_H
\ No newline at end of file
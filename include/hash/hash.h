@@ -6,6 +6,82 @@
 #define HASH_FNV32_BASIS 0x811c9dc5
 #define HASH_FNV32_PRIME 0x01000193
 
+// Constants of the wide (multi-lane) kernel family
+#define HASH_WIDE_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_WIDE_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_WIDE_PRIME_3 0x165667B19E3779F9ULL
+#define HASH_WIDE_PRIME_4 0x85EBCA77C2B2AE63ULL
+
+#define HASH_WIDE_ROTATE 23
+
+// Which implementation HASH_wide32 runs its stripes on. Every kernel returns the same hash.
+#define HASH_KERNEL_SCALAR 0
+#define HASH_KERNEL_SSE2   1
+#define HASH_KERNEL_AVX2   2
+#define HASH_KERNEL_NEON   3
+
+// Kernels a HASH_STATE can stream through
+#define HASH_STATE_FNV1A  0
+#define HASH_STATE_WIDE8  1
+#define HASH_STATE_WIDE16 2
+#define HASH_STATE_WIDE32 3
+
+#define HASH_STATE_BUFFER_SIZE 32
+
+// Incremental hashing of a key that arrives in pieces, gives the same value as the one shot kernel
+typedef struct HASH_STATE {
+    u64 lanes[4];
+    u64 size;
+    u8 buffer[HASH_STATE_BUFFER_SIZE];
+    u8 buffered;
+    u8 kind;
+} HASH_STATE;
+
 u32 HASH_fnv1a(const u8* data, u32 size);
 
+// 64-bit hashes that consume 8, 16 and 32 bytes per step
+u64 HASH_wide8(const u8* data, u32 size);
+u64 HASH_wide16(const u8* data, u32 size);
+u64 HASH_wide32(const u8* data, u32 size);
+
+// HASH_wide32 folded to 32 bits, drop in replacement for HASH_fnv1a
+u32 HASH_wide(const u8* data, u32 size);
+
+u8 HASH_wide_kernel(void);
+u8 HASH_wide_set_kernel(u8 kernel);
+
+// Multiply-shift mixers for integer keys, meant to be inlined through *_DECLARE_EX
+static inline u32 HASH_u32(const u32 key) {
+    return (u32)(((u64)key * HASH_WIDE_PRIME_1) >> 32);
+}
+
+static inline u32 HASH_u64(u64 key) {
+    key ^= key >> 32;
+    return (u32)((key * HASH_WIDE_PRIME_1) >> 32);
+}
+
+// Hashes the address itself, for interned keys that are compared by pointer
+static inline u32 HASH_pointer(const void* pointer) {
+    return HASH_u64((u64)(uintptr_t)pointer);
+}
+
+u8 HASH_STATE_init(HASH_STATE* state, u8 kind);
+void HASH_STATE_update(HASH_STATE* state, const u8* data, u32 size);
+
+// HASH_fnv1a or HASH_wide8/16/32 of everything seen so far, the state can keep being updated
+u64 HASH_STATE_final(const HASH_STATE* state);
+// Same as HASH_fnv1a or HASH_wide, the hash the containers store
+u32 HASH_STATE_final32(const HASH_STATE* state);
+
+#define HASH_EQUAL(a, b) ((a) == (b))
+
+// Cache hints used by the batched container calls, no-ops where the builtin is missing
+#if defined(__GNUC__)
+#define HASH_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#define HASH_PREFETCH_WRITE(address) __builtin_prefetch((address), 1, 3)
+#else
+#define HASH_PREFETCH(address) ((void)(address))
+#define HASH_PREFETCH_WRITE(address) ((void)(address))
+#endif
+
 #endif //NESQUIK_HASH_H
\ No newline at end of file
@@ -3,21 +3,41 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "types.h"
+#include "allocator.h"
 #include "hash/hash.h"
+#include "hash/mapped.h"
+#include "sketch/bloom.h"
 
 #define HASHSET_ENTRY_STATUS_EMPTY      0
 #define HASHSET_ENTRY_STATUS_FILLED     1
 #define HASHSET_ENTRY_STATUS_TOMBSTONE  2
+// Marks entries still to be moved while _rehash purges tombstones in place
+#define HASHSET_ENTRY_STATUS_DISPLACED  3
 
 #define HASHSET_MIN_LOAD_FACTOR         0.5
 #define HASHSET_MAX_LOAD_FACTOR         0.75
 
 #define HASHSET_MIN_CAPACITY            8
 
+// Result sets and in-place algebra size from the element count, never from the capacity of the inputs
+static inline u32 HASHSET_capacity_for(const f64 size) {
+    return (u32)(size / HASHSET_MAX_LOAD_FACTOR) + 1;
+}
+
+// What HASHSET_next yields after one of the _iterate* calls, without building a result set
+#define HASHSET_ITERATE_ALL             0
+#define HASHSET_ITERATE_UNION           1
+#define HASHSET_ITERATE_INTERSECTION    2
+#define HASHSET_ITERATE_DIFFERENCE      3
+
+// Keys hashed and prefetched ahead of probing by _add_many and _find_many
+#define HASHSET_BATCH_SIZE              16
+
 #pragma pack(push, 1)
-#define HASHSET_DECLARE(K)                                                                                      \
+#define HASHSET_DECLARE_TYPES(K)                                                                                \
     typedef struct HASHSET_ENTRY_##K {                                                                          \
         u8 status;                                                                                              \
         u32 hash;                                                                                               \
@@ -29,55 +49,150 @@
         u32 size;                                                                                               \
         u32 capacity;                                                                                           \
         u32 tombstones;                                                                                         \
+        BLOOM* filter;                                                                                          \
+        u8 mapped;                                                                                              \
+        const NESQUIK_ALLOCATOR* allocator;                                                                     \
     } HASHSET_##K;                                                                                              \
                                                                                                                 \
+    typedef struct HASHSET_ITERATOR_##K {                                                                       \
+        const HASHSET_##K* a;                                                                                   \
+        const HASHSET_##K* b;                                                                                   \
+        u32 index;                                                                                              \
+        u8 mode;                                                                                                \
+    } HASHSET_ITERATOR_##K;                                                                                     \
+                                                                                                                \
     u8 HASHSET_##K##_init(HASHSET_##K* hashset, u32 capacity);                                                  \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, u32 capacity, const NESQUIK_ALLOCATOR* allocator);    \
     HASHSET_##K* HASHSET_##K##_create(u32 capacity);                                                            \
+    HASHSET_##K* HASHSET_##K##_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);              \
                                                                                                                 \
     void HASHSET_##K##_deinit(HASHSET_##K* hashset);                                                            \
     void HASHSET_##K##_destroy(HASHSET_##K* hashset);                                                           \
                                                                                                                 \
     u8 HASHSET_##K##_grow(HASHSET_##K* hashset);                                                                \
+    u8 HASHSET_##K##_resize(HASHSET_##K* hashset, u32 capacity);                                                \
+    u8 HASHSET_##K##_rehash(HASHSET_##K* hashset);                                                              \
+    u8 HASHSET_##K##_reserve(HASHSET_##K* hashset, u32 n);                                                      \
+    u8 HASHSET_##K##_shrink_to_fit(HASHSET_##K* hashset);                                                       \
+    u8 HASHSET_##K##_attach_filter(HASHSET_##K* hashset, f64 false_rate);                                       \
+    void HASHSET_##K##_detach_filter(HASHSET_##K* hashset);                                                     \
+    u8 HASHSET_##K##_save(const HASHSET_##K* hashset, const char* path);                                        \
+    HASHSET_##K* HASHSET_##K##_open_mmap(const char* path);                                                     \
+    HASHSET_##K* HASHSET_##K##_open_mmap_allocator(const char* path, const NESQUIK_ALLOCATOR* allocator);       \
     u8 HASHSET_##K##_add(HASHSET_##K* hashset, K key);                                                          \
     u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, u32 hash, K key);                                          \
     void HASHSET_##K##_remove(HASHSET_##K* hashset, K key);                                                     \
                                                                                                                 \
-    u32 HASHSET_##K##_hash(const u8* data, u32 size);                                                           \
-                                                                                                                \
     u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, K key);                                               \
     HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, K key);                                   \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, u32 hash, K key);                              \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, u32 hash, K key);                  \
+                                                                                                                \
+    u32 HASHSET_##K##_add_many(HASHSET_##K* hashset, const K* keys, u32 n);                                     \
+    u32 HASHSET_##K##_find_many(const HASHSET_##K* hashset, const K* keys, u32 n, HASHSET_ENTRY_##K** out);     \
                                                                                                                 \
     HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b);                               \
     HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b);                        \
-    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b);
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b);                          \
+                                                                                                                \
+    u32 HASHSET_##K##_union_into(HASHSET_##K* a, const HASHSET_##K* b);                                         \
+    u32 HASHSET_##K##_intersect_inplace(HASHSET_##K* a, const HASHSET_##K* b);                                  \
+    u32 HASHSET_##K##_subtract_inplace(HASHSET_##K* a, const HASHSET_##K* b);                                   \
+                                                                                                                \
+    u32 HASHSET_##K##_union_size(const HASHSET_##K* a, const HASHSET_##K* b);                                   \
+    u32 HASHSET_##K##_intersection_size(const HASHSET_##K* a, const HASHSET_##K* b);                            \
+    u32 HASHSET_##K##_difference_size(const HASHSET_##K* a, const HASHSET_##K* b);                              \
+                                                                                                                \
+    void HASHSET_##K##_iterate(HASHSET_ITERATOR_##K* iterator, const HASHSET_##K* hashset);                     \
+    void HASHSET_##K##_iterate_union(HASHSET_ITERATOR_##K* iterator,                                            \
+        const HASHSET_##K* a, const HASHSET_##K* b);                                                            \
+    void HASHSET_##K##_iterate_intersection(HASHSET_ITERATOR_##K* iterator,                                     \
+        const HASHSET_##K* a, const HASHSET_##K* b);                                                            \
+    void HASHSET_##K##_iterate_difference(HASHSET_ITERATOR_##K* iterator,                                       \
+        const HASHSET_##K* a, const HASHSET_##K* b);                                                            \
+    const HASHSET_ENTRY_##K* HASHSET_##K##_next(HASHSET_ITERATOR_##K* iterator);
 #pragma pack(pop)
 
+// Hashes the bytes of the key with one of the hash.h kernels and compares keys with ==
+#define HASHSET_DECLARE_KEY_HASH(K, HASH_F)                                     \
+    static inline u32 HASHSET_##K##_hash(const u8* data, const u32 size) {      \
+        return HASH_F(data, size);                                              \
+    }                                                                           \
+                                                                                \
+    static inline u32 HASHSET_##K##_key_hash(const K key) {                     \
+        return HASH_F((const u8*)(&key), sizeof(key));                          \
+    }                                                                           \
+                                                                                \
+    static inline u8 HASHSET_##K##_key_equal(const K a, const K b) {            \
+        return a == b;                                                          \
+    }
+
+// Bakes a user hash (u32 HASH_FN(K)) and equality (u8 EQ_FN(K, K)) into the generated functions,
+// e.g. HASH_u64 for integer keys or a field-wise hash for structs with padding. The byte helper _hash
+// stays on HASH_fnv1a, so both key modes emit the same functions.
+#define HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)                               \
+    static inline u32 HASHSET_##K##_hash(const u8* data, const u32 size) {      \
+        return HASH_fnv1a(data, size);                                          \
+    }                                                                           \
+                                                                                \
+    static inline u32 HASHSET_##K##_key_hash(const K key) {                     \
+        return HASH_FN(key);                                                    \
+    }                                                                           \
+                                                                                \
+    static inline u8 HASHSET_##K##_key_equal(const K a, const K b) {            \
+        return EQ_FN(a, b) ? 1 : 0;                                             \
+    }
+
+#define HASHSET_DECLARE_HASH(K, HASH_F)     \
+    HASHSET_DECLARE_TYPES(K)                \
+    HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define HASHSET_DECLARE_EX(K, HASH_FN, EQ_FN)       \
+    HASHSET_DECLARE_TYPES(K)                        \
+    HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+#define HASHSET_DECLARE(K) HASHSET_DECLARE_HASH(K, HASH_fnv1a)
+
 #define HASHSET_DEFINE(K)                                                                                       \
     u8 HASHSET_##K##_init(HASHSET_##K* hashset, const u32 capacity) {                                           \
+        return HASHSET_##K##_init_allocator(hashset, capacity, NULL);                                           \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, const u32 capacity,                                   \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                   \
+                                                                                                                \
         if (hashset == NULL) return 0;                                                                          \
                                                                                                                 \
+        hashset->allocator = allocator;                                                                         \
         hashset->size = 0;                                                                                      \
         hashset->capacity = capacity < HASHSET_MIN_CAPACITY ? HASHSET_MIN_CAPACITY : capacity;                  \
         hashset->tombstones = 0;                                                                                \
+        hashset->filter = NULL;                                                                                 \
+        hashset->mapped = 0;                                                                                    \
                                                                                                                 \
-        hashset->entries = (HASHSET_ENTRY_##K*)malloc(sizeof(HASHSET_ENTRY_##K) * capacity);                    \
+        hashset->entries = (HASHSET_ENTRY_##K*)NESQUIK_alloc(allocator,                                         \
+            sizeof(HASHSET_ENTRY_##K) * hashset->capacity);                                                     \
         if (hashset->entries == NULL) {                                                                         \
             hashset->capacity = 0;                                                                              \
             return 0;                                                                                           \
         }                                                                                                       \
                                                                                                                 \
-        memset(hashset->entries, 0, sizeof(HASHSET_ENTRY_##K) * capacity);                                      \
+        memset(hashset->entries, 0, sizeof(HASHSET_ENTRY_##K) * hashset->capacity);                             \
                                                                                                                 \
         return 1;                                                                                               \
     }                                                                                                           \
                                                                                                                 \
     HASHSET_##K* HASHSET_##K##_create(const u32 capacity) {                                                     \
-        HASHSET_##K* hashset = (HASHSET_##K*)malloc(sizeof(HASHSET_##K));                                       \
+        return HASHSET_##K##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {       \
+        HASHSET_##K* hashset = (HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_##K));                     \
         if (hashset == NULL) return NULL;                                                                       \
                                                                                                                 \
-        const u8 r = HASHSET_##K##_init(hashset, capacity);                                                     \
+        const u8 r = HASHSET_##K##_init_allocator(hashset, capacity, allocator);                                \
         if (r == 0) {                                                                                           \
-            free(hashset);                                                                                      \
+            NESQUIK_free(allocator, hashset);                                                                   \
             return NULL;                                                                                        \
         }                                                                                                       \
                                                                                                                 \
@@ -86,21 +201,30 @@
                                                                                                                 \
     void HASHSET_##K##_deinit(HASHSET_##K* hashset) {                                                           \
         if (hashset == NULL) return;                                                                            \
+        if (hashset->mapped == 1) {                                                                             \
+            MAPPED_close(hashset->entries, hashset->capacity, sizeof(HASHSET_ENTRY_##K));                       \
+            hashset->entries = NULL;                                                                            \
+            hashset->mapped = 0;                                                                                \
+        }                                                                                                       \
+                                                                                                                \
         hashset->size = 0;                                                                                      \
         hashset->capacity = 0;                                                                                  \
         hashset->tombstones = 0;                                                                                \
                                                                                                                 \
         if (hashset->entries != NULL) {                                                                         \
-            free(hashset->entries);                                                                             \
+            NESQUIK_free(hashset->allocator, hashset->entries);                                                 \
             hashset->entries = NULL;                                                                            \
         }                                                                                                       \
+                                                                                                                \
+        HASHSET_##K##_detach_filter(hashset);                                                                   \
     }                                                                                                           \
                                                                                                                 \
     void HASHSET_##K##_destroy(HASHSET_##K* hashset) {                                                          \
         if (hashset == NULL) return;                                                                            \
                                                                                                                 \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                                \
         HASHSET_##K##_deinit(hashset);                                                                          \
-        free(hashset);                                                                                          \
+        NESQUIK_free(allocator, hashset);                                                                       \
     }                                                                                                           \
                                                                                                                 \
     u8 HASHSET_##K##_grow(HASHSET_##K* hashset) {                                                               \
@@ -109,8 +233,22 @@
         u32 new_capacity = (u32)(hashset->capacity * HASHSET_MAX_LOAD_FACTOR / HASHSET_MIN_LOAD_FACTOR);        \
         new_capacity = (new_capacity > hashset->capacity) ? new_capacity : hashset->capacity;                   \
                                                                                                                 \
+        return HASHSET_##K##_resize(hashset, new_capacity);                                                     \
+    }                                                                                                           \
+                                                                                                                \
+    static void HASHSET_##K##_fill_filter(const HASHSET_##K* hashset, BLOOM* filter) {                          \
+        BLOOM_clear(filter);                                                                                    \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                           \
+            const HASHSET_ENTRY_##K* entry = hashset->entries + i;                                              \
+            if (entry->status == HASHSET_ENTRY_STATUS_FILLED) BLOOM_add_hash(filter, entry->hash);              \
+        }                                                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_resize(HASHSET_##K* hashset, const u32 new_capacity) {                                     \
+        if (hashset == NULL || hashset->mapped == 1) return 0;                                                  \
+                                                                                                                \
         HASHSET_##K new_hashset;                                                                                \
-        u8 r = HASHSET_##K##_init(&new_hashset, new_capacity);                                                  \
+        u8 r = HASHSET_##K##_init_allocator(&new_hashset, new_capacity, hashset->allocator);                    \
         if (r == 0) return 0;                                                                                   \
                                                                                                                 \
         for (u32 i = 0; i < hashset->capacity; i++) {                                                           \
@@ -125,19 +263,157 @@
             }                                                                                                   \
         }                                                                                                       \
                                                                                                                 \
-        free(hashset->entries);                                                                                 \
+        NESQUIK_free(hashset->allocator, hashset->entries);                                                     \
         hashset->entries = new_hashset.entries;                                                                 \
-        hashset->capacity = new_capacity;                                                                       \
+        hashset->capacity = new_hashset.capacity;                                                               \
         hashset->tombstones = 0;                                                                                \
                                                                                                                 \
+        if (hashset->filter != NULL && hashset->capacity * HASHSET_MAX_LOAD_FACTOR > hashset->filter->expected) \
+            HASHSET_##K##_attach_filter(hashset, hashset->filter->false_rate);                                  \
+                                                                                                                \
         return 1;                                                                                               \
     }                                                                                                           \
                                                                                                                 \
-    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, const u32 hash, const K key) {                             \
+    u8 HASHSET_##K##_rehash(HASHSET_##K* hashset) {                                                             \
+        if (hashset == NULL || hashset->mapped == 1) return 0;                                                  \
+                                                                                                                \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                           \
+            HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                    \
+            if (entry->status == HASHSET_ENTRY_STATUS_FILLED) entry->status = HASHSET_ENTRY_STATUS_DISPLACED;   \
+            else memset(entry, 0, sizeof(HASHSET_ENTRY_##K));                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                           \
+            if (hashset->entries[i].status != HASHSET_ENTRY_STATUS_DISPLACED) continue;                         \
+                                                                                                                \
+            HASHSET_ENTRY_##K moving = hashset->entries[i];                                                     \
+            memset(hashset->entries + i, 0, sizeof(HASHSET_ENTRY_##K));                                         \
+                                                                                                                \
+            for (;;) {                                                                                          \
+                u32 j = moving.hash % hashset->capacity;                                                        \
+                while (hashset->entries[j].status == HASHSET_ENTRY_STATUS_FILLED)                               \
+                    j = (j + 1) % hashset->capacity;                                                            \
+                                                                                                                \
+                const HASHSET_ENTRY_##K displaced = hashset->entries[j];                                        \
+                hashset->entries[j] = moving;                                                                   \
+                hashset->entries[j].status = HASHSET_ENTRY_STATUS_FILLED;                                       \
+                                                                                                                \
+                if (displaced.status == HASHSET_ENTRY_STATUS_EMPTY) break;                                      \
+                moving = displaced;                                                                             \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        hashset->tombstones = 0;                                                                                \
+        if (hashset->filter != NULL) HASHSET_##K##_fill_filter(hashset, hashset->filter);                       \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_reserve(HASHSET_##K* hashset, const u32 n) {                                               \
         if (hashset == NULL) return 0;                                                                          \
                                                                                                                 \
-        if ((hashset->size + 0.0) / hashset->capacity >= HASHSET_MAX_LOAD_FACTOR) {                             \
-            const u8 r = HASHSET_##K##_grow(hashset);                                                           \
+        const u32 capacity = (u32)(n / HASHSET_MAX_LOAD_FACTOR) + 1;                                            \
+        if (capacity <= hashset->capacity) return 1;                                                            \
+                                                                                                                \
+        return HASHSET_##K##_resize(hashset, capacity);                                                         \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_shrink_to_fit(HASHSET_##K* hashset) {                                                      \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        u32 capacity = (u32)(hashset->size / HASHSET_MAX_LOAD_FACTOR) + 1;                                      \
+        capacity = capacity < HASHSET_MIN_CAPACITY ? HASHSET_MIN_CAPACITY : capacity;                           \
+                                                                                                                \
+        if (capacity < hashset->capacity) return HASHSET_##K##_resize(hashset, capacity);                       \
+        if (hashset->tombstones == 0) return 1;                                                                 \
+        return HASHSET_##K##_rehash(hashset);                                                                   \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_attach_filter(HASHSET_##K* hashset, const f64 false_rate) {                                \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const u32 expected = (u32)(hashset->capacity * HASHSET_MAX_LOAD_FACTOR) + 1;                            \
+        BLOOM* filter = BLOOM_create(expected > hashset->size ? expected : hashset->size, false_rate);          \
+        if (filter == NULL) return 0;                                                                           \
+                                                                                                                \
+        HASHSET_##K##_fill_filter(hashset, filter);                                                             \
+        BLOOM_destroy(hashset->filter);                                                                         \
+        hashset->filter = filter;                                                                               \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_detach_filter(HASHSET_##K* hashset) {                                                    \
+        if (hashset == NULL) return;                                                                            \
+                                                                                                                \
+        BLOOM_destroy(hashset->filter);                                                                         \
+        hashset->filter = NULL;                                                                                 \
+    }                                                                                                           \
+                                                                                                                \
+    static u64 HASHSET_##K##_fingerprint(void) {                                                                \
+        u64 fingerprint = MAPPED_fingerprint_mix(0, offsetof(HASHSET_ENTRY_##K, status));                       \
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHSET_ENTRY_##K, hash));                   \
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHSET_ENTRY_##K, key));                    \
+                                                                                                                \
+        K key;                                                                                                  \
+        for (u32 i = 0; i < MAPPED_FINGERPRINT_PROBES; i++) {                                                   \
+            MAPPED_probe_key(&key, sizeof(K), i);                                                               \
+            fingerprint = MAPPED_fingerprint_mix(fingerprint, HASHSET_##K##_key_hash(key));                     \
+        }                                                                                                       \
+                                                                                                                \
+        return fingerprint;                                                                                     \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_save(const HASHSET_##K* hashset, const char* path) {                                       \
+        if (hashset == NULL || path == NULL) return 0;                                                          \
+                                                                                                                \
+        MAPPED_HEADER header;                                                                                   \
+        header.kind = MAPPED_KIND_HASHSET;                                                                      \
+        header.entry_size = sizeof(HASHSET_ENTRY_##K);                                                          \
+        header.key_size = sizeof(K);                                                                            \
+        header.value_size = 0;                                                                                  \
+        header.size = hashset->size;                                                                            \
+        header.capacity = hashset->capacity;                                                                    \
+        header.tombstones = hashset->tombstones;                                                                \
+        header.fingerprint = HASHSET_##K##_fingerprint();                                                       \
+        return MAPPED_save(path, &header, hashset->entries);                                                    \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_open_mmap(const char* path) {                                                    \
+        return HASHSET_##K##_open_mmap_allocator(path, NULL);                                                   \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_open_mmap_allocator(const char* path, const NESQUIK_ALLOCATOR* allocator) {      \
+        MAPPED_HEADER header;                                                                                   \
+        header.kind = MAPPED_KIND_HASHSET;                                                                      \
+        header.entry_size = sizeof(HASHSET_ENTRY_##K);                                                          \
+        header.key_size = sizeof(K);                                                                            \
+        header.value_size = 0;                                                                                  \
+        header.fingerprint = HASHSET_##K##_fingerprint();                                                       \
+                                                                                                                \
+        HASHSET_ENTRY_##K* entries = (HASHSET_ENTRY_##K*)MAPPED_open(path, &header);                            \
+        if (entries == NULL) return NULL;                                                                       \
+                                                                                                                \
+        HASHSET_##K* hashset = (HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_##K));                     \
+        if (hashset == NULL) {                                                                                  \
+            MAPPED_close(entries, header.capacity, header.entry_size);                                          \
+            return NULL;                                                                                        \
+        }                                                                                                       \
+                                                                                                                \
+        hashset->entries = entries;                                                                             \
+        hashset->size = header.size;                                                                            \
+        hashset->capacity = header.capacity;                                                                    \
+        hashset->tombstones = header.tombstones;                                                                \
+        hashset->filter = NULL;                                                                                 \
+        hashset->mapped = 1;                                                                                    \
+        hashset->allocator = allocator;                                                                         \
+        return hashset;                                                                                         \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, const u32 hash, const K key) {                             \
+        if (hashset == NULL || hashset->mapped == 1) return 0;                                                  \
+                                                                                                                \
+        if ((hashset->size + hashset->tombstones + 0.0) / hashset->capacity >= HASHSET_MAX_LOAD_FACTOR) {       \
+            const u8 purge = (hashset->size + 0.0) / hashset->capacity < HASHSET_MIN_LOAD_FACTOR;               \
+            const u8 r = purge == 1 ? HASHSET_##K##_rehash(hashset) : HASHSET_##K##_grow(hashset);              \
             if (r == 0) return 0;                                                                               \
         }                                                                                                       \
                                                                                                                 \
@@ -148,21 +424,27 @@
             HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                    \
             const u8 status = entry->status;                                                                    \
                                                                                                                 \
-            if (status == HASHSET_ENTRY_STATUS_EMPTY || status == HASHSET_ENTRY_STATUS_TOMBSTONE) {             \
-                found_entry = entry;                                                                            \
+            if (status == HASHSET_ENTRY_STATUS_EMPTY) {                                                         \
+                if (found_entry == NULL) found_entry = entry;                                                   \
                 break;                                                                                          \
             }                                                                                                   \
                                                                                                                 \
-            if (entry->key == key) break;                                                                       \
+            if (status == HASHSET_ENTRY_STATUS_TOMBSTONE) {                                                     \
+                if (found_entry == NULL) found_entry = entry;                                                   \
+            }                                                                                                   \
+            else if (entry->hash == hash && HASHSET_##K##_key_equal(entry->key, key) == 1) return 0;            \
+                                                                                                                \
             i = (i + 1) % hashset->capacity;                                                                    \
         } while (i != hash % hashset->capacity);                                                                \
                                                                                                                 \
         if (found_entry == NULL) return 0;                                                                      \
+        if (found_entry->status == HASHSET_ENTRY_STATUS_TOMBSTONE) hashset->tombstones--;                       \
                                                                                                                 \
         found_entry->status = HASHSET_ENTRY_STATUS_FILLED;                                                      \
         found_entry->hash = hash;                                                                               \
         found_entry->key = key;                                                                                 \
                                                                                                                 \
+        if (hashset->filter != NULL) BLOOM_add_hash(hashset->filter, hash);                                     \
         hashset->size++;                                                                                        \
         return 1;                                                                                               \
     }                                                                                                           \
@@ -170,12 +452,12 @@
     u8 HASHSET_##K##_add(HASHSET_##K* hashset, const K key) {                                                   \
         if (hashset == NULL) return 0;                                                                          \
                                                                                                                 \
-        const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));                                                  \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
         return HASHSET_##K##_quick_add(hashset, hash, key);                                                     \
     }                                                                                                           \
                                                                                                                 \
     void HASHSET_##K##_remove(HASHSET_##K* hashset, const K key) {                                              \
-        if (hashset == NULL) return;                                                                            \
+        if (hashset == NULL || hashset->mapped == 1) return;                                                    \
                                                                                                                 \
         HASHSET_ENTRY_##K* entry = HASHSET_##K##_find(hashset, key);                                            \
         if (entry == NULL) return;                                                                              \
@@ -186,10 +468,6 @@
         hashset->tombstones++;                                                                                  \
     }                                                                                                           \
                                                                                                                 \
-    u32 HASHSET_##K##_hash(const u8* data, const u32 size) {                                                    \
-        return HASH_fnv1a(data, size);                                                                          \
-    }                                                                                                           \
-                                                                                                                \
     u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, const K key) {                                        \
         if (hashset == NULL) return 0;                                                                          \
                                                                                                                 \
@@ -201,7 +479,21 @@
     HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, const K key) {                            \
         if (hashset == NULL) return NULL;                                                                       \
                                                                                                                 \
-        const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));                                                  \
+        return HASHSET_##K##_find_hashed(hashset, HASHSET_##K##_key_hash(key), key);                            \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {                 \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find_hashed(hashset, hash, key);                         \
+        if (entry == NULL) return 0;                                                                            \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {     \
+        if (hashset == NULL) return NULL;                                                                       \
+        if (hashset->filter != NULL && BLOOM_may_contain_hash(hashset->filter, hash) == 0) return NULL;         \
+                                                                                                                \
         u32 i = hash % hashset->capacity;                                                                       \
                                                                                                                 \
         HASHSET_ENTRY_##K* entry;                                                                               \
@@ -217,7 +509,7 @@
                 continue;                                                                                       \
             }                                                                                                   \
                                                                                                                 \
-            if (entry->key == key) break;                                                                       \
+            if (HASHSET_##K##_key_equal(entry->key, key) == 1) break;                                           \
             i = (i + 1) % hashset->capacity;                                                                    \
         } while (i != hash % hashset->capacity);                                                                \
                                                                                                                 \
@@ -225,10 +517,63 @@
         return NULL;                                                                                            \
     }                                                                                                           \
                                                                                                                 \
+    u32 HASHSET_##K##_add_many(HASHSET_##K* hashset, const K* keys, const u32 n) {                              \
+        if (hashset == NULL || keys == NULL) return 0;                                                          \
+                                                                                                                \
+        const u32 capacity = (u32)((hashset->size + (f64)n) / HASHSET_MAX_LOAD_FACTOR) + 1;                     \
+        if (capacity > hashset->capacity) {                                                                     \
+            const u8 r = HASHSET_##K##_resize(hashset, capacity);                                               \
+            if (r == 0) return 0;                                                                               \
+        }                                                                                                       \
+                                                                                                                \
+        u32 hashes[HASHSET_BATCH_SIZE];                                                                         \
+        u32 added = 0;                                                                                          \
+                                                                                                                \
+        for (u32 start = 0; start < n; start += HASHSET_BATCH_SIZE) {                                           \
+            const u32 count = n - start < HASHSET_BATCH_SIZE ? n - start : HASHSET_BATCH_SIZE;                  \
+                                                                                                                \
+            for (u32 i = 0; i < count; i++) {                                                                   \
+                hashes[i] = HASHSET_##K##_key_hash(keys[start + i]);                                            \
+                HASH_PREFETCH_WRITE(hashset->entries + hashes[i] % hashset->capacity);                          \
+            }                                                                                                   \
+                                                                                                                \
+            for (u32 i = 0; i < count; i++)                                                                     \
+                added += HASHSET_##K##_quick_add(hashset, hashes[i], keys[start + i]);                          \
+        }                                                                                                       \
+                                                                                                                \
+        return added;                                                                                           \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_find_many(const HASHSET_##K* hashset, const K* keys, const u32 n,                         \
+        HASHSET_ENTRY_##K** out) {                                                                              \
+                                                                                                                \
+        if (hashset == NULL || keys == NULL || out == NULL) return 0;                                           \
+                                                                                                                \
+        u32 hashes[HASHSET_BATCH_SIZE];                                                                         \
+        u32 found = 0;                                                                                          \
+                                                                                                                \
+        for (u32 start = 0; start < n; start += HASHSET_BATCH_SIZE) {                                           \
+            const u32 count = n - start < HASHSET_BATCH_SIZE ? n - start : HASHSET_BATCH_SIZE;                  \
+                                                                                                                \
+            for (u32 i = 0; i < count; i++) {                                                                   \
+                hashes[i] = HASHSET_##K##_key_hash(keys[start + i]);                                            \
+                HASH_PREFETCH(hashset->entries + hashes[i] % hashset->capacity);                                \
+            }                                                                                                   \
+                                                                                                                \
+            for (u32 i = 0; i < count; i++) {                                                                   \
+                out[start + i] = HASHSET_##K##_find_hashed(hashset, hashes[i], keys[start + i]);                \
+                if (out[start + i] != NULL) found++;                                                            \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        return found;                                                                                           \
+    }                                                                                                           \
+                                                                                                                \
     HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b) {                              \
         if (a == NULL || b == NULL) return NULL;                                                                \
                                                                                                                 \
-        HASHSET_##K* c = HASHSET_##K##_create(a->capacity + b->capacity);                                       \
+        const u32 capacity = HASHSET_capacity_for(a->size + (f64)b->size);                                      \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(capacity, a->allocator);                                \
         if (c == NULL) return NULL;                                                                             \
                                                                                                                 \
         for (u32 ai = 0; ai < a->capacity; ai++) {                                                              \
@@ -260,13 +605,14 @@
             larger = a;                                                                                         \
         }                                                                                                       \
                                                                                                                 \
-        HASHSET_##K* c = HASHSET_##K##_create(smaller->capacity);                                               \
+        const u32 capacity = HASHSET_capacity_for(a->size < b->size ? a->size : b->size);                       \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(capacity, a->allocator);                                \
         if (c == NULL) return NULL;                                                                             \
                                                                                                                 \
         for (u32 i = 0; i < smaller->capacity; i++) {                                                           \
             const HASHSET_ENTRY_##K entry = smaller->entries[i];                                                \
             if (entry.status == HASHSET_ENTRY_STATUS_FILLED) {                                                  \
-                if (HASHSET_##K##_contains(larger, entry.key) == 1) {                                           \
+                if (HASHSET_##K##_contains_hashed(larger, entry.hash, entry.key) == 1) {                        \
                     HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                          \
                 }                                                                                               \
             }                                                                                                   \
@@ -278,19 +624,194 @@
     HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b) {                         \
         if (a == NULL || b == NULL) return NULL;                                                                \
                                                                                                                 \
-        HASHSET_##K* c = HASHSET_##K##_create(a->capacity);                                                     \
+        const u32 capacity = HASHSET_capacity_for(a->size);                                                     \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(capacity, a->allocator);                                \
         if (c == NULL) return NULL;                                                                             \
                                                                                                                 \
         for (u32 ai = 0; ai < a->capacity; ai++) {                                                              \
             const HASHSET_ENTRY_##K entry = a->entries[ai];                                                     \
             if (entry.status == HASHSET_ENTRY_STATUS_FILLED) {                                                  \
-                if (HASHSET_##K##_contains(b, entry.key) == 0) {                                                \
+                if (HASHSET_##K##_contains_hashed(b, entry.hash, entry.key) == 0) {                             \
                     HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                          \
                 }                                                                                               \
             }                                                                                                   \
         }                                                                                                       \
                                                                                                                 \
         return c;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    static void HASHSET_##K##_erase(HASHSET_##K* hashset, HASHSET_ENTRY_##K* entry) {                           \
+        memset(entry, 0, sizeof(HASHSET_ENTRY_##K));                                                            \
+        entry->status = HASHSET_ENTRY_STATUS_TOMBSTONE;                                                         \
+        hashset->size--;                                                                                        \
+        hashset->tombstones++;                                                                                  \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_union_into(HASHSET_##K* a, const HASHSET_##K* b) {                                        \
+        if (a == NULL || b == NULL || a == b) return 0;                                                         \
+                                                                                                                \
+        u32 added = 0;                                                                                          \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                              \
+            const HASHSET_ENTRY_##K* entry = b->entries + bi;                                                   \
+            if (entry->status == HASHSET_ENTRY_STATUS_FILLED)                                                   \
+                added += HASHSET_##K##_quick_add(a, entry->hash, entry->key);                                   \
+        }                                                                                                       \
+                                                                                                                \
+        return added;                                                                                           \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_intersect_inplace(HASHSET_##K* a, const HASHSET_##K* b) {                                 \
+        if (a == NULL || b == NULL || a == b || a->mapped == 1) return 0;                                       \
+                                                                                                                \
+        u32 removed = 0;                                                                                        \
+        for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {                                               \
+            HASHSET_ENTRY_##K* entry = a->entries + ai;                                                         \
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                         \
+            if (HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 1) continue;                       \
+                                                                                                                \
+            HASHSET_##K##_erase(a, entry);                                                                      \
+            removed++;                                                                                          \
+        }                                                                                                       \
+                                                                                                                \
+        return removed;                                                                                         \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_subtract_inplace(HASHSET_##K* a, const HASHSET_##K* b) {                                  \
+        if (a == NULL || b == NULL || a->mapped == 1) return 0;                                                 \
+                                                                                                                \
+        u32 removed = 0;                                                                                        \
+        if (a != b && b->capacity < a->capacity) {                                                              \
+            for (u32 bi = 0; bi < b->capacity && a->size > 0; bi++) {                                           \
+                const HASHSET_ENTRY_##K* entry = b->entries + bi;                                               \
+                if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                     \
+                                                                                                                \
+                HASHSET_ENTRY_##K* found = HASHSET_##K##_find_hashed(a, entry->hash, entry->key);               \
+                if (found == NULL) continue;                                                                    \
+                                                                                                                \
+                HASHSET_##K##_erase(a, found);                                                                  \
+                removed++;                                                                                      \
+            }                                                                                                   \
+                                                                                                                \
+            return removed;                                                                                     \
+        }                                                                                                       \
+                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {                                               \
+            HASHSET_ENTRY_##K* entry = a->entries + ai;                                                         \
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                         \
+            if (a != b && HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 0) continue;             \
+                                                                                                                \
+            HASHSET_##K##_erase(a, entry);                                                                      \
+            removed++;                                                                                          \
+        }                                                                                                       \
+                                                                                                                \
+        return removed;                                                                                         \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_intersection_size(const HASHSET_##K* a, const HASHSET_##K* b) {                           \
+        if (a == NULL || b == NULL) return 0;                                                                   \
+        if (a == b) return a->size;                                                                             \
+                                                                                                                \
+        const HASHSET_##K* smaller = a->capacity < b->capacity ? a : b;                                         \
+        const HASHSET_##K* larger = a->capacity < b->capacity ? b : a;                                          \
+                                                                                                                \
+        u32 count = 0;                                                                                          \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                           \
+            const HASHSET_ENTRY_##K* entry = smaller->entries + i;                                              \
+            if (entry->status == HASHSET_ENTRY_STATUS_FILLED)                                                   \
+                count += HASHSET_##K##_contains_hashed(larger, entry->hash, entry->key);                        \
+        }                                                                                                       \
+                                                                                                                \
+        return count;                                                                                           \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_union_size(const HASHSET_##K* a, const HASHSET_##K* b) {                                  \
+        if (a == NULL || b == NULL) return 0;                                                                   \
+                                                                                                                \
+        return a->size + b->size - HASHSET_##K##_intersection_size(a, b);                                       \
+    }                                                                                                           \
+                                                                                                                \
+    u32 HASHSET_##K##_difference_size(const HASHSET_##K* a, const HASHSET_##K* b) {                             \
+        if (a == NULL || b == NULL) return 0;                                                                   \
+                                                                                                                \
+        return a->size - HASHSET_##K##_intersection_size(a, b);                                                 \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_iterate(HASHSET_ITERATOR_##K* iterator, const HASHSET_##K* hashset) {                    \
+        if (iterator == NULL) return;                                                                           \
+                                                                                                                \
+        iterator->a = hashset;                                                                                  \
+        iterator->b = NULL;                                                                                     \
+        iterator->index = 0;                                                                                    \
+        iterator->mode = HASHSET_ITERATE_ALL;                                                                   \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_iterate_union(HASHSET_ITERATOR_##K* iterator,                                            \
+        const HASHSET_##K* a, const HASHSET_##K* b) {                                                           \
+                                                                                                                \
+        if (iterator == NULL) return;                                                                           \
+                                                                                                                \
+        iterator->a = a;                                                                                        \
+        iterator->b = b;                                                                                        \
+        iterator->index = 0;                                                                                    \
+        iterator->mode = a == b ? HASHSET_ITERATE_ALL : HASHSET_ITERATE_UNION;                                  \
+        if (b == NULL) iterator->a = NULL;                                                                      \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_iterate_intersection(HASHSET_ITERATOR_##K* iterator,                                     \
+        const HASHSET_##K* a, const HASHSET_##K* b) {                                                           \
+                                                                                                                \
+        if (iterator == NULL) return;                                                                           \
+                                                                                                                \
+        iterator->a = a != NULL && b != NULL && b->capacity < a->capacity ? b : a;                              \
+        iterator->b = iterator->a == a ? b : a;                                                                 \
+        iterator->index = 0;                                                                                    \
+        iterator->mode = HASHSET_ITERATE_INTERSECTION;                                                          \
+        if (iterator->b == NULL) iterator->a = NULL;                                                            \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_iterate_difference(HASHSET_ITERATOR_##K* iterator,                                       \
+        const HASHSET_##K* a, const HASHSET_##K* b) {                                                           \
+                                                                                                                \
+        if (iterator == NULL) return;                                                                           \
+                                                                                                                \
+        iterator->a = a == b ? NULL : a;                                                                        \
+        iterator->b = b;                                                                                        \
+        iterator->index = 0;                                                                                    \
+        iterator->mode = HASHSET_ITERATE_DIFFERENCE;                                                            \
+        if (b == NULL) iterator->a = NULL;                                                                      \
+    }                                                                                                           \
+                                                                                                                \
+    const HASHSET_ENTRY_##K* HASHSET_##K##_next(HASHSET_ITERATOR_##K* iterator) {                               \
+        if (iterator == NULL || iterator->a == NULL) return NULL;                                               \
+                                                                                                                \
+        const HASHSET_##K* a = iterator->a;                                                                     \
+        const HASHSET_##K* b = iterator->b;                                                                     \
+                                                                                                                \
+        for (; iterator->index < a->capacity; iterator->index++) {                                              \
+            const HASHSET_ENTRY_##K* entry = a->entries + iterator->index;                                      \
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                         \
+                                                                                                                \
+            if (iterator->mode == HASHSET_ITERATE_INTERSECTION &&                                               \
+                HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 0) continue;                       \
+            if (iterator->mode == HASHSET_ITERATE_DIFFERENCE &&                                                 \
+                HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 1) continue;                       \
+                                                                                                                \
+            iterator->index++;                                                                                  \
+            return entry;                                                                                       \
+        }                                                                                                       \
+                                                                                                                \
+        if (iterator->mode != HASHSET_ITERATE_UNION) return NULL;                                               \
+                                                                                                                \
+        for (; iterator->index - a->capacity < b->capacity; iterator->index++) {                                \
+            const HASHSET_ENTRY_##K* entry = b->entries + (iterator->index - a->capacity);                      \
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                         \
+            if (HASHSET_##K##_contains_hashed(a, entry->hash, entry->key) == 1) continue;                       \
+                                                                                                                \
+            iterator->index++;                                                                                  \
+            return entry;                                                                                       \
+        }                                                                                                       \
+                                                                                                                \
+        return NULL;                                                                                            \
     }
 
 #endif // NESQUIK_HASHSET_H
@@ -3,21 +3,30 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "types.h"
+#include "allocator.h"
 #include "hash/hash.h"
+#include "hash/mapped.h"
+#include "sketch/bloom.h"
 
 #define HASHTABLE_ENTRY_STATUS_EMPTY        0
 #define HASHTABLE_ENTRY_STATUS_FILLED       1
 #define HASHTABLE_ENTRY_STATUS_TOMBSTONE    2
+// Marks entries still to be moved while _rehash purges tombstones in place
+#define HASHTABLE_ENTRY_STATUS_DISPLACED    3
 
 #define HASHTABLE_MIN_LOAD_FACTOR           0.5
 #define HASHTABLE_MAX_LOAD_FACTOR           0.75
 
 #define HASHTABLE_MIN_CAPACITY              8
 
+// Keys hashed and prefetched ahead of probing by _add_many and _find_many
+#define HASHTABLE_BATCH_SIZE                16
+
 #pragma pack(push, 1)
-#define HASHTABLE_DECLARE(K, V)                                                                                         \
+#define HASHTABLE_DECLARE_TYPES(K, V)                                                                                   \
     typedef struct HASHTABLE_ENTRY_##K##_##V {                                                                          \
         u8 status;                                                                                                      \
         u32 hash;                                                                                                       \
@@ -30,53 +39,134 @@
         u32 size;                                                                                                       \
         u32 capacity;                                                                                                   \
         u32 tombstones;                                                                                                 \
+        BLOOM* filter;                                                                                                  \
+        u8 mapped;                                                                                                      \
+        const NESQUIK_ALLOCATOR* allocator;                                                                             \
     } HASHTABLE_##K##_##V;                                                                                              \
                                                                                                                         \
     u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, u32 capacity);                                        \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator);                                                                            \
     HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(u32 capacity);                                                    \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);      \
                                                                                                                         \
     void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable);                                                  \
     void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable);                                                 \
                                                                                                                         \
     u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable);                                                      \
+    u8 HASHTABLE_##K##_##V##_resize(HASHTABLE_##K##_##V* hashtable, u32 capacity);                                      \
+    u8 HASHTABLE_##K##_##V##_rehash(HASHTABLE_##K##_##V* hashtable);                                                    \
+    u8 HASHTABLE_##K##_##V##_reserve(HASHTABLE_##K##_##V* hashtable, u32 n);                                            \
+    u8 HASHTABLE_##K##_##V##_shrink_to_fit(HASHTABLE_##K##_##V* hashtable);                                             \
+    u8 HASHTABLE_##K##_##V##_attach_filter(HASHTABLE_##K##_##V* hashtable, f64 false_rate);                             \
+    void HASHTABLE_##K##_##V##_detach_filter(HASHTABLE_##K##_##V* hashtable);                                           \
+    u8 HASHTABLE_##K##_##V##_save(const HASHTABLE_##K##_##V* hashtable, const char* path);                              \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_open_mmap(const char* path);                                             \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_open_mmap_allocator(const char* path,                                    \
+        const NESQUIK_ALLOCATOR* allocator);                                                                            \
     u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, K key, V value);                                       \
     u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);                       \
+    u8 HASHTABLE_##K##_##V##_upsert(HASHTABLE_##K##_##V* hashtable, K key, V value);                                    \
+    u8 HASHTABLE_##K##_##V##_quick_upsert(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);                    \
+    V* HASHTABLE_##K##_##V##_get_or_insert(HASHTABLE_##K##_##V* hashtable, K key, u8* inserted);                        \
+    V* HASHTABLE_##K##_##V##_quick_get_or_insert(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, u8* inserted);        \
     void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, K key);                                           \
                                                                                                                         \
-    u32 HASHTABLE_##K##_##V##_hash(const u8* data, u32 size);                                                           \
-                                                                                                                        \
     u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, K key);                                     \
-    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, K key);
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, K key);                 \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash, K key);                    \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable,                  \
+        u32 hash, K key);                                                                                               \
+                                                                                                                        \
+    u32 HASHTABLE_##K##_##V##_add_many(HASHTABLE_##K##_##V* hashtable, const K* keys, const V* values, u32 n);          \
+    u32 HASHTABLE_##K##_##V##_find_many(const HASHTABLE_##K##_##V* hashtable, const K* keys, u32 n,                     \
+        HASHTABLE_ENTRY_##K##_##V** out);
 #pragma pack(pop)
 
+// Hashes the bytes of the key with one of the hash.h kernels and compares keys with ==
+#define HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)                                        \
+    static inline u32 HASHTABLE_##K##_##V##_hash(const u8* data, const u32 size) {      \
+        return HASH_F(data, size);                                                      \
+    }                                                                                   \
+                                                                                        \
+    static inline u32 HASHTABLE_##K##_##V##_key_hash(const K key) {                     \
+        return HASH_F((const u8*)(&key), sizeof(key));                                  \
+    }                                                                                   \
+                                                                                        \
+    static inline u8 HASHTABLE_##K##_##V##_key_equal(const K a, const K b) {            \
+        return a == b;                                                                  \
+    }
+
+// Bakes a user hash (u32 HASH_FN(K)) and equality (u8 EQ_FN(K, K)) into the generated functions,
+// e.g. HASH_u64 for integer keys or a field-wise hash for structs with padding. The byte helper _hash
+// stays on HASH_fnv1a, so both key modes emit the same functions.
+#define HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)                                  \
+    static inline u32 HASHTABLE_##K##_##V##_hash(const u8* data, const u32 size) {      \
+        return HASH_fnv1a(data, size);                                                  \
+    }                                                                                   \
+                                                                                        \
+    static inline u32 HASHTABLE_##K##_##V##_key_hash(const K key) {                     \
+        return HASH_FN(key);                                                            \
+    }                                                                                   \
+                                                                                        \
+    static inline u8 HASHTABLE_##K##_##V##_key_equal(const K a, const K b) {            \
+        return EQ_FN(a, b) ? 1 : 0;                                                     \
+    }
+
+#define HASHTABLE_DECLARE_HASH(K, V, HASH_F)    \
+    HASHTABLE_DECLARE_TYPES(K, V)               \
+    HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define HASHTABLE_DECLARE_EX(K, V, HASH_FN, EQ_FN)      \
+    HASHTABLE_DECLARE_TYPES(K, V)                       \
+    HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define HASHTABLE_DECLARE(K, V) HASHTABLE_DECLARE_HASH(K, V, HASH_fnv1a)
+
 #define HASHTABLE_DEFINE(K, V)                                                                                          \
     u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, const u32 capacity) {                                 \
+        return HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, NULL);                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, const u32 capacity,                         \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
                                                                                                                         \
         if (hashtable == NULL) return 0;                                                                                \
                                                                                                                         \
+        hashtable->allocator = allocator;                                                                               \
         hashtable->size = 0;                                                                                            \
         hashtable->capacity = capacity < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : capacity;                    \
         hashtable->tombstones = 0;                                                                                      \
+        hashtable->filter = NULL;                                                                                       \
+        hashtable->mapped = 0;                                                                                          \
                                                                                                                         \
-        hashtable->entries = (HASHTABLE_ENTRY_##K##_##V*)malloc(sizeof(HASHTABLE_ENTRY_##K##_##V) * capacity);          \
+        hashtable->entries = (HASHTABLE_ENTRY_##K##_##V*)NESQUIK_alloc(allocator,                                       \
+            sizeof(HASHTABLE_ENTRY_##K##_##V) *                                                                         \
+            hashtable->capacity);                                                                                       \
         if (hashtable->entries == NULL) {                                                                               \
             hashtable->capacity = 0;                                                                                    \
             return 0;                                                                                                   \
         }                                                                                                               \
                                                                                                                         \
-        memset(hashtable->entries, 0, sizeof(HASHTABLE_ENTRY_##K##_##V) * capacity);                                    \
+        memset(hashtable->entries, 0, sizeof(HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                         \
                                                                                                                         \
         return 1;                                                                                                       \
     }                                                                                                                   \
                                                                                                                         \
     HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(const u32 capacity) {                                             \
+        return HASHTABLE_##K##_##V##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                                   \
                                                                                                                         \
-        HASHTABLE_##K##_##V* hashtable = (HASHTABLE_##K##_##V*)malloc(sizeof(HASHTABLE_##K##_##V));                     \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                     \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        HASHTABLE_##K##_##V* hashtable = (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                 \
+            sizeof(HASHTABLE_##K##_##V));                                                                               \
         if (hashtable == NULL) return NULL;                                                                             \
                                                                                                                         \
-        const u8 r = HASHTABLE_##K##_##V##_init(hashtable, capacity);                                                   \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, allocator);                              \
         if (r == 0) {                                                                                                   \
-            free(hashtable);                                                                                            \
+            NESQUIK_free(allocator, hashtable);                                                                         \
             return NULL;                                                                                                \
         }                                                                                                               \
                                                                                                                         \
@@ -85,21 +175,30 @@
                                                                                                                         \
     void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable) {                                                 \
         if (hashtable == NULL) return;                                                                                  \
+        if (hashtable->mapped == 1) {                                                                                   \
+            MAPPED_close(hashtable->entries, hashtable->capacity, sizeof(HASHTABLE_ENTRY_##K##_##V));                   \
+            hashtable->entries = NULL;                                                                                  \
+            hashtable->mapped = 0;                                                                                      \
+        }                                                                                                               \
+                                                                                                                        \
         hashtable->size = 0;                                                                                            \
         hashtable->capacity = 0;                                                                                        \
         hashtable->tombstones = 0;                                                                                      \
                                                                                                                         \
         if (hashtable->entries != NULL) {                                                                               \
-            free(hashtable->entries);                                                                                   \
+            NESQUIK_free(hashtable->allocator, hashtable->entries);                                                     \
             hashtable->entries = NULL;                                                                                  \
         }                                                                                                               \
+                                                                                                                        \
+        HASHTABLE_##K##_##V##_detach_filter(hashtable);                                                                 \
     }                                                                                                                   \
                                                                                                                         \
     void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable) {                                                \
         if (hashtable == NULL) return;                                                                                  \
                                                                                                                         \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                      \
         HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
-        free(hashtable);                                                                                                \
+        NESQUIK_free(allocator, hashtable);                                                                             \
     }                                                                                                                   \
                                                                                                                         \
     u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable) {                                                     \
@@ -108,8 +207,22 @@
         u32 new_capacity = (u32)(hashtable->capacity * HASHTABLE_MAX_LOAD_FACTOR / HASHTABLE_MIN_LOAD_FACTOR);          \
         new_capacity = (new_capacity > hashtable->capacity) ? new_capacity : hashtable->capacity;                       \
                                                                                                                         \
+        return HASHTABLE_##K##_##V##_resize(hashtable, new_capacity);                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+    static void HASHTABLE_##K##_##V##_fill_filter(const HASHTABLE_##K##_##V* hashtable, BLOOM* filter) {                \
+        BLOOM_clear(filter);                                                                                            \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                 \
+            const HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                            \
+            if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED) BLOOM_add_hash(filter, entry->hash);                    \
+        }                                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_resize(HASHTABLE_##K##_##V* hashtable, const u32 new_capacity) {                           \
+        if (hashtable == NULL || hashtable->mapped == 1) return 0;                                                      \
+                                                                                                                        \
         HASHTABLE_##K##_##V new_hashtable;                                                                              \
-        u8 r = HASHTABLE_##K##_##V##_init(&new_hashtable, new_capacity);                                                \
+        u8 r = HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);                \
         if (r == 0) return 0;                                                                                           \
                                                                                                                         \
         for (u32 i = 0; i < hashtable->capacity; i++) {                                                                 \
@@ -124,20 +237,164 @@
             }                                                                                                           \
         }                                                                                                               \
                                                                                                                         \
-        free(hashtable->entries);                                                                                       \
+        NESQUIK_free(hashtable->allocator, hashtable->entries);                                                         \
         hashtable->entries = new_hashtable.entries;                                                                     \
-        hashtable->capacity = new_capacity;                                                                             \
+        hashtable->capacity = new_hashtable.capacity;                                                                   \
         hashtable->tombstones = 0;                                                                                      \
                                                                                                                         \
+        if (hashtable->filter != NULL && hashtable->capacity * HASHTABLE_MAX_LOAD_FACTOR > hashtable->filter->expected) \
+            HASHTABLE_##K##_##V##_attach_filter(hashtable, hashtable->filter->false_rate);                              \
+                                                                                                                        \
         return 1;                                                                                                       \
     }                                                                                                                   \
                                                                                                                         \
-    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) {    \
+    u8 HASHTABLE_##K##_##V##_rehash(HASHTABLE_##K##_##V* hashtable) {                                                   \
+        if (hashtable == NULL || hashtable->mapped == 1) return 0;                                                      \
+                                                                                                                        \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                 \
+            HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                  \
+            if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED) entry->status = HASHTABLE_ENTRY_STATUS_DISPLACED;       \
+            else memset(entry, 0, sizeof(HASHTABLE_ENTRY_##K##_##V));                                                   \
+        }                                                                                                               \
+                                                                                                                        \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                 \
+            if (hashtable->entries[i].status != HASHTABLE_ENTRY_STATUS_DISPLACED) continue;                             \
+                                                                                                                        \
+            HASHTABLE_ENTRY_##K##_##V moving = hashtable->entries[i];                                                   \
+            memset(hashtable->entries + i, 0, sizeof(HASHTABLE_ENTRY_##K##_##V));                                       \
+                                                                                                                        \
+            for (;;) {                                                                                                  \
+                u32 j = moving.hash % hashtable->capacity;                                                              \
+                while (hashtable->entries[j].status == HASHTABLE_ENTRY_STATUS_FILLED)                                   \
+                    j = (j + 1) % hashtable->capacity;                                                                  \
+                                                                                                                        \
+                const HASHTABLE_ENTRY_##K##_##V displaced = hashtable->entries[j];                                      \
+                hashtable->entries[j] = moving;                                                                         \
+                hashtable->entries[j].status = HASHTABLE_ENTRY_STATUS_FILLED;                                           \
+                                                                                                                        \
+                if (displaced.status == HASHTABLE_ENTRY_STATUS_EMPTY) break;                                            \
+                moving = displaced;                                                                                     \
+            }                                                                                                           \
+        }                                                                                                               \
+                                                                                                                        \
+        hashtable->tombstones = 0;                                                                                      \
+        if (hashtable->filter != NULL) HASHTABLE_##K##_##V##_fill_filter(hashtable, hashtable->filter);                 \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_reserve(HASHTABLE_##K##_##V* hashtable, const u32 n) {                                     \
         if (hashtable == NULL) return 0;                                                                                \
                                                                                                                         \
-        if ((hashtable->size + 0.0) / hashtable->capacity >= HASHTABLE_MAX_LOAD_FACTOR) {                               \
-            const u8 r = HASHTABLE_##K##_##V##_grow(hashtable);                                                         \
-            if (r == 0) return 0;                                                                                       \
+        const u32 capacity = (u32)(n / HASHTABLE_MAX_LOAD_FACTOR) + 1;                                                  \
+        if (capacity <= hashtable->capacity) return 1;                                                                  \
+                                                                                                                        \
+        return HASHTABLE_##K##_##V##_resize(hashtable, capacity);                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_shrink_to_fit(HASHTABLE_##K##_##V* hashtable) {                                            \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        u32 capacity = (u32)(hashtable->size / HASHTABLE_MAX_LOAD_FACTOR) + 1;                                          \
+        capacity = capacity < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : capacity;                               \
+                                                                                                                        \
+        if (capacity < hashtable->capacity) return HASHTABLE_##K##_##V##_resize(hashtable, capacity);                   \
+        if (hashtable->tombstones == 0) return 1;                                                                       \
+        return HASHTABLE_##K##_##V##_rehash(hashtable);                                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_attach_filter(HASHTABLE_##K##_##V* hashtable, const f64 false_rate) {                      \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const u32 expected = (u32)(hashtable->capacity * HASHTABLE_MAX_LOAD_FACTOR) + 1;                                \
+        BLOOM* filter = BLOOM_create(expected > hashtable->size ? expected : hashtable->size, false_rate);              \
+        if (filter == NULL) return 0;                                                                                   \
+                                                                                                                        \
+        HASHTABLE_##K##_##V##_fill_filter(hashtable, filter);                                                           \
+        BLOOM_destroy(hashtable->filter);                                                                               \
+        hashtable->filter = filter;                                                                                     \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_detach_filter(HASHTABLE_##K##_##V* hashtable) {                                          \
+        if (hashtable == NULL) return;                                                                                  \
+                                                                                                                        \
+        BLOOM_destroy(hashtable->filter);                                                                               \
+        hashtable->filter = NULL;                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    static u64 HASHTABLE_##K##_##V##_fingerprint(void) {                                                                \
+        u64 fingerprint = MAPPED_fingerprint_mix(0, offsetof(HASHTABLE_ENTRY_##K##_##V, status));                       \
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHTABLE_ENTRY_##K##_##V, hash));                   \
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHTABLE_ENTRY_##K##_##V, key));                    \
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHTABLE_ENTRY_##K##_##V, value));                  \
+                                                                                                                        \
+        K key;                                                                                                          \
+        for (u32 i = 0; i < MAPPED_FINGERPRINT_PROBES; i++) {                                                           \
+            MAPPED_probe_key(&key, sizeof(K), i);                                                                       \
+            fingerprint = MAPPED_fingerprint_mix(fingerprint, HASHTABLE_##K##_##V##_key_hash(key));                     \
+        }                                                                                                               \
+                                                                                                                        \
+        return fingerprint;                                                                                             \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_save(const HASHTABLE_##K##_##V* hashtable, const char* path) {                             \
+        if (hashtable == NULL || path == NULL) return 0;                                                                \
+                                                                                                                        \
+        MAPPED_HEADER header;                                                                                           \
+        header.kind = MAPPED_KIND_HASHTABLE;                                                                            \
+        header.entry_size = sizeof(HASHTABLE_ENTRY_##K##_##V);                                                          \
+        header.key_size = sizeof(K);                                                                                    \
+        header.value_size = sizeof(V);                                                                                  \
+        header.size = hashtable->size;                                                                                  \
+        header.capacity = hashtable->capacity;                                                                          \
+        header.tombstones = hashtable->tombstones;                                                                      \
+        header.fingerprint = HASHTABLE_##K##_##V##_fingerprint();                                                       \
+        return MAPPED_save(path, &header, hashtable->entries);                                                          \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_open_mmap(const char* path) {                                            \
+        return HASHTABLE_##K##_##V##_open_mmap_allocator(path, NULL);                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_open_mmap_allocator(const char* path,                                    \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        MAPPED_HEADER header;                                                                                           \
+        header.kind = MAPPED_KIND_HASHTABLE;                                                                            \
+        header.entry_size = sizeof(HASHTABLE_ENTRY_##K##_##V);                                                          \
+        header.key_size = sizeof(K);                                                                                    \
+        header.value_size = sizeof(V);                                                                                  \
+        header.fingerprint = HASHTABLE_##K##_##V##_fingerprint();                                                       \
+                                                                                                                        \
+        HASHTABLE_ENTRY_##K##_##V* entries = (HASHTABLE_ENTRY_##K##_##V*)MAPPED_open(path, &header);                    \
+        if (entries == NULL) return NULL;                                                                               \
+                                                                                                                        \
+        HASHTABLE_##K##_##V* hashtable =                                                                                \
+            (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator, sizeof(HASHTABLE_##K##_##V));                                \
+        if (hashtable == NULL) {                                                                                        \
+            MAPPED_close(entries, header.capacity, header.entry_size);                                                  \
+            return NULL;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        hashtable->entries = entries;                                                                                   \
+        hashtable->size = header.size;                                                                                  \
+        hashtable->capacity = header.capacity;                                                                          \
+        hashtable->tombstones = header.tombstones;                                                                      \
+        hashtable->filter = NULL;                                                                                       \
+        hashtable->mapped = 1;                                                                                          \
+        hashtable->allocator = allocator;                                                                               \
+        return hashtable;                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    V* HASHTABLE_##K##_##V##_quick_get_or_insert(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key,           \
+        u8* inserted) {                                                                                                 \
+                                                                                                                        \
+        if (hashtable == NULL || hashtable->mapped == 1) return NULL;                                                   \
+                                                                                                                        \
+        if ((hashtable->size + hashtable->tombstones + 0.0) / hashtable->capacity >= HASHTABLE_MAX_LOAD_FACTOR) {       \
+            const u8 purge = (hashtable->size + 0.0) / hashtable->capacity < HASHTABLE_MIN_LOAD_FACTOR;                 \
+            const u8 r = purge == 1 ? HASHTABLE_##K##_##V##_rehash(hashtable) : HASHTABLE_##K##_##V##_grow(hashtable);  \
+            if (r == 0) return NULL;                                                                                    \
         }                                                                                                               \
                                                                                                                         \
         u32 i = hash % hashtable->capacity;                                                                             \
@@ -147,35 +404,80 @@
             HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                  \
             const u8 status = entry->status;                                                                            \
                                                                                                                         \
-            if (status == HASHTABLE_ENTRY_STATUS_EMPTY || status == HASHTABLE_ENTRY_STATUS_TOMBSTONE) {                 \
-                found_entry = entry;                                                                                    \
+            if (status == HASHTABLE_ENTRY_STATUS_EMPTY) {                                                               \
+                if (found_entry == NULL) found_entry = entry;                                                           \
                 break;                                                                                                  \
             }                                                                                                           \
                                                                                                                         \
-            if (entry->key == key) break;                                                                               \
+            if (status == HASHTABLE_ENTRY_STATUS_TOMBSTONE) {                                                           \
+                if (found_entry == NULL) found_entry = entry;                                                           \
+            }                                                                                                           \
+            else if (entry->hash == hash && HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) {                    \
+                if (inserted != NULL) *inserted = 0;                                                                    \
+                return &entry->value;                                                                                   \
+            }                                                                                                           \
+                                                                                                                        \
             i = (i + 1) % hashtable->capacity;                                                                          \
         } while (i != hash % hashtable->capacity);                                                                      \
                                                                                                                         \
-        if (found_entry == NULL) return 0;                                                                              \
+        if (found_entry == NULL) return NULL;                                                                           \
+        if (found_entry->status == HASHTABLE_ENTRY_STATUS_TOMBSTONE) hashtable->tombstones--;                           \
                                                                                                                         \
         found_entry->status = HASHTABLE_ENTRY_STATUS_FILLED;                                                            \
         found_entry->hash = hash;                                                                                       \
         found_entry->key = key;                                                                                         \
-        found_entry->value = value;                                                                                     \
+        memset(&found_entry->value, 0, sizeof(V));                                                                      \
                                                                                                                         \
+        if (hashtable->filter != NULL) BLOOM_add_hash(hashtable->filter, hash);                                         \
         hashtable->size++;                                                                                              \
+        if (inserted != NULL) *inserted = 1;                                                                            \
+        return &found_entry->value;                                                                                     \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) {    \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        u8 inserted;                                                                                                    \
+        V* value_slot = HASHTABLE_##K##_##V##_quick_get_or_insert(hashtable, hash, key, &inserted);                     \
+        if (value_slot == NULL || inserted == 0) return 0;                                                              \
+                                                                                                                        \
+        *value_slot = value;                                                                                            \
         return 1;                                                                                                       \
     }                                                                                                                   \
                                                                                                                         \
     u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, const K key, const V value) {                          \
         if (hashtable == NULL) return 0;                                                                                \
                                                                                                                         \
-        const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));                                                          \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
         return HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                            \
     }                                                                                                                   \
                                                                                                                         \
+    u8 HASHTABLE_##K##_##V##_quick_upsert(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) { \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        V* value_slot = HASHTABLE_##K##_##V##_quick_get_or_insert(hashtable, hash, key, NULL);                          \
+        if (value_slot == NULL) return 0;                                                                               \
+                                                                                                                        \
+        *value_slot = value;                                                                                            \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_upsert(HASHTABLE_##K##_##V* hashtable, const K key, const V value) {                       \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_quick_upsert(hashtable, hash, key, value);                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+    V* HASHTABLE_##K##_##V##_get_or_insert(HASHTABLE_##K##_##V* hashtable, const K key, u8* inserted) {                 \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_quick_get_or_insert(hashtable, hash, key, inserted);                               \
+    }                                                                                                                   \
+                                                                                                                        \
     void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, const K key) {                                    \
-        if (hashtable == NULL) return;                                                                                  \
+        if (hashtable == NULL || hashtable->mapped == 1) return;                                                        \
                                                                                                                         \
         HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find(hashtable, key);                                  \
         if (entry == NULL) return;                                                                                      \
@@ -186,10 +488,6 @@
         hashtable->tombstones++;                                                                                        \
     }                                                                                                                   \
                                                                                                                         \
-    u32 HASHTABLE_##K##_##V##_hash(const u8* data, const u32 size) {                                                    \
-        return HASH_fnv1a(data, size);                                                                                  \
-    }                                                                                                                   \
-                                                                                                                        \
     u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, const K key) {                              \
         if (hashtable == NULL) return 0;                                                                                \
                                                                                                                         \
@@ -201,7 +499,24 @@
     HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, const K key) {          \
         if (hashtable == NULL) return NULL;                                                                             \
                                                                                                                         \
-        const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));                                                          \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {       \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);               \
+        if (entry == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable,                  \
+        const u32 hash, const K key) {                                                                                  \
+                                                                                                                        \
+        if (hashtable == NULL) return NULL;                                                                             \
+        if (hashtable->filter != NULL && BLOOM_may_contain_hash(hashtable->filter, hash) == 0) return NULL;             \
+                                                                                                                        \
         u32 i = hash % hashtable->capacity;                                                                             \
                                                                                                                         \
         HASHTABLE_ENTRY_##K##_##V* entry;                                                                               \
@@ -217,12 +532,64 @@
                 continue;                                                                                               \
             }                                                                                                           \
                                                                                                                         \
-            if (entry->key == key) break;                                                                               \
+            if (HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) break;                                           \
             i = (i + 1) % hashtable->capacity;                                                                          \
         } while (i != hash % hashtable->capacity);                                                                      \
                                                                                                                         \
         if (status == HASHTABLE_ENTRY_STATUS_FILLED) return entry;                                                      \
         return NULL;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+    u32 HASHTABLE_##K##_##V##_add_many(HASHTABLE_##K##_##V* hashtable, const K* keys, const V* values, const u32 n) {   \
+        if (hashtable == NULL || keys == NULL || values == NULL) return 0;                                              \
+                                                                                                                        \
+        const u32 capacity = (u32)((hashtable->size + (f64)n) / HASHTABLE_MAX_LOAD_FACTOR) + 1;                         \
+        if (capacity > hashtable->capacity) {                                                                           \
+            const u8 r = HASHTABLE_##K##_##V##_resize(hashtable, capacity);                                             \
+            if (r == 0) return 0;                                                                                       \
+        }                                                                                                               \
+                                                                                                                        \
+        u32 hashes[HASHTABLE_BATCH_SIZE];                                                                               \
+        u32 added = 0;                                                                                                  \
+                                                                                                                        \
+        for (u32 start = 0; start < n; start += HASHTABLE_BATCH_SIZE) {                                                 \
+            const u32 count = n - start < HASHTABLE_BATCH_SIZE ? n - start : HASHTABLE_BATCH_SIZE;                      \
+                                                                                                                        \
+            for (u32 i = 0; i < count; i++) {                                                                           \
+                hashes[i] = HASHTABLE_##K##_##V##_key_hash(keys[start + i]);                                            \
+                HASH_PREFETCH_WRITE(hashtable->entries + hashes[i] % hashtable->capacity);                              \
+            }                                                                                                           \
+                                                                                                                        \
+            for (u32 i = 0; i < count; i++)                                                                             \
+                added += HASHTABLE_##K##_##V##_quick_add(hashtable, hashes[i], keys[start + i], values[start + i]);     \
+        }                                                                                                               \
+                                                                                                                        \
+        return added;                                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+    u32 HASHTABLE_##K##_##V##_find_many(const HASHTABLE_##K##_##V* hashtable, const K* keys, const u32 n,               \
+        HASHTABLE_ENTRY_##K##_##V** out) {                                                                              \
+                                                                                                                        \
+        if (hashtable == NULL || keys == NULL || out == NULL) return 0;                                                 \
+                                                                                                                        \
+        u32 hashes[HASHTABLE_BATCH_SIZE];                                                                               \
+        u32 found = 0;                                                                                                  \
+                                                                                                                        \
+        for (u32 start = 0; start < n; start += HASHTABLE_BATCH_SIZE) {                                                 \
+            const u32 count = n - start < HASHTABLE_BATCH_SIZE ? n - start : HASHTABLE_BATCH_SIZE;                      \
+                                                                                                                        \
+            for (u32 i = 0; i < count; i++) {                                                                           \
+                hashes[i] = HASHTABLE_##K##_##V##_key_hash(keys[start + i]);                                            \
+                HASH_PREFETCH(hashtable->entries + hashes[i] % hashtable->capacity);                                    \
+            }                                                                                                           \
+                                                                                                                        \
+            for (u32 i = 0; i < count; i++) {                                                                           \
+                out[start + i] = HASHTABLE_##K##_##V##_find_hashed(hashtable, hashes[i], keys[start + i]);              \
+                if (out[start + i] != NULL) found++;                                                                    \
+            }                                                                                                           \
+        }                                                                                                               \
+                                                                                                                        \
+        return found;                                                                                                   \
     }
 
 #endif // NESQUIK_HASHTABLE_H
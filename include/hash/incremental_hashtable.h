@@ -0,0 +1,241 @@
+#ifndef NESQUIK_INCREMENTAL_HASHTABLE_H
+#define NESQUIK_INCREMENTAL_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+
+// Old buckets moved into the new table by every add and remove while a resize is in flight
+#define INCREMENTAL_HASHTABLE_MIGRATE_BUCKETS   64
+
+// A HASHTABLE that spreads its rehash over later operations instead of doing it inside one _add.
+// When the table fills up it becomes the old table, a table twice its size takes its place and each
+// add or remove moves a bounded number of old buckets across. Lookups consult both tables meanwhile.
+// A table filled mostly by tombstones is migrated into one of the same size, which drops them.
+// Needs HASHTABLE_DECLARE(K, V) (or one of its variants) and HASHTABLE_DEFINE(K, V) for the same K and V.
+#define INCREMENTAL_HASHTABLE_DECLARE(K, V)                                                                                     \
+    typedef struct INCREMENTAL_HASHTABLE_##K##_##V {                                                                            \
+        HASHTABLE_##K##_##V table;                                                                                              \
+        HASHTABLE_##K##_##V old;                                                                                                \
+        u32 size;                                                                                                               \
+        u32 migrated;                                                                                                           \
+        u8 migrating;                                                                                                           \
+        const NESQUIK_ALLOCATOR* allocator;                                                                                     \
+    } INCREMENTAL_HASHTABLE_##K##_##V;                                                                                          \
+                                                                                                                                \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_init(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, u32 capacity);                        \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_init_allocator(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, u32 capacity,               \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                    \
+    INCREMENTAL_HASHTABLE_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_create(u32 capacity);                                    \
+    INCREMENTAL_HASHTABLE_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_create_allocator(u32 capacity,                           \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                    \
+                                                                                                                                \
+    void INCREMENTAL_HASHTABLE_##K##_##V##_deinit(INCREMENTAL_HASHTABLE_##K##_##V* hashtable);                                  \
+    void INCREMENTAL_HASHTABLE_##K##_##V##_destroy(INCREMENTAL_HASHTABLE_##K##_##V* hashtable);                                 \
+                                                                                                                                \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_migrate(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, u32 buckets);                      \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_add(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, K key, V value);                       \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_quick_add(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);       \
+    void INCREMENTAL_HASHTABLE_##K##_##V##_remove(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, K key);                           \
+                                                                                                                                \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_contains(const INCREMENTAL_HASHTABLE_##K##_##V* hashtable, K key);                     \
+    HASHTABLE_ENTRY_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_find(const INCREMENTAL_HASHTABLE_##K##_##V* hashtable,         \
+        K key);                                                                                                                 \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_contains_hashed(const INCREMENTAL_HASHTABLE_##K##_##V* hashtable, u32 hash,            \
+        K key);                                                                                                                 \
+    HASHTABLE_ENTRY_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_find_hashed(                                                   \
+        const INCREMENTAL_HASHTABLE_##K##_##V* hashtable, u32 hash, K key);
+
+#define INCREMENTAL_HASHTABLE_DEFINE(K, V)                                                                                  \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_init(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const u32 capacity) {             \
+        return INCREMENTAL_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, NULL);                                 \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_init_allocator(INCREMENTAL_HASHTABLE_##K##_##V* hashtable,                         \
+        const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {                                                           \
+                                                                                                                            \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        memset(hashtable, 0, sizeof(INCREMENTAL_HASHTABLE_##K##_##V));                                                      \
+        hashtable->allocator = allocator;                                                                                   \
+                                                                                                                            \
+        const u32 new_capacity = capacity < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : capacity;                     \
+        return HASHTABLE_##K##_##V##_init_allocator(&hashtable->table, new_capacity, allocator);                            \
+    }                                                                                                                       \
+                                                                                                                            \
+    INCREMENTAL_HASHTABLE_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_create(const u32 capacity) {                         \
+        return INCREMENTAL_HASHTABLE_##K##_##V##_create_allocator(capacity, NULL);                                          \
+    }                                                                                                                       \
+                                                                                                                            \
+    INCREMENTAL_HASHTABLE_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                 \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                               \
+                                                                                                                            \
+        INCREMENTAL_HASHTABLE_##K##_##V* hashtable =                                                                        \
+            (INCREMENTAL_HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator, sizeof(INCREMENTAL_HASHTABLE_##K##_##V));            \
+        if (hashtable == NULL) return NULL;                                                                                 \
+                                                                                                                            \
+        const u8 r = INCREMENTAL_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, allocator);                      \
+        if (r == 0) {                                                                                                       \
+            NESQUIK_free(allocator, hashtable);                                                                             \
+            return NULL;                                                                                                    \
+        }                                                                                                                   \
+                                                                                                                            \
+        return hashtable;                                                                                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    void INCREMENTAL_HASHTABLE_##K##_##V##_deinit(INCREMENTAL_HASHTABLE_##K##_##V* hashtable) {                             \
+        if (hashtable == NULL) return;                                                                                      \
+                                                                                                                            \
+        HASHTABLE_##K##_##V##_deinit(&hashtable->table);                                                                    \
+        if (hashtable->migrating == 1) HASHTABLE_##K##_##V##_deinit(&hashtable->old);                                       \
+                                                                                                                            \
+        hashtable->migrated = 0;                                                                                            \
+        hashtable->migrating = 0;                                                                                           \
+        hashtable->size = 0;                                                                                                \
+    }                                                                                                                       \
+                                                                                                                            \
+    void INCREMENTAL_HASHTABLE_##K##_##V##_destroy(INCREMENTAL_HASHTABLE_##K##_##V* hashtable) {                            \
+        if (hashtable == NULL) return;                                                                                      \
+                                                                                                                            \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                          \
+        INCREMENTAL_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                \
+        NESQUIK_free(allocator, hashtable);                                                                                 \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_migrate(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const u32 buckets) {           \
+        if (hashtable == NULL) return 0;                                                                                    \
+        if (hashtable->migrating == 0) return 1;                                                                            \
+                                                                                                                            \
+        HASHTABLE_##K##_##V* old = &hashtable->old;                                                                         \
+        const u32 end = old->capacity - hashtable->migrated < buckets ? old->capacity : hashtable->migrated + buckets;      \
+                                                                                                                            \
+        for (; hashtable->migrated < end; hashtable->migrated++) {                                                          \
+            HASHTABLE_ENTRY_##K##_##V* entry = old->entries + hashtable->migrated;                                          \
+            if (entry->status != HASHTABLE_ENTRY_STATUS_FILLED) continue;                                                   \
+                                                                                                                            \
+            const u8 r = HASHTABLE_##K##_##V##_quick_add(&hashtable->table, entry->hash, entry->key, entry->value);         \
+            if (r == 0) return 0;                                                                                           \
+                                                                                                                            \
+            entry->status = HASHTABLE_ENTRY_STATUS_TOMBSTONE;                                                               \
+            old->size--;                                                                                                    \
+            old->tombstones++;                                                                                              \
+        }                                                                                                                   \
+                                                                                                                            \
+        if (hashtable->migrated == old->capacity) {                                                                         \
+            HASHTABLE_##K##_##V##_deinit(old);                                                                              \
+            hashtable->migrated = 0;                                                                                        \
+            hashtable->migrating = 0;                                                                                       \
+        }                                                                                                                   \
+                                                                                                                            \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    static u8 INCREMENTAL_HASHTABLE_##K##_##V##_reserve_one(INCREMENTAL_HASHTABLE_##K##_##V* hashtable) {                   \
+        if (hashtable->migrating == 1) {                                                                                    \
+            const u8 r = INCREMENTAL_HASHTABLE_##K##_##V##_migrate(hashtable, INCREMENTAL_HASHTABLE_MIGRATE_BUCKETS);       \
+            if (r == 0) return 0;                                                                                           \
+        }                                                                                                                   \
+                                                                                                                            \
+        const HASHTABLE_##K##_##V* table = &hashtable->table;                                                               \
+        if ((table->size + table->tombstones + 0.0) / table->capacity < HASHTABLE_MAX_LOAD_FACTOR) return 1;                \
+                                                                                                                            \
+        if (hashtable->migrating == 1) {                                                                                    \
+            const u8 r = INCREMENTAL_HASHTABLE_##K##_##V##_migrate(hashtable, hashtable->old.capacity);                     \
+            if (r == 0) return 0;                                                                                           \
+        }                                                                                                                   \
+                                                                                                                            \
+        u32 capacity = table->capacity;                                                                                     \
+        if ((table->size + 0.0) / table->capacity >= HASHTABLE_MIN_LOAD_FACTOR) {                                           \
+            if (capacity & 0x80000000) return 0;                                                                            \
+            capacity <<= 1;                                                                                                 \
+        }                                                                                                                   \
+                                                                                                                            \
+        HASHTABLE_##K##_##V new_table;                                                                                      \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(&new_table, capacity, hashtable->allocator);                      \
+        if (r == 0) return 0;                                                                                               \
+                                                                                                                            \
+        hashtable->old = hashtable->table;                                                                                  \
+        hashtable->table = new_table;                                                                                       \
+        hashtable->migrated = 0;                                                                                            \
+        hashtable->migrating = 1;                                                                                           \
+                                                                                                                            \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_quick_add(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const u32 hash,              \
+        const K key, const V value) {                                                                                       \
+                                                                                                                            \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u8 r = INCREMENTAL_HASHTABLE_##K##_##V##_reserve_one(hashtable);                                              \
+        if (r == 0) return 0;                                                                                               \
+                                                                                                                            \
+        if (hashtable->migrating == 1 &&                                                                                    \
+            HASHTABLE_##K##_##V##_contains_hashed(&hashtable->old, hash, key) == 1) return 0;                               \
+                                                                                                                            \
+        const u8 added = HASHTABLE_##K##_##V##_quick_add(&hashtable->table, hash, key, value);                              \
+        hashtable->size += added;                                                                                           \
+        return added;                                                                                                       \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_add(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const K key, const V value) {      \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        return INCREMENTAL_HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                    \
+    }                                                                                                                       \
+                                                                                                                            \
+    void INCREMENTAL_HASHTABLE_##K##_##V##_remove(INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const K key) {                \
+        if (hashtable == NULL) return;                                                                                      \
+                                                                                                                            \
+        INCREMENTAL_HASHTABLE_##K##_##V##_migrate(hashtable, INCREMENTAL_HASHTABLE_MIGRATE_BUCKETS);                        \
+                                                                                                                            \
+        HASHTABLE_##K##_##V##_remove(&hashtable->table, key);                                                               \
+        if (hashtable->migrating == 1) HASHTABLE_##K##_##V##_remove(&hashtable->old, key);                                  \
+                                                                                                                            \
+        hashtable->size = hashtable->table.size + (hashtable->migrating == 1 ? hashtable->old.size : 0);                    \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_contains(const INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const K key) {          \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const HASHTABLE_ENTRY_##K##_##V* entry = INCREMENTAL_HASHTABLE_##K##_##V##_find(hashtable, key);                    \
+        if (entry == NULL) return 0;                                                                                        \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    HASHTABLE_ENTRY_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_find(const INCREMENTAL_HASHTABLE_##K##_##V* hashtable,     \
+        const K key) {                                                                                                      \
+                                                                                                                            \
+        if (hashtable == NULL) return NULL;                                                                                 \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        return INCREMENTAL_HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                         \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 INCREMENTAL_HASHTABLE_##K##_##V##_contains_hashed(const INCREMENTAL_HASHTABLE_##K##_##V* hashtable,                  \
+        const u32 hash, const K key) {                                                                                      \
+                                                                                                                            \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const HASHTABLE_ENTRY_##K##_##V* entry = INCREMENTAL_HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);       \
+        if (entry == NULL) return 0;                                                                                        \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    HASHTABLE_ENTRY_##K##_##V* INCREMENTAL_HASHTABLE_##K##_##V##_find_hashed(                                               \
+        const INCREMENTAL_HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {                                    \
+                                                                                                                            \
+        if (hashtable == NULL) return NULL;                                                                                 \
+                                                                                                                            \
+        HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(&hashtable->table, hash, key);                 \
+        if (entry != NULL || hashtable->migrating == 0) return entry;                                                       \
+                                                                                                                            \
+        return HASHTABLE_##K##_##V##_find_hashed(&hashtable->old, hash, key);                                               \
+    }
+
+#endif // NESQUIK_INCREMENTAL_HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,418 @@
+#ifndef NESQUIK_LOCKFREE_HASHTABLE_H
+#define NESQUIK_LOCKFREE_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "thread/epoch.h"
+
+// Open addressing over atomic slots that each hold a pointer to an immutable node {hash, key, value}.
+// _add claims an empty slot with one CAS, _upsert and _remove CAS the slot to a new node or a tombstone and
+// retire the old node. _get never locks and never writes shared memory, its probe is bounded by the capacity.
+// Every call runs inside the caller's EPOCH_RECORD, see LOCKFREE_HASHTABLE_##K##_##V##_register, a thread that
+// stops using the table hands its record back with _unregister. Memory the epoch cannot take because its
+// retired list failed to grow is freed on the spot after an EPOCH_synchronize.
+// Resizing is rare and serialized by a mutex: the resizer freezes every old slot with the FROZEN bit, copies
+// the node pointers into the new array, publishes it and retires the old one. A writer that meets a frozen
+// slot waits for the resize and retries, a reader still probing the old array sees it as of the freeze.
+#define LOCKFREE_HASHTABLE_SLOT_EMPTY       ((uintptr_t)0)
+#define LOCKFREE_HASHTABLE_SLOT_TOMBSTONE   ((uintptr_t)2)
+#define LOCKFREE_HASHTABLE_SLOT_FROZEN      ((uintptr_t)1)
+
+#define LOCKFREE_HASHTABLE_MIN_CAPACITY     8
+#define LOCKFREE_HASHTABLE_MAX_LOAD(capacity) ((capacity) - (capacity) / 4)
+
+static inline u32 LOCKFREE_HASHTABLE_capacity(const u32 capacity) {
+    u32 new_capacity = LOCKFREE_HASHTABLE_MIN_CAPACITY;
+    while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;
+    return new_capacity;
+}
+
+#define LOCKFREE_HASHTABLE_DECLARE_TYPES(K, V)                                                                          \
+    typedef struct LOCKFREE_HASHTABLE_NODE_##K##_##V {                                                                  \
+        u32 hash;                                                                                                       \
+        K key;                                                                                                          \
+        V value;                                                                                                        \
+    } LOCKFREE_HASHTABLE_NODE_##K##_##V;                                                                                \
+                                                                                                                        \
+    typedef struct LOCKFREE_HASHTABLE_ARRAY_##K##_##V {                                                                 \
+        u32 capacity;                                                                                                   \
+        _Atomic u32 used;                                                                                               \
+        _Atomic uintptr_t slots[];                                                                                      \
+    } LOCKFREE_HASHTABLE_ARRAY_##K##_##V;                                                                               \
+                                                                                                                        \
+    typedef struct LOCKFREE_HASHTABLE_##K##_##V {                                                                       \
+        _Atomic(LOCKFREE_HASHTABLE_ARRAY_##K##_##V*) array;                                                             \
+        _Atomic u32 size;                                                                                               \
+        pthread_mutex_t resize_mutex;                                                                                   \
+        EPOCH epoch;                                                                                                    \
+    } LOCKFREE_HASHTABLE_##K##_##V;                                                                                     \
+                                                                                                                        \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_init(LOCKFREE_HASHTABLE_##K##_##V* hashtable, u32 capacity, u32 max_threads);     \
+    LOCKFREE_HASHTABLE_##K##_##V* LOCKFREE_HASHTABLE_##K##_##V##_create(u32 capacity, u32 max_threads);                 \
+                                                                                                                        \
+    void LOCKFREE_HASHTABLE_##K##_##V##_deinit(LOCKFREE_HASHTABLE_##K##_##V* hashtable);                                \
+    void LOCKFREE_HASHTABLE_##K##_##V##_destroy(LOCKFREE_HASHTABLE_##K##_##V* hashtable);                               \
+                                                                                                                        \
+    EPOCH_RECORD* LOCKFREE_HASHTABLE_##K##_##V##_register(LOCKFREE_HASHTABLE_##K##_##V* hashtable);                     \
+    void LOCKFREE_HASHTABLE_##K##_##V##_unregister(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record);      \
+                                                                                                                        \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_add(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                \
+        K key, V value);                                                                                                \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_upsert(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,             \
+        K key, V value);                                                                                                \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_remove(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,             \
+        K key);                                                                                                         \
+                                                                                                                        \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_get(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                \
+        K key, V* value);                                                                                               \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_contains(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,           \
+        K key);                                                                                                         \
+    u32 LOCKFREE_HASHTABLE_##K##_##V##_size(LOCKFREE_HASHTABLE_##K##_##V* hashtable);
+
+// Hashes the bytes of the key with one of the hash.h kernels and compares keys with ==
+#define LOCKFREE_HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)                                   \
+    static inline u32 LOCKFREE_HASHTABLE_##K##_##V##_key_hash(const K key) {                \
+        return HASH_F((const u8*)(&key), sizeof(key));                                      \
+    }                                                                                       \
+                                                                                            \
+    static inline u8 LOCKFREE_HASHTABLE_##K##_##V##_key_equal(const K a, const K b) {       \
+        return a == b;                                                                      \
+    }
+
+// Bakes a user hash (u32 HASH_FN(K)) and equality (u8 EQ_FN(K, K)) into the generated functions
+#define LOCKFREE_HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)                             \
+    static inline u32 LOCKFREE_HASHTABLE_##K##_##V##_key_hash(const K key) {                \
+        return HASH_FN(key);                                                                \
+    }                                                                                       \
+                                                                                            \
+    static inline u8 LOCKFREE_HASHTABLE_##K##_##V##_key_equal(const K a, const K b) {       \
+        return EQ_FN(a, b) ? 1 : 0;                                                         \
+    }
+
+#define LOCKFREE_HASHTABLE_DECLARE_HASH(K, V, HASH_F)       \
+    LOCKFREE_HASHTABLE_DECLARE_TYPES(K, V)                  \
+    LOCKFREE_HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define LOCKFREE_HASHTABLE_DECLARE_EX(K, V, HASH_FN, EQ_FN)     \
+    LOCKFREE_HASHTABLE_DECLARE_TYPES(K, V)                      \
+    LOCKFREE_HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define LOCKFREE_HASHTABLE_DECLARE(K, V) LOCKFREE_HASHTABLE_DECLARE_HASH(K, V, HASH_fnv1a)
+
+#define LOCKFREE_HASHTABLE_DEFINE(K, V)                                                                                             \
+    static LOCKFREE_HASHTABLE_ARRAY_##K##_##V* LOCKFREE_HASHTABLE_##K##_##V##_array_create(const u32 capacity) {                    \
+        LOCKFREE_HASHTABLE_ARRAY_##K##_##V* array = (LOCKFREE_HASHTABLE_ARRAY_##K##_##V*)malloc(                                    \
+            sizeof(LOCKFREE_HASHTABLE_ARRAY_##K##_##V) + sizeof(_Atomic uintptr_t) * capacity);                                     \
+        if (array == NULL) return NULL;                                                                                             \
+                                                                                                                                    \
+        array->capacity = capacity;                                                                                                 \
+        atomic_init(&array->used, 0);                                                                                               \
+        for (u32 i = 0; i < capacity; i++) atomic_init(&array->slots[i], LOCKFREE_HASHTABLE_SLOT_EMPTY);                            \
+                                                                                                                                    \
+        return array;                                                                                                               \
+    }                                                                                                                               \
+                                                                                                                                    \
+    static inline LOCKFREE_HASHTABLE_NODE_##K##_##V* LOCKFREE_HASHTABLE_##K##_##V##_node(const uintptr_t slot) {                    \
+        const uintptr_t pointer = slot & ~LOCKFREE_HASHTABLE_SLOT_FROZEN;                                                           \
+        if (pointer == LOCKFREE_HASHTABLE_SLOT_EMPTY || pointer == LOCKFREE_HASHTABLE_SLOT_TOMBSTONE) return NULL;                  \
+        return (LOCKFREE_HASHTABLE_NODE_##K##_##V*)pointer;                                                                         \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_init(LOCKFREE_HASHTABLE_##K##_##V* hashtable, const u32 capacity,                             \
+        const u32 max_threads) {                                                                                                    \
+                                                                                                                                    \
+        if (hashtable == NULL) return 0;                                                                                            \
+                                                                                                                                    \
+        LOCKFREE_HASHTABLE_ARRAY_##K##_##V* array =                                                                                 \
+            LOCKFREE_HASHTABLE_##K##_##V##_array_create(LOCKFREE_HASHTABLE_capacity(capacity));                                     \
+        if (array == NULL) return 0;                                                                                                \
+                                                                                                                                    \
+        if (EPOCH_init(&hashtable->epoch, max_threads) == 0) {                                                                      \
+            free(array);                                                                                                            \
+            return 0;                                                                                                               \
+        }                                                                                                                           \
+                                                                                                                                    \
+        if (pthread_mutex_init(&hashtable->resize_mutex, NULL) != 0) {                                                              \
+            EPOCH_deinit(&hashtable->epoch);                                                                                        \
+            free(array);                                                                                                            \
+            return 0;                                                                                                               \
+        }                                                                                                                           \
+                                                                                                                                    \
+        atomic_init(&hashtable->array, array);                                                                                      \
+        atomic_init(&hashtable->size, 0);                                                                                           \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    LOCKFREE_HASHTABLE_##K##_##V* LOCKFREE_HASHTABLE_##K##_##V##_create(const u32 capacity, const u32 max_threads) {                \
+        LOCKFREE_HASHTABLE_##K##_##V* hashtable = (LOCKFREE_HASHTABLE_##K##_##V*)aligned_alloc(EPOCH_CACHE_LINE,                    \
+            sizeof(LOCKFREE_HASHTABLE_##K##_##V));                                                                                  \
+        if (hashtable == NULL) return NULL;                                                                                         \
+                                                                                                                                    \
+        const u8 r = LOCKFREE_HASHTABLE_##K##_##V##_init(hashtable, capacity, max_threads);                                         \
+        if (r == 0) {                                                                                                               \
+            free(hashtable);                                                                                                        \
+            return NULL;                                                                                                            \
+        }                                                                                                                           \
+                                                                                                                                    \
+        return hashtable;                                                                                                           \
+    }                                                                                                                               \
+                                                                                                                                    \
+    void LOCKFREE_HASHTABLE_##K##_##V##_deinit(LOCKFREE_HASHTABLE_##K##_##V* hashtable) {                                           \
+        if (hashtable == NULL) return;                                                                                              \
+                                                                                                                                    \
+        LOCKFREE_HASHTABLE_ARRAY_##K##_##V* array = atomic_load(&hashtable->array);                                                 \
+        if (array == NULL) return;                                                                                                  \
+                                                                                                                                    \
+        for (u32 i = 0; i < array->capacity; i++) free(LOCKFREE_HASHTABLE_##K##_##V##_node(atomic_load(&array->slots[i])));         \
+        free(array);                                                                                                                \
+        atomic_store(&hashtable->array, NULL);                                                                                      \
+        atomic_store(&hashtable->size, 0);                                                                                          \
+                                                                                                                                    \
+        EPOCH_deinit(&hashtable->epoch);                                                                                            \
+        pthread_mutex_destroy(&hashtable->resize_mutex);                                                                            \
+    }                                                                                                                               \
+                                                                                                                                    \
+    void LOCKFREE_HASHTABLE_##K##_##V##_destroy(LOCKFREE_HASHTABLE_##K##_##V* hashtable) {                                          \
+        if (hashtable == NULL) return;                                                                                              \
+                                                                                                                                    \
+        LOCKFREE_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                           \
+        free(hashtable);                                                                                                            \
+    }                                                                                                                               \
+                                                                                                                                    \
+    EPOCH_RECORD* LOCKFREE_HASHTABLE_##K##_##V##_register(LOCKFREE_HASHTABLE_##K##_##V* hashtable) {                                \
+        if (hashtable == NULL) return NULL;                                                                                         \
+        return EPOCH_register(&hashtable->epoch);                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    void LOCKFREE_HASHTABLE_##K##_##V##_unregister(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record) {                 \
+        if (hashtable == NULL) return;                                                                                              \
+        EPOCH_unregister(&hashtable->epoch, record);                                                                                \
+    }                                                                                                                               \
+                                                                                                                                    \
+    static void LOCKFREE_HASHTABLE_##K##_##V##_reclaim(LOCKFREE_HASHTABLE_##K##_##V* hashtable, void* pointer) {                    \
+        if (pointer == NULL) return;                                                                                                \
+                                                                                                                                    \
+        EPOCH_synchronize(&hashtable->epoch);                                                                                       \
+        free(pointer);                                                                                                              \
+    }                                                                                                                               \
+                                                                                                                                    \
+    static u8 LOCKFREE_HASHTABLE_##K##_##V##_resize(LOCKFREE_HASHTABLE_##K##_##V* hashtable,                                        \
+        LOCKFREE_HASHTABLE_ARRAY_##K##_##V* old_array) {                                                                            \
+                                                                                                                                    \
+        pthread_mutex_lock(&hashtable->resize_mutex);                                                                               \
+        if (atomic_load(&hashtable->array) != old_array) {                                                                          \
+            pthread_mutex_unlock(&hashtable->resize_mutex);                                                                         \
+            return 1;                                                                                                               \
+        }                                                                                                                           \
+                                                                                                                                    \
+        const u32 size = atomic_load(&hashtable->size);                                                                             \
+        const u32 capacity = LOCKFREE_HASHTABLE_capacity(size < 0x40000000 ? size * 2 + 1 : 0x80000000);                            \
+        LOCKFREE_HASHTABLE_ARRAY_##K##_##V* new_array = LOCKFREE_HASHTABLE_##K##_##V##_array_create(capacity);                      \
+        if (new_array == NULL) {                                                                                                    \
+            pthread_mutex_unlock(&hashtable->resize_mutex);                                                                         \
+            return 0;                                                                                                               \
+        }                                                                                                                           \
+                                                                                                                                    \
+        u32 used = 0;                                                                                                               \
+        for (u32 i = 0; i < old_array->capacity; i++) {                                                                             \
+            uintptr_t slot = atomic_load(&old_array->slots[i]);                                                                     \
+            while ((slot & LOCKFREE_HASHTABLE_SLOT_FROZEN) == 0 &&                                                                  \
+                atomic_compare_exchange_weak(&old_array->slots[i], &slot, slot | LOCKFREE_HASHTABLE_SLOT_FROZEN) == 0);             \
+                                                                                                                                    \
+            const LOCKFREE_HASHTABLE_NODE_##K##_##V* node = LOCKFREE_HASHTABLE_##K##_##V##_node(slot);                              \
+            if (node == NULL) continue;                                                                                             \
+                                                                                                                                    \
+            u32 j = node->hash & (capacity - 1);                                                                                    \
+            while (atomic_load_explicit(&new_array->slots[j], memory_order_relaxed) != LOCKFREE_HASHTABLE_SLOT_EMPTY)               \
+                j = (j + 1) & (capacity - 1);                                                                                       \
+            atomic_store_explicit(&new_array->slots[j], slot & ~LOCKFREE_HASHTABLE_SLOT_FROZEN, memory_order_relaxed);              \
+            used++;                                                                                                                 \
+        }                                                                                                                           \
+                                                                                                                                    \
+        atomic_store_explicit(&new_array->used, used, memory_order_relaxed);                                                        \
+        atomic_store_explicit(&hashtable->array, new_array, memory_order_release);                                                  \
+        pthread_mutex_unlock(&hashtable->resize_mutex);                                                                             \
+                                                                                                                                    \
+        if (EPOCH_retire(&hashtable->epoch, old_array, free) == 0)                                                                  \
+            LOCKFREE_HASHTABLE_##K##_##V##_reclaim(hashtable, old_array);                                                           \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    static u8 LOCKFREE_HASHTABLE_##K##_##V##_store(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                   \
+        const K key, const V value, const u8 replace) {                                                                             \
+                                                                                                                                    \
+        if (hashtable == NULL || record == NULL) return 0;                                                                          \
+                                                                                                                                    \
+        const u32 hash = LOCKFREE_HASHTABLE_##K##_##V##_key_hash(key);                                                              \
+        LOCKFREE_HASHTABLE_NODE_##K##_##V* node = NULL;                                                                             \
+        void* unretired = NULL;                                                                                                     \
+                                                                                                                                    \
+        u8 r = 2;                                                                                                                   \
+        while (r == 2) {                                                                                                            \
+            EPOCH_enter(&hashtable->epoch, record);                                                                                 \
+            LOCKFREE_HASHTABLE_ARRAY_##K##_##V* array = atomic_load_explicit(&hashtable->array, memory_order_acquire);              \
+            const u32 mask = array->capacity - 1;                                                                                   \
+                                                                                                                                    \
+            if (atomic_load_explicit(&array->used, memory_order_relaxed) >= LOCKFREE_HASHTABLE_MAX_LOAD(array->capacity)) {         \
+                EPOCH_exit(record);                                                                                                 \
+                if (LOCKFREE_HASHTABLE_##K##_##V##_resize(hashtable, array) == 0) r = 0;                                            \
+                continue;                                                                                                           \
+            }                                                                                                                       \
+                                                                                                                                    \
+            if (node == NULL) {                                                                                                     \
+                node = (LOCKFREE_HASHTABLE_NODE_##K##_##V*)malloc(sizeof(LOCKFREE_HASHTABLE_NODE_##K##_##V));                       \
+                if (node == NULL) {                                                                                                 \
+                    EPOCH_exit(record);                                                                                             \
+                    return 0;                                                                                                       \
+                }                                                                                                                   \
+                                                                                                                                    \
+                node->hash = hash;                                                                                                  \
+                node->key = key;                                                                                                    \
+                node->value = value;                                                                                                \
+            }                                                                                                                       \
+                                                                                                                                    \
+            u32 i = hash & mask;                                                                                                    \
+            u32 probes = 0;                                                                                                         \
+            while (r == 2 && probes < array->capacity) {                                                                            \
+                uintptr_t slot = atomic_load_explicit(&array->slots[i], memory_order_acquire);                                      \
+                if ((slot & LOCKFREE_HASHTABLE_SLOT_FROZEN) != 0) break;                                                            \
+                                                                                                                                    \
+                const LOCKFREE_HASHTABLE_NODE_##K##_##V* found = LOCKFREE_HASHTABLE_##K##_##V##_node(slot);                         \
+                if (slot == LOCKFREE_HASHTABLE_SLOT_EMPTY) {                                                                        \
+                    if (atomic_compare_exchange_strong(&array->slots[i], &slot, (uintptr_t)node) == 0) continue;                    \
+                                                                                                                                    \
+                    atomic_fetch_add_explicit(&array->used, 1, memory_order_relaxed);                                               \
+                    atomic_fetch_add_explicit(&hashtable->size, 1, memory_order_relaxed);                                           \
+                    node = NULL;                                                                                                    \
+                    r = 1;                                                                                                          \
+                }                                                                                                                   \
+                else if (found != NULL && found->hash == hash &&                                                                    \
+                    LOCKFREE_HASHTABLE_##K##_##V##_key_equal(found->key, key) == 1) {                                               \
+                                                                                                                                    \
+                    if (replace == 0) r = 0;                                                                                        \
+                    else if (atomic_compare_exchange_strong(&array->slots[i], &slot, (uintptr_t)node) == 1) {                       \
+                        if (EPOCH_retire(&hashtable->epoch, (void*)found, free) == 0) unretired = (void*)found;                     \
+                        node = NULL;                                                                                                \
+                        r = 1;                                                                                                      \
+                    }                                                                                                               \
+                }                                                                                                                   \
+                else {                                                                                                              \
+                    i = (i + 1) & mask;                                                                                             \
+                    probes++;                                                                                                       \
+                }                                                                                                                   \
+            }                                                                                                                       \
+                                                                                                                                    \
+            EPOCH_exit(record);                                                                                                     \
+            if (r == 2 && LOCKFREE_HASHTABLE_##K##_##V##_resize(hashtable, array) == 0) r = 0;                                      \
+        }                                                                                                                           \
+                                                                                                                                    \
+        LOCKFREE_HASHTABLE_##K##_##V##_reclaim(hashtable, unretired);                                                               \
+        free(node);                                                                                                                 \
+        return r;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_add(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                            \
+        const K key, const V value) {                                                                                               \
+                                                                                                                                    \
+        return LOCKFREE_HASHTABLE_##K##_##V##_store(hashtable, record, key, value, 0);                                              \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_upsert(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                         \
+        const K key, const V value) {                                                                                               \
+                                                                                                                                    \
+        return LOCKFREE_HASHTABLE_##K##_##V##_store(hashtable, record, key, value, 1);                                              \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_remove(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                         \
+        const K key) {                                                                                                              \
+                                                                                                                                    \
+        if (hashtable == NULL || record == NULL) return 0;                                                                          \
+                                                                                                                                    \
+        const u32 hash = LOCKFREE_HASHTABLE_##K##_##V##_key_hash(key);                                                              \
+        void* unretired = NULL;                                                                                                     \
+                                                                                                                                    \
+        u8 r = 2;                                                                                                                   \
+        while (r == 2) {                                                                                                            \
+            EPOCH_enter(&hashtable->epoch, record);                                                                                 \
+            LOCKFREE_HASHTABLE_ARRAY_##K##_##V* array = atomic_load_explicit(&hashtable->array, memory_order_acquire);              \
+            const u32 mask = array->capacity - 1;                                                                                   \
+                                                                                                                                    \
+            u32 i = hash & mask;                                                                                                    \
+            u32 probes = 0;                                                                                                         \
+            while (r == 2 && probes < array->capacity) {                                                                            \
+                uintptr_t slot = atomic_load_explicit(&array->slots[i], memory_order_acquire);                                      \
+                if ((slot & LOCKFREE_HASHTABLE_SLOT_FROZEN) != 0) break;                                                            \
+                if (slot == LOCKFREE_HASHTABLE_SLOT_EMPTY) r = 0;                                                                   \
+                                                                                                                                    \
+                const LOCKFREE_HASHTABLE_NODE_##K##_##V* found = LOCKFREE_HASHTABLE_##K##_##V##_node(slot);                         \
+                if (found != NULL && found->hash == hash && LOCKFREE_HASHTABLE_##K##_##V##_key_equal(found->key, key) == 1) {       \
+                    if (atomic_compare_exchange_strong(&array->slots[i], &slot, LOCKFREE_HASHTABLE_SLOT_TOMBSTONE) == 0)            \
+                        continue;                                                                                                   \
+                                                                                                                                    \
+                    atomic_fetch_sub_explicit(&hashtable->size, 1, memory_order_relaxed);                                           \
+                    if (EPOCH_retire(&hashtable->epoch, (void*)found, free) == 0) unretired = (void*)found;                         \
+                    r = 1;                                                                                                          \
+                }                                                                                                                   \
+                                                                                                                                    \
+                i = (i + 1) & mask;                                                                                                 \
+                probes++;                                                                                                           \
+            }                                                                                                                       \
+                                                                                                                                    \
+            EPOCH_exit(record);                                                                                                     \
+            if (r == 2 && probes == array->capacity) r = 0;                                                                         \
+            if (r == 2 && LOCKFREE_HASHTABLE_##K##_##V##_resize(hashtable, array) == 0) r = 0;                                      \
+        }                                                                                                                           \
+                                                                                                                                    \
+        LOCKFREE_HASHTABLE_##K##_##V##_reclaim(hashtable, unretired);                                                               \
+        return r;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_get(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                            \
+        const K key, V* value) {                                                                                                    \
+                                                                                                                                    \
+        if (hashtable == NULL || record == NULL) return 0;                                                                          \
+                                                                                                                                    \
+        const u32 hash = LOCKFREE_HASHTABLE_##K##_##V##_key_hash(key);                                                              \
+                                                                                                                                    \
+        EPOCH_enter(&hashtable->epoch, record);                                                                                     \
+        const LOCKFREE_HASHTABLE_ARRAY_##K##_##V* array = atomic_load_explicit(&hashtable->array, memory_order_acquire);            \
+        const u32 mask = array->capacity - 1;                                                                                       \
+                                                                                                                                    \
+        u8 r = 0;                                                                                                                   \
+        u32 i = hash & mask;                                                                                                        \
+        for (u32 probes = 0; probes < array->capacity; probes++) {                                                                  \
+            const uintptr_t slot = atomic_load_explicit(&array->slots[i], memory_order_acquire);                                    \
+            if ((slot & ~LOCKFREE_HASHTABLE_SLOT_FROZEN) == LOCKFREE_HASHTABLE_SLOT_EMPTY) break;                                   \
+                                                                                                                                    \
+            const LOCKFREE_HASHTABLE_NODE_##K##_##V* found = LOCKFREE_HASHTABLE_##K##_##V##_node(slot);                             \
+            if (found != NULL && found->hash == hash && LOCKFREE_HASHTABLE_##K##_##V##_key_equal(found->key, key) == 1) {           \
+                if (value != NULL) *value = found->value;                                                                           \
+                r = 1;                                                                                                              \
+                break;                                                                                                              \
+            }                                                                                                                       \
+                                                                                                                                    \
+            i = (i + 1) & mask;                                                                                                     \
+        }                                                                                                                           \
+                                                                                                                                    \
+        EPOCH_exit(record);                                                                                                         \
+        return r;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 LOCKFREE_HASHTABLE_##K##_##V##_contains(LOCKFREE_HASHTABLE_##K##_##V* hashtable, EPOCH_RECORD* record,                       \
+        const K key) {                                                                                                              \
+                                                                                                                                    \
+        return LOCKFREE_HASHTABLE_##K##_##V##_get(hashtable, record, key, NULL);                                                    \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u32 LOCKFREE_HASHTABLE_##K##_##V##_size(LOCKFREE_HASHTABLE_##K##_##V* hashtable) {                                              \
+        if (hashtable == NULL) return 0;                                                                                            \
+        return atomic_load_explicit(&hashtable->size, memory_order_relaxed);                                                        \
+    }
+
+#endif //NESQUIK_LOCKFREE_HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef NESQUIK_MAPPED_H
+#define NESQUIK_MAPPED_H
+
+#include "types.h"
+#include "hash/hash.h"
+
+// On-disk image of a classic HASHSET/HASHTABLE: a 64-byte header followed by the entries array exactly as it sits
+// in memory, so _open_mmap can point a table straight at the mapping and look up with no parsing or rehashing.
+// Images only move between builds with the same entry layout, byte order and key hash, and keys and values must
+// not hold pointers. A mapped table is read-only, the calls that would modify it fail. The header carries a
+// fingerprint of the entry field offsets and of the key hash over a few probe keys, an image whose fingerprint
+// differs from the opening table's is refused.
+#define MAPPED_MAGIC                0x4B495551534E454EULL
+#define MAPPED_VERSION              2
+#define MAPPED_HEADER_SIZE          64
+
+#define MAPPED_KIND_HASHSET         1
+#define MAPPED_KIND_HASHTABLE       2
+
+// Keys MAPPED_probe_key builds to fingerprint the key hash
+#define MAPPED_FINGERPRINT_PROBES   4
+
+typedef struct {
+    // Also tells the byte order apart, a foreign image reads back as a different magic
+    u64 magic;
+    u32 version;
+    u32 kind;
+
+    u32 entry_size;
+    u32 key_size;
+    u32 value_size;
+
+    u32 size;
+    u32 capacity;
+    u32 tombstones;
+
+    u64 fingerprint;
+
+    u8 reserved[MAPPED_HEADER_SIZE - 48];
+} MAPPED_HEADER;
+
+// Writes next to path and renames over it, a crash never leaves a torn image behind
+u8 MAPPED_save(const char* path, const MAPPED_HEADER* header, const void* entries);
+
+// Maps the image read-only once it matches the kind, sizes and fingerprint preset in header, which then receives
+// the stored header. Returns the entries or NULL
+void* MAPPED_open(const char* path, MAPPED_HEADER* header);
+void MAPPED_close(void* entries, u32 capacity, u32 entry_size);
+
+// Fills the bytes of probe key number probe, the same on every build
+void MAPPED_probe_key(void* key, u32 size, u32 probe);
+
+static inline u64 MAPPED_fingerprint_mix(u64 fingerprint, const u64 value) {
+    fingerprint = (fingerprint ^ value) * HASH_WIDE_PRIME_2;
+    return fingerprint ^ (fingerprint >> 29);
+}
+
+#endif //NESQUIK_MAPPED_H
\ No newline at end of file
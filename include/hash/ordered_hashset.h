@@ -0,0 +1,347 @@
+#ifndef NESQUIK_ORDERED_HASHSET_H
+#define NESQUIK_ORDERED_HASHSET_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashset.h"
+#include "hash/ordered_index.h"
+
+// Insertion ordered dict layout behind the HASHSET API. Entries are appended to a dense array and a bucket
+// index of u8/u16/u32 slot numbers points into it, so iterating with _next walks the entries in insertion
+// order without touching empty buckets. Removed entries leave a hole until the next _grow compacts the array.
+// The set operations keep the order too: a's keys first, then b's.
+#define HASHSET_DECLARE_ORDERED_TYPES(K)                                                    \
+    typedef struct HASHSET_ENTRY_##K {                                                      \
+        u8 status;                                                                          \
+        u32 hash;                                                                           \
+        K key;                                                                              \
+    } HASHSET_ENTRY_##K;                                                                    \
+                                                                                            \
+    typedef struct HASHSET_##K {                                                            \
+        void* index;                                                                        \
+        HASHSET_ENTRY_##K* entries;                                                         \
+        u32 size;                                                                           \
+        u32 used;                                                                           \
+        u32 capacity;                                                                       \
+        u8 width;                                                                           \
+        const NESQUIK_ALLOCATOR* allocator;                                                 \
+    } HASHSET_##K;                                                                          \
+                                                                                            \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, u32 capacity);                              \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, u32 capacity,                     \
+        const NESQUIK_ALLOCATOR* allocator);                                                \
+    HASHSET_##K* HASHSET_##K##_create(u32 capacity);                                        \
+    HASHSET_##K* HASHSET_##K##_create_allocator(u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator);                                                \
+                                                                                            \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset);                                        \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset);                                       \
+                                                                                            \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset);                                            \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, K key);                                      \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, u32 hash, K key);                      \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, K key);                                 \
+                                                                                            \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, K key);                           \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, K key);               \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, u32 hash, K key);          \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, u32 hash,      \
+        K key);                                                                             \
+                                                                                            \
+    HASHSET_ENTRY_##K* HASHSET_##K##_next(const HASHSET_##K* hashset, u32* position);       \
+                                                                                            \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b);           \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b);    \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b);
+
+#define HASHSET_DECLARE_ORDERED_HASH(K, HASH_F)     \
+    HASHSET_DECLARE_ORDERED_TYPES(K)                \
+    HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define HASHSET_DECLARE_ORDERED_EX(K, HASH_FN, EQ_FN)       \
+    HASHSET_DECLARE_ORDERED_TYPES(K)                        \
+    HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+#define HASHSET_DECLARE_ORDERED(K) HASHSET_DECLARE_ORDERED_HASH(K, HASH_fnv1a)
+
+#define HASHSET_DEFINE_ORDERED(K)                                                                           \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, const u32 capacity) {                                       \
+        return HASHSET_##K##_init_allocator(hashset, capacity, NULL);                                       \
+    }                                                                                                       \
+                                                                                                            \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, const u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator) {                                                               \
+                                                                                                            \
+        if (hashset == NULL) return 0;                                                                      \
+                                                                                                            \
+        hashset->allocator = allocator;                                                                     \
+        hashset->size = 0;                                                                                  \
+        hashset->used = 0;                                                                                  \
+        hashset->capacity = ORDERED_capacity(capacity);                                                     \
+        hashset->width = ORDERED_index_width(hashset->capacity);                                            \
+                                                                                                            \
+        hashset->index = NESQUIK_calloc(allocator, hashset->capacity, hashset->width);                      \
+        hashset->entries = (HASHSET_ENTRY_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_ENTRY_##K) *         \
+            ORDERED_MAX_LOAD(hashset->capacity));                                                           \
+                                                                                                            \
+        if (hashset->index == NULL || hashset->entries == NULL) {                                           \
+            HASHSET_##K##_deinit(hashset);                                                                  \
+            return 0;                                                                                       \
+        }                                                                                                   \
+                                                                                                            \
+        return 1;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_##K* HASHSET_##K##_create(const u32 capacity) {                                                 \
+        return HASHSET_##K##_create_allocator(capacity, NULL);                                              \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_##K* HASHSET_##K##_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {   \
+        HASHSET_##K* hashset = (HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_##K));                 \
+        if (hashset == NULL) return NULL;                                                                   \
+                                                                                                            \
+        const u8 r = HASHSET_##K##_init_allocator(hashset, capacity, allocator);                            \
+        if (r == 0) {                                                                                       \
+            NESQUIK_free(allocator, hashset);                                                               \
+            return NULL;                                                                                    \
+        }                                                                                                   \
+                                                                                                            \
+        return hashset;                                                                                     \
+    }                                                                                                       \
+                                                                                                            \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset) {                                                       \
+        if (hashset == NULL) return;                                                                        \
+        hashset->size = 0;                                                                                  \
+        hashset->used = 0;                                                                                  \
+        hashset->capacity = 0;                                                                              \
+                                                                                                            \
+        NESQUIK_free(hashset->allocator, hashset->index);                                                   \
+        NESQUIK_free(hashset->allocator, hashset->entries);                                                 \
+                                                                                                            \
+        hashset->index = NULL;                                                                              \
+        hashset->entries = NULL;                                                                            \
+    }                                                                                                       \
+                                                                                                            \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset) {                                                      \
+        if (hashset == NULL) return;                                                                        \
+                                                                                                            \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                            \
+        HASHSET_##K##_deinit(hashset);                                                                      \
+        NESQUIK_free(allocator, hashset);                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    static u32 HASHSET_##K##_bucket(const HASHSET_##K* hashset, const u32 hash, const K key) {              \
+        const u32 mask = hashset->capacity - 1;                                                             \
+        u32 i = hash & mask;                                                                                \
+                                                                                                            \
+        for (;;) {                                                                                          \
+            const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i);                          \
+            if (slot == ORDERED_INDEX_EMPTY) return hashset->capacity;                                      \
+                                                                                                            \
+            if (slot != ORDERED_INDEX_DELETED) {                                                            \
+                const HASHSET_ENTRY_##K* entry = hashset->entries + slot - ORDERED_INDEX_OFFSET;            \
+                if (entry->hash == hash && HASHSET_##K##_key_equal(entry->key, key) == 1) return i;         \
+            }                                                                                               \
+                                                                                                            \
+            i = (i + 1) & mask;                                                                             \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset) {                                                           \
+        if (hashset == NULL) return 0;                                                                      \
+                                                                                                            \
+        u32 new_capacity = hashset->capacity;                                                               \
+        if (hashset->size + 1 > ORDERED_MAX_LOAD(hashset->capacity) / 2) {                                  \
+            if (hashset->capacity & 0x80000000) return 0;                                                   \
+            new_capacity = hashset->capacity << 1;                                                          \
+        }                                                                                                   \
+                                                                                                            \
+        HASHSET_##K new_hashset;                                                                            \
+        const u8 r = HASHSET_##K##_init_allocator(&new_hashset, new_capacity, hashset->allocator);          \
+        if (r == 0) return 0;                                                                               \
+                                                                                                            \
+        const u32 mask = new_hashset.capacity - 1;                                                          \
+        for (u32 i = 0; i < hashset->used; i++) {                                                           \
+            const HASHSET_ENTRY_##K* entry = hashset->entries + i;                                          \
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                     \
+                                                                                                            \
+            u32 j = entry->hash & mask;                                                                     \
+            while (ORDERED_index_get(new_hashset.index, new_hashset.width, j) != ORDERED_INDEX_EMPTY)       \
+                j = (j + 1) & mask;                                                                         \
+                                                                                                            \
+            const u32 slot = new_hashset.used++;                                                            \
+            ORDERED_index_set(new_hashset.index, new_hashset.width, j, slot + ORDERED_INDEX_OFFSET);        \
+            new_hashset.entries[slot] = *entry;                                                             \
+        }                                                                                                   \
+                                                                                                            \
+        new_hashset.size = hashset->size;                                                                   \
+                                                                                                            \
+        HASHSET_##K##_deinit(hashset);                                                                      \
+        *hashset = new_hashset;                                                                             \
+                                                                                                            \
+        return 1;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, const u32 hash, const K key) {                         \
+        if (hashset == NULL) return 0;                                                                      \
+        if (hashset->capacity == 0) return 0;                                                               \
+                                                                                                            \
+        if (hashset->used + 1 > ORDERED_MAX_LOAD(hashset->capacity)) {                                      \
+            const u8 r = HASHSET_##K##_grow(hashset);                                                       \
+            if (r == 0) return 0;                                                                           \
+        }                                                                                                   \
+                                                                                                            \
+        const u32 mask = hashset->capacity - 1;                                                             \
+        u32 i = hash & mask;                                                                                \
+        u32 found = hashset->capacity;                                                                      \
+                                                                                                            \
+        for (;;) {                                                                                          \
+            const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i);                          \
+            if (slot == ORDERED_INDEX_EMPTY) {                                                              \
+                if (found == hashset->capacity) found = i;                                                  \
+                break;                                                                                      \
+            }                                                                                               \
+                                                                                                            \
+            if (slot == ORDERED_INDEX_DELETED) {                                                            \
+                if (found == hashset->capacity) found = i;                                                  \
+            }                                                                                               \
+            else {                                                                                          \
+                const HASHSET_ENTRY_##K* entry = hashset->entries + slot - ORDERED_INDEX_OFFSET;            \
+                if (entry->hash == hash && HASHSET_##K##_key_equal(entry->key, key) == 1) return 0;         \
+            }                                                                                               \
+                                                                                                            \
+            i = (i + 1) & mask;                                                                             \
+        }                                                                                                   \
+                                                                                                            \
+        HASHSET_ENTRY_##K* entry = hashset->entries + hashset->used;                                        \
+        entry->status = HASHSET_ENTRY_STATUS_FILLED;                                                        \
+        entry->hash = hash;                                                                                 \
+        entry->key = key;                                                                                   \
+                                                                                                            \
+        ORDERED_index_set(hashset->index, hashset->width, found, hashset->used + ORDERED_INDEX_OFFSET);     \
+        hashset->used++;                                                                                    \
+        hashset->size++;                                                                                    \
+        return 1;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, const K key) {                                               \
+        if (hashset == NULL) return 0;                                                                      \
+                                                                                                            \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                       \
+        return HASHSET_##K##_quick_add(hashset, hash, key);                                                 \
+    }                                                                                                       \
+                                                                                                            \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, const K key) {                                          \
+        if (hashset == NULL) return;                                                                        \
+        if (hashset->capacity == 0) return;                                                                 \
+                                                                                                            \
+        const u32 i = HASHSET_##K##_bucket(hashset, HASHSET_##K##_key_hash(key), key);                      \
+        if (i == hashset->capacity) return;                                                                 \
+                                                                                                            \
+        const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i) - ORDERED_INDEX_OFFSET;       \
+        ORDERED_index_set(hashset->index, hashset->width, i, ORDERED_INDEX_DELETED);                        \
+        hashset->entries[slot].status = HASHSET_ENTRY_STATUS_TOMBSTONE;                                     \
+        hashset->size--;                                                                                    \
+    }                                                                                                       \
+                                                                                                            \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, const K key) {                                    \
+        if (hashset == NULL) return 0;                                                                      \
+                                                                                                            \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find(hashset, key);                                  \
+        if (entry == NULL) return 0;                                                                        \
+        return 1;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, const K key) {                        \
+        if (hashset == NULL) return NULL;                                                                   \
+                                                                                                            \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                       \
+        return HASHSET_##K##_find_hashed(hashset, hash, key);                                               \
+    }                                                                                                       \
+                                                                                                            \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {             \
+        if (hashset == NULL) return 0;                                                                      \
+                                                                                                            \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find_hashed(hashset, hash, key);                     \
+        if (entry == NULL) return 0;                                                                        \
+        return 1;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) { \
+        if (hashset == NULL) return NULL;                                                                   \
+        if (hashset->capacity == 0) return NULL;                                                            \
+                                                                                                            \
+        const u32 i = HASHSET_##K##_bucket(hashset, hash, key);                                             \
+        if (i == hashset->capacity) return NULL;                                                            \
+                                                                                                            \
+        const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i) - ORDERED_INDEX_OFFSET;       \
+        return hashset->entries + slot;                                                                     \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_ENTRY_##K* HASHSET_##K##_next(const HASHSET_##K* hashset, u32* position) {                      \
+        if (hashset == NULL || position == NULL) return NULL;                                               \
+                                                                                                            \
+        while (*position < hashset->used) {                                                                 \
+            HASHSET_ENTRY_##K* entry = hashset->entries + (*position)++;                                    \
+            if (entry->status == HASHSET_ENTRY_STATUS_FILLED) return entry;                                 \
+        }                                                                                                   \
+                                                                                                            \
+        return NULL;                                                                                        \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b) {                          \
+        if (a == NULL || b == NULL) return NULL;                                                            \
+                                                                                                            \
+        const u32 capacity = (u32)((a->size + (u64)b->size) * 3 / 2) + 1;                                   \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(capacity, a->allocator);                            \
+        if (c == NULL) return NULL;                                                                         \
+                                                                                                            \
+        const HASHSET_ENTRY_##K* entry;                                                                     \
+        u32 position = 0;                                                                                   \
+        while ((entry = HASHSET_##K##_next(a, &position)) != NULL)                                          \
+            HASHSET_##K##_quick_add(c, entry->hash, entry->key);                                            \
+                                                                                                            \
+        position = 0;                                                                                       \
+        while ((entry = HASHSET_##K##_next(b, &position)) != NULL)                                          \
+            HASHSET_##K##_quick_add(c, entry->hash, entry->key);                                            \
+                                                                                                            \
+        return c;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b) {                   \
+        if (a == NULL || b == NULL) return NULL;                                                            \
+                                                                                                            \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(0, a->allocator);                                   \
+        if (c == NULL) return NULL;                                                                         \
+                                                                                                            \
+        const HASHSET_ENTRY_##K* entry;                                                                     \
+        u32 position = 0;                                                                                   \
+        while ((entry = HASHSET_##K##_next(a, &position)) != NULL) {                                        \
+            if (HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 1)                             \
+                HASHSET_##K##_quick_add(c, entry->hash, entry->key);                                        \
+        }                                                                                                   \
+                                                                                                            \
+        return c;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b) {                     \
+        if (a == NULL || b == NULL) return NULL;                                                            \
+                                                                                                            \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(0, a->allocator);                                   \
+        if (c == NULL) return NULL;                                                                         \
+                                                                                                            \
+        const HASHSET_ENTRY_##K* entry;                                                                     \
+        u32 position = 0;                                                                                   \
+        while ((entry = HASHSET_##K##_next(a, &position)) != NULL) {                                        \
+            if (HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 0)                             \
+                HASHSET_##K##_quick_add(c, entry->hash, entry->key);                                        \
+        }                                                                                                   \
+                                                                                                            \
+        return c;                                                                                           \
+    }
+
+#endif //NESQUIK_ORDERED_HASHSET_H
\ No newline at end of file
@@ -0,0 +1,298 @@
+#ifndef NESQUIK_ORDERED_HASHTABLE_H
+#define NESQUIK_ORDERED_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/ordered_index.h"
+
+// Insertion ordered dict layout behind the HASHTABLE API. Entries are appended to a dense array and a bucket
+// index of u8/u16/u32 slot numbers points into it, so iterating with _next walks the entries in insertion
+// order without touching empty buckets. Removed entries leave a hole until the next _grow compacts the array.
+#define HASHTABLE_DECLARE_ORDERED_TYPES(K, V)                                                                       \
+    typedef struct HASHTABLE_ENTRY_##K##_##V {                                                                      \
+        u8 status;                                                                                                  \
+        u32 hash;                                                                                                   \
+        K key;                                                                                                      \
+        V value;                                                                                                    \
+    } HASHTABLE_ENTRY_##K##_##V;                                                                                    \
+                                                                                                                    \
+    typedef struct HASHTABLE_##K##_##V {                                                                            \
+        void* index;                                                                                                \
+        HASHTABLE_ENTRY_##K##_##V* entries;                                                                         \
+        u32 size;                                                                                                   \
+        u32 used;                                                                                                   \
+        u32 capacity;                                                                                               \
+        u8 width;                                                                                                   \
+        const NESQUIK_ALLOCATOR* allocator;                                                                         \
+    } HASHTABLE_##K##_##V;                                                                                          \
+                                                                                                                    \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, u32 capacity);                                    \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, u32 capacity,                           \
+        const NESQUIK_ALLOCATOR* allocator);                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(u32 capacity);                                                \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);  \
+                                                                                                                    \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable);                                              \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable);                                             \
+                                                                                                                    \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable);                                                  \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, K key, V value);                                   \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);                   \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, K key);                                       \
+                                                                                                                    \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, K key);                                 \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, K key);             \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash, K key);                \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash,    \
+        K key);                                                                                                     \
+                                                                                                                    \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_next(const HASHTABLE_##K##_##V* hashtable, u32* position);
+
+#define HASHTABLE_DECLARE_ORDERED_HASH(K, V, HASH_F)    \
+    HASHTABLE_DECLARE_ORDERED_TYPES(K, V)               \
+    HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define HASHTABLE_DECLARE_ORDERED_EX(K, V, HASH_FN, EQ_FN)      \
+    HASHTABLE_DECLARE_ORDERED_TYPES(K, V)                       \
+    HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define HASHTABLE_DECLARE_ORDERED(K, V) HASHTABLE_DECLARE_ORDERED_HASH(K, V, HASH_fnv1a)
+
+#define HASHTABLE_DEFINE_ORDERED(K, V)                                                                                  \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, const u32 capacity) {                                 \
+        return HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, NULL);                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, const u32 capacity,                         \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        hashtable->allocator = allocator;                                                                               \
+        hashtable->size = 0;                                                                                            \
+        hashtable->used = 0;                                                                                            \
+        hashtable->capacity = ORDERED_capacity(capacity);                                                               \
+        hashtable->width = ORDERED_index_width(hashtable->capacity);                                                    \
+                                                                                                                        \
+        hashtable->index = NESQUIK_calloc(allocator, hashtable->capacity, hashtable->width);                            \
+        hashtable->entries = (HASHTABLE_ENTRY_##K##_##V*)NESQUIK_alloc(allocator,                                       \
+            sizeof(HASHTABLE_ENTRY_##K##_##V) *                                                                         \
+            ORDERED_MAX_LOAD(hashtable->capacity));                                                                     \
+                                                                                                                        \
+        if (hashtable->index == NULL || hashtable->entries == NULL) {                                                   \
+            HASHTABLE_##K##_##V##_deinit(hashtable);                                                                    \
+            return 0;                                                                                                   \
+        }                                                                                                               \
+                                                                                                                        \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(const u32 capacity) {                                             \
+        return HASHTABLE_##K##_##V##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                     \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        HASHTABLE_##K##_##V* hashtable = (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                 \
+            sizeof(HASHTABLE_##K##_##V));                                                                               \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, allocator);                              \
+        if (r == 0) {                                                                                                   \
+            NESQUIK_free(allocator, hashtable);                                                                         \
+            return NULL;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        return hashtable;                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable) {                                                 \
+        if (hashtable == NULL) return;                                                                                  \
+        hashtable->size = 0;                                                                                            \
+        hashtable->used = 0;                                                                                            \
+        hashtable->capacity = 0;                                                                                        \
+                                                                                                                        \
+        NESQUIK_free(hashtable->allocator, hashtable->index);                                                           \
+        NESQUIK_free(hashtable->allocator, hashtable->entries);                                                         \
+                                                                                                                        \
+        hashtable->index = NULL;                                                                                        \
+        hashtable->entries = NULL;                                                                                      \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable) {                                                \
+        if (hashtable == NULL) return;                                                                                  \
+                                                                                                                        \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                      \
+        HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
+        NESQUIK_free(allocator, hashtable);                                                                             \
+    }                                                                                                                   \
+                                                                                                                        \
+    static u32 HASHTABLE_##K##_##V##_bucket(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {        \
+        const u32 mask = hashtable->capacity - 1;                                                                       \
+        u32 i = hash & mask;                                                                                            \
+                                                                                                                        \
+        for (;;) {                                                                                                      \
+            const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i);                                  \
+            if (slot == ORDERED_INDEX_EMPTY) return hashtable->capacity;                                                \
+                                                                                                                        \
+            if (slot != ORDERED_INDEX_DELETED) {                                                                        \
+                const HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + slot - ORDERED_INDEX_OFFSET;              \
+                if (entry->hash == hash && HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) return i;             \
+            }                                                                                                           \
+                                                                                                                        \
+            i = (i + 1) & mask;                                                                                         \
+        }                                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable) {                                                     \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        u32 new_capacity = hashtable->capacity;                                                                         \
+        if (hashtable->size + 1 > ORDERED_MAX_LOAD(hashtable->capacity) / 2) {                                          \
+            if (hashtable->capacity & 0x80000000) return 0;                                                             \
+            new_capacity = hashtable->capacity << 1;                                                                    \
+        }                                                                                                               \
+                                                                                                                        \
+        HASHTABLE_##K##_##V new_hashtable;                                                                              \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);          \
+        if (r == 0) return 0;                                                                                           \
+                                                                                                                        \
+        const u32 mask = new_hashtable.capacity - 1;                                                                    \
+        for (u32 i = 0; i < hashtable->used; i++) {                                                                     \
+            const HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                            \
+            if (entry->status != HASHTABLE_ENTRY_STATUS_FILLED) continue;                                               \
+                                                                                                                        \
+            u32 j = entry->hash & mask;                                                                                 \
+            while (ORDERED_index_get(new_hashtable.index, new_hashtable.width, j) != ORDERED_INDEX_EMPTY)               \
+                j = (j + 1) & mask;                                                                                     \
+                                                                                                                        \
+            const u32 slot = new_hashtable.used++;                                                                      \
+            ORDERED_index_set(new_hashtable.index, new_hashtable.width, j, slot + ORDERED_INDEX_OFFSET);                \
+            new_hashtable.entries[slot] = *entry;                                                                       \
+        }                                                                                                               \
+                                                                                                                        \
+        new_hashtable.size = hashtable->size;                                                                           \
+                                                                                                                        \
+        HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
+        *hashtable = new_hashtable;                                                                                     \
+                                                                                                                        \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) {    \
+        if (hashtable == NULL) return 0;                                                                                \
+        if (hashtable->capacity == 0) return 0;                                                                         \
+                                                                                                                        \
+        if (hashtable->used + 1 > ORDERED_MAX_LOAD(hashtable->capacity)) {                                              \
+            const u8 r = HASHTABLE_##K##_##V##_grow(hashtable);                                                         \
+            if (r == 0) return 0;                                                                                       \
+        }                                                                                                               \
+                                                                                                                        \
+        const u32 mask = hashtable->capacity - 1;                                                                       \
+        u32 i = hash & mask;                                                                                            \
+        u32 found = hashtable->capacity;                                                                                \
+                                                                                                                        \
+        for (;;) {                                                                                                      \
+            const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i);                                  \
+            if (slot == ORDERED_INDEX_EMPTY) {                                                                          \
+                if (found == hashtable->capacity) found = i;                                                            \
+                break;                                                                                                  \
+            }                                                                                                           \
+                                                                                                                        \
+            if (slot == ORDERED_INDEX_DELETED) {                                                                        \
+                if (found == hashtable->capacity) found = i;                                                            \
+            }                                                                                                           \
+            else {                                                                                                      \
+                const HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + slot - ORDERED_INDEX_OFFSET;              \
+                if (entry->hash == hash && HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) return 0;             \
+            }                                                                                                           \
+                                                                                                                        \
+            i = (i + 1) & mask;                                                                                         \
+        }                                                                                                               \
+                                                                                                                        \
+        HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + hashtable->used;                                        \
+        entry->status = HASHTABLE_ENTRY_STATUS_FILLED;                                                                  \
+        entry->hash = hash;                                                                                             \
+        entry->key = key;                                                                                               \
+        entry->value = value;                                                                                           \
+                                                                                                                        \
+        ORDERED_index_set(hashtable->index, hashtable->width, found, hashtable->used + ORDERED_INDEX_OFFSET);           \
+        hashtable->used++;                                                                                              \
+        hashtable->size++;                                                                                              \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, const K key, const V value) {                          \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                            \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, const K key) {                                    \
+        if (hashtable == NULL) return;                                                                                  \
+        if (hashtable->capacity == 0) return;                                                                           \
+                                                                                                                        \
+        const u32 i = HASHTABLE_##K##_##V##_bucket(hashtable, HASHTABLE_##K##_##V##_key_hash(key), key);                \
+        if (i == hashtable->capacity) return;                                                                           \
+                                                                                                                        \
+        const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i) - ORDERED_INDEX_OFFSET;               \
+        ORDERED_index_set(hashtable->index, hashtable->width, i, ORDERED_INDEX_DELETED);                                \
+        hashtable->entries[slot].status = HASHTABLE_ENTRY_STATUS_TOMBSTONE;                                             \
+        hashtable->size--;                                                                                              \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, const K key) {                              \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find(hashtable, key);                            \
+        if (entry == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, const K key) {          \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {       \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);               \
+        if (entry == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash,  \
+        const K key) {                                                                                                  \
+                                                                                                                        \
+        if (hashtable == NULL) return NULL;                                                                             \
+        if (hashtable->capacity == 0) return NULL;                                                                      \
+                                                                                                                        \
+        const u32 i = HASHTABLE_##K##_##V##_bucket(hashtable, hash, key);                                               \
+        if (i == hashtable->capacity) return NULL;                                                                      \
+                                                                                                                        \
+        const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i) - ORDERED_INDEX_OFFSET;               \
+        return hashtable->entries + slot;                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_next(const HASHTABLE_##K##_##V* hashtable, u32* position) {        \
+        if (hashtable == NULL || position == NULL) return NULL;                                                         \
+                                                                                                                        \
+        while (*position < hashtable->used) {                                                                           \
+            HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + (*position)++;                                      \
+            if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED) return entry;                                           \
+        }                                                                                                               \
+                                                                                                                        \
+        return NULL;                                                                                                    \
+    }
+
+#endif //NESQUIK_ORDERED_HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef NESQUIK_ORDERED_INDEX_H
+#define NESQUIK_ORDERED_INDEX_H
+
+#include "types.h"
+
+// Bucket index of the *_DEFINE_ORDERED engines. Every bucket holds a slot number into the dense entries array
+// in the narrowest of u8, u16 or u32 that fits the capacity. Slot n is stored as n + ORDERED_INDEX_OFFSET.
+#define ORDERED_INDEX_EMPTY         0
+#define ORDERED_INDEX_DELETED       1
+#define ORDERED_INDEX_OFFSET        2
+
+#define ORDERED_MIN_CAPACITY        8
+#define ORDERED_MAX_LOAD(capacity)  ((capacity) - (capacity) / 3)
+
+static inline u32 ORDERED_capacity(const u32 capacity) {
+    u32 new_capacity = ORDERED_MIN_CAPACITY;
+    while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;
+    return new_capacity;
+}
+
+static inline u8 ORDERED_index_width(const u32 capacity) {
+    const u64 largest = (u64)ORDERED_MAX_LOAD(capacity) - 1 + ORDERED_INDEX_OFFSET;
+    if (largest <= 0xFF) return sizeof(u8);
+    if (largest <= 0xFFFF) return sizeof(u16);
+    return sizeof(u32);
+}
+
+static inline u32 ORDERED_index_get(const void* index, const u8 width, const u32 i) {
+    if (width == sizeof(u8)) return ((const u8*)index)[i];
+    if (width == sizeof(u16)) return ((const u16*)index)[i];
+    return ((const u32*)index)[i];
+}
+
+static inline void ORDERED_index_set(void* index, const u8 width, const u32 i, const u32 value) {
+    if (width == sizeof(u8)) ((u8*)index)[i] = (u8)value;
+    else if (width == sizeof(u16)) ((u16*)index)[i] = (u16)value;
+    else ((u32*)index)[i] = value;
+}
+
+#endif //NESQUIK_ORDERED_INDEX_H
\ No newline at end of file
@@ -0,0 +1,223 @@
+#ifndef NESQUIK_PARALLEL_HASHSET_H
+#define NESQUIK_PARALLEL_HASHSET_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "hash/hashset.h"
+#include "thread/thread_pool.h"
+
+// Parallel union, intersection and difference for the classic HASHSET, expanded next to HASHSET_DECLARE/HASHSET_DEFINE.
+// Workers scan slices of the inputs into one bucket per output partition, a partition is a contiguous slot range
+// of the pre-sized result. Each worker then probes only inside its own partition, so no locks and no merge are
+// needed. The few entries whose probe runs past the partition end are added afterwards by the calling thread.
+// A single worker falls back to the serial HASHSET operations. Like those, the result uses the allocator of a,
+// the scatter buckets always come from libc.
+
+// Entries a scatter bucket holds before its first realloc
+#define HASHSET_PARALLEL_BUCKET_MIN_CAPACITY 64
+
+// Partition of a result slot, the inverse of THREAD_POOL_split over the result capacity
+static inline u32 HASHSET_partition_of(const u32 slot, const u32 capacity, const u32 partitions) {
+    return (u32)((u64)slot * partitions / capacity);
+}
+
+#define HASHSET_DECLARE_PARALLEL(K)                                                                                 \
+    typedef struct HASHSET_BUCKET_##K {                                                                             \
+        HASHSET_ENTRY_##K* entries;                                                                                 \
+        u32 size;                                                                                                   \
+        u32 capacity;                                                                                               \
+    } HASHSET_BUCKET_##K;                                                                                           \
+                                                                                                                    \
+    typedef struct HASHSET_PARALLEL_##K {                                                                           \
+        const HASHSET_##K* sources[2];                                                                              \
+        const HASHSET_##K* filters[2];                                                                              \
+        u8 keep[2];                                                                                                 \
+                                                                                                                    \
+        HASHSET_##K* result;                                                                                        \
+        u32 partitions;                                                                                             \
+        HASHSET_BUCKET_##K* buckets;                                                                                \
+        HASHSET_BUCKET_##K* overflow;                                                                               \
+        u32* placed;                                                                                                \
+        u8* failed;                                                                                                 \
+    } HASHSET_PARALLEL_##K;                                                                                         \
+                                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_union_parallel(const HASHSET_##K* a, const HASHSET_##K* b, THREAD_POOL* pool);       \
+    HASHSET_##K* HASHSET_##K##_intersection_parallel(const HASHSET_##K* a, const HASHSET_##K* b,                    \
+        THREAD_POOL* pool);                                                                                         \
+    HASHSET_##K* HASHSET_##K##_difference_parallel(const HASHSET_##K* a, const HASHSET_##K* b,                      \
+        THREAD_POOL* pool);
+
+#define HASHSET_DEFINE_PARALLEL(K)                                                                                      \
+    static u8 HASHSET_##K##_bucket_push(HASHSET_BUCKET_##K* bucket, const HASHSET_ENTRY_##K* entry) {                   \
+        if (bucket->size == bucket->capacity) {                                                                         \
+            u32 capacity = bucket->capacity * 2;                                                                        \
+            capacity = capacity < HASHSET_PARALLEL_BUCKET_MIN_CAPACITY ?                                                \
+                HASHSET_PARALLEL_BUCKET_MIN_CAPACITY : capacity;                                                        \
+                                                                                                                        \
+            HASHSET_ENTRY_##K* entries = (HASHSET_ENTRY_##K*)realloc(bucket->entries,                                   \
+                sizeof(HASHSET_ENTRY_##K) * capacity);                                                                  \
+            if (entries == NULL) return 0;                                                                              \
+                                                                                                                        \
+            bucket->entries = entries;                                                                                  \
+            bucket->capacity = capacity;                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        bucket->entries[bucket->size++] = *entry;                                                                       \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    static void HASHSET_##K##_scatter(void* context, const u32 worker, const u32 workers) {                             \
+        HASHSET_PARALLEL_##K* job = (HASHSET_PARALLEL_##K*)context;                                                     \
+        HASHSET_BUCKET_##K* buckets = job->buckets + (u64)worker * job->partitions;                                     \
+        const u32 capacity = job->result->capacity;                                                                     \
+                                                                                                                        \
+        for (u32 s = 0; s < 2; s++) {                                                                                   \
+            const HASHSET_##K* source = job->sources[s];                                                                \
+            if (source == NULL) continue;                                                                               \
+                                                                                                                        \
+            const u32 begin = THREAD_POOL_split(source->capacity, worker, workers);                                     \
+            const u32 end = THREAD_POOL_split(source->capacity, worker + 1, workers);                                   \
+            for (u32 i = begin; i < end; i++) {                                                                         \
+                const HASHSET_ENTRY_##K* entry = source->entries + i;                                                   \
+                if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;                                             \
+                if (job->filters[s] != NULL &&                                                                          \
+                    HASHSET_##K##_contains_hashed(job->filters[s], entry->hash, entry->key) != job->keep[s])            \
+                    continue;                                                                                           \
+                                                                                                                        \
+                const u32 partition = HASHSET_partition_of(entry->hash % capacity, capacity, job->partitions);          \
+                if (HASHSET_##K##_bucket_push(buckets + partition, entry) == 0) {                                       \
+                    job->failed[worker] = 1;                                                                            \
+                    return;                                                                                             \
+                }                                                                                                       \
+            }                                                                                                           \
+        }                                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    static void HASHSET_##K##_gather(void* context, const u32 worker, const u32 workers) {                              \
+        HASHSET_PARALLEL_##K* job = (HASHSET_PARALLEL_##K*)context;                                                     \
+        HASHSET_ENTRY_##K* entries = job->result->entries;                                                              \
+        const u32 capacity = job->result->capacity;                                                                     \
+        const u32 end = THREAD_POOL_split(capacity, worker + 1, job->partitions);                                       \
+                                                                                                                        \
+        u32 placed = 0;                                                                                                 \
+        for (u32 w = 0; w < workers; w++) {                                                                             \
+            const HASHSET_BUCKET_##K* bucket = job->buckets + (u64)w * job->partitions + worker;                        \
+                                                                                                                        \
+            for (u32 e = 0; e < bucket->size; e++) {                                                                    \
+                const HASHSET_ENTRY_##K* entry = bucket->entries + e;                                                   \
+                                                                                                                        \
+                u32 i = entry->hash % capacity;                                                                         \
+                while (i < end && entries[i].status == HASHSET_ENTRY_STATUS_FILLED) i++;                                \
+                                                                                                                        \
+                if (i == end) {                                                                                         \
+                    if (HASHSET_##K##_bucket_push(job->overflow + worker, entry) == 1) continue;                        \
+                    job->failed[worker] = 1;                                                                            \
+                    break;                                                                                              \
+                }                                                                                                       \
+                                                                                                                        \
+                entries[i] = *entry;                                                                                    \
+                placed++;                                                                                               \
+            }                                                                                                           \
+        }                                                                                                               \
+                                                                                                                        \
+        job->placed[worker] = placed;                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+    static HASHSET_##K* HASHSET_##K##_run_parallel(HASHSET_PARALLEL_##K* job, const u32 size,                           \
+        const NESQUIK_ALLOCATOR* allocator, THREAD_POOL* pool) {                                                        \
+                                                                                                                        \
+        const u32 workers = THREAD_POOL_workers(pool);                                                                  \
+        job->partitions = workers;                                                                                      \
+                                                                                                                        \
+        job->result = HASHSET_##K##_create_allocator(HASHSET_capacity_for(size), allocator);                            \
+        if (job->result == NULL) return NULL;                                                                           \
+                                                                                                                        \
+        const u64 bucket_count = (u64)workers * workers;                                                                \
+        job->buckets = (HASHSET_BUCKET_##K*)calloc(bucket_count, sizeof(HASHSET_BUCKET_##K));                           \
+        job->overflow = (HASHSET_BUCKET_##K*)calloc(workers, sizeof(HASHSET_BUCKET_##K));                               \
+        job->placed = (u32*)calloc(workers, sizeof(u32));                                                               \
+        job->failed = (u8*)calloc(workers, sizeof(u8));                                                                 \
+                                                                                                                        \
+        u8 failed = job->buckets == NULL || job->overflow == NULL || job->placed == NULL || job->failed == NULL;        \
+        if (failed == 0) THREAD_POOL_run(pool, HASHSET_##K##_scatter, job);                                             \
+        for (u32 w = 0; w < workers && failed == 0; w++) failed = job->failed[w];                                       \
+                                                                                                                        \
+        if (failed == 0) THREAD_POOL_run(pool, HASHSET_##K##_gather, job);                                              \
+        for (u32 w = 0; w < workers && failed == 0; w++) failed = job->failed[w];                                       \
+                                                                                                                        \
+        if (failed == 0) {                                                                                              \
+            for (u32 w = 0; w < workers; w++) job->result->size += job->placed[w];                                      \
+                                                                                                                        \
+            for (u32 w = 0; w < workers && failed == 0; w++) {                                                          \
+                const HASHSET_BUCKET_##K* overflow = job->overflow + w;                                                 \
+                for (u32 e = 0; e < overflow->size; e++) {                                                              \
+                    const HASHSET_ENTRY_##K* entry = overflow->entries + e;                                             \
+                    if (HASHSET_##K##_quick_add(job->result, entry->hash, entry->key) == 0) failed = 1;                 \
+                }                                                                                                       \
+            }                                                                                                           \
+        }                                                                                                               \
+                                                                                                                        \
+        for (u64 i = 0; job->buckets != NULL && i < bucket_count; i++) free(job->buckets[i].entries);                   \
+        for (u32 w = 0; job->overflow != NULL && w < workers; w++) free(job->overflow[w].entries);                      \
+        free(job->buckets);                                                                                             \
+        free(job->overflow);                                                                                            \
+        free(job->placed);                                                                                              \
+        free(job->failed);                                                                                              \
+                                                                                                                        \
+        if (failed == 1) {                                                                                              \
+            HASHSET_##K##_destroy(job->result);                                                                         \
+            return NULL;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        return job->result;                                                                                             \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHSET_##K* HASHSET_##K##_union_parallel(const HASHSET_##K* a, const HASHSET_##K* b, THREAD_POOL* pool) {          \
+        if (a == NULL || b == NULL) return NULL;                                                                        \
+        if (THREAD_POOL_workers(pool) == 1) return HASHSET_##K##_union(a, b);                                           \
+                                                                                                                        \
+        HASHSET_PARALLEL_##K job = {                                                                                    \
+            .sources = {a, a == b ? NULL : b},                                                                          \
+            .filters = {NULL, a},                                                                                       \
+            .keep = {1, 0}                                                                                              \
+        };                                                                                                              \
+                                                                                                                        \
+        return HASHSET_##K##_run_parallel(&job, a->size + b->size, a->allocator, pool);                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHSET_##K* HASHSET_##K##_intersection_parallel(const HASHSET_##K* a, const HASHSET_##K* b,                        \
+        THREAD_POOL* pool) {                                                                                            \
+                                                                                                                        \
+        if (a == NULL || b == NULL) return NULL;                                                                        \
+        if (THREAD_POOL_workers(pool) == 1) return HASHSET_##K##_intersection(a, b);                                    \
+                                                                                                                        \
+        const HASHSET_##K* smaller = a->capacity < b->capacity ? a : b;                                                 \
+        const HASHSET_##K* larger = a->capacity < b->capacity ? b : a;                                                  \
+                                                                                                                        \
+        HASHSET_PARALLEL_##K job = {                                                                                    \
+            .sources = {smaller, NULL},                                                                                 \
+            .filters = {a == b ? NULL : larger, NULL},                                                                  \
+            .keep = {1, 1}                                                                                              \
+        };                                                                                                              \
+                                                                                                                        \
+        return HASHSET_##K##_run_parallel(&job, a->size < b->size ? a->size : b->size, a->allocator, pool);             \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHSET_##K* HASHSET_##K##_difference_parallel(const HASHSET_##K* a, const HASHSET_##K* b,                          \
+        THREAD_POOL* pool) {                                                                                            \
+                                                                                                                        \
+        if (a == NULL || b == NULL) return NULL;                                                                        \
+        if (THREAD_POOL_workers(pool) == 1) return HASHSET_##K##_difference(a, b);                                      \
+                                                                                                                        \
+        HASHSET_PARALLEL_##K job = {                                                                                    \
+            .sources = {a == b ? NULL : a, NULL},                                                                       \
+            .filters = {b, NULL},                                                                                       \
+            .keep = {0, 1}                                                                                              \
+        };                                                                                                              \
+                                                                                                                        \
+        return HASHSET_##K##_run_parallel(&job, a->size, a->allocator, pool);                                           \
+    }
+
+#endif //NESQUIK_PARALLEL_HASHSET_H
\ No newline at end of file
@@ -5,66 +5,175 @@
 #include <stdlib.h>
 
 #include "types.h"
+#include "allocator.h"
 #include "hash/hash.h"
 
 #define POINTER_HASHSET_ENTRY_STATUS_EMPTY      0
 #define POINTER_HASHSET_ENTRY_STATUS_FILLED     1
 #define POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE  2
+// Marks entries still to be moved while _rehash purges tombstones in place
+#define POINTER_HASHSET_ENTRY_STATUS_DISPLACED  3
 
 #define POINTER_HASHSET_MIN_LOAD_FACTOR         0.5
 #define POINTER_HASHSET_MAX_LOAD_FACTOR         0.75
 
 #define POINTER_HASHSET_MIN_CAPACITY            8
 
+// Result sets and in-place algebra size from the element count, never from the capacity of the inputs
+static inline u32 POINTER_HASHSET_capacity_for(const f64 size) {
+    return (u32)(size / POINTER_HASHSET_MAX_LOAD_FACTOR) + 1;
+}
+
+// What POINTER_HASHSET_next yields after one of the _iterate* calls, without building a result set
+#define POINTER_HASHSET_ITERATE_ALL             0
+#define POINTER_HASHSET_ITERATE_UNION           1
+#define POINTER_HASHSET_ITERATE_INTERSECTION    2
+#define POINTER_HASHSET_ITERATE_DIFFERENCE      3
+
 #pragma pack(push, 1)
-#define POINTER_HASHSET_DECLARE(K)                                                                                              \
-    typedef struct POINTER_HASHSET_ENTRY_##K {                                                                                  \
-        u8 status;                                                                                                              \
-        u32 hash;                                                                                                               \
-        K* key;                                                                                                                 \
-    } POINTER_HASHSET_ENTRY_##K;                                                                                                \
-                                                                                                                                \
-    typedef struct POINTER_HASHSET_##K {                                                                                        \
-        POINTER_HASHSET_ENTRY_##K* entries;                                                                                     \
-        u32 size;                                                                                                               \
-        u32 capacity;                                                                                                           \
-        u32 tombstones;                                                                                                         \
-                                                                                                                                \
-        u32 (*key_size)(const K*);                                                                                              \
-        u8 (*key_equal)(const K*, const K*);                                                                                    \
-    } POINTER_HASHSET_##K;                                                                                                      \
-                                                                                                                                \
-    u8 POINTER_HASHSET_##K##_init(POINTER_HASHSET_##K* hashset,                                                                 \
-        u32 capacity,                                                                                                           \
-        u32 (*key_size)(const K*),                                                                                              \
-        u8 (*key_equal)(const K*, const K*));                                                                                   \
-    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create(const u32 capacity,                                                       \
-        u32 (*key_size)(const K*),                                                                                              \
-        u8 (*key_equal)(const K*, const K*));                                                                                   \
-                                                                                                                                \
-    void POINTER_HASHSET_##K##_deinit(POINTER_HASHSET_##K* hashset);                                                            \
-    void POINTER_HASHSET_##K##_destroy(POINTER_HASHSET_##K* hashset);                                                           \
-                                                                                                                                \
-    u8 POINTER_HASHSET_##K##_grow(POINTER_HASHSET_##K* hashset);                                                                \
-    u8 POINTER_HASHSET_##K##_add(POINTER_HASHSET_##K* hashset, K* key);                                                         \
-    u8 POINTER_HASHSET_##K##_quick_add(POINTER_HASHSET_##K* hashset, u32 hash, K* key);                                         \
-    void POINTER_HASHSET_##K##_remove(POINTER_HASHSET_##K* hashset, const K* key);                                              \
-                                                                                                                                \
-    u32 POINTER_HASHSET_##K##_hash(const u8* data, u32 size);                                                                   \
-                                                                                                                                \
-    u8 POINTER_HASHSET_##K##_contains(const POINTER_HASHSET_##K* hashset, const K* key);                                        \
-    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find(const POINTER_HASHSET_##K* hashset, const K* key);                    \
-                                                                                                                                \
-    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_union(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);               \
-    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_intersection(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);        \
-    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_difference(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);
+#define POINTER_HASHSET_DECLARE_TYPES(K)                                                                                    \
+    typedef struct POINTER_HASHSET_ENTRY_##K {                                                                              \
+        u8 status;                                                                                                          \
+        u32 hash;                                                                                                           \
+        K* key;                                                                                                             \
+    } POINTER_HASHSET_ENTRY_##K;                                                                                            \
+                                                                                                                            \
+    typedef struct POINTER_HASHSET_##K {                                                                                    \
+        POINTER_HASHSET_ENTRY_##K* entries;                                                                                 \
+        u32 size;                                                                                                           \
+        u32 capacity;                                                                                                       \
+        u32 tombstones;                                                                                                     \
+                                                                                                                            \
+        u32 (*key_size)(const K*);                                                                                          \
+        u8 (*key_equal)(const K*, const K*);                                                                                \
+        const NESQUIK_ALLOCATOR* allocator;                                                                                 \
+    } POINTER_HASHSET_##K;                                                                                                  \
+                                                                                                                            \
+    typedef struct POINTER_HASHSET_ITERATOR_##K {                                                                           \
+        const POINTER_HASHSET_##K* a;                                                                                       \
+        const POINTER_HASHSET_##K* b;                                                                                       \
+        u32 index;                                                                                                          \
+        u8 mode;                                                                                                            \
+    } POINTER_HASHSET_ITERATOR_##K;                                                                                         \
+                                                                                                                            \
+    u8 POINTER_HASHSET_##K##_init(POINTER_HASHSET_##K* hashset,                                                             \
+        u32 capacity,                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*));                                                                               \
+    u8 POINTER_HASHSET_##K##_init_allocator(POINTER_HASHSET_##K* hashset,                                                   \
+        u32 capacity,                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create(const u32 capacity,                                                   \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*));                                                                               \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create_allocator(u32 capacity,                                               \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                \
+                                                                                                                            \
+    void POINTER_HASHSET_##K##_deinit(POINTER_HASHSET_##K* hashset);                                                        \
+    void POINTER_HASHSET_##K##_destroy(POINTER_HASHSET_##K* hashset);                                                       \
+                                                                                                                            \
+    u8 POINTER_HASHSET_##K##_grow(POINTER_HASHSET_##K* hashset);                                                            \
+    u8 POINTER_HASHSET_##K##_resize(POINTER_HASHSET_##K* hashset, u32 capacity);                                            \
+    u8 POINTER_HASHSET_##K##_rehash(POINTER_HASHSET_##K* hashset);                                                          \
+    u8 POINTER_HASHSET_##K##_reserve(POINTER_HASHSET_##K* hashset, u32 n);                                                  \
+    u8 POINTER_HASHSET_##K##_shrink_to_fit(POINTER_HASHSET_##K* hashset);                                                   \
+    u8 POINTER_HASHSET_##K##_add(POINTER_HASHSET_##K* hashset, K* key);                                                     \
+    u8 POINTER_HASHSET_##K##_quick_add(POINTER_HASHSET_##K* hashset, u32 hash, K* key);                                     \
+    void POINTER_HASHSET_##K##_remove(POINTER_HASHSET_##K* hashset, const K* key);                                          \
+                                                                                                                            \
+    u8 POINTER_HASHSET_##K##_contains(const POINTER_HASHSET_##K* hashset, const K* key);                                    \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find(const POINTER_HASHSET_##K* hashset, const K* key);                \
+    u8 POINTER_HASHSET_##K##_contains_hashed(const POINTER_HASHSET_##K* hashset, u32 hash, const K* key);                   \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find_hashed(const POINTER_HASHSET_##K* hashset,                        \
+        u32 hash, const K* key);                                                                                            \
+                                                                                                                            \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_union(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);           \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_intersection(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_difference(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);      \
+                                                                                                                            \
+    u32 POINTER_HASHSET_##K##_union_into(POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                             \
+    u32 POINTER_HASHSET_##K##_intersect_inplace(POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                      \
+    u32 POINTER_HASHSET_##K##_subtract_inplace(POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                       \
+                                                                                                                            \
+    u32 POINTER_HASHSET_##K##_union_size(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                       \
+    u32 POINTER_HASHSET_##K##_intersection_size(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                \
+    u32 POINTER_HASHSET_##K##_difference_size(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                  \
+                                                                                                                            \
+    void POINTER_HASHSET_##K##_iterate(POINTER_HASHSET_ITERATOR_##K* iterator, const POINTER_HASHSET_##K* hashset);         \
+    void POINTER_HASHSET_##K##_iterate_union(POINTER_HASHSET_ITERATOR_##K* iterator,                                        \
+        const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                                                        \
+    void POINTER_HASHSET_##K##_iterate_intersection(POINTER_HASHSET_ITERATOR_##K* iterator,                                 \
+        const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                                                        \
+    void POINTER_HASHSET_##K##_iterate_difference(POINTER_HASHSET_ITERATOR_##K* iterator,                                   \
+        const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);                                                        \
+    const POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_next(POINTER_HASHSET_ITERATOR_##K* iterator);
 #pragma pack(pop)
 
+// Hashes the key_size bytes behind the key with one of the hash.h kernels and compares keys with key_equal,
+// both called through the function pointers given to _init
+#define POINTER_HASHSET_DECLARE_KEY_HASH(K, HASH_F)                                                                     \
+    static inline u32 POINTER_HASHSET_##K##_hash(const u8* data, const u32 size) {                                      \
+        return HASH_F(data, size);                                                                                      \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline u32 POINTER_HASHSET_##K##_key_hash(const POINTER_HASHSET_##K* hashset, const K* key) {                \
+        return HASH_F((const u8*)key, hashset->key_size(key));                                                          \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline u8 POINTER_HASHSET_##K##_key_equal(const POINTER_HASHSET_##K* hashset, const K* a, const K* b) {      \
+        return hashset->key_equal(a, b);                                                                                \
+    }
+
+// Bakes a user hash (u32 HASH_FN(const K*)) and equality (u8 EQ_FN(const K*, const K*)) into the generated
+// functions, key_size and key_equal are then never called and may be NULL. The byte helper _hash stays on
+// HASH_fnv1a, so both key modes emit the same functions.
+#define POINTER_HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)                                                               \
+    static inline u32 POINTER_HASHSET_##K##_hash(const u8* data, const u32 size) {                                      \
+        return HASH_fnv1a(data, size);                                                                                  \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline u32 POINTER_HASHSET_##K##_key_hash(const POINTER_HASHSET_##K* hashset, const K* key) {                \
+        (void)hashset;                                                                                                  \
+        return HASH_FN(key);                                                                                            \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline u8 POINTER_HASHSET_##K##_key_equal(const POINTER_HASHSET_##K* hashset, const K* a, const K* b) {      \
+        (void)hashset;                                                                                                  \
+        return EQ_FN(a, b) ? 1 : 0;                                                                                     \
+    }
+
+#define POINTER_HASHSET_DECLARE_HASH(K, HASH_F)     \
+    POINTER_HASHSET_DECLARE_TYPES(K)                \
+    POINTER_HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define POINTER_HASHSET_DECLARE_EX(K, HASH_FN, EQ_FN)       \
+    POINTER_HASHSET_DECLARE_TYPES(K)                        \
+    POINTER_HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+// Interned keys, one object per distinct key like STATE: the address is the key, hashed and compared as is
+#define POINTER_HASHSET_DECLARE_IDENTITY(K) POINTER_HASHSET_DECLARE_EX(K, HASH_pointer, HASH_EQUAL)
+
+// Instantiations pick their hash kernel with POINTER_HASHSET_DECLARE_HASH, FNV-1a by default
+#define POINTER_HASHSET_DECLARE(K) POINTER_HASHSET_DECLARE_HASH(K, HASH_fnv1a)
+
 #define POINTER_HASHSET_DEFINE(K)                                                                                               \
     u8 POINTER_HASHSET_##K##_init(POINTER_HASHSET_##K* hashset,                                                                 \
-                      const u32 capacity,                                                                                       \
-                      u32 (*key_size)(const K*),                                                                                \
-                      u8 (*key_equal)(const K*, const K*)) {                                                                    \
+        const u32 capacity,                                                                                                     \
+        u32 (*key_size)(const K*),                                                                                              \
+        u8 (*key_equal)(const K*, const K*)) {                                                                                  \
+                                                                                                                                \
+        return POINTER_HASHSET_##K##_init_allocator(hashset, capacity, key_size, key_equal, NULL);                              \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 POINTER_HASHSET_##K##_init_allocator(POINTER_HASHSET_##K* hashset,                                                       \
+        const u32 capacity,                                                                                                     \
+        u32 (*key_size)(const K*),                                                                                              \
+        u8 (*key_equal)(const K*, const K*),                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                   \
                                                                                                                                 \
         if (hashset == NULL) return 0;                                                                                          \
                                                                                                                                 \
@@ -74,14 +183,16 @@
                                                                                                                                 \
         hashset->key_size = key_size;                                                                                           \
         hashset->key_equal = key_equal;                                                                                         \
+        hashset->allocator = allocator;                                                                                         \
                                                                                                                                 \
-        hashset->entries = (POINTER_HASHSET_ENTRY_##K*)malloc(sizeof(POINTER_HASHSET_ENTRY_##K) * capacity);                    \
+        hashset->entries = (POINTER_HASHSET_ENTRY_##K*)NESQUIK_alloc(allocator,                                                 \
+            sizeof(POINTER_HASHSET_ENTRY_##K) * hashset->capacity);                                                             \
         if (hashset->entries == NULL) {                                                                                         \
             hashset->capacity = 0;                                                                                              \
             return 0;                                                                                                           \
         }                                                                                                                       \
                                                                                                                                 \
-        memset(hashset->entries, 0, sizeof(POINTER_HASHSET_ENTRY_##K) * capacity);                                              \
+        memset(hashset->entries, 0, sizeof(POINTER_HASHSET_ENTRY_##K) * hashset->capacity);                                     \
                                                                                                                                 \
         return 1;                                                                                                               \
     }                                                                                                                           \
@@ -90,12 +201,20 @@
         u32 (*key_size)(const K*),                                                                                              \
         u8 (*key_equal)(const K*, const K*)) {                                                                                  \
                                                                                                                                 \
-        POINTER_HASHSET_##K* hashset = (POINTER_HASHSET_##K*)malloc(sizeof(POINTER_HASHSET_##K));                               \
+        return POINTER_HASHSET_##K##_create_allocator(capacity, key_size, key_equal, NULL);                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create_allocator(const u32 capacity,                                             \
+        u32 (*key_size)(const K*),                                                                                              \
+        u8 (*key_equal)(const K*, const K*),                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                   \
+                                                                                                                                \
+        POINTER_HASHSET_##K* hashset = (POINTER_HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(POINTER_HASHSET_##K));             \
         if (hashset == NULL) return NULL;                                                                                       \
                                                                                                                                 \
-        const u8 r = POINTER_HASHSET_##K##_init(hashset, capacity, key_size, key_equal);                                        \
+        const u8 r = POINTER_HASHSET_##K##_init_allocator(hashset, capacity, key_size, key_equal, allocator);                   \
         if (r == 0) {                                                                                                           \
-            free(hashset);                                                                                                      \
+            NESQUIK_free(allocator, hashset);                                                                                   \
             return NULL;                                                                                                        \
         }                                                                                                                       \
                                                                                                                                 \
@@ -112,7 +231,7 @@
         hashset->key_equal = NULL;                                                                                              \
                                                                                                                                 \
         if (hashset->entries != NULL) {                                                                                         \
-            free(hashset->entries);                                                                                             \
+            NESQUIK_free(hashset->allocator, hashset->entries);                                                                 \
             hashset->entries = NULL;                                                                                            \
         }                                                                                                                       \
     }                                                                                                                           \
@@ -120,8 +239,9 @@
     void POINTER_HASHSET_##K##_destroy(POINTER_HASHSET_##K* hashset) {                                                          \
         if (hashset == NULL) return;                                                                                            \
                                                                                                                                 \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                                                \
         POINTER_HASHSET_##K##_deinit(hashset);                                                                                  \
-        free(hashset);                                                                                                          \
+        NESQUIK_free(allocator, hashset);                                                                                       \
     }                                                                                                                           \
                                                                                                                                 \
     u8 POINTER_HASHSET_##K##_grow(POINTER_HASHSET_##K* hashset) {                                                               \
@@ -130,8 +250,15 @@
         u32 new_capacity = (u32)(hashset->capacity * POINTER_HASHSET_MAX_LOAD_FACTOR / POINTER_HASHSET_MIN_LOAD_FACTOR);        \
         new_capacity = (new_capacity > hashset->capacity) ? new_capacity : hashset->capacity;                                   \
                                                                                                                                 \
+        return POINTER_HASHSET_##K##_resize(hashset, new_capacity);                                                             \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 POINTER_HASHSET_##K##_resize(POINTER_HASHSET_##K* hashset, const u32 new_capacity) {                                     \
+        if (hashset == NULL) return 0;                                                                                          \
+                                                                                                                                \
         POINTER_HASHSET_##K new_hashset;                                                                                        \
-        u8 r = POINTER_HASHSET_##K##_init(&new_hashset, new_capacity, hashset->key_size, hashset->key_equal);                   \
+        u8 r = POINTER_HASHSET_##K##_init_allocator(&new_hashset, new_capacity, hashset->key_size,                              \
+            hashset->key_equal, hashset->allocator);                                                                            \
         if (r == 0) return 0;                                                                                                   \
                                                                                                                                 \
         for (u32 i = 0; i < hashset->capacity; i++) {                                                                           \
@@ -146,19 +273,73 @@
             }                                                                                                                   \
         }                                                                                                                       \
                                                                                                                                 \
-        free(hashset->entries);                                                                                                 \
+        NESQUIK_free(hashset->allocator, hashset->entries);                                                                     \
         hashset->entries = new_hashset.entries;                                                                                 \
-        hashset->capacity = new_capacity;                                                                                       \
+        hashset->capacity = new_hashset.capacity;                                                                               \
         hashset->tombstones = 0;                                                                                                \
                                                                                                                                 \
         return 1;                                                                                                               \
     }                                                                                                                           \
                                                                                                                                 \
+    u8 POINTER_HASHSET_##K##_rehash(POINTER_HASHSET_##K* hashset) {                                                             \
+        if (hashset == NULL) return 0;                                                                                          \
+                                                                                                                                \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                                           \
+            POINTER_HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                            \
+            if (entry->status == POINTER_HASHSET_ENTRY_STATUS_FILLED) entry->status = POINTER_HASHSET_ENTRY_STATUS_DISPLACED;   \
+            else memset(entry, 0, sizeof(POINTER_HASHSET_ENTRY_##K));                                                           \
+        }                                                                                                                       \
+                                                                                                                                \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                                           \
+            if (hashset->entries[i].status != POINTER_HASHSET_ENTRY_STATUS_DISPLACED) continue;                                 \
+                                                                                                                                \
+            POINTER_HASHSET_ENTRY_##K moving = hashset->entries[i];                                                             \
+            memset(hashset->entries + i, 0, sizeof(POINTER_HASHSET_ENTRY_##K));                                                 \
+                                                                                                                                \
+            for (;;) {                                                                                                          \
+                u32 j = moving.hash % hashset->capacity;                                                                        \
+                while (hashset->entries[j].status == POINTER_HASHSET_ENTRY_STATUS_FILLED)                                       \
+                    j = (j + 1) % hashset->capacity;                                                                            \
+                                                                                                                                \
+                const POINTER_HASHSET_ENTRY_##K displaced = hashset->entries[j];                                                \
+                hashset->entries[j] = moving;                                                                                   \
+                hashset->entries[j].status = POINTER_HASHSET_ENTRY_STATUS_FILLED;                                               \
+                                                                                                                                \
+                if (displaced.status == POINTER_HASHSET_ENTRY_STATUS_EMPTY) break;                                              \
+                moving = displaced;                                                                                             \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        hashset->tombstones = 0;                                                                                                \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 POINTER_HASHSET_##K##_reserve(POINTER_HASHSET_##K* hashset, const u32 n) {                                               \
+        if (hashset == NULL) return 0;                                                                                          \
+                                                                                                                                \
+        const u32 capacity = (u32)(n / POINTER_HASHSET_MAX_LOAD_FACTOR) + 1;                                                    \
+        if (capacity <= hashset->capacity) return 1;                                                                            \
+                                                                                                                                \
+        return POINTER_HASHSET_##K##_resize(hashset, capacity);                                                                 \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 POINTER_HASHSET_##K##_shrink_to_fit(POINTER_HASHSET_##K* hashset) {                                                      \
+        if (hashset == NULL) return 0;                                                                                          \
+                                                                                                                                \
+        u32 capacity = (u32)(hashset->size / POINTER_HASHSET_MAX_LOAD_FACTOR) + 1;                                              \
+        capacity = capacity < POINTER_HASHSET_MIN_CAPACITY ? POINTER_HASHSET_MIN_CAPACITY : capacity;                           \
+                                                                                                                                \
+        if (capacity < hashset->capacity) return POINTER_HASHSET_##K##_resize(hashset, capacity);                               \
+        if (hashset->tombstones == 0) return 1;                                                                                 \
+        return POINTER_HASHSET_##K##_rehash(hashset);                                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
     u8 POINTER_HASHSET_##K##_quick_add(POINTER_HASHSET_##K* hashset, const u32 hash, K* key) {                                  \
         if (hashset == NULL) return 0;                                                                                          \
                                                                                                                                 \
-        if ((hashset->size + 0.0) / hashset->capacity >= POINTER_HASHSET_MAX_LOAD_FACTOR) {                                     \
-            const u8 r = POINTER_HASHSET_##K##_grow(hashset);                                                                   \
+        if ((hashset->size + hashset->tombstones + 0.0) / hashset->capacity >= POINTER_HASHSET_MAX_LOAD_FACTOR) {               \
+            const u8 purge = (hashset->size + 0.0) / hashset->capacity < POINTER_HASHSET_MIN_LOAD_FACTOR;                       \
+            const u8 r = purge == 1 ? POINTER_HASHSET_##K##_rehash(hashset) : POINTER_HASHSET_##K##_grow(hashset);              \
             if (r == 0) return 0;                                                                                               \
         }                                                                                                                       \
                                                                                                                                 \
@@ -169,17 +350,21 @@
             POINTER_HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                            \
             const u8 status = entry->status;                                                                                    \
                                                                                                                                 \
-            if (status == POINTER_HASHSET_ENTRY_STATUS_EMPTY || status == POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE) {             \
-                found_entry = entry;                                                                                            \
+            if (status == POINTER_HASHSET_ENTRY_STATUS_EMPTY) {                                                                 \
+                if (found_entry == NULL) found_entry = entry;                                                                   \
                 break;                                                                                                          \
             }                                                                                                                   \
                                                                                                                                 \
-            const u8 equal = hashset->key_equal(entry->key, key);                                                               \
-            if (equal == 1) break;                                                                                              \
+            if (status == POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE) {                                                             \
+                if (found_entry == NULL) found_entry = entry;                                                                   \
+            }                                                                                                                   \
+            else if (entry->hash == hash && POINTER_HASHSET_##K##_key_equal(hashset, entry->key, key) == 1) return 0;           \
+                                                                                                                                \
             i = (i + 1) % hashset->capacity;                                                                                    \
         } while (i != hash % hashset->capacity);                                                                                \
                                                                                                                                 \
         if (found_entry == NULL) return 0;                                                                                      \
+        if (found_entry->status == POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE) hashset->tombstones--;                               \
                                                                                                                                 \
         found_entry->status = POINTER_HASHSET_ENTRY_STATUS_FILLED;                                                              \
         found_entry->hash = hash;                                                                                               \
@@ -192,8 +377,7 @@
     u8 POINTER_HASHSET_##K##_add(POINTER_HASHSET_##K* hashset, K* key) {                                                        \
         if (hashset == NULL) return 0;                                                                                          \
                                                                                                                                 \
-        const u32 key_size = hashset->key_size(key);                                                                            \
-        const u32 hash = HASH_fnv1a((u8*)key, key_size);                                                                        \
+        const u32 hash = POINTER_HASHSET_##K##_key_hash(hashset, key);                                                          \
                                                                                                                                 \
         return POINTER_HASHSET_##K##_quick_add(hashset, hash, key);                                                             \
     }                                                                                                                           \
@@ -210,10 +394,6 @@
         hashset->tombstones++;                                                                                                  \
     }                                                                                                                           \
                                                                                                                                 \
-    u32 POINTER_HASHSET_##K##_hash(const u8* data, const u32 size) {                                                            \
-        return HASH_fnv1a(data, size);                                                                                          \
-    }                                                                                                                           \
-                                                                                                                                \
     u8 POINTER_HASHSET_##K##_contains(const POINTER_HASHSET_##K* hashset, const K* key) {                                       \
         if (hashset == NULL) return 0;                                                                                          \
                                                                                                                                 \
@@ -225,8 +405,23 @@
     POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find(const POINTER_HASHSET_##K* hashset, const K* key) {                   \
         if (hashset == NULL) return NULL;                                                                                       \
                                                                                                                                 \
-        const u32 key_size = hashset->key_size(key);                                                                            \
-        const u32 hash = HASH_fnv1a((u8*)key, key_size);                                                                        \
+        const u32 hash = POINTER_HASHSET_##K##_key_hash(hashset, key);                                                          \
+                                                                                                                                \
+        return POINTER_HASHSET_##K##_find_hashed(hashset, hash, key);                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 POINTER_HASHSET_##K##_contains_hashed(const POINTER_HASHSET_##K* hashset, const u32 hash, const K* key) {                \
+        if (hashset == NULL) return 0;                                                                                          \
+                                                                                                                                \
+        const POINTER_HASHSET_ENTRY_##K* entry = POINTER_HASHSET_##K##_find_hashed(hashset, hash, key);                         \
+        if (entry == NULL) return 0;                                                                                            \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find_hashed(const POINTER_HASHSET_##K* hashset,                            \
+        const u32 hash, const K* key) {                                                                                         \
+                                                                                                                                \
+        if (hashset == NULL) return NULL;                                                                                       \
                                                                                                                                 \
         u32 i = hash % hashset->capacity;                                                                                       \
                                                                                                                                 \
@@ -243,13 +438,261 @@
                 continue;                                                                                                       \
             }                                                                                                                   \
                                                                                                                                 \
-            const u8 equal = hashset->key_equal(entry->key, key);                                                               \
+            const u8 equal = POINTER_HASHSET_##K##_key_equal(hashset, entry->key, key);                                         \
             if (equal == 1) break;                                                                                              \
             i = (i + 1) % hashset->capacity;                                                                                    \
         } while (i != hash % hashset->capacity);                                                                                \
                                                                                                                                 \
         if (status == POINTER_HASHSET_ENTRY_STATUS_FILLED) return entry;                                                        \
         return NULL;                                                                                                            \
+    }                                                                                                                           \
+                                                                                                                                \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_union(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {              \
+        if (a == NULL || b == NULL) return NULL;                                                                                \
+                                                                                                                                \
+        const u32 capacity = POINTER_HASHSET_capacity_for(a->size + (f64)b->size);                                              \
+        POINTER_HASHSET_##K* c = POINTER_HASHSET_##K##_create_allocator(capacity, a->key_size, a->key_equal,                    \
+            a->allocator);                                                                                                      \
+        if (c == NULL) return NULL;                                                                                             \
+                                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                                              \
+            const POINTER_HASHSET_ENTRY_##K entry = a->entries[ai];                                                             \
+            if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED)                                                            \
+                POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                      \
+        }                                                                                                                       \
+                                                                                                                                \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                                              \
+            const POINTER_HASHSET_ENTRY_##K entry = b->entries[bi];                                                             \
+            if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED)                                                            \
+                POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                      \
+        }                                                                                                                       \
+                                                                                                                                \
+        return c;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_intersection(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {       \
+        if (a == NULL || b == NULL) return NULL;                                                                                \
+                                                                                                                                \
+        const POINTER_HASHSET_##K* smaller;                                                                                     \
+        const POINTER_HASHSET_##K* larger;                                                                                      \
+        if (a->capacity < b->capacity) {                                                                                        \
+            smaller = a;                                                                                                        \
+            larger = b;                                                                                                         \
+        }                                                                                                                       \
+        else {                                                                                                                  \
+            smaller = b;                                                                                                        \
+            larger = a;                                                                                                         \
+        }                                                                                                                       \
+                                                                                                                                \
+        const u32 capacity = POINTER_HASHSET_capacity_for(a->size < b->size ? a->size : b->size);                               \
+        POINTER_HASHSET_##K* c = POINTER_HASHSET_##K##_create_allocator(capacity, a->key_size, a->key_equal,                    \
+            a->allocator);                                                                                                      \
+        if (c == NULL) return NULL;                                                                                             \
+                                                                                                                                \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                                           \
+            const POINTER_HASHSET_ENTRY_##K entry = smaller->entries[i];                                                        \
+            if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED) {                                                          \
+                if (POINTER_HASHSET_##K##_contains_hashed(larger, entry.hash, entry.key) == 1) {                                \
+                    POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                  \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        return c;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_difference(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {         \
+        if (a == NULL || b == NULL) return NULL;                                                                                \
+                                                                                                                                \
+        const u32 capacity = POINTER_HASHSET_capacity_for(a->size);                                                             \
+        POINTER_HASHSET_##K* c = POINTER_HASHSET_##K##_create_allocator(capacity, a->key_size, a->key_equal,                    \
+            a->allocator);                                                                                                      \
+        if (c == NULL) return NULL;                                                                                             \
+                                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                                              \
+            const POINTER_HASHSET_ENTRY_##K entry = a->entries[ai];                                                             \
+            if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED) {                                                          \
+                if (POINTER_HASHSET_##K##_contains_hashed(b, entry.hash, entry.key) == 0) {                                     \
+                    POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                  \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        return c;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    static void POINTER_HASHSET_##K##_erase(POINTER_HASHSET_##K* hashset, POINTER_HASHSET_ENTRY_##K* entry) {                   \
+        memset(entry, 0, sizeof(POINTER_HASHSET_ENTRY_##K));                                                                    \
+        entry->status = POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE;                                                                 \
+        hashset->size--;                                                                                                        \
+        hashset->tombstones++;                                                                                                  \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 POINTER_HASHSET_##K##_union_into(POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                                \
+        if (a == NULL || b == NULL || a == b) return 0;                                                                         \
+                                                                                                                                \
+        u32 added = 0;                                                                                                          \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                                              \
+            const POINTER_HASHSET_ENTRY_##K* entry = b->entries + bi;                                                           \
+            if (entry->status == POINTER_HASHSET_ENTRY_STATUS_FILLED)                                                           \
+                added += POINTER_HASHSET_##K##_quick_add(a, entry->hash, entry->key);                                           \
+        }                                                                                                                       \
+                                                                                                                                \
+        return added;                                                                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 POINTER_HASHSET_##K##_intersect_inplace(POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                         \
+        if (a == NULL || b == NULL || a == b) return 0;                                                                         \
+                                                                                                                                \
+        u32 removed = 0;                                                                                                        \
+        for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {                                                               \
+            POINTER_HASHSET_ENTRY_##K* entry = a->entries + ai;                                                                 \
+            if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;                                                 \
+            if (POINTER_HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 1) continue;                               \
+                                                                                                                                \
+            POINTER_HASHSET_##K##_erase(a, entry);                                                                              \
+            removed++;                                                                                                          \
+        }                                                                                                                       \
+                                                                                                                                \
+        return removed;                                                                                                         \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 POINTER_HASHSET_##K##_subtract_inplace(POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                          \
+        if (a == NULL || b == NULL) return 0;                                                                                   \
+                                                                                                                                \
+        u32 removed = 0;                                                                                                        \
+        if (a != b && b->capacity < a->capacity) {                                                                              \
+            for (u32 bi = 0; bi < b->capacity && a->size > 0; bi++) {                                                           \
+                const POINTER_HASHSET_ENTRY_##K* entry = b->entries + bi;                                                       \
+                if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;                                             \
+                                                                                                                                \
+                POINTER_HASHSET_ENTRY_##K* found = POINTER_HASHSET_##K##_find_hashed(a, entry->hash, entry->key);               \
+                if (found == NULL) continue;                                                                                    \
+                                                                                                                                \
+                POINTER_HASHSET_##K##_erase(a, found);                                                                          \
+                removed++;                                                                                                      \
+            }                                                                                                                   \
+                                                                                                                                \
+            return removed;                                                                                                     \
+        }                                                                                                                       \
+                                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {                                                               \
+            POINTER_HASHSET_ENTRY_##K* entry = a->entries + ai;                                                                 \
+            if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;                                                 \
+            if (a != b && POINTER_HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 0) continue;                     \
+                                                                                                                                \
+            POINTER_HASHSET_##K##_erase(a, entry);                                                                              \
+            removed++;                                                                                                          \
+        }                                                                                                                       \
+                                                                                                                                \
+        return removed;                                                                                                         \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 POINTER_HASHSET_##K##_intersection_size(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                   \
+        if (a == NULL || b == NULL) return 0;                                                                                   \
+        if (a == b) return a->size;                                                                                             \
+                                                                                                                                \
+        const POINTER_HASHSET_##K* smaller = a->capacity < b->capacity ? a : b;                                                 \
+        const POINTER_HASHSET_##K* larger = a->capacity < b->capacity ? b : a;                                                  \
+                                                                                                                                \
+        u32 count = 0;                                                                                                          \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                                           \
+            const POINTER_HASHSET_ENTRY_##K* entry = smaller->entries + i;                                                      \
+            if (entry->status == POINTER_HASHSET_ENTRY_STATUS_FILLED)                                                           \
+                count += POINTER_HASHSET_##K##_contains_hashed(larger, entry->hash, entry->key);                                \
+        }                                                                                                                       \
+                                                                                                                                \
+        return count;                                                                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 POINTER_HASHSET_##K##_union_size(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                          \
+        if (a == NULL || b == NULL) return 0;                                                                                   \
+                                                                                                                                \
+        return a->size + b->size - POINTER_HASHSET_##K##_intersection_size(a, b);                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 POINTER_HASHSET_##K##_difference_size(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                     \
+        if (a == NULL || b == NULL) return 0;                                                                                   \
+                                                                                                                                \
+        return a->size - POINTER_HASHSET_##K##_intersection_size(a, b);                                                         \
+    }                                                                                                                           \
+                                                                                                                                \
+    void POINTER_HASHSET_##K##_iterate(POINTER_HASHSET_ITERATOR_##K* iterator, const POINTER_HASHSET_##K* hashset) {            \
+        if (iterator == NULL) return;                                                                                           \
+                                                                                                                                \
+        iterator->a = hashset;                                                                                                  \
+        iterator->b = NULL;                                                                                                     \
+        iterator->index = 0;                                                                                                    \
+        iterator->mode = POINTER_HASHSET_ITERATE_ALL;                                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
+    void POINTER_HASHSET_##K##_iterate_union(POINTER_HASHSET_ITERATOR_##K* iterator,                                            \
+        const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                                                           \
+                                                                                                                                \
+        if (iterator == NULL) return;                                                                                           \
+                                                                                                                                \
+        iterator->a = a;                                                                                                        \
+        iterator->b = b;                                                                                                        \
+        iterator->index = 0;                                                                                                    \
+        iterator->mode = a == b ? POINTER_HASHSET_ITERATE_ALL : POINTER_HASHSET_ITERATE_UNION;                                  \
+        if (b == NULL) iterator->a = NULL;                                                                                      \
+    }                                                                                                                           \
+                                                                                                                                \
+    void POINTER_HASHSET_##K##_iterate_intersection(POINTER_HASHSET_ITERATOR_##K* iterator,                                     \
+        const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                                                           \
+                                                                                                                                \
+        if (iterator == NULL) return;                                                                                           \
+                                                                                                                                \
+        iterator->a = a != NULL && b != NULL && b->capacity < a->capacity ? b : a;                                              \
+        iterator->b = iterator->a == a ? b : a;                                                                                 \
+        iterator->index = 0;                                                                                                    \
+        iterator->mode = POINTER_HASHSET_ITERATE_INTERSECTION;                                                                  \
+        if (iterator->b == NULL) iterator->a = NULL;                                                                            \
+    }                                                                                                                           \
+                                                                                                                                \
+    void POINTER_HASHSET_##K##_iterate_difference(POINTER_HASHSET_ITERATOR_##K* iterator,                                       \
+        const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                                                           \
+                                                                                                                                \
+        if (iterator == NULL) return;                                                                                           \
+                                                                                                                                \
+        iterator->a = a == b ? NULL : a;                                                                                        \
+        iterator->b = b;                                                                                                        \
+        iterator->index = 0;                                                                                                    \
+        iterator->mode = POINTER_HASHSET_ITERATE_DIFFERENCE;                                                                    \
+        if (b == NULL) iterator->a = NULL;                                                                                      \
+    }                                                                                                                           \
+                                                                                                                                \
+    const POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_next(POINTER_HASHSET_ITERATOR_##K* iterator) {                       \
+        if (iterator == NULL || iterator->a == NULL) return NULL;                                                               \
+                                                                                                                                \
+        const POINTER_HASHSET_##K* a = iterator->a;                                                                             \
+        const POINTER_HASHSET_##K* b = iterator->b;                                                                             \
+                                                                                                                                \
+        for (; iterator->index < a->capacity; iterator->index++) {                                                              \
+            const POINTER_HASHSET_ENTRY_##K* entry = a->entries + iterator->index;                                              \
+            if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;                                                 \
+                                                                                                                                \
+            if (iterator->mode == POINTER_HASHSET_ITERATE_INTERSECTION &&                                                       \
+                POINTER_HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 0) continue;                               \
+            if (iterator->mode == POINTER_HASHSET_ITERATE_DIFFERENCE &&                                                         \
+                POINTER_HASHSET_##K##_contains_hashed(b, entry->hash, entry->key) == 1) continue;                               \
+                                                                                                                                \
+            iterator->index++;                                                                                                  \
+            return entry;                                                                                                       \
+        }                                                                                                                       \
+                                                                                                                                \
+        if (iterator->mode != POINTER_HASHSET_ITERATE_UNION) return NULL;                                                       \
+                                                                                                                                \
+        for (; iterator->index - a->capacity < b->capacity; iterator->index++) {                                                \
+            const POINTER_HASHSET_ENTRY_##K* entry = b->entries + (iterator->index - a->capacity);                              \
+            if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;                                                 \
+            if (POINTER_HASHSET_##K##_contains_hashed(a, entry->hash, entry->key) == 1) continue;                               \
+                                                                                                                                \
+            iterator->index++;                                                                                                  \
+            return entry;                                                                                                       \
+        }                                                                                                                       \
+                                                                                                                                \
+        return NULL;                                                                                                            \
     }
 
 #endif // NESQUIK_POINTER_HASHSET_H
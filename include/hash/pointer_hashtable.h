@@ -5,11 +5,14 @@
 #include <stdlib.h>
 
 #include "types.h"
+#include "allocator.h"
 #include "hash/hash.h"
 
 #define POINTER_HASHTABLE_ENTRY_STATUS_EMPTY        0
 #define POINTER_HASHTABLE_ENTRY_STATUS_FILLED       1
 #define POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE    2
+// Marks entries still to be moved while _rehash purges tombstones in place
+#define POINTER_HASHTABLE_ENTRY_STATUS_DISPLACED    3
 
 #define POINTER_HASHTABLE_MIN_LOAD_FACTOR           0.5
 #define POINTER_HASHTABLE_MAX_LOAD_FACTOR           0.75
@@ -17,7 +20,7 @@
 #define POINTER_HASHTABLE_MIN_CAPACITY              8
 
 #pragma pack(push, 1)
-#define POINTER_HASHTABLE_DECLARE(K, V)                                                                                                     \
+#define POINTER_HASHTABLE_DECLARE_TYPES(K, V)                                                                                               \
     typedef struct POINTER_HASHTABLE_ENTRY_##K##_##V {                                                                                      \
         u8 status;                                                                                                                          \
         u32 hash;                                                                                                                           \
@@ -33,35 +36,110 @@
                                                                                                                                             \
         u32 (*key_size)(const K*);                                                                                                          \
         u8 (*key_equal)(const K*, const K*);                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator;                                                                                                 \
     } POINTER_HASHTABLE_##K##_##V;                                                                                                          \
                                                                                                                                             \
     u8 POINTER_HASHTABLE_##K##_##V##_init(POINTER_HASHTABLE_##K##_##V* hashtable,                                                           \
         u32 capacity,                                                                                                                       \
         u32 (*key_size)(const K*),                                                                                                          \
         u8 (*key_equal)(const K*, const K*));                                                                                               \
+    u8 POINTER_HASHTABLE_##K##_##V##_init_allocator(POINTER_HASHTABLE_##K##_##V* hashtable,                                                 \
+        u32 capacity,                                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                                \
     POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create(u32 capacity,                                                         \
         u32 (*key_size)(const K*),                                                                                                          \
         u8 (*key_equal)(const K*, const K*));                                                                                               \
+    POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create_allocator(u32 capacity,                                               \
+        u32 (*key_size)(const K*),                                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                                \
                                                                                                                                             \
     void POINTER_HASHTABLE_##K##_##V##_deinit(POINTER_HASHTABLE_##K##_##V* hashtable);                                                      \
     void POINTER_HASHTABLE_##K##_##V##_destroy(POINTER_HASHTABLE_##K##_##V* hashtable);                                                     \
                                                                                                                                             \
     u8 POINTER_HASHTABLE_##K##_##V##_grow(POINTER_HASHTABLE_##K##_##V* hashtable);                                                          \
+    u8 POINTER_HASHTABLE_##K##_##V##_resize(POINTER_HASHTABLE_##K##_##V* hashtable, u32 capacity);                                          \
+    u8 POINTER_HASHTABLE_##K##_##V##_rehash(POINTER_HASHTABLE_##K##_##V* hashtable);                                                        \
+    u8 POINTER_HASHTABLE_##K##_##V##_reserve(POINTER_HASHTABLE_##K##_##V* hashtable, u32 n);                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_shrink_to_fit(POINTER_HASHTABLE_##K##_##V* hashtable);                                                 \
     u8 POINTER_HASHTABLE_##K##_##V##_add(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, V value);                                          \
     u8 POINTER_HASHTABLE_##K##_##V##_quick_add(POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash, K* key, V value);                          \
+    u8 POINTER_HASHTABLE_##K##_##V##_upsert(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, V value);                                       \
+    u8 POINTER_HASHTABLE_##K##_##V##_quick_upsert(POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash, K* key, V value);                       \
+    V* POINTER_HASHTABLE_##K##_##V##_get_or_insert(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, u8* inserted);                           \
+    V* POINTER_HASHTABLE_##K##_##V##_quick_get_or_insert(POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash, K* key, u8* inserted);           \
     void POINTER_HASHTABLE_##K##_##V##_remove(POINTER_HASHTABLE_##K##_##V* hashtable, const K* key);                                        \
                                                                                                                                             \
-    u32 POINTER_HASHTABLE_##K##_##V##_hash(const u8* data, u32 size);                                                                       \
-                                                                                                                                            \
     u8 POINTER_HASHTABLE_##K##_##V##_contains(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key);                                  \
-    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key);
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key);      \
+    u8 POINTER_HASHTABLE_##K##_##V##_contains_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash, const K* key);                 \
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable,              \
+        u32 hash, const K* key);
 #pragma pack(pop)
 
+// Hashes the key_size bytes behind the key with one of the hash.h kernels and compares keys with key_equal,
+// both called through the function pointers given to _init
+#define POINTER_HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)                                                                                \
+    static inline u32 POINTER_HASHTABLE_##K##_##V##_hash(const u8* data, const u32 size) {                                              \
+        return HASH_F(data, size);                                                                                                      \
+    }                                                                                                                                   \
+                                                                                                                                        \
+    static inline u32 POINTER_HASHTABLE_##K##_##V##_key_hash(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {              \
+        return HASH_F((const u8*)key, hashtable->key_size(key));                                                                        \
+    }                                                                                                                                   \
+                                                                                                                                        \
+    static inline u8 POINTER_HASHTABLE_##K##_##V##_key_equal(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* a, const K* b) {    \
+        return hashtable->key_equal(a, b);                                                                                              \
+    }
+
+// Bakes a user hash (u32 HASH_FN(const K*)) and equality (u8 EQ_FN(const K*, const K*)) into the generated
+// functions, key_size and key_equal are then never called and may be NULL. The byte helper _hash stays on
+// HASH_fnv1a, so both key modes emit the same functions.
+#define POINTER_HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)                                                                          \
+    static inline u32 POINTER_HASHTABLE_##K##_##V##_hash(const u8* data, const u32 size) {                                              \
+        return HASH_fnv1a(data, size);                                                                                                  \
+    }                                                                                                                                   \
+                                                                                                                                        \
+    static inline u32 POINTER_HASHTABLE_##K##_##V##_key_hash(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {              \
+        (void)hashtable;                                                                                                                \
+        return HASH_FN(key);                                                                                                            \
+    }                                                                                                                                   \
+                                                                                                                                        \
+    static inline u8 POINTER_HASHTABLE_##K##_##V##_key_equal(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* a, const K* b) {    \
+        (void)hashtable;                                                                                                                \
+        return EQ_FN(a, b) ? 1 : 0;                                                                                                     \
+    }
+
+#define POINTER_HASHTABLE_DECLARE_HASH(K, V, HASH_F)    \
+    POINTER_HASHTABLE_DECLARE_TYPES(K, V)               \
+    POINTER_HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define POINTER_HASHTABLE_DECLARE_EX(K, V, HASH_FN, EQ_FN)      \
+    POINTER_HASHTABLE_DECLARE_TYPES(K, V)                       \
+    POINTER_HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+// Interned keys, one object per distinct key like STATE: the address is the key, hashed and compared as is
+#define POINTER_HASHTABLE_DECLARE_IDENTITY(K, V) POINTER_HASHTABLE_DECLARE_EX(K, V, HASH_pointer, HASH_EQUAL)
+
+// Instantiations pick their hash kernel with POINTER_HASHTABLE_DECLARE_HASH, FNV-1a by default
+#define POINTER_HASHTABLE_DECLARE(K, V) POINTER_HASHTABLE_DECLARE_HASH(K, V, HASH_fnv1a)
+
 #define POINTER_HASHTABLE_DEFINE(K, V)                                                                                                      \
     u8 POINTER_HASHTABLE_##K##_##V##_init(POINTER_HASHTABLE_##K##_##V* hashtable,                                                           \
-                      const u32 capacity,                                                                                                   \
-                      u32 (*key_size)(const K*),                                                                                            \
-                      u8 (*key_equal)(const K*, const K*)) {                                                                                \
+        const u32 capacity,                                                                                                                 \
+        u32 (*key_size)(const K*),                                                                                                          \
+        u8 (*key_equal)(const K*, const K*)) {                                                                                              \
+                                                                                                                                            \
+        return POINTER_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, key_size, key_equal, NULL);                                \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_init_allocator(POINTER_HASHTABLE_##K##_##V* hashtable,                                                 \
+        const u32 capacity,                                                                                                                 \
+        u32 (*key_size)(const K*),                                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                               \
                                                                                                                                             \
         if (hashtable == NULL) return 0;                                                                                                    \
                                                                                                                                             \
@@ -71,14 +149,16 @@
                                                                                                                                             \
         hashtable->key_size = key_size;                                                                                                     \
         hashtable->key_equal = key_equal;                                                                                                   \
+        hashtable->allocator = allocator;                                                                                                   \
                                                                                                                                             \
-        hashtable->entries = (POINTER_HASHTABLE_ENTRY_##K##_##V*)malloc(sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V) * capacity);              \
+        hashtable->entries = (POINTER_HASHTABLE_ENTRY_##K##_##V*)NESQUIK_alloc(allocator,                                                   \
+            sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                                                               \
         if (hashtable->entries == NULL) {                                                                                                   \
             hashtable->capacity = 0;                                                                                                        \
             return 0;                                                                                                                       \
         }                                                                                                                                   \
                                                                                                                                             \
-        memset(hashtable->entries, 0, sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V) * capacity);                                                \
+        memset(hashtable->entries, 0, sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                                     \
                                                                                                                                             \
         return 1;                                                                                                                           \
     }                                                                                                                                       \
@@ -87,12 +167,22 @@
         u32 (*key_size)(const K*),                                                                                                          \
         u8 (*key_equal)(const K*, const K*)) {                                                                                              \
                                                                                                                                             \
-        POINTER_HASHTABLE_##K##_##V* hashtable = (POINTER_HASHTABLE_##K##_##V*)malloc(sizeof(POINTER_HASHTABLE_##K##_##V));                 \
+        return POINTER_HASHTABLE_##K##_##V##_create_allocator(capacity, key_size, key_equal, NULL);                                         \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                         \
+        u32 (*key_size)(const K*),                                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                               \
+                                                                                                                                            \
+        POINTER_HASHTABLE_##K##_##V* hashtable = (POINTER_HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                     \
+            sizeof(POINTER_HASHTABLE_##K##_##V));                                                                                           \
         if (hashtable == NULL) return NULL;                                                                                                 \
                                                                                                                                             \
-        const u8 r = POINTER_HASHTABLE_##K##_##V##_init(hashtable, capacity, key_size, key_equal);                                          \
+        const u8 r = POINTER_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, key_size, key_equal,                                 \
+            allocator);                                                                                                                     \
         if (r == 0) {                                                                                                                       \
-            free(hashtable);                                                                                                                \
+            NESQUIK_free(allocator, hashtable);                                                                                             \
             return NULL;                                                                                                                    \
         }                                                                                                                                   \
                                                                                                                                             \
@@ -109,7 +199,7 @@
         hashtable->key_equal = NULL;                                                                                                        \
                                                                                                                                             \
         if (hashtable->entries != NULL) {                                                                                                   \
-            free(hashtable->entries);                                                                                                       \
+            NESQUIK_free(hashtable->allocator, hashtable->entries);                                                                         \
             hashtable->entries = NULL;                                                                                                      \
         }                                                                                                                                   \
     }                                                                                                                                       \
@@ -117,8 +207,9 @@
     void POINTER_HASHTABLE_##K##_##V##_destroy(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                    \
         if (hashtable == NULL) return;                                                                                                      \
                                                                                                                                             \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                                          \
         POINTER_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                                    \
-        free(hashtable);                                                                                                                    \
+        NESQUIK_free(allocator, hashtable);                                                                                                 \
     }                                                                                                                                       \
                                                                                                                                             \
     u8 POINTER_HASHTABLE_##K##_##V##_grow(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                         \
@@ -127,8 +218,15 @@
         u32 new_capacity = (u32)(hashtable->capacity * POINTER_HASHTABLE_MAX_LOAD_FACTOR / POINTER_HASHTABLE_MIN_LOAD_FACTOR);              \
         new_capacity = (new_capacity > hashtable->capacity) ? new_capacity : hashtable->capacity;                                           \
                                                                                                                                             \
+        return POINTER_HASHTABLE_##K##_##V##_resize(hashtable, new_capacity);                                                               \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_resize(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 new_capacity) {                               \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
         POINTER_HASHTABLE_##K##_##V new_hashtable;                                                                                          \
-        u8 r = POINTER_HASHTABLE_##K##_##V##_init(&new_hashtable, new_capacity, hashtable->key_size, hashtable->key_equal);                 \
+        u8 r = POINTER_HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, new_capacity, hashtable->key_size,                              \
+            hashtable->key_equal, hashtable->allocator);                                                                                    \
         if (r == 0) return 0;                                                                                                               \
                                                                                                                                             \
         for (u32 i = 0; i < hashtable->capacity; i++) {                                                                                     \
@@ -143,20 +241,76 @@
             }                                                                                                                               \
         }                                                                                                                                   \
                                                                                                                                             \
-        free(hashtable->entries);                                                                                                           \
+        NESQUIK_free(hashtable->allocator, hashtable->entries);                                                                             \
         hashtable->entries = new_hashtable.entries;                                                                                         \
-        hashtable->capacity = new_capacity;                                                                                                 \
+        hashtable->capacity = new_hashtable.capacity;                                                                                       \
         hashtable->tombstones = 0;                                                                                                          \
                                                                                                                                             \
         return 1;                                                                                                                           \
     }                                                                                                                                       \
                                                                                                                                             \
-    u8 POINTER_HASHTABLE_##K##_##V##_quick_add(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, K* key, V value) {                   \
+    u8 POINTER_HASHTABLE_##K##_##V##_rehash(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                       \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                                     \
+            POINTER_HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                              \
+            if (entry->status == POINTER_HASHTABLE_ENTRY_STATUS_FILLED) entry->status = POINTER_HASHTABLE_ENTRY_STATUS_DISPLACED;           \
+            else memset(entry, 0, sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V));                                                               \
+        }                                                                                                                                   \
+                                                                                                                                            \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                                     \
+            if (hashtable->entries[i].status != POINTER_HASHTABLE_ENTRY_STATUS_DISPLACED) continue;                                         \
+                                                                                                                                            \
+            POINTER_HASHTABLE_ENTRY_##K##_##V moving = hashtable->entries[i];                                                               \
+            memset(hashtable->entries + i, 0, sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V));                                                   \
+                                                                                                                                            \
+            for (;;) {                                                                                                                      \
+                u32 j = moving.hash % hashtable->capacity;                                                                                  \
+                while (hashtable->entries[j].status == POINTER_HASHTABLE_ENTRY_STATUS_FILLED)                                               \
+                    j = (j + 1) % hashtable->capacity;                                                                                      \
+                                                                                                                                            \
+                const POINTER_HASHTABLE_ENTRY_##K##_##V displaced = hashtable->entries[j];                                                  \
+                hashtable->entries[j] = moving;                                                                                             \
+                hashtable->entries[j].status = POINTER_HASHTABLE_ENTRY_STATUS_FILLED;                                                       \
+                                                                                                                                            \
+                if (displaced.status == POINTER_HASHTABLE_ENTRY_STATUS_EMPTY) break;                                                        \
+                moving = displaced;                                                                                                         \
+            }                                                                                                                               \
+        }                                                                                                                                   \
+                                                                                                                                            \
+        hashtable->tombstones = 0;                                                                                                          \
+        return 1;                                                                                                                           \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_reserve(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 n) {                                         \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
+        const u32 capacity = (u32)(n / POINTER_HASHTABLE_MAX_LOAD_FACTOR) + 1;                                                              \
+        if (capacity <= hashtable->capacity) return 1;                                                                                      \
+                                                                                                                                            \
+        return POINTER_HASHTABLE_##K##_##V##_resize(hashtable, capacity);                                                                   \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_shrink_to_fit(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                \
         if (hashtable == NULL) return 0;                                                                                                    \
                                                                                                                                             \
-        if ((hashtable->size + 0.0) / hashtable->capacity >= POINTER_HASHTABLE_MAX_LOAD_FACTOR) {                                           \
-            const u8 r = POINTER_HASHTABLE_##K##_##V##_grow(hashtable);                                                                     \
-            if (r == 0) return 0;                                                                                                           \
+        u32 capacity = (u32)(hashtable->size / POINTER_HASHTABLE_MAX_LOAD_FACTOR) + 1;                                                      \
+        capacity = capacity < POINTER_HASHTABLE_MIN_CAPACITY ? POINTER_HASHTABLE_MIN_CAPACITY : capacity;                                   \
+                                                                                                                                            \
+        if (capacity < hashtable->capacity) return POINTER_HASHTABLE_##K##_##V##_resize(hashtable, capacity);                               \
+        if (hashtable->tombstones == 0) return 1;                                                                                           \
+        return POINTER_HASHTABLE_##K##_##V##_rehash(hashtable);                                                                             \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    V* POINTER_HASHTABLE_##K##_##V##_quick_get_or_insert(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, K* key,                    \
+        u8* inserted) {                                                                                                                     \
+                                                                                                                                            \
+        if (hashtable == NULL) return NULL;                                                                                                 \
+                                                                                                                                            \
+        if ((hashtable->size + hashtable->tombstones + 0.0) / hashtable->capacity >= POINTER_HASHTABLE_MAX_LOAD_FACTOR) {                   \
+            const u8 purge = (hashtable->size + 0.0) / hashtable->capacity < POINTER_HASHTABLE_MIN_LOAD_FACTOR;                             \
+            const u8 r = purge == 1 ? POINTER_HASHTABLE_##K##_##V##_rehash(hashtable) : POINTER_HASHTABLE_##K##_##V##_grow(hashtable);      \
+            if (r == 0) return NULL;                                                                                                        \
         }                                                                                                                                   \
                                                                                                                                             \
         u32 i = hash % hashtable->capacity;                                                                                                 \
@@ -166,36 +320,78 @@
             POINTER_HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                              \
             const u8 status = entry->status;                                                                                                \
                                                                                                                                             \
-            if (status == POINTER_HASHTABLE_ENTRY_STATUS_EMPTY || status == POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE) {                     \
-                found_entry = entry;                                                                                                        \
+            if (status == POINTER_HASHTABLE_ENTRY_STATUS_EMPTY) {                                                                           \
+                if (found_entry == NULL) found_entry = entry;                                                                               \
                 break;                                                                                                                      \
             }                                                                                                                               \
                                                                                                                                             \
-            const u8 equal = hashtable->key_equal(entry->key, key);                                                                         \
-            if (equal == 1) break;                                                                                                          \
+            if (status == POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE) {                                                                       \
+                if (found_entry == NULL) found_entry = entry;                                                                               \
+            }                                                                                                                               \
+            else if (entry->hash == hash && POINTER_HASHTABLE_##K##_##V##_key_equal(hashtable, entry->key, key) == 1) {                     \
+                if (inserted != NULL) *inserted = 0;                                                                                        \
+                return &entry->value;                                                                                                       \
+            }                                                                                                                               \
+                                                                                                                                            \
             i = (i + 1) % hashtable->capacity;                                                                                              \
         } while (i != hash % hashtable->capacity);                                                                                          \
                                                                                                                                             \
-        if (found_entry == NULL) return 0;                                                                                                  \
+        if (found_entry == NULL) return NULL;                                                                                               \
+        if (found_entry->status == POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE) hashtable->tombstones--;                                       \
                                                                                                                                             \
         found_entry->status = POINTER_HASHTABLE_ENTRY_STATUS_FILLED;                                                                        \
         found_entry->hash = hash;                                                                                                           \
         found_entry->key = key;                                                                                                             \
-        found_entry->value = value;                                                                                                         \
+        memset(&found_entry->value, 0, sizeof(V));                                                                                          \
                                                                                                                                             \
         hashtable->size++;                                                                                                                  \
+        if (inserted != NULL) *inserted = 1;                                                                                                \
+        return &found_entry->value;                                                                                                         \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_quick_add(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, K* key, V value) {                   \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
+        u8 inserted;                                                                                                                        \
+        V* value_slot = POINTER_HASHTABLE_##K##_##V##_quick_get_or_insert(hashtable, hash, key, &inserted);                                 \
+        if (value_slot == NULL || inserted == 0) return 0;                                                                                  \
+                                                                                                                                            \
+        *value_slot = value;                                                                                                                \
         return 1;                                                                                                                           \
     }                                                                                                                                       \
                                                                                                                                             \
     u8 POINTER_HASHTABLE_##K##_##V##_add(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, V value) {                                         \
         if (hashtable == NULL) return 0;                                                                                                    \
                                                                                                                                             \
-        const u32 key_size = hashtable->key_size(key);                                                                                      \
-        const u32 hash = HASH_fnv1a((u8*)key, key_size);                                                                                    \
+        const u32 hash = POINTER_HASHTABLE_##K##_##V##_key_hash(hashtable, key);                                                            \
                                                                                                                                             \
         return POINTER_HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                                        \
     }                                                                                                                                       \
                                                                                                                                             \
+    u8 POINTER_HASHTABLE_##K##_##V##_quick_upsert(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, K* key, const V value) {          \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
+        V* value_slot = POINTER_HASHTABLE_##K##_##V##_quick_get_or_insert(hashtable, hash, key, NULL);                                      \
+        if (value_slot == NULL) return 0;                                                                                                   \
+                                                                                                                                            \
+        *value_slot = value;                                                                                                                \
+        return 1;                                                                                                                           \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_upsert(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, const V value) {                                \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
+        const u32 hash = POINTER_HASHTABLE_##K##_##V##_key_hash(hashtable, key);                                                            \
+        return POINTER_HASHTABLE_##K##_##V##_quick_upsert(hashtable, hash, key, value);                                                     \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    V* POINTER_HASHTABLE_##K##_##V##_get_or_insert(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, u8* inserted) {                          \
+        if (hashtable == NULL) return NULL;                                                                                                 \
+                                                                                                                                            \
+        const u32 hash = POINTER_HASHTABLE_##K##_##V##_key_hash(hashtable, key);                                                            \
+        return POINTER_HASHTABLE_##K##_##V##_quick_get_or_insert(hashtable, hash, key, inserted);                                           \
+    }                                                                                                                                       \
+                                                                                                                                            \
     void POINTER_HASHTABLE_##K##_##V##_remove(POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {                                       \
         if (hashtable == NULL) return;                                                                                                      \
                                                                                                                                             \
@@ -208,10 +404,6 @@
         hashtable->tombstones++;                                                                                                            \
     }                                                                                                                                       \
                                                                                                                                             \
-    u32 POINTER_HASHTABLE_##K##_##V##_hash(const u8* data, const u32 size) {                                                                \
-        return HASH_fnv1a(data, size);                                                                                                      \
-    }                                                                                                                                       \
-                                                                                                                                            \
     u8 POINTER_HASHTABLE_##K##_##V##_contains(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {                                 \
         if (hashtable == NULL) return 0;                                                                                                    \
                                                                                                                                             \
@@ -223,8 +415,22 @@
     POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {     \
         if (hashtable == NULL) return NULL;                                                                                                 \
                                                                                                                                             \
-        const u32 key_size = hashtable->key_size(key);                                                                                      \
-        const u32 hash = HASH_fnv1a((u8*)key, key_size);                                                                                    \
+        const u32 hash = POINTER_HASHTABLE_##K##_##V##_key_hash(hashtable, key);                                                            \
+        return POINTER_HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                             \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_contains_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, const K* key) {          \
+        if (hashtable == NULL) return 0;                                                                                                    \
+                                                                                                                                            \
+        const POINTER_HASHTABLE_ENTRY_##K##_##V* entry = POINTER_HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                   \
+        if (entry == NULL) return 0;                                                                                                        \
+        return 1;                                                                                                                           \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable,              \
+        const u32 hash, const K* key) {                                                                                                     \
+                                                                                                                                            \
+        if (hashtable == NULL) return NULL;                                                                                                 \
                                                                                                                                             \
         u32 i = hash % hashtable->capacity;                                                                                                 \
                                                                                                                                             \
@@ -241,7 +447,7 @@
                 continue;                                                                                                                   \
             }                                                                                                                               \
                                                                                                                                             \
-            const u8 equal = hashtable->key_equal(entry->key, key);                                                                         \
+            const u8 equal = POINTER_HASHTABLE_##K##_##V##_key_equal(hashtable, entry->key, key);                                           \
             if (equal == 1) break;                                                                                                          \
             i = (i + 1) % hashtable->capacity;                                                                                              \
         } while (i != hash % hashtable->capacity);                                                                                          \
@@ -0,0 +1,337 @@
+#ifndef NESQUIK_ROBIN_HASHSET_H
+#define NESQUIK_ROBIN_HASHSET_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashset.h"
+#include "hash/robin_hood.h"
+
+// Robin Hood engine behind the HASHSET API. Swapping HASHSET_DECLARE/HASHSET_DEFINE for
+// HASHSET_DECLARE_ROBIN/HASHSET_DEFINE_ROBIN keeps every call site compiling.
+// Backward-shift deletion leaves no tombstones, the field is kept at 0 for code that reads it.
+#define HASHSET_DECLARE_ROBIN_TYPES(K)                                                              \
+    typedef struct HASHSET_ENTRY_##K {                                                              \
+        u32 distance;                                                                               \
+        u32 hash;                                                                                   \
+        K key;                                                                                      \
+    } HASHSET_ENTRY_##K;                                                                            \
+                                                                                                    \
+    typedef struct HASHSET_##K {                                                                    \
+        HASHSET_ENTRY_##K* entries;                                                                 \
+        u32 size;                                                                                   \
+        u32 capacity;                                                                               \
+        u32 tombstones;                                                                             \
+        const NESQUIK_ALLOCATOR* allocator;                                                         \
+    } HASHSET_##K;                                                                                  \
+                                                                                                    \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, u32 capacity);                                      \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, u32 capacity,                             \
+        const NESQUIK_ALLOCATOR* allocator);                                                        \
+    HASHSET_##K* HASHSET_##K##_create(u32 capacity);                                                \
+    HASHSET_##K* HASHSET_##K##_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);  \
+                                                                                                    \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset);                                                \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset);                                               \
+                                                                                                    \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset);                                                    \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, K key);                                              \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, u32 hash, K key);                              \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, K key);                                         \
+                                                                                                    \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, K key);                                   \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, K key);                       \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, u32 hash, K key);                  \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, u32 hash, K key);      \
+                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b);                   \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b);            \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b);
+
+#define HASHSET_DECLARE_ROBIN_HASH(K, HASH_F)       \
+    HASHSET_DECLARE_ROBIN_TYPES(K)                  \
+    HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define HASHSET_DECLARE_ROBIN_EX(K, HASH_FN, EQ_FN)     \
+    HASHSET_DECLARE_ROBIN_TYPES(K)                      \
+    HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+#define HASHSET_DECLARE_ROBIN(K) HASHSET_DECLARE_ROBIN_HASH(K, HASH_fnv1a)
+
+// Capacity is a power of two indexed with a mask. An insert takes the slot of any entry that sits closer
+// to its home than the incoming one, so a lookup can stop as soon as it meets such an entry, and a remove
+// shifts the following run back by one instead of leaving a tombstone.
+#define HASHSET_DEFINE_ROBIN(K)                                                                                 \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, const u32 capacity) {                                           \
+        return HASHSET_##K##_init_allocator(hashset, capacity, NULL);                                           \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, const u32 capacity,                                   \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                   \
+                                                                                                                \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        hashset->allocator = allocator;                                                                         \
+        hashset->size = 0;                                                                                      \
+        hashset->capacity = ROBIN_capacity(capacity);                                                           \
+        hashset->tombstones = 0;                                                                                \
+                                                                                                                \
+        hashset->entries = (HASHSET_ENTRY_##K*)NESQUIK_alloc(allocator,                                         \
+            sizeof(HASHSET_ENTRY_##K) * hashset->capacity);                                                     \
+        if (hashset->entries == NULL) {                                                                         \
+            hashset->capacity = 0;                                                                              \
+            return 0;                                                                                           \
+        }                                                                                                       \
+                                                                                                                \
+        memset(hashset->entries, 0, sizeof(HASHSET_ENTRY_##K) * hashset->capacity);                             \
+                                                                                                                \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_create(const u32 capacity) {                                                     \
+        return HASHSET_##K##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {       \
+        HASHSET_##K* hashset = (HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_##K));                     \
+        if (hashset == NULL) return NULL;                                                                       \
+                                                                                                                \
+        const u8 r = HASHSET_##K##_init_allocator(hashset, capacity, allocator);                                \
+        if (r == 0) {                                                                                           \
+            NESQUIK_free(allocator, hashset);                                                                   \
+            return NULL;                                                                                        \
+        }                                                                                                       \
+                                                                                                                \
+        return hashset;                                                                                         \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset) {                                                           \
+        if (hashset == NULL) return;                                                                            \
+        hashset->size = 0;                                                                                      \
+        hashset->capacity = 0;                                                                                  \
+        hashset->tombstones = 0;                                                                                \
+                                                                                                                \
+        if (hashset->entries != NULL) {                                                                         \
+            NESQUIK_free(hashset->allocator, hashset->entries);                                                 \
+            hashset->entries = NULL;                                                                            \
+        }                                                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset) {                                                          \
+        if (hashset == NULL) return;                                                                            \
+                                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                                \
+        HASHSET_##K##_deinit(hashset);                                                                          \
+        NESQUIK_free(allocator, hashset);                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    static void HASHSET_##K##_place(HASHSET_##K* hashset, HASHSET_ENTRY_##K incoming) {                         \
+        const u32 mask = hashset->capacity - 1;                                                                 \
+        u32 i = incoming.hash & mask;                                                                           \
+                                                                                                                \
+        incoming.distance = 1;                                                                                  \
+        for (;;) {                                                                                              \
+            HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                    \
+            if (entry->distance == ROBIN_DISTANCE_EMPTY) {                                                      \
+                *entry = incoming;                                                                              \
+                return;                                                                                         \
+            }                                                                                                   \
+                                                                                                                \
+            if (entry->distance < incoming.distance) {                                                          \
+                const HASHSET_ENTRY_##K displaced = *entry;                                                     \
+                *entry = incoming;                                                                              \
+                incoming = displaced;                                                                           \
+            }                                                                                                   \
+                                                                                                                \
+            incoming.distance++;                                                                                \
+            i = (i + 1) & mask;                                                                                 \
+        }                                                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset) {                                                               \
+        if (hashset == NULL) return 0;                                                                          \
+        if (hashset->capacity & 0x80000000) return 0;                                                           \
+                                                                                                                \
+        HASHSET_##K new_hashset;                                                                                \
+        const u8 r = HASHSET_##K##_init_allocator(&new_hashset, hashset->capacity << 1, hashset->allocator);    \
+        if (r == 0) return 0;                                                                                   \
+                                                                                                                \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                           \
+            const HASHSET_ENTRY_##K* entry = hashset->entries + i;                                              \
+            if (entry->distance != ROBIN_DISTANCE_EMPTY) HASHSET_##K##_place(&new_hashset, *entry);             \
+        }                                                                                                       \
+                                                                                                                \
+        NESQUIK_free(hashset->allocator, hashset->entries);                                                     \
+        hashset->entries = new_hashset.entries;                                                                 \
+        hashset->capacity = new_hashset.capacity;                                                               \
+                                                                                                                \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, const u32 hash, const K key) {                             \
+        if (hashset == NULL) return 0;                                                                          \
+        if (hashset->capacity == 0) return 0;                                                                   \
+                                                                                                                \
+        if (hashset->size + 1 > ROBIN_MAX_LOAD(hashset->capacity)) {                                            \
+            const u8 r = HASHSET_##K##_grow(hashset);                                                           \
+            if (r == 0) return 0;                                                                               \
+        }                                                                                                       \
+                                                                                                                \
+        const u32 mask = hashset->capacity - 1;                                                                 \
+        u32 i = hash & mask;                                                                                    \
+                                                                                                                \
+        for (u32 distance = 1; ; distance++) {                                                                  \
+            HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                    \
+            if (entry->distance < distance) break;                                                              \
+            if (entry->hash == hash && HASHSET_##K##_key_equal(entry->key, key) == 1) return 0;                 \
+            i = (i + 1) & mask;                                                                                 \
+        }                                                                                                       \
+                                                                                                                \
+        HASHSET_ENTRY_##K incoming;                                                                             \
+        incoming.hash = hash;                                                                                   \
+        incoming.key = key;                                                                                     \
+        HASHSET_##K##_place(hashset, incoming);                                                                 \
+                                                                                                                \
+        hashset->size++;                                                                                        \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, const K key) {                                                   \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
+        return HASHSET_##K##_quick_add(hashset, hash, key);                                                     \
+    }                                                                                                           \
+                                                                                                                \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, const K key) {                                              \
+        if (hashset == NULL) return;                                                                            \
+                                                                                                                \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find(hashset, key);                                      \
+        if (entry == NULL) return;                                                                              \
+                                                                                                                \
+        const u32 mask = hashset->capacity - 1;                                                                 \
+        u32 i = (u32)(entry - hashset->entries);                                                                \
+                                                                                                                \
+        for (;;) {                                                                                              \
+            const u32 next = (i + 1) & mask;                                                                    \
+            if (hashset->entries[next].distance <= 1) break;                                                    \
+                                                                                                                \
+            hashset->entries[i] = hashset->entries[next];                                                       \
+            hashset->entries[i].distance--;                                                                     \
+            i = next;                                                                                           \
+        }                                                                                                       \
+                                                                                                                \
+        hashset->entries[i].distance = ROBIN_DISTANCE_EMPTY;                                                    \
+        hashset->size--;                                                                                        \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, const K key) {                                        \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find(hashset, key);                                      \
+        if (entry == NULL) return 0;                                                                            \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, const K key) {                            \
+        if (hashset == NULL) return NULL;                                                                       \
+                                                                                                                \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
+        return HASHSET_##K##_find_hashed(hashset, hash, key);                                                   \
+    }                                                                                                           \
+                                                                                                                \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {                 \
+        if (hashset == NULL) return 0;                                                                          \
+                                                                                                                \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find_hashed(hashset, hash, key);                         \
+        if (entry == NULL) return 0;                                                                            \
+        return 1;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {     \
+        if (hashset == NULL) return NULL;                                                                       \
+        if (hashset->capacity == 0) return NULL;                                                                \
+                                                                                                                \
+        const u32 mask = hashset->capacity - 1;                                                                 \
+        u32 i = hash & mask;                                                                                    \
+                                                                                                                \
+        for (u32 distance = 1; ; distance++) {                                                                  \
+            HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                    \
+            if (entry->distance < distance) return NULL;                                                        \
+            if (entry->hash == hash && HASHSET_##K##_key_equal(entry->key, key) == 1) return entry;             \
+            i = (i + 1) & mask;                                                                                 \
+        }                                                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b) {                              \
+        if (a == NULL || b == NULL) return NULL;                                                                \
+                                                                                                                \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(a->capacity + b->capacity, a->allocator);               \
+        if (c == NULL) return NULL;                                                                             \
+                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                              \
+            const HASHSET_ENTRY_##K entry = a->entries[ai];                                                     \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY)                                                         \
+                HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                              \
+        }                                                                                                       \
+                                                                                                                \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                              \
+            const HASHSET_ENTRY_##K entry = b->entries[bi];                                                     \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY)                                                         \
+                HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                              \
+        }                                                                                                       \
+                                                                                                                \
+        return c;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b) {                       \
+        if (a == NULL || b == NULL) return NULL;                                                                \
+                                                                                                                \
+        const HASHSET_##K* smaller;                                                                             \
+        const HASHSET_##K* larger;                                                                              \
+        if (a->capacity < b->capacity) {                                                                        \
+            smaller = a;                                                                                        \
+            larger = b;                                                                                         \
+        }                                                                                                       \
+        else {                                                                                                  \
+            smaller = b;                                                                                        \
+            larger = a;                                                                                         \
+        }                                                                                                       \
+                                                                                                                \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(smaller->capacity, a->allocator);                       \
+        if (c == NULL) return NULL;                                                                             \
+                                                                                                                \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                           \
+            const HASHSET_ENTRY_##K entry = smaller->entries[i];                                                \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY) {                                                       \
+                if (HASHSET_##K##_contains_hashed(larger, entry.hash, entry.key) == 1) {                        \
+                    HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                          \
+                }                                                                                               \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        return c;                                                                                               \
+    }                                                                                                           \
+                                                                                                                \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b) {                         \
+        if (a == NULL || b == NULL) return NULL;                                                                \
+                                                                                                                \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(a->capacity, a->allocator);                             \
+        if (c == NULL) return NULL;                                                                             \
+                                                                                                                \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                              \
+            const HASHSET_ENTRY_##K entry = a->entries[ai];                                                     \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY) {                                                       \
+                if (HASHSET_##K##_contains_hashed(b, entry.hash, entry.key) == 0) {                             \
+                    HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                          \
+                }                                                                                               \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        return c;                                                                                               \
+    }
+
+#endif // NESQUIK_ROBIN_HASHSET_H
\ No newline at end of file
@@ -0,0 +1,277 @@
+#ifndef NESQUIK_ROBIN_HASHTABLE_H
+#define NESQUIK_ROBIN_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/robin_hood.h"
+
+// Robin Hood engine behind the HASHTABLE API. Swapping HASHTABLE_DECLARE/HASHTABLE_DEFINE for
+// HASHTABLE_DECLARE_ROBIN/HASHTABLE_DEFINE_ROBIN keeps every call site compiling.
+// Backward-shift deletion leaves no tombstones, the field is kept at 0 for code that reads it.
+// The INCREMENTAL, CONCURRENT and SHARDED wrappers walk classic entry states or need _upsert and _resize,
+// so they require the classic engine.
+#define HASHTABLE_DECLARE_ROBIN_TYPES(K, V)                                                                 \
+    typedef struct HASHTABLE_ENTRY_##K##_##V {                                                              \
+        u32 distance;                                                                                       \
+        u32 hash;                                                                                           \
+        K key;                                                                                              \
+        V value;                                                                                            \
+    } HASHTABLE_ENTRY_##K##_##V;                                                                            \
+                                                                                                            \
+    typedef struct HASHTABLE_##K##_##V {                                                                    \
+        HASHTABLE_ENTRY_##K##_##V* entries;                                                                 \
+        u32 size;                                                                                           \
+        u32 capacity;                                                                                       \
+        u32 tombstones;                                                                                     \
+        const NESQUIK_ALLOCATOR* allocator;                                                                 \
+    } HASHTABLE_##K##_##V;                                                                                  \
+                                                                                                            \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, u32 capacity);                            \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, u32 capacity,                   \
+        const NESQUIK_ALLOCATOR* allocator);                                                                \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(u32 capacity);                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator);                                                                \
+                                                                                                            \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable);                                      \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable);                                     \
+                                                                                                            \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable);                                          \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, K key, V value);                           \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);           \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, K key);                               \
+                                                                                                            \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, K key);                         \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, K key);     \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash, K key);        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable,      \
+        u32 hash, K key);
+
+#define HASHTABLE_DECLARE_ROBIN_HASH(K, V, HASH_F)      \
+    HASHTABLE_DECLARE_ROBIN_TYPES(K, V)                 \
+    HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define HASHTABLE_DECLARE_ROBIN_EX(K, V, HASH_FN, EQ_FN)    \
+    HASHTABLE_DECLARE_ROBIN_TYPES(K, V)                     \
+    HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define HASHTABLE_DECLARE_ROBIN(K, V) HASHTABLE_DECLARE_ROBIN_HASH(K, V, HASH_fnv1a)
+
+// Capacity is a power of two indexed with a mask. An insert takes the slot of any entry that sits closer
+// to its home than the incoming one, so a lookup can stop as soon as it meets such an entry, and a remove
+// shifts the following run back by one instead of leaving a tombstone.
+#define HASHTABLE_DEFINE_ROBIN(K, V)                                                                                            \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, const u32 capacity) {                                         \
+        return HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, NULL);                                                 \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, const u32 capacity,                                 \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                   \
+                                                                                                                                \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        hashtable->allocator = allocator;                                                                                       \
+        hashtable->size = 0;                                                                                                    \
+        hashtable->capacity = ROBIN_capacity(capacity);                                                                         \
+        hashtable->tombstones = 0;                                                                                              \
+                                                                                                                                \
+        hashtable->entries = (HASHTABLE_ENTRY_##K##_##V*)NESQUIK_alloc(allocator,                                               \
+            sizeof(HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                                                           \
+        if (hashtable->entries == NULL) {                                                                                       \
+            hashtable->capacity = 0;                                                                                            \
+            return 0;                                                                                                           \
+        }                                                                                                                       \
+                                                                                                                                \
+        memset(hashtable->entries, 0, sizeof(HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                                 \
+                                                                                                                                \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(const u32 capacity) {                                                     \
+        return HASHTABLE_##K##_##V##_create_allocator(capacity, NULL);                                                          \
+    }                                                                                                                           \
+                                                                                                                                \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                             \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                   \
+                                                                                                                                \
+        HASHTABLE_##K##_##V* hashtable = (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                         \
+            sizeof(HASHTABLE_##K##_##V));                                                                                       \
+        if (hashtable == NULL) return NULL;                                                                                     \
+                                                                                                                                \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, allocator);                                      \
+        if (r == 0) {                                                                                                           \
+            NESQUIK_free(allocator, hashtable);                                                                                 \
+            return NULL;                                                                                                        \
+        }                                                                                                                       \
+                                                                                                                                \
+        return hashtable;                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable) {                                                         \
+        if (hashtable == NULL) return;                                                                                          \
+        hashtable->size = 0;                                                                                                    \
+        hashtable->capacity = 0;                                                                                                \
+        hashtable->tombstones = 0;                                                                                              \
+                                                                                                                                \
+        if (hashtable->entries != NULL) {                                                                                       \
+            NESQUIK_free(hashtable->allocator, hashtable->entries);                                                             \
+            hashtable->entries = NULL;                                                                                          \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable) {                                                        \
+        if (hashtable == NULL) return;                                                                                          \
+                                                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                              \
+        HASHTABLE_##K##_##V##_deinit(hashtable);                                                                                \
+        NESQUIK_free(allocator, hashtable);                                                                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    static void HASHTABLE_##K##_##V##_place(HASHTABLE_##K##_##V* hashtable, HASHTABLE_ENTRY_##K##_##V incoming) {               \
+        const u32 mask = hashtable->capacity - 1;                                                                               \
+        u32 i = incoming.hash & mask;                                                                                           \
+                                                                                                                                \
+        incoming.distance = 1;                                                                                                  \
+        for (;;) {                                                                                                              \
+            HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                          \
+            if (entry->distance == ROBIN_DISTANCE_EMPTY) {                                                                      \
+                *entry = incoming;                                                                                              \
+                return;                                                                                                         \
+            }                                                                                                                   \
+                                                                                                                                \
+            if (entry->distance < incoming.distance) {                                                                          \
+                const HASHTABLE_ENTRY_##K##_##V displaced = *entry;                                                             \
+                *entry = incoming;                                                                                              \
+                incoming = displaced;                                                                                           \
+            }                                                                                                                   \
+                                                                                                                                \
+            incoming.distance++;                                                                                                \
+            i = (i + 1) & mask;                                                                                                 \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable) {                                                             \
+        if (hashtable == NULL) return 0;                                                                                        \
+        if (hashtable->capacity & 0x80000000) return 0;                                                                         \
+                                                                                                                                \
+        HASHTABLE_##K##_##V new_hashtable;                                                                                      \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, hashtable->capacity << 1,                             \
+            hashtable->allocator);                                                                                              \
+        if (r == 0) return 0;                                                                                                   \
+                                                                                                                                \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                         \
+            const HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                    \
+            if (entry->distance != ROBIN_DISTANCE_EMPTY) HASHTABLE_##K##_##V##_place(&new_hashtable, *entry);                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        NESQUIK_free(hashtable->allocator, hashtable->entries);                                                                 \
+        hashtable->entries = new_hashtable.entries;                                                                             \
+        hashtable->capacity = new_hashtable.capacity;                                                                           \
+                                                                                                                                \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) {            \
+        if (hashtable == NULL) return 0;                                                                                        \
+        if (hashtable->capacity == 0) return 0;                                                                                 \
+                                                                                                                                \
+        if (hashtable->size + 1 > ROBIN_MAX_LOAD(hashtable->capacity)) {                                                        \
+            const u8 r = HASHTABLE_##K##_##V##_grow(hashtable);                                                                 \
+            if (r == 0) return 0;                                                                                               \
+        }                                                                                                                       \
+                                                                                                                                \
+        const u32 mask = hashtable->capacity - 1;                                                                               \
+        u32 i = hash & mask;                                                                                                    \
+                                                                                                                                \
+        for (u32 distance = 1; ; distance++) {                                                                                  \
+            HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                          \
+            if (entry->distance < distance) break;                                                                              \
+            if (entry->hash == hash && HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) return 0;                         \
+            i = (i + 1) & mask;                                                                                                 \
+        }                                                                                                                       \
+                                                                                                                                \
+        HASHTABLE_ENTRY_##K##_##V incoming;                                                                                     \
+        incoming.hash = hash;                                                                                                   \
+        incoming.key = key;                                                                                                     \
+        incoming.value = value;                                                                                                 \
+        HASHTABLE_##K##_##V##_place(hashtable, incoming);                                                                       \
+                                                                                                                                \
+        hashtable->size++;                                                                                                      \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, const K key, const V value) {                                  \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                                   \
+        return HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                                    \
+    }                                                                                                                           \
+                                                                                                                                \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, const K key) {                                            \
+        if (hashtable == NULL) return;                                                                                          \
+                                                                                                                                \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find(hashtable, key);                                    \
+        if (entry == NULL) return;                                                                                              \
+                                                                                                                                \
+        const u32 mask = hashtable->capacity - 1;                                                                               \
+        u32 i = (u32)(entry - hashtable->entries);                                                                              \
+                                                                                                                                \
+        for (;;) {                                                                                                              \
+            const u32 next = (i + 1) & mask;                                                                                    \
+            if (hashtable->entries[next].distance <= 1) break;                                                                  \
+                                                                                                                                \
+            hashtable->entries[i] = hashtable->entries[next];                                                                   \
+            hashtable->entries[i].distance--;                                                                                   \
+            i = next;                                                                                                           \
+        }                                                                                                                       \
+                                                                                                                                \
+        hashtable->entries[i].distance = ROBIN_DISTANCE_EMPTY;                                                                  \
+        hashtable->size--;                                                                                                      \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, const K key) {                                      \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find(hashtable, key);                                    \
+        if (entry == NULL) return 0;                                                                                            \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, const K key) {                  \
+        if (hashtable == NULL) return NULL;                                                                                     \
+                                                                                                                                \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                                   \
+        return HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                         \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {               \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                       \
+        if (entry == NULL) return 0;                                                                                            \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable,                          \
+        const u32 hash, const K key) {                                                                                          \
+                                                                                                                                \
+        if (hashtable == NULL) return NULL;                                                                                     \
+        if (hashtable->capacity == 0) return NULL;                                                                              \
+                                                                                                                                \
+        const u32 mask = hashtable->capacity - 1;                                                                               \
+        u32 i = hash & mask;                                                                                                    \
+                                                                                                                                \
+        for (u32 distance = 1; ; distance++) {                                                                                  \
+            HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                          \
+            if (entry->distance < distance) return NULL;                                                                        \
+            if (entry->hash == hash && HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) return entry;                     \
+            i = (i + 1) & mask;                                                                                                 \
+        }                                                                                                                       \
+    }
+
+#endif // NESQUIK_ROBIN_HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef NESQUIK_ROBIN_HOOD_H
+#define NESQUIK_ROBIN_HOOD_H
+
+#include "types.h"
+
+// Shared by the *_DEFINE_ROBIN engines. An entry's distance is its probe length plus one, 0 marks an empty slot.
+#define ROBIN_DISTANCE_EMPTY        0
+
+#define ROBIN_MIN_CAPACITY          8
+#define ROBIN_MAX_LOAD(capacity)    ((capacity) - (capacity) / 8)
+
+static inline u32 ROBIN_capacity(const u32 capacity) {
+    u32 new_capacity = ROBIN_MIN_CAPACITY;
+    while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;
+    return new_capacity;
+}
+
+#endif //NESQUIK_ROBIN_HOOD_H
\ No newline at end of file
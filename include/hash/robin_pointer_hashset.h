@@ -0,0 +1,372 @@
+#ifndef NESQUIK_ROBIN_POINTER_HASHSET_H
+#define NESQUIK_ROBIN_POINTER_HASHSET_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/pointer_hashset.h"
+#include "hash/robin_hood.h"
+
+// Robin Hood engine behind the POINTER_HASHSET API, see hash/robin_hashset.h
+#define POINTER_HASHSET_DECLARE_ROBIN_TYPES(K)                                                                              \
+    typedef struct POINTER_HASHSET_ENTRY_##K {                                                                              \
+        u32 distance;                                                                                                       \
+        u32 hash;                                                                                                           \
+        K* key;                                                                                                             \
+    } POINTER_HASHSET_ENTRY_##K;                                                                                            \
+                                                                                                                            \
+    typedef struct POINTER_HASHSET_##K {                                                                                    \
+        POINTER_HASHSET_ENTRY_##K* entries;                                                                                 \
+        u32 size;                                                                                                           \
+        u32 capacity;                                                                                                       \
+                                                                                                                            \
+        u32 (*key_size)(const K*);                                                                                          \
+        u8 (*key_equal)(const K*, const K*);                                                                                \
+        const NESQUIK_ALLOCATOR* allocator;                                                                                 \
+    } POINTER_HASHSET_##K;                                                                                                  \
+                                                                                                                            \
+    u8 POINTER_HASHSET_##K##_init(POINTER_HASHSET_##K* hashset,                                                             \
+        u32 capacity,                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*));                                                                               \
+    u8 POINTER_HASHSET_##K##_init_allocator(POINTER_HASHSET_##K* hashset,                                                   \
+        u32 capacity,                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create(const u32 capacity,                                                   \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*));                                                                               \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create_allocator(u32 capacity,                                               \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                \
+                                                                                                                            \
+    void POINTER_HASHSET_##K##_deinit(POINTER_HASHSET_##K* hashset);                                                        \
+    void POINTER_HASHSET_##K##_destroy(POINTER_HASHSET_##K* hashset);                                                       \
+                                                                                                                            \
+    u8 POINTER_HASHSET_##K##_grow(POINTER_HASHSET_##K* hashset);                                                            \
+    u8 POINTER_HASHSET_##K##_add(POINTER_HASHSET_##K* hashset, K* key);                                                     \
+    u8 POINTER_HASHSET_##K##_quick_add(POINTER_HASHSET_##K* hashset, u32 hash, K* key);                                     \
+    void POINTER_HASHSET_##K##_remove(POINTER_HASHSET_##K* hashset, const K* key);                                          \
+                                                                                                                            \
+    u8 POINTER_HASHSET_##K##_contains(const POINTER_HASHSET_##K* hashset, const K* key);                                    \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find(const POINTER_HASHSET_##K* hashset, const K* key);                \
+    u8 POINTER_HASHSET_##K##_contains_hashed(const POINTER_HASHSET_##K* hashset, u32 hash, const K* key);                   \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find_hashed(const POINTER_HASHSET_##K* hashset,                        \
+        u32 hash, const K* key);                                                                                            \
+                                                                                                                            \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_union(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);           \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_intersection(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_difference(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b);
+
+#define POINTER_HASHSET_DECLARE_ROBIN_HASH(K, HASH_F)       \
+    POINTER_HASHSET_DECLARE_ROBIN_TYPES(K)                  \
+    POINTER_HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define POINTER_HASHSET_DECLARE_ROBIN_EX(K, HASH_FN, EQ_FN)     \
+    POINTER_HASHSET_DECLARE_ROBIN_TYPES(K)                      \
+    POINTER_HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+#define POINTER_HASHSET_DECLARE_ROBIN_IDENTITY(K) POINTER_HASHSET_DECLARE_ROBIN_EX(K, HASH_pointer, HASH_EQUAL)
+
+#define POINTER_HASHSET_DECLARE_ROBIN(K) POINTER_HASHSET_DECLARE_ROBIN_HASH(K, HASH_fnv1a)
+
+#define POINTER_HASHSET_DEFINE_ROBIN(K)                                                                                             \
+    u8 POINTER_HASHSET_##K##_init(POINTER_HASHSET_##K* hashset,                                                                     \
+        const u32 capacity,                                                                                                         \
+        u32 (*key_size)(const K*),                                                                                                  \
+        u8 (*key_equal)(const K*, const K*)) {                                                                                      \
+                                                                                                                                    \
+        return POINTER_HASHSET_##K##_init_allocator(hashset, capacity, key_size, key_equal, NULL);                                  \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 POINTER_HASHSET_##K##_init_allocator(POINTER_HASHSET_##K* hashset,                                                           \
+        const u32 capacity,                                                                                                         \
+        u32 (*key_size)(const K*),                                                                                                  \
+        u8 (*key_equal)(const K*, const K*),                                                                                        \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                       \
+                                                                                                                                    \
+        if (hashset == NULL) return 0;                                                                                              \
+                                                                                                                                    \
+        hashset->size = 0;                                                                                                          \
+        hashset->capacity = ROBIN_capacity(capacity);                                                                               \
+                                                                                                                                    \
+        hashset->key_size = key_size;                                                                                               \
+        hashset->key_equal = key_equal;                                                                                             \
+        hashset->allocator = allocator;                                                                                             \
+                                                                                                                                    \
+        hashset->entries = (POINTER_HASHSET_ENTRY_##K*)NESQUIK_alloc(allocator,                                                     \
+            sizeof(POINTER_HASHSET_ENTRY_##K) * hashset->capacity);                                                                 \
+        if (hashset->entries == NULL) {                                                                                             \
+            hashset->capacity = 0;                                                                                                  \
+            return 0;                                                                                                               \
+        }                                                                                                                           \
+                                                                                                                                    \
+        memset(hashset->entries, 0, sizeof(POINTER_HASHSET_ENTRY_##K) * hashset->capacity);                                         \
+                                                                                                                                    \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create(const u32 capacity,                                                           \
+        u32 (*key_size)(const K*),                                                                                                  \
+        u8 (*key_equal)(const K*, const K*)) {                                                                                      \
+                                                                                                                                    \
+        return POINTER_HASHSET_##K##_create_allocator(capacity, key_size, key_equal, NULL);                                         \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_create_allocator(const u32 capacity,                                                 \
+        u32 (*key_size)(const K*),                                                                                                  \
+        u8 (*key_equal)(const K*, const K*),                                                                                        \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                       \
+                                                                                                                                    \
+        POINTER_HASHSET_##K* hashset = (POINTER_HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(POINTER_HASHSET_##K));                 \
+        if (hashset == NULL) return NULL;                                                                                           \
+                                                                                                                                    \
+        const u8 r = POINTER_HASHSET_##K##_init_allocator(hashset, capacity, key_size, key_equal, allocator);                       \
+        if (r == 0) {                                                                                                               \
+            NESQUIK_free(allocator, hashset);                                                                                       \
+            return NULL;                                                                                                            \
+        }                                                                                                                           \
+                                                                                                                                    \
+        return hashset;                                                                                                             \
+    }                                                                                                                               \
+                                                                                                                                    \
+    void POINTER_HASHSET_##K##_deinit(POINTER_HASHSET_##K* hashset) {                                                               \
+        if (hashset == NULL) return;                                                                                                \
+        hashset->size = 0;                                                                                                          \
+        hashset->capacity = 0;                                                                                                      \
+                                                                                                                                    \
+        hashset->key_size = NULL;                                                                                                   \
+        hashset->key_equal = NULL;                                                                                                  \
+                                                                                                                                    \
+        if (hashset->entries != NULL) {                                                                                             \
+            NESQUIK_free(hashset->allocator, hashset->entries);                                                                     \
+            hashset->entries = NULL;                                                                                                \
+        }                                                                                                                           \
+    }                                                                                                                               \
+                                                                                                                                    \
+    void POINTER_HASHSET_##K##_destroy(POINTER_HASHSET_##K* hashset) {                                                              \
+        if (hashset == NULL) return;                                                                                                \
+                                                                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                                                    \
+        POINTER_HASHSET_##K##_deinit(hashset);                                                                                      \
+        NESQUIK_free(allocator, hashset);                                                                                           \
+    }                                                                                                                               \
+                                                                                                                                    \
+    static void POINTER_HASHSET_##K##_place(POINTER_HASHSET_##K* hashset, POINTER_HASHSET_ENTRY_##K incoming) {                     \
+        const u32 mask = hashset->capacity - 1;                                                                                     \
+        u32 i = incoming.hash & mask;                                                                                               \
+                                                                                                                                    \
+        incoming.distance = 1;                                                                                                      \
+        for (;;) {                                                                                                                  \
+            POINTER_HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                                \
+            if (entry->distance == ROBIN_DISTANCE_EMPTY) {                                                                          \
+                *entry = incoming;                                                                                                  \
+                return;                                                                                                             \
+            }                                                                                                                       \
+                                                                                                                                    \
+            if (entry->distance < incoming.distance) {                                                                              \
+                const POINTER_HASHSET_ENTRY_##K displaced = *entry;                                                                 \
+                *entry = incoming;                                                                                                  \
+                incoming = displaced;                                                                                               \
+            }                                                                                                                       \
+                                                                                                                                    \
+            incoming.distance++;                                                                                                    \
+            i = (i + 1) & mask;                                                                                                     \
+        }                                                                                                                           \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 POINTER_HASHSET_##K##_grow(POINTER_HASHSET_##K* hashset) {                                                                   \
+        if (hashset == NULL) return 0;                                                                                              \
+        if (hashset->capacity & 0x80000000) return 0;                                                                               \
+                                                                                                                                    \
+        POINTER_HASHSET_##K new_hashset;                                                                                            \
+        const u8 r = POINTER_HASHSET_##K##_init_allocator(&new_hashset, hashset->capacity << 1, hashset->key_size,                  \
+            hashset->key_equal, hashset->allocator);                                                                                \
+        if (r == 0) return 0;                                                                                                       \
+                                                                                                                                    \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                                               \
+            const POINTER_HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                          \
+            if (entry->distance != ROBIN_DISTANCE_EMPTY) POINTER_HASHSET_##K##_place(&new_hashset, *entry);                         \
+        }                                                                                                                           \
+                                                                                                                                    \
+        NESQUIK_free(hashset->allocator, hashset->entries);                                                                         \
+        hashset->entries = new_hashset.entries;                                                                                     \
+        hashset->capacity = new_hashset.capacity;                                                                                   \
+                                                                                                                                    \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 POINTER_HASHSET_##K##_quick_add(POINTER_HASHSET_##K* hashset, const u32 hash, K* key) {                                      \
+        if (hashset == NULL) return 0;                                                                                              \
+        if (hashset->capacity == 0) return 0;                                                                                       \
+                                                                                                                                    \
+        if (hashset->size + 1 > ROBIN_MAX_LOAD(hashset->capacity)) {                                                                \
+            const u8 r = POINTER_HASHSET_##K##_grow(hashset);                                                                       \
+            if (r == 0) return 0;                                                                                                   \
+        }                                                                                                                           \
+                                                                                                                                    \
+        const u32 mask = hashset->capacity - 1;                                                                                     \
+        u32 i = hash & mask;                                                                                                        \
+                                                                                                                                    \
+        for (u32 distance = 1; ; distance++) {                                                                                      \
+            POINTER_HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                                \
+            if (entry->distance < distance) break;                                                                                  \
+            if (entry->hash == hash && POINTER_HASHSET_##K##_key_equal(hashset, entry->key, key) == 1) return 0;                    \
+            i = (i + 1) & mask;                                                                                                     \
+        }                                                                                                                           \
+                                                                                                                                    \
+        POINTER_HASHSET_ENTRY_##K incoming;                                                                                         \
+        incoming.hash = hash;                                                                                                       \
+        incoming.key = key;                                                                                                         \
+        POINTER_HASHSET_##K##_place(hashset, incoming);                                                                             \
+                                                                                                                                    \
+        hashset->size++;                                                                                                            \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 POINTER_HASHSET_##K##_add(POINTER_HASHSET_##K* hashset, K* key) {                                                            \
+        if (hashset == NULL) return 0;                                                                                              \
+                                                                                                                                    \
+        const u32 hash = POINTER_HASHSET_##K##_key_hash(hashset, key);                                                              \
+        return POINTER_HASHSET_##K##_quick_add(hashset, hash, key);                                                                 \
+    }                                                                                                                               \
+                                                                                                                                    \
+    void POINTER_HASHSET_##K##_remove(POINTER_HASHSET_##K* hashset, const K* key) {                                                 \
+        if (hashset == NULL) return;                                                                                                \
+                                                                                                                                    \
+        const POINTER_HASHSET_ENTRY_##K* entry = POINTER_HASHSET_##K##_find(hashset, key);                                          \
+        if (entry == NULL) return;                                                                                                  \
+                                                                                                                                    \
+        const u32 mask = hashset->capacity - 1;                                                                                     \
+        u32 i = (u32)(entry - hashset->entries);                                                                                    \
+                                                                                                                                    \
+        for (;;) {                                                                                                                  \
+            const u32 next = (i + 1) & mask;                                                                                        \
+            if (hashset->entries[next].distance <= 1) break;                                                                        \
+                                                                                                                                    \
+            hashset->entries[i] = hashset->entries[next];                                                                           \
+            hashset->entries[i].distance--;                                                                                         \
+            i = next;                                                                                                               \
+        }                                                                                                                           \
+                                                                                                                                    \
+        hashset->entries[i].distance = ROBIN_DISTANCE_EMPTY;                                                                        \
+        hashset->size--;                                                                                                            \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 POINTER_HASHSET_##K##_contains(const POINTER_HASHSET_##K* hashset, const K* key) {                                           \
+        if (hashset == NULL) return 0;                                                                                              \
+                                                                                                                                    \
+        const POINTER_HASHSET_ENTRY_##K* entry = POINTER_HASHSET_##K##_find(hashset, key);                                          \
+        if (entry == NULL) return 0;                                                                                                \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find(const POINTER_HASHSET_##K* hashset, const K* key) {                       \
+        if (hashset == NULL) return NULL;                                                                                           \
+                                                                                                                                    \
+        const u32 hash = POINTER_HASHSET_##K##_key_hash(hashset, key);                                                              \
+        return POINTER_HASHSET_##K##_find_hashed(hashset, hash, key);                                                               \
+    }                                                                                                                               \
+                                                                                                                                    \
+    u8 POINTER_HASHSET_##K##_contains_hashed(const POINTER_HASHSET_##K* hashset, const u32 hash, const K* key) {                    \
+        if (hashset == NULL) return 0;                                                                                              \
+                                                                                                                                    \
+        const POINTER_HASHSET_ENTRY_##K* entry = POINTER_HASHSET_##K##_find_hashed(hashset, hash, key);                             \
+        if (entry == NULL) return 0;                                                                                                \
+        return 1;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_ENTRY_##K* POINTER_HASHSET_##K##_find_hashed(const POINTER_HASHSET_##K* hashset,                                \
+        const u32 hash, const K* key) {                                                                                             \
+                                                                                                                                    \
+        if (hashset == NULL) return NULL;                                                                                           \
+        if (hashset->capacity == 0) return NULL;                                                                                    \
+                                                                                                                                    \
+        const u32 mask = hashset->capacity - 1;                                                                                     \
+        u32 i = hash & mask;                                                                                                        \
+                                                                                                                                    \
+        for (u32 distance = 1; ; distance++) {                                                                                      \
+            POINTER_HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                                \
+            if (entry->distance < distance) return NULL;                                                                            \
+            if (entry->hash == hash && POINTER_HASHSET_##K##_key_equal(hashset, entry->key, key) == 1) return entry;                \
+            i = (i + 1) & mask;                                                                                                     \
+        }                                                                                                                           \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_union(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {                  \
+        if (a == NULL || b == NULL) return NULL;                                                                                    \
+                                                                                                                                    \
+        POINTER_HASHSET_##K* c = POINTER_HASHSET_##K##_create_allocator(a->capacity + b->capacity, a->key_size,                     \
+            a->key_equal, a->allocator);                                                                                            \
+        if (c == NULL) return NULL;                                                                                                 \
+                                                                                                                                    \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                                                  \
+            const POINTER_HASHSET_ENTRY_##K entry = a->entries[ai];                                                                 \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY)                                                                             \
+                POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                          \
+        }                                                                                                                           \
+                                                                                                                                    \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                                                  \
+            const POINTER_HASHSET_ENTRY_##K entry = b->entries[bi];                                                                 \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY)                                                                             \
+                POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                          \
+        }                                                                                                                           \
+                                                                                                                                    \
+        return c;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_intersection(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {           \
+        if (a == NULL || b == NULL) return NULL;                                                                                    \
+                                                                                                                                    \
+        const POINTER_HASHSET_##K* smaller;                                                                                         \
+        const POINTER_HASHSET_##K* larger;                                                                                          \
+        if (a->capacity < b->capacity) {                                                                                            \
+            smaller = a;                                                                                                            \
+            larger = b;                                                                                                             \
+        }                                                                                                                           \
+        else {                                                                                                                      \
+            smaller = b;                                                                                                            \
+            larger = a;                                                                                                             \
+        }                                                                                                                           \
+                                                                                                                                    \
+        POINTER_HASHSET_##K* c = POINTER_HASHSET_##K##_create_allocator(smaller->capacity, a->key_size,                             \
+            a->key_equal, a->allocator);                                                                                            \
+        if (c == NULL) return NULL;                                                                                                 \
+                                                                                                                                    \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                                               \
+            const POINTER_HASHSET_ENTRY_##K entry = smaller->entries[i];                                                            \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY) {                                                                           \
+                if (POINTER_HASHSET_##K##_contains_hashed(larger, entry.hash, entry.key) == 1) {                                    \
+                    POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                      \
+                }                                                                                                                   \
+            }                                                                                                                       \
+        }                                                                                                                           \
+                                                                                                                                    \
+        return c;                                                                                                                   \
+    }                                                                                                                               \
+                                                                                                                                    \
+    POINTER_HASHSET_##K* POINTER_HASHSET_##K##_difference(const POINTER_HASHSET_##K* a, const POINTER_HASHSET_##K* b) {             \
+        if (a == NULL || b == NULL) return NULL;                                                                                    \
+                                                                                                                                    \
+        POINTER_HASHSET_##K* c = POINTER_HASHSET_##K##_create_allocator(a->capacity, a->key_size, a->key_equal,                     \
+            a->allocator);                                                                                                          \
+        if (c == NULL) return NULL;                                                                                                 \
+                                                                                                                                    \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                                                  \
+            const POINTER_HASHSET_ENTRY_##K entry = a->entries[ai];                                                                 \
+            if (entry.distance != ROBIN_DISTANCE_EMPTY) {                                                                           \
+                if (POINTER_HASHSET_##K##_contains_hashed(b, entry.hash, entry.key) == 0) {                                         \
+                    POINTER_HASHSET_##K##_quick_add(c, entry.hash, entry.key);                                                      \
+                }                                                                                                                   \
+            }                                                                                                                       \
+        }                                                                                                                           \
+                                                                                                                                    \
+        return c;                                                                                                                   \
+    }
+
+#endif // NESQUIK_ROBIN_POINTER_HASHSET_H
\ No newline at end of file
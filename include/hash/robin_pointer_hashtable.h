@@ -0,0 +1,303 @@
+#ifndef NESQUIK_ROBIN_POINTER_HASHTABLE_H
+#define NESQUIK_ROBIN_POINTER_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/pointer_hashtable.h"
+#include "hash/robin_hood.h"
+
+// Robin Hood engine behind the POINTER_HASHTABLE API, see hash/robin_hashtable.h
+#define POINTER_HASHTABLE_DECLARE_ROBIN_TYPES(K, V)                                                                         \
+    typedef struct POINTER_HASHTABLE_ENTRY_##K##_##V {                                                                      \
+        u32 distance;                                                                                                       \
+        u32 hash;                                                                                                           \
+        K* key;                                                                                                             \
+        V value;                                                                                                            \
+    } POINTER_HASHTABLE_ENTRY_##K##_##V;                                                                                    \
+                                                                                                                            \
+    typedef struct POINTER_HASHTABLE_##K##_##V {                                                                            \
+        POINTER_HASHTABLE_ENTRY_##K##_##V* entries;                                                                         \
+        u32 size;                                                                                                           \
+        u32 capacity;                                                                                                       \
+                                                                                                                            \
+        u32 (*key_size)(const K*);                                                                                          \
+        u8 (*key_equal)(const K*, const K*);                                                                                \
+        const NESQUIK_ALLOCATOR* allocator;                                                                                 \
+    } POINTER_HASHTABLE_##K##_##V;                                                                                          \
+                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_init(POINTER_HASHTABLE_##K##_##V* hashtable,                                           \
+        u32 capacity,                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*));                                                                               \
+    u8 POINTER_HASHTABLE_##K##_##V##_init_allocator(POINTER_HASHTABLE_##K##_##V* hashtable,                                 \
+        u32 capacity,                                                                                                       \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                \
+    POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create(u32 capacity,                                         \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*));                                                                               \
+    POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create_allocator(u32 capacity,                               \
+        u32 (*key_size)(const K*),                                                                                          \
+        u8 (*key_equal)(const K*, const K*),                                                                                \
+        const NESQUIK_ALLOCATOR* allocator);                                                                                \
+                                                                                                                            \
+    void POINTER_HASHTABLE_##K##_##V##_deinit(POINTER_HASHTABLE_##K##_##V* hashtable);                                      \
+    void POINTER_HASHTABLE_##K##_##V##_destroy(POINTER_HASHTABLE_##K##_##V* hashtable);                                     \
+                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_grow(POINTER_HASHTABLE_##K##_##V* hashtable);                                          \
+    u8 POINTER_HASHTABLE_##K##_##V##_add(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, V value);                          \
+    u8 POINTER_HASHTABLE_##K##_##V##_quick_add(POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash, K* key, V value);          \
+    void POINTER_HASHTABLE_##K##_##V##_remove(POINTER_HASHTABLE_##K##_##V* hashtable, const K* key);                        \
+                                                                                                                            \
+    u8 POINTER_HASHTABLE_##K##_##V##_contains(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key);                  \
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find(const POINTER_HASHTABLE_##K##_##V* hashtable,     \
+        const K* key);                                                                                                      \
+    u8 POINTER_HASHTABLE_##K##_##V##_contains_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash,                \
+        const K* key);                                                                                                      \
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find_hashed(                                           \
+        const POINTER_HASHTABLE_##K##_##V* hashtable, u32 hash, const K* key);
+
+#define POINTER_HASHTABLE_DECLARE_ROBIN_HASH(K, V, HASH_F)      \
+    POINTER_HASHTABLE_DECLARE_ROBIN_TYPES(K, V)                 \
+    POINTER_HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define POINTER_HASHTABLE_DECLARE_ROBIN_EX(K, V, HASH_FN, EQ_FN)    \
+    POINTER_HASHTABLE_DECLARE_ROBIN_TYPES(K, V)                     \
+    POINTER_HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define POINTER_HASHTABLE_DECLARE_ROBIN_IDENTITY(K, V) POINTER_HASHTABLE_DECLARE_ROBIN_EX(K, V, HASH_pointer, HASH_EQUAL)
+
+#define POINTER_HASHTABLE_DECLARE_ROBIN(K, V) POINTER_HASHTABLE_DECLARE_ROBIN_HASH(K, V, HASH_fnv1a)
+
+#define POINTER_HASHTABLE_DEFINE_ROBIN(K, V)                                                                                                    \
+    u8 POINTER_HASHTABLE_##K##_##V##_init(POINTER_HASHTABLE_##K##_##V* hashtable,                                                               \
+        const u32 capacity,                                                                                                                     \
+        u32 (*key_size)(const K*),                                                                                                              \
+        u8 (*key_equal)(const K*, const K*)) {                                                                                                  \
+                                                                                                                                                \
+        return POINTER_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, key_size, key_equal, NULL);                                    \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_init_allocator(POINTER_HASHTABLE_##K##_##V* hashtable,                                                     \
+        const u32 capacity,                                                                                                                     \
+        u32 (*key_size)(const K*),                                                                                                              \
+        u8 (*key_equal)(const K*, const K*),                                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                                   \
+                                                                                                                                                \
+        if (hashtable == NULL) return 0;                                                                                                        \
+                                                                                                                                                \
+        hashtable->size = 0;                                                                                                                    \
+        hashtable->capacity = ROBIN_capacity(capacity);                                                                                         \
+                                                                                                                                                \
+        hashtable->key_size = key_size;                                                                                                         \
+        hashtable->key_equal = key_equal;                                                                                                       \
+        hashtable->allocator = allocator;                                                                                                       \
+                                                                                                                                                \
+        hashtable->entries = (POINTER_HASHTABLE_ENTRY_##K##_##V*)NESQUIK_alloc(allocator,                                                       \
+            sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                                                                   \
+        if (hashtable->entries == NULL) {                                                                                                       \
+            hashtable->capacity = 0;                                                                                                            \
+            return 0;                                                                                                                           \
+        }                                                                                                                                       \
+                                                                                                                                                \
+        memset(hashtable->entries, 0, sizeof(POINTER_HASHTABLE_ENTRY_##K##_##V) * hashtable->capacity);                                         \
+                                                                                                                                                \
+        return 1;                                                                                                                               \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create(const u32 capacity,                                                       \
+        u32 (*key_size)(const K*),                                                                                                              \
+        u8 (*key_equal)(const K*, const K*)) {                                                                                                  \
+                                                                                                                                                \
+        return POINTER_HASHTABLE_##K##_##V##_create_allocator(capacity, key_size, key_equal, NULL);                                             \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    POINTER_HASHTABLE_##K##_##V* POINTER_HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                             \
+        u32 (*key_size)(const K*),                                                                                                              \
+        u8 (*key_equal)(const K*, const K*),                                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                                                   \
+                                                                                                                                                \
+        POINTER_HASHTABLE_##K##_##V* hashtable = (POINTER_HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                         \
+            sizeof(POINTER_HASHTABLE_##K##_##V));                                                                                               \
+        if (hashtable == NULL) return NULL;                                                                                                     \
+                                                                                                                                                \
+        const u8 r = POINTER_HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, key_size, key_equal,                                     \
+            allocator);                                                                                                                         \
+        if (r == 0) {                                                                                                                           \
+            NESQUIK_free(allocator, hashtable);                                                                                                 \
+            return NULL;                                                                                                                        \
+        }                                                                                                                                       \
+                                                                                                                                                \
+        return hashtable;                                                                                                                       \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    void POINTER_HASHTABLE_##K##_##V##_deinit(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                         \
+        if (hashtable == NULL) return;                                                                                                          \
+        hashtable->size = 0;                                                                                                                    \
+        hashtable->capacity = 0;                                                                                                                \
+                                                                                                                                                \
+        hashtable->key_size = NULL;                                                                                                             \
+        hashtable->key_equal = NULL;                                                                                                            \
+                                                                                                                                                \
+        if (hashtable->entries != NULL) {                                                                                                       \
+            NESQUIK_free(hashtable->allocator, hashtable->entries);                                                                             \
+            hashtable->entries = NULL;                                                                                                          \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    void POINTER_HASHTABLE_##K##_##V##_destroy(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                        \
+        if (hashtable == NULL) return;                                                                                                          \
+                                                                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                                              \
+        POINTER_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                                        \
+        NESQUIK_free(allocator, hashtable);                                                                                                     \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    static void POINTER_HASHTABLE_##K##_##V##_place(POINTER_HASHTABLE_##K##_##V* hashtable, POINTER_HASHTABLE_ENTRY_##K##_##V incoming) {       \
+        const u32 mask = hashtable->capacity - 1;                                                                                               \
+        u32 i = incoming.hash & mask;                                                                                                           \
+                                                                                                                                                \
+        incoming.distance = 1;                                                                                                                  \
+        for (;;) {                                                                                                                              \
+            POINTER_HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                                  \
+            if (entry->distance == ROBIN_DISTANCE_EMPTY) {                                                                                      \
+                *entry = incoming;                                                                                                              \
+                return;                                                                                                                         \
+            }                                                                                                                                   \
+                                                                                                                                                \
+            if (entry->distance < incoming.distance) {                                                                                          \
+                const POINTER_HASHTABLE_ENTRY_##K##_##V displaced = *entry;                                                                     \
+                *entry = incoming;                                                                                                              \
+                incoming = displaced;                                                                                                           \
+            }                                                                                                                                   \
+                                                                                                                                                \
+            incoming.distance++;                                                                                                                \
+            i = (i + 1) & mask;                                                                                                                 \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_grow(POINTER_HASHTABLE_##K##_##V* hashtable) {                                                             \
+        if (hashtable == NULL) return 0;                                                                                                        \
+        if (hashtable->capacity & 0x80000000) return 0;                                                                                         \
+                                                                                                                                                \
+        POINTER_HASHTABLE_##K##_##V new_hashtable;                                                                                              \
+        const u8 r = POINTER_HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, hashtable->capacity << 1,                                     \
+            hashtable->key_size, hashtable->key_equal, hashtable->allocator);                                                                   \
+        if (r == 0) return 0;                                                                                                                   \
+                                                                                                                                                \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                                         \
+            const POINTER_HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                            \
+            if (entry->distance != ROBIN_DISTANCE_EMPTY) POINTER_HASHTABLE_##K##_##V##_place(&new_hashtable, *entry);                           \
+        }                                                                                                                                       \
+                                                                                                                                                \
+        NESQUIK_free(hashtable->allocator, hashtable->entries);                                                                                 \
+        hashtable->entries = new_hashtable.entries;                                                                                             \
+        hashtable->capacity = new_hashtable.capacity;                                                                                           \
+                                                                                                                                                \
+        return 1;                                                                                                                               \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_quick_add(POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, K* key, V value) {                       \
+        if (hashtable == NULL) return 0;                                                                                                        \
+        if (hashtable->capacity == 0) return 0;                                                                                                 \
+                                                                                                                                                \
+        if (hashtable->size + 1 > ROBIN_MAX_LOAD(hashtable->capacity)) {                                                                        \
+            const u8 r = POINTER_HASHTABLE_##K##_##V##_grow(hashtable);                                                                         \
+            if (r == 0) return 0;                                                                                                               \
+        }                                                                                                                                       \
+                                                                                                                                                \
+        const u32 mask = hashtable->capacity - 1;                                                                                               \
+        u32 i = hash & mask;                                                                                                                    \
+                                                                                                                                                \
+        for (u32 distance = 1; ; distance++) {                                                                                                  \
+            POINTER_HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                                  \
+            if (entry->distance < distance) break;                                                                                              \
+            if (entry->hash == hash && POINTER_HASHTABLE_##K##_##V##_key_equal(hashtable, entry->key, key) == 1) return 0;                      \
+            i = (i + 1) & mask;                                                                                                                 \
+        }                                                                                                                                       \
+                                                                                                                                                \
+        POINTER_HASHTABLE_ENTRY_##K##_##V incoming;                                                                                             \
+        incoming.hash = hash;                                                                                                                   \
+        incoming.key = key;                                                                                                                     \
+        incoming.value = value;                                                                                                                 \
+        POINTER_HASHTABLE_##K##_##V##_place(hashtable, incoming);                                                                               \
+                                                                                                                                                \
+        hashtable->size++;                                                                                                                      \
+        return 1;                                                                                                                               \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_add(POINTER_HASHTABLE_##K##_##V* hashtable, K* key, V value) {                                             \
+        if (hashtable == NULL) return 0;                                                                                                        \
+                                                                                                                                                \
+        const u32 hash = POINTER_HASHTABLE_##K##_##V##_key_hash(hashtable, key);                                                                \
+        return POINTER_HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                                            \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    void POINTER_HASHTABLE_##K##_##V##_remove(POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {                                           \
+        if (hashtable == NULL) return;                                                                                                          \
+                                                                                                                                                \
+        const POINTER_HASHTABLE_ENTRY_##K##_##V* entry = POINTER_HASHTABLE_##K##_##V##_find(hashtable, key);                                    \
+        if (entry == NULL) return;                                                                                                              \
+                                                                                                                                                \
+        const u32 mask = hashtable->capacity - 1;                                                                                               \
+        u32 i = (u32)(entry - hashtable->entries);                                                                                              \
+                                                                                                                                                \
+        for (;;) {                                                                                                                              \
+            const u32 next = (i + 1) & mask;                                                                                                    \
+            if (hashtable->entries[next].distance <= 1) break;                                                                                  \
+                                                                                                                                                \
+            hashtable->entries[i] = hashtable->entries[next];                                                                                   \
+            hashtable->entries[i].distance--;                                                                                                   \
+            i = next;                                                                                                                           \
+        }                                                                                                                                       \
+                                                                                                                                                \
+        hashtable->entries[i].distance = ROBIN_DISTANCE_EMPTY;                                                                                  \
+        hashtable->size--;                                                                                                                      \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_contains(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {                                     \
+        if (hashtable == NULL) return 0;                                                                                                        \
+                                                                                                                                                \
+        const POINTER_HASHTABLE_ENTRY_##K##_##V* entry = POINTER_HASHTABLE_##K##_##V##_find(hashtable, key);                                    \
+        if (entry == NULL) return 0;                                                                                                            \
+        return 1;                                                                                                                               \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find(const POINTER_HASHTABLE_##K##_##V* hashtable, const K* key) {         \
+        if (hashtable == NULL) return NULL;                                                                                                     \
+                                                                                                                                                \
+        const u32 hash = POINTER_HASHTABLE_##K##_##V##_key_hash(hashtable, key);                                                                \
+        return POINTER_HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                                 \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    u8 POINTER_HASHTABLE_##K##_##V##_contains_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable, const u32 hash, const K* key) {              \
+        if (hashtable == NULL) return 0;                                                                                                        \
+                                                                                                                                                \
+        const POINTER_HASHTABLE_ENTRY_##K##_##V* entry = POINTER_HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                       \
+        if (entry == NULL) return 0;                                                                                                            \
+        return 1;                                                                                                                               \
+    }                                                                                                                                           \
+                                                                                                                                                \
+    POINTER_HASHTABLE_ENTRY_##K##_##V* POINTER_HASHTABLE_##K##_##V##_find_hashed(const POINTER_HASHTABLE_##K##_##V* hashtable,                  \
+        const u32 hash, const K* key) {                                                                                                         \
+                                                                                                                                                \
+        if (hashtable == NULL) return NULL;                                                                                                     \
+        if (hashtable->capacity == 0) return NULL;                                                                                              \
+                                                                                                                                                \
+        const u32 mask = hashtable->capacity - 1;                                                                                               \
+        u32 i = hash & mask;                                                                                                                    \
+                                                                                                                                                \
+        for (u32 distance = 1; ; distance++) {                                                                                                  \
+            POINTER_HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                                                  \
+            if (entry->distance < distance) return NULL;                                                                                        \
+            if (entry->hash == hash && POINTER_HASHTABLE_##K##_##V##_key_equal(hashtable, entry->key, key) == 1) return entry;                  \
+            i = (i + 1) & mask;                                                                                                                 \
+        }                                                                                                                                       \
+    }
+
+#endif // NESQUIK_ROBIN_POINTER_HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,352 @@
+#ifndef NESQUIK_SHARDED_HASHTABLE_H
+#define NESQUIK_SHARDED_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "thread/thread_pool.h"
+
+// Shared-nothing front-end over N independent classic HASHTABLEs, expanded next to HASHTABLE_DECLARE/DEFINE.
+// The high hash bits pick the shard, a shard is only ever touched by the worker that owns it. Producers route
+// their keys into a ROUTER, which buffers them per shard, and every owner later drains its shards' buffers
+// from all routers. _ingest runs both phases on a THREAD_POOL, worker w owns shards w, w + workers, ...
+// _place is a best-effort NUMA hint: every worker re-allocates its own shards, so first-touch puts their pages
+// on the node the worker runs on at that moment. THREAD_POOL does not pin workers to CPUs, so the scheduler may
+// move a worker away from the node holding its shards. Pin the pool's threads externally to guarantee locality.
+// Shards grow on their owners' workers, so an allocator given to _init_allocator must be thread safe. Router
+// buffers and job scratch always come from libc.
+#define SHARDED_HASHTABLE_BUFFER_MIN_CAPACITY   64
+
+// Shard of a hash from its high bits, valid for any shard count
+static inline u32 SHARDED_HASHTABLE_shard_of(const u32 hash, const u32 shard_count) {
+    return (u32)(((u64)hash * shard_count) >> 32);
+}
+
+#define SHARDED_HASHTABLE_DECLARE(K, V)                                                                                 \
+    typedef struct SHARDED_HASHTABLE_ITEM_##K##_##V {                                                                   \
+        u32 hash;                                                                                                       \
+        K key;                                                                                                          \
+        V value;                                                                                                        \
+    } SHARDED_HASHTABLE_ITEM_##K##_##V;                                                                                 \
+                                                                                                                        \
+    typedef struct SHARDED_HASHTABLE_BUFFER_##K##_##V {                                                                 \
+        SHARDED_HASHTABLE_ITEM_##K##_##V* items;                                                                        \
+        u32 size;                                                                                                       \
+        u32 capacity;                                                                                                   \
+    } SHARDED_HASHTABLE_BUFFER_##K##_##V;                                                                               \
+                                                                                                                        \
+    typedef struct SHARDED_HASHTABLE_##K##_##V {                                                                        \
+        HASHTABLE_##K##_##V* shards;                                                                                    \
+        u32 shard_count;                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator;                                                                             \
+    } SHARDED_HASHTABLE_##K##_##V;                                                                                      \
+                                                                                                                        \
+    typedef struct SHARDED_HASHTABLE_ROUTER_##K##_##V {                                                                 \
+        SHARDED_HASHTABLE_##K##_##V* hashtable;                                                                         \
+        SHARDED_HASHTABLE_BUFFER_##K##_##V* buffers;                                                                    \
+    } SHARDED_HASHTABLE_ROUTER_##K##_##V;                                                                               \
+                                                                                                                        \
+    u8 SHARDED_HASHTABLE_##K##_##V##_init(SHARDED_HASHTABLE_##K##_##V* hashtable, u32 shard_count, u32 capacity);       \
+    u8 SHARDED_HASHTABLE_##K##_##V##_init_allocator(SHARDED_HASHTABLE_##K##_##V* hashtable, u32 shard_count,            \
+        u32 capacity, const NESQUIK_ALLOCATOR* allocator);                                                              \
+    SHARDED_HASHTABLE_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_create(u32 shard_count, u32 capacity);                   \
+    SHARDED_HASHTABLE_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_create_allocator(u32 shard_count, u32 capacity,          \
+        const NESQUIK_ALLOCATOR* allocator);                                                                            \
+                                                                                                                        \
+    void SHARDED_HASHTABLE_##K##_##V##_deinit(SHARDED_HASHTABLE_##K##_##V* hashtable);                                  \
+    void SHARDED_HASHTABLE_##K##_##V##_destroy(SHARDED_HASHTABLE_##K##_##V* hashtable);                                 \
+                                                                                                                        \
+    u8 SHARDED_HASHTABLE_##K##_##V##_place(SHARDED_HASHTABLE_##K##_##V* hashtable, THREAD_POOL* pool);                  \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_shard(const SHARDED_HASHTABLE_##K##_##V* hashtable, K key);      \
+    u8 SHARDED_HASHTABLE_##K##_##V##_upsert(SHARDED_HASHTABLE_##K##_##V* hashtable, K key, V value);                    \
+    void SHARDED_HASHTABLE_##K##_##V##_remove(SHARDED_HASHTABLE_##K##_##V* hashtable, K key);                           \
+    u8 SHARDED_HASHTABLE_##K##_##V##_contains(const SHARDED_HASHTABLE_##K##_##V* hashtable, K key);                     \
+    HASHTABLE_ENTRY_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_find(const SHARDED_HASHTABLE_##K##_##V* hashtable,         \
+        K key);                                                                                                         \
+    u32 SHARDED_HASHTABLE_##K##_##V##_size(const SHARDED_HASHTABLE_##K##_##V* hashtable);                               \
+                                                                                                                        \
+    u8 SHARDED_HASHTABLE_##K##_##V##_router_init(SHARDED_HASHTABLE_ROUTER_##K##_##V* router,                            \
+        SHARDED_HASHTABLE_##K##_##V* hashtable);                                                                        \
+    void SHARDED_HASHTABLE_##K##_##V##_router_deinit(SHARDED_HASHTABLE_ROUTER_##K##_##V* router);                       \
+    u8 SHARDED_HASHTABLE_##K##_##V##_route(SHARDED_HASHTABLE_ROUTER_##K##_##V* router, K key, V value);                 \
+    u8 SHARDED_HASHTABLE_##K##_##V##_drain(SHARDED_HASHTABLE_##K##_##V* hashtable, u32 shard,                           \
+        SHARDED_HASHTABLE_ROUTER_##K##_##V* routers, u32 router_count);                                                 \
+                                                                                                                        \
+    u8 SHARDED_HASHTABLE_##K##_##V##_ingest(SHARDED_HASHTABLE_##K##_##V* hashtable, const K* keys,                      \
+        const V* values, u32 n, THREAD_POOL* pool);
+
+#define SHARDED_HASHTABLE_DEFINE(K, V)                                                                                          \
+    typedef struct SHARDED_HASHTABLE_JOB_##K##_##V {                                                                            \
+        SHARDED_HASHTABLE_##K##_##V* hashtable;                                                                                 \
+        SHARDED_HASHTABLE_ROUTER_##K##_##V* routers;                                                                            \
+        const K* keys;                                                                                                          \
+        const V* values;                                                                                                        \
+        u32 n;                                                                                                                  \
+        u8* failed;                                                                                                             \
+    } SHARDED_HASHTABLE_JOB_##K##_##V;                                                                                          \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_init(SHARDED_HASHTABLE_##K##_##V* hashtable, const u32 shard_count,                        \
+        const u32 capacity) {                                                                                                   \
+                                                                                                                                \
+        return SHARDED_HASHTABLE_##K##_##V##_init_allocator(hashtable, shard_count, capacity, NULL);                            \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_init_allocator(SHARDED_HASHTABLE_##K##_##V* hashtable, const u32 shard_count,              \
+        const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {                                                               \
+                                                                                                                                \
+        if (hashtable == NULL || shard_count == 0) return 0;                                                                    \
+                                                                                                                                \
+        hashtable->allocator = allocator;                                                                                       \
+        hashtable->shards = (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                                      \
+            sizeof(HASHTABLE_##K##_##V) * shard_count);                                                                         \
+        if (hashtable->shards == NULL) return 0;                                                                                \
+                                                                                                                                \
+        const u32 shard_capacity = capacity / shard_count;                                                                      \
+        for (u32 i = 0; i < shard_count; i++) {                                                                                 \
+            HASHTABLE_##K##_##V* shard = hashtable->shards + i;                                                                 \
+            if (HASHTABLE_##K##_##V##_init_allocator(shard, shard_capacity, allocator) == 1) continue;                          \
+                                                                                                                                \
+            hashtable->shard_count = i;                                                                                         \
+            SHARDED_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                    \
+            return 0;                                                                                                           \
+        }                                                                                                                       \
+                                                                                                                                \
+        hashtable->shard_count = shard_count;                                                                                   \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    SHARDED_HASHTABLE_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_create(const u32 shard_count, const u32 capacity) {              \
+        return SHARDED_HASHTABLE_##K##_##V##_create_allocator(shard_count, capacity, NULL);                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    SHARDED_HASHTABLE_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_create_allocator(const u32 shard_count,                          \
+        const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {                                                               \
+                                                                                                                                \
+        SHARDED_HASHTABLE_##K##_##V* hashtable =                                                                                \
+            (SHARDED_HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator, sizeof(SHARDED_HASHTABLE_##K##_##V));                        \
+        if (hashtable == NULL) return NULL;                                                                                     \
+                                                                                                                                \
+        const u8 r = SHARDED_HASHTABLE_##K##_##V##_init_allocator(hashtable, shard_count, capacity, allocator);                 \
+        if (r == 0) {                                                                                                           \
+            NESQUIK_free(allocator, hashtable);                                                                                 \
+            return NULL;                                                                                                        \
+        }                                                                                                                       \
+                                                                                                                                \
+        return hashtable;                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    void SHARDED_HASHTABLE_##K##_##V##_deinit(SHARDED_HASHTABLE_##K##_##V* hashtable) {                                         \
+        if (hashtable == NULL) return;                                                                                          \
+                                                                                                                                \
+        for (u32 i = 0; i < hashtable->shard_count; i++) HASHTABLE_##K##_##V##_deinit(hashtable->shards + i);                   \
+        NESQUIK_free(hashtable->allocator, hashtable->shards);                                                                  \
+        hashtable->shards = NULL;                                                                                               \
+        hashtable->shard_count = 0;                                                                                             \
+    }                                                                                                                           \
+                                                                                                                                \
+    void SHARDED_HASHTABLE_##K##_##V##_destroy(SHARDED_HASHTABLE_##K##_##V* hashtable) {                                        \
+        if (hashtable == NULL) return;                                                                                          \
+                                                                                                                                \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                              \
+        SHARDED_HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
+        NESQUIK_free(allocator, hashtable);                                                                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    static void SHARDED_HASHTABLE_##K##_##V##_place_task(void* context, const u32 worker, const u32 workers) {                  \
+        SHARDED_HASHTABLE_JOB_##K##_##V* job = (SHARDED_HASHTABLE_JOB_##K##_##V*)context;                                       \
+        SHARDED_HASHTABLE_##K##_##V* hashtable = job->hashtable;                                                                \
+                                                                                                                                \
+        for (u32 s = worker; s < hashtable->shard_count; s += workers) {                                                        \
+            HASHTABLE_##K##_##V* shard = hashtable->shards + s;                                                                 \
+            if (HASHTABLE_##K##_##V##_resize(shard, shard->capacity) == 0) job->failed[worker] = 1;                             \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_place(SHARDED_HASHTABLE_##K##_##V* hashtable, THREAD_POOL* pool) {                         \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        const u32 workers = THREAD_POOL_workers(pool);                                                                          \
+        SHARDED_HASHTABLE_JOB_##K##_##V job = { .hashtable = hashtable };                                                       \
+        job.failed = (u8*)calloc(workers, sizeof(u8));                                                                          \
+        if (job.failed == NULL) return 0;                                                                                       \
+                                                                                                                                \
+        THREAD_POOL_run(pool, SHARDED_HASHTABLE_##K##_##V##_place_task, &job);                                                  \
+                                                                                                                                \
+        u8 r = 1;                                                                                                               \
+        for (u32 w = 0; w < workers; w++) r = job.failed[w] == 1 ? 0 : r;                                                       \
+        free(job.failed);                                                                                                       \
+        return r;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    HASHTABLE_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_shard(const SHARDED_HASHTABLE_##K##_##V* hashtable,                      \
+        const K key) {                                                                                                          \
+                                                                                                                                \
+        if (hashtable == NULL) return NULL;                                                                                     \
+                                                                                                                                \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                                   \
+        return hashtable->shards + SHARDED_HASHTABLE_shard_of(hash, hashtable->shard_count);                                    \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_upsert(SHARDED_HASHTABLE_##K##_##V* hashtable, const K key, const V value) {               \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                                   \
+        HASHTABLE_##K##_##V* shard = hashtable->shards + SHARDED_HASHTABLE_shard_of(hash, hashtable->shard_count);              \
+        return HASHTABLE_##K##_##V##_quick_upsert(shard, hash, key, value);                                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    void SHARDED_HASHTABLE_##K##_##V##_remove(SHARDED_HASHTABLE_##K##_##V* hashtable, const K key) {                            \
+        if (hashtable == NULL) return;                                                                                          \
+                                                                                                                                \
+        HASHTABLE_##K##_##V##_remove(SHARDED_HASHTABLE_##K##_##V##_shard(hashtable, key), key);                                 \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_contains(const SHARDED_HASHTABLE_##K##_##V* hashtable, const K key) {                      \
+        return SHARDED_HASHTABLE_##K##_##V##_find(hashtable, key) != NULL;                                                      \
+    }                                                                                                                           \
+                                                                                                                                \
+    HASHTABLE_ENTRY_##K##_##V* SHARDED_HASHTABLE_##K##_##V##_find(const SHARDED_HASHTABLE_##K##_##V* hashtable,                 \
+        const K key) {                                                                                                          \
+                                                                                                                                \
+        if (hashtable == NULL) return NULL;                                                                                     \
+                                                                                                                                \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                                   \
+        const HASHTABLE_##K##_##V* shard = hashtable->shards + SHARDED_HASHTABLE_shard_of(hash, hashtable->shard_count);        \
+        return HASHTABLE_##K##_##V##_find_hashed(shard, hash, key);                                                             \
+    }                                                                                                                           \
+                                                                                                                                \
+    u32 SHARDED_HASHTABLE_##K##_##V##_size(const SHARDED_HASHTABLE_##K##_##V* hashtable) {                                      \
+        if (hashtable == NULL) return 0;                                                                                        \
+                                                                                                                                \
+        u32 size = 0;                                                                                                           \
+        for (u32 i = 0; i < hashtable->shard_count; i++) size += hashtable->shards[i].size;                                     \
+        return size;                                                                                                            \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_router_init(SHARDED_HASHTABLE_ROUTER_##K##_##V* router,                                    \
+        SHARDED_HASHTABLE_##K##_##V* hashtable) {                                                                               \
+                                                                                                                                \
+        if (router == NULL || hashtable == NULL) return 0;                                                                      \
+                                                                                                                                \
+        router->hashtable = hashtable;                                                                                          \
+        router->buffers = (SHARDED_HASHTABLE_BUFFER_##K##_##V*)calloc(hashtable->shard_count,                                   \
+            sizeof(SHARDED_HASHTABLE_BUFFER_##K##_##V));                                                                        \
+        if (router->buffers == NULL) return 0;                                                                                  \
+                                                                                                                                \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    void SHARDED_HASHTABLE_##K##_##V##_router_deinit(SHARDED_HASHTABLE_ROUTER_##K##_##V* router) {                              \
+        if (router == NULL || router->buffers == NULL) return;                                                                  \
+                                                                                                                                \
+        for (u32 i = 0; i < router->hashtable->shard_count; i++) free(router->buffers[i].items);                                \
+        free(router->buffers);                                                                                                  \
+        router->buffers = NULL;                                                                                                 \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_route(SHARDED_HASHTABLE_ROUTER_##K##_##V* router, const K key, const V value) {            \
+        if (router == NULL) return 0;                                                                                           \
+                                                                                                                                \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                                   \
+        SHARDED_HASHTABLE_BUFFER_##K##_##V* buffer =                                                                            \
+            router->buffers + SHARDED_HASHTABLE_shard_of(hash, router->hashtable->shard_count);                                 \
+                                                                                                                                \
+        if (buffer->size == buffer->capacity) {                                                                                 \
+            u32 capacity = buffer->capacity * 2;                                                                                \
+            capacity = capacity < SHARDED_HASHTABLE_BUFFER_MIN_CAPACITY ? SHARDED_HASHTABLE_BUFFER_MIN_CAPACITY : capacity;     \
+                                                                                                                                \
+            SHARDED_HASHTABLE_ITEM_##K##_##V* items = (SHARDED_HASHTABLE_ITEM_##K##_##V*)realloc(buffer->items,                 \
+                sizeof(SHARDED_HASHTABLE_ITEM_##K##_##V) * capacity);                                                           \
+            if (items == NULL) return 0;                                                                                        \
+                                                                                                                                \
+            buffer->items = items;                                                                                              \
+            buffer->capacity = capacity;                                                                                        \
+        }                                                                                                                       \
+                                                                                                                                \
+        SHARDED_HASHTABLE_ITEM_##K##_##V* item = buffer->items + buffer->size++;                                                \
+        item->hash = hash;                                                                                                      \
+        item->key = key;                                                                                                        \
+        item->value = value;                                                                                                    \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_drain(SHARDED_HASHTABLE_##K##_##V* hashtable, const u32 shard,                             \
+        SHARDED_HASHTABLE_ROUTER_##K##_##V* routers, const u32 router_count) {                                                  \
+                                                                                                                                \
+        if (hashtable == NULL || shard >= hashtable->shard_count) return 0;                                                     \
+                                                                                                                                \
+        u32 pending = 0;                                                                                                        \
+        for (u32 r = 0; r < router_count; r++) pending += routers[r].buffers[shard].size;                                       \
+                                                                                                                                \
+        HASHTABLE_##K##_##V* target = hashtable->shards + shard;                                                                \
+        if (HASHTABLE_##K##_##V##_reserve(target, target->size + pending) == 0) return 0;                                       \
+                                                                                                                                \
+        for (u32 r = 0; r < router_count; r++) {                                                                                \
+            SHARDED_HASHTABLE_BUFFER_##K##_##V* buffer = routers[r].buffers + shard;                                            \
+                                                                                                                                \
+            for (u32 i = 0; i < buffer->size; i++) {                                                                            \
+                const SHARDED_HASHTABLE_ITEM_##K##_##V* item = buffer->items + i;                                               \
+                if (HASHTABLE_##K##_##V##_quick_upsert(target, item->hash, item->key, item->value) == 0) return 0;              \
+            }                                                                                                                   \
+                                                                                                                                \
+            buffer->size = 0;                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        return 1;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    static void SHARDED_HASHTABLE_##K##_##V##_route_task(void* context, const u32 worker, const u32 workers) {                  \
+        SHARDED_HASHTABLE_JOB_##K##_##V* job = (SHARDED_HASHTABLE_JOB_##K##_##V*)context;                                       \
+        SHARDED_HASHTABLE_ROUTER_##K##_##V* router = job->routers + worker;                                                     \
+                                                                                                                                \
+        const u32 begin = THREAD_POOL_split(job->n, worker, workers);                                                           \
+        const u32 end = THREAD_POOL_split(job->n, worker + 1, workers);                                                         \
+        for (u32 i = begin; i < end; i++) {                                                                                     \
+            if (SHARDED_HASHTABLE_##K##_##V##_route(router, job->keys[i], job->values[i]) == 1) continue;                       \
+                                                                                                                                \
+            job->failed[worker] = 1;                                                                                            \
+            return;                                                                                                             \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    static void SHARDED_HASHTABLE_##K##_##V##_drain_task(void* context, const u32 worker, const u32 workers) {                  \
+        SHARDED_HASHTABLE_JOB_##K##_##V* job = (SHARDED_HASHTABLE_JOB_##K##_##V*)context;                                       \
+                                                                                                                                \
+        for (u32 s = worker; s < job->hashtable->shard_count; s += workers) {                                                   \
+            if (SHARDED_HASHTABLE_##K##_##V##_drain(job->hashtable, s, job->routers, workers) == 0) job->failed[worker] = 1;    \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    u8 SHARDED_HASHTABLE_##K##_##V##_ingest(SHARDED_HASHTABLE_##K##_##V* hashtable, const K* keys,                              \
+        const V* values, const u32 n, THREAD_POOL* pool) {                                                                      \
+                                                                                                                                \
+        if (hashtable == NULL || keys == NULL || values == NULL) return 0;                                                      \
+                                                                                                                                \
+        const u32 workers = THREAD_POOL_workers(pool);                                                                          \
+        SHARDED_HASHTABLE_JOB_##K##_##V job = { .hashtable = hashtable, .keys = keys, .values = values, .n = n };               \
+        job.routers = (SHARDED_HASHTABLE_ROUTER_##K##_##V*)calloc(workers, sizeof(SHARDED_HASHTABLE_ROUTER_##K##_##V));         \
+        job.failed = (u8*)calloc(workers, sizeof(u8));                                                                          \
+                                                                                                                                \
+        u8 r = job.routers != NULL && job.failed != NULL;                                                                       \
+        for (u32 w = 0; w < workers && r == 1; w++)                                                                             \
+            r = SHARDED_HASHTABLE_##K##_##V##_router_init(job.routers + w, hashtable);                                          \
+                                                                                                                                \
+        if (r == 1) THREAD_POOL_run(pool, SHARDED_HASHTABLE_##K##_##V##_route_task, &job);                                      \
+        for (u32 w = 0; w < workers && r == 1; w++) r = job.failed[w] == 0;                                                     \
+                                                                                                                                \
+        if (r == 1) THREAD_POOL_run(pool, SHARDED_HASHTABLE_##K##_##V##_drain_task, &job);                                      \
+        for (u32 w = 0; w < workers && r == 1; w++) r = job.failed[w] == 0;                                                     \
+                                                                                                                                \
+        for (u32 w = 0; job.routers != NULL && w < workers; w++)                                                                \
+            SHARDED_HASHTABLE_##K##_##V##_router_deinit(job.routers + w);                                                       \
+        free(job.routers);                                                                                                      \
+        free(job.failed);                                                                                                       \
+        return r;                                                                                                               \
+    }
+
+#endif //NESQUIK_SHARDED_HASHTABLE_H
\ No newline at end of file
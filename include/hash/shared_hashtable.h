@@ -0,0 +1,194 @@
+#ifndef NESQUIK_SHARED_HASHTABLE_H
+#define NESQUIK_SHARED_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/shared_memory.h"
+
+// Classic HASHTABLE entries living in a POSIX shared memory segment, expanded next to HASHTABLE_DECLARE/DEFINE.
+// One writer process creates the segment and changes it under a seqlock, any number of reader processes map it
+// read-only and look up with no lock and no copy of the table, retrying when the writer moved under them.
+// A segment cannot grow under its readers, so the capacity given at create is final.
+#define SHARED_HASHTABLE_DECLARE(K, V)                                                                      \
+    typedef struct SHARED_HASHTABLE_##K##_##V {                                                             \
+        SHARED_MEMORY_HEADER* header;                                                                       \
+        HASHTABLE_ENTRY_##K##_##V* entries;                                                                 \
+        u8 writer;                                                                                          \
+    } SHARED_HASHTABLE_##K##_##V;                                                                           \
+                                                                                                            \
+    SHARED_HASHTABLE_##K##_##V* SHARED_HASHTABLE_##K##_##V##_create(const char* name, u32 capacity);        \
+    SHARED_HASHTABLE_##K##_##V* SHARED_HASHTABLE_##K##_##V##_open(const char* name);                        \
+    void SHARED_HASHTABLE_##K##_##V##_destroy(SHARED_HASHTABLE_##K##_##V* hashtable);                       \
+                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_upsert(SHARED_HASHTABLE_##K##_##V* hashtable, K key, V value);          \
+    u8 SHARED_HASHTABLE_##K##_##V##_remove(SHARED_HASHTABLE_##K##_##V* hashtable, K key);                   \
+    u8 SHARED_HASHTABLE_##K##_##V##_publish(SHARED_HASHTABLE_##K##_##V* hashtable,                          \
+        const HASHTABLE_##K##_##V* source);                                                                 \
+                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_get(const SHARED_HASHTABLE_##K##_##V* hashtable, K key, V* value);      \
+    u8 SHARED_HASHTABLE_##K##_##V##_contains(const SHARED_HASHTABLE_##K##_##V* hashtable, K key);           \
+    u32 SHARED_HASHTABLE_##K##_##V##_size(const SHARED_HASHTABLE_##K##_##V* hashtable);
+
+#define SHARED_HASHTABLE_DEFINE(K, V)                                                                                       \
+    static inline void SHARED_HASHTABLE_##K##_##V##_layout(SHARED_MEMORY_HEADER* layout, const u32 capacity) {              \
+        layout->entry_size = sizeof(HASHTABLE_ENTRY_##K##_##V);                                                             \
+        layout->key_size = sizeof(K);                                                                                       \
+        layout->value_size = sizeof(V);                                                                                     \
+        layout->capacity = capacity;                                                                                        \
+    }                                                                                                                       \
+                                                                                                                            \
+    static inline HASHTABLE_##K##_##V SHARED_HASHTABLE_##K##_##V##_view(const SHARED_HASHTABLE_##K##_##V* hashtable) {      \
+        HASHTABLE_##K##_##V view;                                                                                           \
+        memset(&view, 0, sizeof(view));                                                                                     \
+        view.entries = hashtable->entries;                                                                                  \
+        view.size = hashtable->header->size;                                                                                \
+        view.capacity = hashtable->header->capacity;                                                                        \
+        view.tombstones = hashtable->header->tombstones;                                                                    \
+        return view;                                                                                                        \
+    }                                                                                                                       \
+                                                                                                                            \
+    static inline void SHARED_HASHTABLE_##K##_##V##_store(SHARED_HASHTABLE_##K##_##V* hashtable,                            \
+        const HASHTABLE_##K##_##V* view) {                                                                                  \
+                                                                                                                            \
+        hashtable->header->size = view->size;                                                                               \
+        hashtable->header->tombstones = view->tombstones;                                                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    static SHARED_HASHTABLE_##K##_##V* SHARED_HASHTABLE_##K##_##V##_wrap(SHARED_MEMORY_HEADER* header,                      \
+        const u8 writer) {                                                                                                  \
+                                                                                                                            \
+        if (header == NULL) return NULL;                                                                                    \
+                                                                                                                            \
+        SHARED_HASHTABLE_##K##_##V* hashtable =                                                                             \
+            (SHARED_HASHTABLE_##K##_##V*)malloc(sizeof(SHARED_HASHTABLE_##K##_##V));                                        \
+        if (hashtable == NULL) {                                                                                            \
+            SHARED_MEMORY_close(header);                                                                                    \
+            return NULL;                                                                                                    \
+        }                                                                                                                   \
+                                                                                                                            \
+        hashtable->header = header;                                                                                         \
+        hashtable->entries = (HASHTABLE_ENTRY_##K##_##V*)SHARED_MEMORY_entries(header);                                     \
+        hashtable->writer = writer;                                                                                         \
+        return hashtable;                                                                                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    SHARED_HASHTABLE_##K##_##V* SHARED_HASHTABLE_##K##_##V##_create(const char* name, const u32 capacity) {                 \
+        SHARED_MEMORY_HEADER layout;                                                                                        \
+        const u32 slots = (u32)(capacity / HASHTABLE_MAX_LOAD_FACTOR) + 1;                                                  \
+        SHARED_HASHTABLE_##K##_##V##_layout(&layout, slots < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : slots);      \
+        return SHARED_HASHTABLE_##K##_##V##_wrap(SHARED_MEMORY_create(name, &layout), 1);                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    SHARED_HASHTABLE_##K##_##V* SHARED_HASHTABLE_##K##_##V##_open(const char* name) {                                       \
+        SHARED_MEMORY_HEADER layout;                                                                                        \
+        SHARED_HASHTABLE_##K##_##V##_layout(&layout, 0);                                                                    \
+        return SHARED_HASHTABLE_##K##_##V##_wrap((SHARED_MEMORY_HEADER*)SHARED_MEMORY_open(name, &layout), 0);              \
+    }                                                                                                                       \
+                                                                                                                            \
+    void SHARED_HASHTABLE_##K##_##V##_destroy(SHARED_HASHTABLE_##K##_##V* hashtable) {                                      \
+        if (hashtable == NULL) return;                                                                                      \
+                                                                                                                            \
+        SHARED_MEMORY_close(hashtable->header);                                                                             \
+        free(hashtable);                                                                                                    \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_upsert(SHARED_HASHTABLE_##K##_##V* hashtable, const K key, const V value) {             \
+        if (hashtable == NULL || hashtable->writer == 0) return 0;                                                          \
+                                                                                                                            \
+        HASHTABLE_##K##_##V view = SHARED_HASHTABLE_##K##_##V##_view(hashtable);                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+                                                                                                                            \
+        HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(&view, hash, key);                             \
+        if (entry != NULL) {                                                                                                \
+            SHARED_MEMORY_write_begin(hashtable->header);                                                                   \
+            entry->value = value;                                                                                           \
+            SHARED_MEMORY_write_end(hashtable->header);                                                                     \
+            return 1;                                                                                                       \
+        }                                                                                                                   \
+                                                                                                                            \
+        if ((view.size + 1.0) / view.capacity >= HASHTABLE_MAX_LOAD_FACTOR) return 0;                                       \
+                                                                                                                            \
+        SHARED_MEMORY_write_begin(hashtable->header);                                                                       \
+        if ((view.size + view.tombstones + 1.0) / view.capacity >= HASHTABLE_MAX_LOAD_FACTOR)                               \
+            HASHTABLE_##K##_##V##_rehash(&view);                                                                            \
+                                                                                                                            \
+        const u8 r = HASHTABLE_##K##_##V##_quick_add(&view, hash, key, value);                                              \
+        SHARED_HASHTABLE_##K##_##V##_store(hashtable, &view);                                                               \
+        SHARED_MEMORY_write_end(hashtable->header);                                                                         \
+        return r;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_remove(SHARED_HASHTABLE_##K##_##V* hashtable, const K key) {                            \
+        if (hashtable == NULL || hashtable->writer == 0) return 0;                                                          \
+                                                                                                                            \
+        HASHTABLE_##K##_##V view = SHARED_HASHTABLE_##K##_##V##_view(hashtable);                                            \
+        if (HASHTABLE_##K##_##V##_contains(&view, key) == 0) return 0;                                                      \
+                                                                                                                            \
+        SHARED_MEMORY_write_begin(hashtable->header);                                                                       \
+        HASHTABLE_##K##_##V##_remove(&view, key);                                                                           \
+        SHARED_HASHTABLE_##K##_##V##_store(hashtable, &view);                                                               \
+        SHARED_MEMORY_write_end(hashtable->header);                                                                         \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_publish(SHARED_HASHTABLE_##K##_##V* hashtable,                                          \
+        const HASHTABLE_##K##_##V* source) {                                                                                \
+                                                                                                                            \
+        if (hashtable == NULL || source == NULL || hashtable->writer == 0) return 0;                                        \
+                                                                                                                            \
+        HASHTABLE_##K##_##V view = SHARED_HASHTABLE_##K##_##V##_view(hashtable);                                            \
+        if ((source->size + 0.0) / view.capacity >= HASHTABLE_MAX_LOAD_FACTOR) return 0;                                    \
+                                                                                                                            \
+        SHARED_MEMORY_write_begin(hashtable->header);                                                                       \
+        memset(view.entries, 0, sizeof(HASHTABLE_ENTRY_##K##_##V) * view.capacity);                                         \
+        view.size = 0;                                                                                                      \
+        view.tombstones = 0;                                                                                                \
+                                                                                                                            \
+        for (u32 i = 0; i < source->capacity; i++) {                                                                        \
+            const HASHTABLE_ENTRY_##K##_##V* entry = source->entries + i;                                                   \
+            if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED)                                                             \
+                HASHTABLE_##K##_##V##_quick_add(&view, entry->hash, entry->key, entry->value);                              \
+        }                                                                                                                   \
+                                                                                                                            \
+        SHARED_HASHTABLE_##K##_##V##_store(hashtable, &view);                                                               \
+        SHARED_MEMORY_write_end(hashtable->header);                                                                         \
+        return 1;                                                                                                           \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_get(const SHARED_HASHTABLE_##K##_##V* hashtable, const K key, V* value) {               \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                               \
+        for (;;) {                                                                                                          \
+            const u32 sequence = SHARED_MEMORY_read_begin(hashtable->header);                                               \
+            const HASHTABLE_##K##_##V view = SHARED_HASHTABLE_##K##_##V##_view(hashtable);                                  \
+            const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(&view, hash, key);                   \
+                                                                                                                            \
+            V found;                                                                                                        \
+            if (entry != NULL) found = entry->value;                                                                        \
+            if (SHARED_MEMORY_read_retry(hashtable->header, sequence) == 1) continue;                                       \
+                                                                                                                            \
+            if (entry != NULL && value != NULL) *value = found;                                                             \
+            return entry != NULL;                                                                                           \
+        }                                                                                                                   \
+    }                                                                                                                       \
+                                                                                                                            \
+    u8 SHARED_HASHTABLE_##K##_##V##_contains(const SHARED_HASHTABLE_##K##_##V* hashtable, const K key) {                    \
+        return SHARED_HASHTABLE_##K##_##V##_get(hashtable, key, NULL);                                                      \
+    }                                                                                                                       \
+                                                                                                                            \
+    u32 SHARED_HASHTABLE_##K##_##V##_size(const SHARED_HASHTABLE_##K##_##V* hashtable) {                                    \
+        if (hashtable == NULL) return 0;                                                                                    \
+                                                                                                                            \
+        for (;;) {                                                                                                          \
+            const u32 sequence = SHARED_MEMORY_read_begin(hashtable->header);                                               \
+            const u32 size = hashtable->header->size;                                                                       \
+            if (SHARED_MEMORY_read_retry(hashtable->header, sequence) == 0) return size;                                    \
+        }                                                                                                                   \
+    }
+
+#endif //NESQUIK_SHARED_HASHTABLE_H
\ No newline at end of file
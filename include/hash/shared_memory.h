@@ -0,0 +1,71 @@
+#ifndef NESQUIK_SHARED_MEMORY_H
+#define NESQUIK_SHARED_MEMORY_H
+
+#include <stdatomic.h>
+
+#include "types.h"
+
+// POSIX shared memory segments behind the SHARED_* containers: this header at offset 0 and the entries at
+// entries_offset. Nothing in the segment is a pointer, so every process maps it at whatever address it gets.
+#define SHARED_MEMORY_MAGIC         0x4D48535155534E45ULL
+#define SHARED_MEMORY_VERSION       1
+#define SHARED_MEMORY_CACHE_LINE    64
+
+typedef struct {
+    u64 magic;
+    u32 version;
+
+    u32 entry_size;
+    u32 key_size;
+    u32 value_size;
+    u32 capacity;
+
+    u64 entries_offset;
+    u64 bytes;
+
+    // Seqlock of the single writer, odd while it is changing the segment. size and tombstones change under it.
+    _Alignas(SHARED_MEMORY_CACHE_LINE) _Atomic u32 sequence;
+    u32 size;
+    u32 tombstones;
+} SHARED_MEMORY_HEADER;
+
+// Replaces any segment of that name with a zeroed one shaped after layout (sizes and capacity), mapped writable.
+// Processes that still map the old segment keep reading it until they reopen.
+SHARED_MEMORY_HEADER* SHARED_MEMORY_create(const char* name, const SHARED_MEMORY_HEADER* layout);
+
+// Maps an existing segment read-only if it matches the sizes of layout
+const SHARED_MEMORY_HEADER* SHARED_MEMORY_open(const char* name, const SHARED_MEMORY_HEADER* layout);
+
+void SHARED_MEMORY_close(const SHARED_MEMORY_HEADER* header);
+u8 SHARED_MEMORY_unlink(const char* name);
+
+static inline void* SHARED_MEMORY_entries(const SHARED_MEMORY_HEADER* header) {
+    return (u8*)header + header->entries_offset;
+}
+
+static inline void SHARED_MEMORY_write_begin(SHARED_MEMORY_HEADER* header) {
+    const u32 sequence = atomic_load_explicit(&header->sequence, memory_order_relaxed);
+    atomic_store_explicit(&header->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void SHARED_MEMORY_write_end(SHARED_MEMORY_HEADER* header) {
+    const u32 sequence = atomic_load_explicit(&header->sequence, memory_order_relaxed);
+    atomic_store_explicit(&header->sequence, sequence + 1, memory_order_release);
+}
+
+// Yields until the writer is done and returns the even sequence, out of line since readers rarely get there
+u32 SHARED_MEMORY_wait(const SHARED_MEMORY_HEADER* header);
+
+static inline u32 SHARED_MEMORY_read_begin(const SHARED_MEMORY_HEADER* header) {
+    const u32 sequence = atomic_load_explicit(&header->sequence, memory_order_acquire);
+    return sequence & 1 ? SHARED_MEMORY_wait(header) : sequence;
+}
+
+// 1 when the writer moved while reading, whatever was read must be thrown away
+static inline u8 SHARED_MEMORY_read_retry(const SHARED_MEMORY_HEADER* header, const u32 sequence) {
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&header->sequence, memory_order_relaxed) != sequence;
+}
+
+#endif //NESQUIK_SHARED_MEMORY_H
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef NESQUIK_SWISS_GROUP_H
+#define NESQUIK_SWISS_GROUP_H
+
+#include <string.h>
+
+#include "types.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Control bytes of the swiss engine. A full slot holds the top 7 bits of its hash.
+#define SWISS_CONTROL_EMPTY         0x80
+#define SWISS_CONTROL_DELETED       0xFE
+
+#define SWISS_GROUP_WIDTH           16
+
+#define SWISS_MIN_CAPACITY          SWISS_GROUP_WIDTH
+#define SWISS_MAX_LOAD(capacity)    ((capacity) - (capacity) / 8)
+
+#define SWISS_H1(hash)              (hash)
+#define SWISS_H2(hash)              ((u8)((hash) >> 25))
+
+#define SWISS_LSB                   0x0101010101010101ULL
+#define SWISS_MSB                   0x8080808080808080ULL
+
+static inline u32 SWISS_ctz(const u32 mask) {
+#if defined(__GNUC__)
+    return (u32)__builtin_ctz(mask);
+#else
+    u32 i = 0;
+    while (((mask >> i) & 1) == 0) i++;
+    return i;
+#endif
+}
+
+#if defined(__SSE2__)
+
+// Bit i of the result is set when slot i of the 16 slot group matches
+static inline u32 SWISS_GROUP_match(const u8* group, const u8 h2) {
+    const __m128i control = _mm_loadu_si128((const __m128i*)group);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)h2)));
+}
+
+static inline u32 SWISS_GROUP_match_empty(const u8* group) {
+    const __m128i control = _mm_loadu_si128((const __m128i*)group);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)SWISS_CONTROL_EMPTY)));
+}
+
+static inline u32 SWISS_GROUP_match_empty_or_deleted(const u8* group) {
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+}
+
+#else
+
+// SWAR fallback, two 8 byte words per group
+static inline u64 SWISS_WORD_load(const u8* group) {
+    u64 word;
+    memcpy(&word, group, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+// Gathers the top bit of every byte into an 8 bit mask
+static inline u32 SWISS_WORD_mask(const u64 bits) {
+    return (u32)((((bits >> 7) & SWISS_LSB) * 0x0102040810204080ULL) >> 56);
+}
+
+// May report a false positive next to a real match, callers compare keys anyway
+static inline u32 SWISS_WORD_match(const u64 word, const u8 h2) {
+    const u64 x = word ^ (SWISS_LSB * h2);
+    return SWISS_WORD_mask((x - SWISS_LSB) & ~x & SWISS_MSB);
+}
+
+static inline u32 SWISS_GROUP_match(const u8* group, const u8 h2) {
+    return SWISS_WORD_match(SWISS_WORD_load(group), h2) |
+        (SWISS_WORD_match(SWISS_WORD_load(group + 8), h2) << 8);
+}
+
+static inline u32 SWISS_GROUP_match_empty(const u8* group) {
+    const u64 lo = SWISS_WORD_load(group);
+    const u64 hi = SWISS_WORD_load(group + 8);
+    return SWISS_WORD_mask(lo & ~(lo << 6) & SWISS_MSB) | (SWISS_WORD_mask(hi & ~(hi << 6) & SWISS_MSB) << 8);
+}
+
+static inline u32 SWISS_GROUP_match_empty_or_deleted(const u8* group) {
+    return SWISS_WORD_mask(SWISS_WORD_load(group) & SWISS_MSB) |
+        (SWISS_WORD_mask(SWISS_WORD_load(group + 8) & SWISS_MSB) << 8);
+}
+
+#endif
+
+static inline u32 SWISS_GROUP_match_full(const u8* group) {
+    return ~SWISS_GROUP_match_empty_or_deleted(group) & 0xFFFF;
+}
+
+#endif //NESQUIK_SWISS_GROUP_H
\ No newline at end of file
@@ -0,0 +1,361 @@
+#ifndef NESQUIK_SWISS_HASHSET_H
+#define NESQUIK_SWISS_HASHSET_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashset.h"
+#include "hash/swiss_group.h"
+
+// Swiss table engine behind the HASHSET API. Swapping HASHSET_DECLARE/HASHSET_DEFINE for
+// HASHSET_DECLARE_SWISS/HASHSET_DEFINE_SWISS keeps every call site compiling. Entries do not store their hash,
+// growing recomputes it with _key_hash, so the hash passed to _quick_add and the *_hashed lookups must be
+// _key_hash(key). A set keyed by some other hash needs the classic engine, which keeps the caller's hash.
+#define HASHSET_DECLARE_SWISS_TYPES(K)                                                              \
+    typedef struct HASHSET_ENTRY_##K {                                                              \
+        K key;                                                                                      \
+    } HASHSET_ENTRY_##K;                                                                            \
+                                                                                                    \
+    typedef struct HASHSET_##K {                                                                    \
+        u8* control;                                                                                \
+        HASHSET_ENTRY_##K* entries;                                                                 \
+        u32 size;                                                                                   \
+        u32 capacity;                                                                               \
+        u32 tombstones;                                                                             \
+        u32 growth_left;                                                                            \
+        const NESQUIK_ALLOCATOR* allocator;                                                         \
+    } HASHSET_##K;                                                                                  \
+                                                                                                    \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, u32 capacity);                                      \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, u32 capacity,                             \
+        const NESQUIK_ALLOCATOR* allocator);                                                        \
+    HASHSET_##K* HASHSET_##K##_create(u32 capacity);                                                \
+    HASHSET_##K* HASHSET_##K##_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);  \
+                                                                                                    \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset);                                                \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset);                                               \
+                                                                                                    \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset);                                                    \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, K key);                                              \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, u32 hash, K key);                              \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, K key);                                         \
+                                                                                                    \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, K key);                                   \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, K key);                       \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, u32 hash, K key);                  \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, u32 hash, K key);      \
+                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b);                   \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b);            \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b);
+
+#define HASHSET_DECLARE_SWISS_HASH(K, HASH_F)       \
+    HASHSET_DECLARE_SWISS_TYPES(K)                  \
+    HASHSET_DECLARE_KEY_HASH(K, HASH_F)
+
+#define HASHSET_DECLARE_SWISS_EX(K, HASH_FN, EQ_FN)     \
+    HASHSET_DECLARE_SWISS_TYPES(K)                      \
+    HASHSET_DECLARE_KEY_EX(K, HASH_FN, EQ_FN)
+
+#define HASHSET_DECLARE_SWISS(K) HASHSET_DECLARE_SWISS_HASH(K, HASH_fnv1a)
+
+// Capacity is a power of two split into 16 slot groups probed triangularly. Growth doubles the table
+// when live entries use up the load budget and rebuilds in place when tombstones do.
+#define HASHSET_DEFINE_SWISS(K)                                                                                     \
+    u8 HASHSET_##K##_init(HASHSET_##K* hashset, const u32 capacity) {                                               \
+        return HASHSET_##K##_init_allocator(hashset, capacity, NULL);                                               \
+    }                                                                                                               \
+                                                                                                                    \
+    u8 HASHSET_##K##_init_allocator(HASHSET_##K* hashset, const u32 capacity, const NESQUIK_ALLOCATOR* allocator) { \
+        if (hashset == NULL) return 0;                                                                              \
+                                                                                                                    \
+        u32 new_capacity = SWISS_MIN_CAPACITY;                                                                      \
+        while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;                            \
+                                                                                                                    \
+        hashset->allocator = allocator;                                                                             \
+        hashset->size = 0;                                                                                          \
+        hashset->capacity = new_capacity;                                                                           \
+        hashset->tombstones = 0;                                                                                    \
+        hashset->growth_left = SWISS_MAX_LOAD(new_capacity);                                                        \
+                                                                                                                    \
+        hashset->control = (u8*)NESQUIK_alloc(allocator, new_capacity);                                             \
+        hashset->entries = (HASHSET_ENTRY_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_ENTRY_##K) * new_capacity);  \
+        if (hashset->control == NULL || hashset->entries == NULL) {                                                 \
+            NESQUIK_free(allocator, hashset->control);                                                              \
+            NESQUIK_free(allocator, hashset->entries);                                                              \
+            hashset->control = NULL;                                                                                \
+            hashset->entries = NULL;                                                                                \
+            hashset->capacity = 0;                                                                                  \
+            hashset->growth_left = 0;                                                                               \
+            return 0;                                                                                               \
+        }                                                                                                           \
+                                                                                                                    \
+        memset(hashset->control, SWISS_CONTROL_EMPTY, new_capacity);                                                \
+                                                                                                                    \
+        return 1;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_create(const u32 capacity) {                                                         \
+        return HASHSET_##K##_create_allocator(capacity, NULL);                                                      \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {           \
+        HASHSET_##K* hashset = (HASHSET_##K*)NESQUIK_alloc(allocator, sizeof(HASHSET_##K));                         \
+        if (hashset == NULL) return NULL;                                                                           \
+                                                                                                                    \
+        const u8 r = HASHSET_##K##_init_allocator(hashset, capacity, allocator);                                    \
+        if (r == 0) {                                                                                               \
+            NESQUIK_free(allocator, hashset);                                                                       \
+            return NULL;                                                                                            \
+        }                                                                                                           \
+                                                                                                                    \
+        return hashset;                                                                                             \
+    }                                                                                                               \
+                                                                                                                    \
+    void HASHSET_##K##_deinit(HASHSET_##K* hashset) {                                                               \
+        if (hashset == NULL) return;                                                                                \
+        hashset->size = 0;                                                                                          \
+        hashset->capacity = 0;                                                                                      \
+        hashset->tombstones = 0;                                                                                    \
+        hashset->growth_left = 0;                                                                                   \
+                                                                                                                    \
+        if (hashset->control != NULL) {                                                                             \
+            NESQUIK_free(hashset->allocator, hashset->control);                                                     \
+            hashset->control = NULL;                                                                                \
+        }                                                                                                           \
+                                                                                                                    \
+        if (hashset->entries != NULL) {                                                                             \
+            NESQUIK_free(hashset->allocator, hashset->entries);                                                     \
+            hashset->entries = NULL;                                                                                \
+        }                                                                                                           \
+    }                                                                                                               \
+                                                                                                                    \
+    void HASHSET_##K##_destroy(HASHSET_##K* hashset) {                                                              \
+        if (hashset == NULL) return;                                                                                \
+                                                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator = hashset->allocator;                                                    \
+        HASHSET_##K##_deinit(hashset);                                                                              \
+        NESQUIK_free(allocator, hashset);                                                                           \
+    }                                                                                                               \
+                                                                                                                    \
+    static u32 HASHSET_##K##_free_slot(const HASHSET_##K* hashset, const u32 hash) {                                \
+        const u32 group_mask = hashset->capacity / SWISS_GROUP_WIDTH - 1;                                           \
+        u32 group = SWISS_H1(hash) & group_mask;                                                                    \
+                                                                                                                    \
+        for (u32 step = 1; ; step++) {                                                                              \
+            const u32 mask = SWISS_GROUP_match_empty_or_deleted(hashset->control + group * SWISS_GROUP_WIDTH);      \
+            if (mask != 0) return group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);                                      \
+            group = (group + step) & group_mask;                                                                    \
+        }                                                                                                           \
+    }                                                                                                               \
+                                                                                                                    \
+    static HASHSET_ENTRY_##K* HASHSET_##K##_probe(const HASHSET_##K* hashset,                                       \
+        const u32 hash, const K key) {                                                                              \
+                                                                                                                    \
+        const u32 group_mask = hashset->capacity / SWISS_GROUP_WIDTH - 1;                                           \
+        const u8 h2 = SWISS_H2(hash);                                                                               \
+        u32 group = SWISS_H1(hash) & group_mask;                                                                    \
+                                                                                                                    \
+        for (u32 step = 1; step <= group_mask + 1; step++) {                                                        \
+            const u8* control = hashset->control + group * SWISS_GROUP_WIDTH;                                       \
+                                                                                                                    \
+            u32 mask = SWISS_GROUP_match(control, h2);                                                              \
+            while (mask != 0) {                                                                                     \
+                HASHSET_ENTRY_##K* entry = hashset->entries + group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);          \
+                if (HASHSET_##K##_key_equal(entry->key, key) == 1) return entry;                                    \
+                mask &= mask - 1;                                                                                   \
+            }                                                                                                       \
+                                                                                                                    \
+            if (SWISS_GROUP_match_empty(control) != 0) return NULL;                                                 \
+            group = (group + step) & group_mask;                                                                    \
+        }                                                                                                           \
+                                                                                                                    \
+        return NULL;                                                                                                \
+    }                                                                                                               \
+                                                                                                                    \
+    u8 HASHSET_##K##_grow(HASHSET_##K* hashset) {                                                                   \
+        if (hashset == NULL) return 0;                                                                              \
+                                                                                                                    \
+        u32 new_capacity = hashset->capacity;                                                                       \
+        if (hashset->size + 1 > SWISS_MAX_LOAD(hashset->capacity) / 2) {                                            \
+            if (hashset->capacity & 0x80000000) return 0;                                                           \
+            new_capacity = hashset->capacity << 1;                                                                  \
+        }                                                                                                           \
+                                                                                                                    \
+        HASHSET_##K new_hashset;                                                                                    \
+        const u8 r = HASHSET_##K##_init_allocator(&new_hashset, new_capacity, hashset->allocator);                  \
+        if (r == 0) return 0;                                                                                       \
+                                                                                                                    \
+        for (u32 i = 0; i < hashset->capacity; i++) {                                                               \
+            if (hashset->control[i] & SWISS_CONTROL_EMPTY) continue;                                                \
+                                                                                                                    \
+            const HASHSET_ENTRY_##K* entry = hashset->entries + i;                                                  \
+            const u32 hash = HASHSET_##K##_key_hash(entry->key);                                                    \
+            const u32 slot = HASHSET_##K##_free_slot(&new_hashset, hash);                                           \
+                                                                                                                    \
+            new_hashset.control[slot] = SWISS_H2(hash);                                                             \
+            new_hashset.entries[slot] = *entry;                                                                     \
+        }                                                                                                           \
+                                                                                                                    \
+        new_hashset.size = hashset->size;                                                                           \
+        new_hashset.growth_left -= hashset->size;                                                                   \
+                                                                                                                    \
+        NESQUIK_free(hashset->allocator, hashset->control);                                                         \
+        NESQUIK_free(hashset->allocator, hashset->entries);                                                         \
+        *hashset = new_hashset;                                                                                     \
+                                                                                                                    \
+        return 1;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    u8 HASHSET_##K##_quick_add(HASHSET_##K* hashset, const u32 hash, const K key) {                                 \
+        if (hashset == NULL) return 0;                                                                              \
+        if (hashset->capacity == 0) return 0;                                                                       \
+                                                                                                                    \
+        if (HASHSET_##K##_probe(hashset, hash, key) != NULL) return 0;                                              \
+                                                                                                                    \
+        u32 slot = HASHSET_##K##_free_slot(hashset, hash);                                                          \
+        if (hashset->control[slot] == SWISS_CONTROL_EMPTY && hashset->growth_left == 0) {                           \
+            const u8 r = HASHSET_##K##_grow(hashset);                                                               \
+            if (r == 0) return 0;                                                                                   \
+            slot = HASHSET_##K##_free_slot(hashset, hash);                                                          \
+        }                                                                                                           \
+                                                                                                                    \
+        if (hashset->control[slot] == SWISS_CONTROL_EMPTY) hashset->growth_left--;                                  \
+        else hashset->tombstones--;                                                                                 \
+                                                                                                                    \
+        hashset->control[slot] = SWISS_H2(hash);                                                                    \
+        hashset->entries[slot].key = key;                                                                           \
+                                                                                                                    \
+        hashset->size++;                                                                                            \
+        return 1;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    u8 HASHSET_##K##_add(HASHSET_##K* hashset, const K key) {                                                       \
+        if (hashset == NULL) return 0;                                                                              \
+                                                                                                                    \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                               \
+        return HASHSET_##K##_quick_add(hashset, hash, key);                                                         \
+    }                                                                                                               \
+                                                                                                                    \
+    void HASHSET_##K##_remove(HASHSET_##K* hashset, const K key) {                                                  \
+        if (hashset == NULL) return;                                                                                \
+                                                                                                                    \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find(hashset, key);                                          \
+        if (entry == NULL) return;                                                                                  \
+                                                                                                                    \
+        const u32 slot = (u32)(entry - hashset->entries);                                                           \
+        const u8* group = hashset->control + (slot & ~(SWISS_GROUP_WIDTH - 1));                                     \
+        if (SWISS_GROUP_match_empty(group) != 0) {                                                                  \
+            hashset->control[slot] = SWISS_CONTROL_EMPTY;                                                           \
+            hashset->growth_left++;                                                                                 \
+        }                                                                                                           \
+        else {                                                                                                      \
+            hashset->control[slot] = SWISS_CONTROL_DELETED;                                                         \
+            hashset->tombstones++;                                                                                  \
+        }                                                                                                           \
+                                                                                                                    \
+        hashset->size--;                                                                                            \
+    }                                                                                                               \
+                                                                                                                    \
+    u8 HASHSET_##K##_contains(const HASHSET_##K* hashset, const K key) {                                            \
+        if (hashset == NULL) return 0;                                                                              \
+                                                                                                                    \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find(hashset, key);                                          \
+        if (entry == NULL) return 0;                                                                                \
+        return 1;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find(const HASHSET_##K* hashset, const K key) {                                \
+        if (hashset == NULL) return NULL;                                                                           \
+                                                                                                                    \
+        const u32 hash = HASHSET_##K##_key_hash(key);                                                               \
+        return HASHSET_##K##_find_hashed(hashset, hash, key);                                                       \
+    }                                                                                                               \
+                                                                                                                    \
+    u8 HASHSET_##K##_contains_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {                     \
+        if (hashset == NULL) return 0;                                                                              \
+                                                                                                                    \
+        const HASHSET_ENTRY_##K* entry = HASHSET_##K##_find_hashed(hashset, hash, key);                             \
+        if (entry == NULL) return 0;                                                                                \
+        return 1;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_ENTRY_##K* HASHSET_##K##_find_hashed(const HASHSET_##K* hashset, const u32 hash, const K key) {         \
+        if (hashset == NULL) return NULL;                                                                           \
+        if (hashset->capacity == 0) return NULL;                                                                    \
+                                                                                                                    \
+        return HASHSET_##K##_probe(hashset, hash, key);                                                             \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_union(const HASHSET_##K* a, const HASHSET_##K* b) {                                  \
+        if (a == NULL || b == NULL) return NULL;                                                                    \
+                                                                                                                    \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(a->capacity + b->capacity, a->allocator);                   \
+        if (c == NULL) return NULL;                                                                                 \
+                                                                                                                    \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                                  \
+            if (a->control[ai] & SWISS_CONTROL_EMPTY) continue;                                                     \
+            const K key = a->entries[ai].key;                                                                       \
+            HASHSET_##K##_quick_add(c, HASHSET_##K##_key_hash(key), key);                                           \
+        }                                                                                                           \
+                                                                                                                    \
+        for (u32 bi = 0; bi < b->capacity; bi++) {                                                                  \
+            if (b->control[bi] & SWISS_CONTROL_EMPTY) continue;                                                     \
+            const K key = b->entries[bi].key;                                                                       \
+            HASHSET_##K##_quick_add(c, HASHSET_##K##_key_hash(key), key);                                           \
+        }                                                                                                           \
+                                                                                                                    \
+        return c;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_intersection(const HASHSET_##K* a, const HASHSET_##K* b) {                           \
+        if (a == NULL || b == NULL) return NULL;                                                                    \
+                                                                                                                    \
+        const HASHSET_##K* smaller;                                                                                 \
+        const HASHSET_##K* larger;                                                                                  \
+        if (a->capacity < b->capacity) {                                                                            \
+            smaller = a;                                                                                            \
+            larger = b;                                                                                             \
+        }                                                                                                           \
+        else {                                                                                                      \
+            smaller = b;                                                                                            \
+            larger = a;                                                                                             \
+        }                                                                                                           \
+                                                                                                                    \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(smaller->capacity, a->allocator);                           \
+        if (c == NULL) return NULL;                                                                                 \
+                                                                                                                    \
+        for (u32 i = 0; i < smaller->capacity; i++) {                                                               \
+            if (smaller->control[i] & SWISS_CONTROL_EMPTY) continue;                                                \
+            const K key = smaller->entries[i].key;                                                                  \
+            const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
+            if (HASHSET_##K##_contains_hashed(larger, hash, key) == 1) {                                            \
+                HASHSET_##K##_quick_add(c, hash, key);                                                              \
+            }                                                                                                       \
+        }                                                                                                           \
+                                                                                                                    \
+        return c;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    HASHSET_##K* HASHSET_##K##_difference(const HASHSET_##K* a, const HASHSET_##K* b) {                             \
+        if (a == NULL || b == NULL) return NULL;                                                                    \
+                                                                                                                    \
+        HASHSET_##K* c = HASHSET_##K##_create_allocator(a->capacity, a->allocator);                                 \
+        if (c == NULL) return NULL;                                                                                 \
+                                                                                                                    \
+        for (u32 ai = 0; ai < a->capacity; ai++) {                                                                  \
+            if (a->control[ai] & SWISS_CONTROL_EMPTY) continue;                                                     \
+            const K key = a->entries[ai].key;                                                                       \
+            const u32 hash = HASHSET_##K##_key_hash(key);                                                           \
+            if (HASHSET_##K##_contains_hashed(b, hash, key) == 0) {                                                 \
+                HASHSET_##K##_quick_add(c, hash, key);                                                              \
+            }                                                                                                       \
+        }                                                                                                           \
+                                                                                                                    \
+        return c;                                                                                                   \
+    }
+
+#endif // NESQUIK_SWISS_HASHSET_H
\ No newline at end of file
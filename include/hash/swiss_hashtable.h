@@ -0,0 +1,301 @@
+#ifndef NESQUIK_SWISS_HASHTABLE_H
+#define NESQUIK_SWISS_HASHTABLE_H
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/swiss_group.h"
+
+// Swiss table engine behind the HASHTABLE API. Swapping HASHTABLE_DECLARE/HASHTABLE_DEFINE for
+// HASHTABLE_DECLARE_SWISS/HASHTABLE_DEFINE_SWISS keeps every call site compiling. Entries do not store their hash,
+// growing recomputes it with _key_hash, so the hash passed to _quick_add and the *_hashed lookups must be
+// _key_hash(key). A table keyed by some other hash needs the classic engine, which keeps the caller's hash.
+#define HASHTABLE_DECLARE_SWISS_TYPES(K, V)                                                                 \
+    typedef struct HASHTABLE_ENTRY_##K##_##V {                                                              \
+        K key;                                                                                              \
+        V value;                                                                                            \
+    } HASHTABLE_ENTRY_##K##_##V;                                                                            \
+                                                                                                            \
+    typedef struct HASHTABLE_##K##_##V {                                                                    \
+        u8* control;                                                                                        \
+        HASHTABLE_ENTRY_##K##_##V* entries;                                                                 \
+        u32 size;                                                                                           \
+        u32 capacity;                                                                                       \
+        u32 tombstones;                                                                                     \
+        u32 growth_left;                                                                                    \
+        const NESQUIK_ALLOCATOR* allocator;                                                                 \
+    } HASHTABLE_##K##_##V;                                                                                  \
+                                                                                                            \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, u32 capacity);                            \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, u32 capacity,                   \
+        const NESQUIK_ALLOCATOR* allocator);                                                                \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(u32 capacity);                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator);                                                                \
+                                                                                                            \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable);                                      \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable);                                     \
+                                                                                                            \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable);                                          \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, K key, V value);                           \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, u32 hash, K key, V value);           \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, K key);                               \
+                                                                                                            \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, K key);                         \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, K key);     \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, u32 hash, K key);        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable,      \
+        u32 hash, K key);
+
+#define HASHTABLE_DECLARE_SWISS_HASH(K, V, HASH_F)      \
+    HASHTABLE_DECLARE_SWISS_TYPES(K, V)                 \
+    HASHTABLE_DECLARE_KEY_HASH(K, V, HASH_F)
+
+#define HASHTABLE_DECLARE_SWISS_EX(K, V, HASH_FN, EQ_FN)    \
+    HASHTABLE_DECLARE_SWISS_TYPES(K, V)                     \
+    HASHTABLE_DECLARE_KEY_EX(K, V, HASH_FN, EQ_FN)
+
+#define HASHTABLE_DECLARE_SWISS(K, V) HASHTABLE_DECLARE_SWISS_HASH(K, V, HASH_fnv1a)
+
+// Capacity is a power of two split into 16 slot groups probed triangularly. Growth doubles the table
+// when live entries use up the load budget and rebuilds in place when tombstones do.
+#define HASHTABLE_DEFINE_SWISS(K, V)                                                                                    \
+    u8 HASHTABLE_##K##_##V##_init(HASHTABLE_##K##_##V* hashtable, const u32 capacity) {                                 \
+        return HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, NULL);                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_init_allocator(HASHTABLE_##K##_##V* hashtable, const u32 capacity,                         \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        u32 new_capacity = SWISS_MIN_CAPACITY;                                                                          \
+        while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;                                \
+                                                                                                                        \
+        hashtable->allocator = allocator;                                                                               \
+        hashtable->size = 0;                                                                                            \
+        hashtable->capacity = new_capacity;                                                                             \
+        hashtable->tombstones = 0;                                                                                      \
+        hashtable->growth_left = SWISS_MAX_LOAD(new_capacity);                                                          \
+                                                                                                                        \
+        hashtable->control = (u8*)NESQUIK_alloc(allocator, new_capacity);                                               \
+        hashtable->entries = (HASHTABLE_ENTRY_##K##_##V*)NESQUIK_alloc(allocator,                                       \
+            sizeof(HASHTABLE_ENTRY_##K##_##V) * new_capacity);                                                          \
+        if (hashtable->control == NULL || hashtable->entries == NULL) {                                                 \
+            NESQUIK_free(allocator, hashtable->control);                                                                \
+            NESQUIK_free(allocator, hashtable->entries);                                                                \
+            hashtable->control = NULL;                                                                                  \
+            hashtable->entries = NULL;                                                                                  \
+            hashtable->capacity = 0;                                                                                    \
+            hashtable->growth_left = 0;                                                                                 \
+            return 0;                                                                                                   \
+        }                                                                                                               \
+                                                                                                                        \
+        memset(hashtable->control, SWISS_CONTROL_EMPTY, new_capacity);                                                  \
+                                                                                                                        \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create(const u32 capacity) {                                             \
+        return HASHTABLE_##K##_##V##_create_allocator(capacity, NULL);                                                  \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_##K##_##V* HASHTABLE_##K##_##V##_create_allocator(const u32 capacity,                                     \
+        const NESQUIK_ALLOCATOR* allocator) {                                                                           \
+                                                                                                                        \
+        HASHTABLE_##K##_##V* hashtable = (HASHTABLE_##K##_##V*)NESQUIK_alloc(allocator,                                 \
+            sizeof(HASHTABLE_##K##_##V));                                                                               \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(hashtable, capacity, allocator);                              \
+        if (r == 0) {                                                                                                   \
+            NESQUIK_free(allocator, hashtable);                                                                         \
+            return NULL;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        return hashtable;                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_deinit(HASHTABLE_##K##_##V* hashtable) {                                                 \
+        if (hashtable == NULL) return;                                                                                  \
+        hashtable->size = 0;                                                                                            \
+        hashtable->capacity = 0;                                                                                        \
+        hashtable->tombstones = 0;                                                                                      \
+        hashtable->growth_left = 0;                                                                                     \
+                                                                                                                        \
+        if (hashtable->control != NULL) {                                                                               \
+            NESQUIK_free(hashtable->allocator, hashtable->control);                                                     \
+            hashtable->control = NULL;                                                                                  \
+        }                                                                                                               \
+                                                                                                                        \
+        if (hashtable->entries != NULL) {                                                                               \
+            NESQUIK_free(hashtable->allocator, hashtable->entries);                                                     \
+            hashtable->entries = NULL;                                                                                  \
+        }                                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_destroy(HASHTABLE_##K##_##V* hashtable) {                                                \
+        if (hashtable == NULL) return;                                                                                  \
+                                                                                                                        \
+        const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;                                                      \
+        HASHTABLE_##K##_##V##_deinit(hashtable);                                                                        \
+        NESQUIK_free(allocator, hashtable);                                                                             \
+    }                                                                                                                   \
+                                                                                                                        \
+    static u32 HASHTABLE_##K##_##V##_free_slot(const HASHTABLE_##K##_##V* hashtable, const u32 hash) {                  \
+        const u32 group_mask = hashtable->capacity / SWISS_GROUP_WIDTH - 1;                                             \
+        u32 group = SWISS_H1(hash) & group_mask;                                                                        \
+                                                                                                                        \
+        for (u32 step = 1; ; step++) {                                                                                  \
+            const u32 mask = SWISS_GROUP_match_empty_or_deleted(hashtable->control + group * SWISS_GROUP_WIDTH);        \
+            if (mask != 0) return group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);                                          \
+            group = (group + step) & group_mask;                                                                        \
+        }                                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+    static HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_probe(const HASHTABLE_##K##_##V* hashtable,                 \
+        const u32 hash, const K key) {                                                                                  \
+                                                                                                                        \
+        const u32 group_mask = hashtable->capacity / SWISS_GROUP_WIDTH - 1;                                             \
+        const u8 h2 = SWISS_H2(hash);                                                                                   \
+        u32 group = SWISS_H1(hash) & group_mask;                                                                        \
+                                                                                                                        \
+        for (u32 step = 1; step <= group_mask + 1; step++) {                                                            \
+            const u8* control = hashtable->control + group * SWISS_GROUP_WIDTH;                                         \
+                                                                                                                        \
+            u32 mask = SWISS_GROUP_match(control, h2);                                                                  \
+            while (mask != 0) {                                                                                         \
+                HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);    \
+                if (HASHTABLE_##K##_##V##_key_equal(entry->key, key) == 1) return entry;                                \
+                mask &= mask - 1;                                                                                       \
+            }                                                                                                           \
+                                                                                                                        \
+            if (SWISS_GROUP_match_empty(control) != 0) return NULL;                                                     \
+            group = (group + step) & group_mask;                                                                        \
+        }                                                                                                               \
+                                                                                                                        \
+        return NULL;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_grow(HASHTABLE_##K##_##V* hashtable) {                                                     \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        u32 new_capacity = hashtable->capacity;                                                                         \
+        if (hashtable->size + 1 > SWISS_MAX_LOAD(hashtable->capacity) / 2) {                                            \
+            if (hashtable->capacity & 0x80000000) return 0;                                                             \
+            new_capacity = hashtable->capacity << 1;                                                                    \
+        }                                                                                                               \
+                                                                                                                        \
+        HASHTABLE_##K##_##V new_hashtable;                                                                              \
+        const u8 r = HASHTABLE_##K##_##V##_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);          \
+        if (r == 0) return 0;                                                                                           \
+                                                                                                                        \
+        for (u32 i = 0; i < hashtable->capacity; i++) {                                                                 \
+            if (hashtable->control[i] & SWISS_CONTROL_EMPTY) continue;                                                  \
+                                                                                                                        \
+            const HASHTABLE_ENTRY_##K##_##V* entry = hashtable->entries + i;                                            \
+            const u32 hash = HASHTABLE_##K##_##V##_key_hash(entry->key);                                                \
+            const u32 slot = HASHTABLE_##K##_##V##_free_slot(&new_hashtable, hash);                                     \
+                                                                                                                        \
+            new_hashtable.control[slot] = SWISS_H2(hash);                                                               \
+            new_hashtable.entries[slot] = *entry;                                                                       \
+        }                                                                                                               \
+                                                                                                                        \
+        new_hashtable.size = hashtable->size;                                                                           \
+        new_hashtable.growth_left -= hashtable->size;                                                                   \
+                                                                                                                        \
+        NESQUIK_free(hashtable->allocator, hashtable->control);                                                         \
+        NESQUIK_free(hashtable->allocator, hashtable->entries);                                                         \
+        *hashtable = new_hashtable;                                                                                     \
+                                                                                                                        \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_quick_add(HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key, const V value) {    \
+        if (hashtable == NULL) return 0;                                                                                \
+        if (hashtable->capacity == 0) return 0;                                                                         \
+                                                                                                                        \
+        if (HASHTABLE_##K##_##V##_probe(hashtable, hash, key) != NULL) return 0;                                        \
+                                                                                                                        \
+        u32 slot = HASHTABLE_##K##_##V##_free_slot(hashtable, hash);                                                    \
+        if (hashtable->control[slot] == SWISS_CONTROL_EMPTY && hashtable->growth_left == 0) {                           \
+            const u8 r = HASHTABLE_##K##_##V##_grow(hashtable);                                                         \
+            if (r == 0) return 0;                                                                                       \
+            slot = HASHTABLE_##K##_##V##_free_slot(hashtable, hash);                                                    \
+        }                                                                                                               \
+                                                                                                                        \
+        if (hashtable->control[slot] == SWISS_CONTROL_EMPTY) hashtable->growth_left--;                                  \
+        else hashtable->tombstones--;                                                                                   \
+                                                                                                                        \
+        hashtable->control[slot] = SWISS_H2(hash);                                                                      \
+        hashtable->entries[slot].key = key;                                                                             \
+        hashtable->entries[slot].value = value;                                                                         \
+                                                                                                                        \
+        hashtable->size++;                                                                                              \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_add(HASHTABLE_##K##_##V* hashtable, const K key, const V value) {                          \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_quick_add(hashtable, hash, key, value);                                            \
+    }                                                                                                                   \
+                                                                                                                        \
+    void HASHTABLE_##K##_##V##_remove(HASHTABLE_##K##_##V* hashtable, const K key) {                                    \
+        if (hashtable == NULL) return;                                                                                  \
+                                                                                                                        \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find(hashtable, key);                            \
+        if (entry == NULL) return;                                                                                      \
+                                                                                                                        \
+        const u32 slot = (u32)(entry - hashtable->entries);                                                             \
+        const u8* group = hashtable->control + (slot & ~(SWISS_GROUP_WIDTH - 1));                                       \
+        if (SWISS_GROUP_match_empty(group) != 0) {                                                                      \
+            hashtable->control[slot] = SWISS_CONTROL_EMPTY;                                                             \
+            hashtable->growth_left++;                                                                                   \
+        }                                                                                                               \
+        else {                                                                                                          \
+            hashtable->control[slot] = SWISS_CONTROL_DELETED;                                                           \
+            hashtable->tombstones++;                                                                                    \
+        }                                                                                                               \
+                                                                                                                        \
+        hashtable->size--;                                                                                              \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains(const HASHTABLE_##K##_##V* hashtable, const K key) {                              \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find(hashtable, key);                            \
+        if (entry == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find(const HASHTABLE_##K##_##V* hashtable, const K key) {          \
+        if (hashtable == NULL) return NULL;                                                                             \
+                                                                                                                        \
+        const u32 hash = HASHTABLE_##K##_##V##_key_hash(key);                                                           \
+        return HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+    u8 HASHTABLE_##K##_##V##_contains_hashed(const HASHTABLE_##K##_##V* hashtable, const u32 hash, const K key) {       \
+        if (hashtable == NULL) return 0;                                                                                \
+                                                                                                                        \
+        const HASHTABLE_ENTRY_##K##_##V* entry = HASHTABLE_##K##_##V##_find_hashed(hashtable, hash, key);               \
+        if (entry == NULL) return 0;                                                                                    \
+        return 1;                                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+    HASHTABLE_ENTRY_##K##_##V* HASHTABLE_##K##_##V##_find_hashed(const HASHTABLE_##K##_##V* hashtable,                  \
+        const u32 hash, const K key) {                                                                                  \
+                                                                                                                        \
+        if (hashtable == NULL) return NULL;                                                                             \
+        if (hashtable->capacity == 0) return NULL;                                                                      \
+                                                                                                                        \
+        return HASHTABLE_##K##_##V##_probe(hashtable, hash, key);                                                       \
+    }
+
+#endif // NESQUIK_SWISS_HASHTABLE_H
\ No newline at end of file
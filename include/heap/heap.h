@@ -2,6 +2,7 @@
 #define NESQUIK_HEAP_H
 
 #include "types.h"
+#include "allocator.h"
 
 #define HEAP_MIN_CAPACITY 8
 
@@ -16,10 +17,13 @@ typedef struct HEAP {
     u32 size;
     u32 capacity;
     HEAP_NODE* data;
+    const NESQUIK_ALLOCATOR* allocator;
 } HEAP;
 
 u8 HEAP_init(HEAP* heap, u32 capacity);
+u8 HEAP_init_allocator(HEAP* heap, u32 capacity, const NESQUIK_ALLOCATOR* allocator);
 HEAP* HEAP_create(u32 capacity);
+HEAP* HEAP_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);
 
 void HEAP_deinit(HEAP* heap);
 void HEAP_destroy(HEAP* heap);
@@ -29,6 +33,8 @@ u8 HEAP_swap_nodes(const HEAP* heap, u32 a, u32 b);
 
 u8 HEAP_add(HEAP* heap, u32 key, const char* value);
 u8 HEAP_remove_max(HEAP* heap, HEAP_NODE* result);
+// Overwrites the max node and restores the heap, cheaper than a remove_max followed by an add
+u8 HEAP_replace_max(HEAP* heap, u32 key, const char* value);
 HEAP_NODE* HEAP_max(const HEAP* heap);
 
 #endif //NESQUIK_HEAP_H
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 
 #include "types.h"
+#include "allocator.h"
 
 #define LIST_MIN_CAPACITY 8
 
@@ -12,10 +13,15 @@
         u32 size;                                                                           \
         u32 capacity;                                                                       \
         T* data;                                                                            \
+        const NESQUIK_ALLOCATOR* allocator;                                                 \
     } LIST_##T;                                                                             \
                                                                                             \
     u8 LIST_##T##_init(LIST_##T* list, u32 capacity);                                       \
+    u8 LIST_##T##_init_allocator(LIST_##T* list, u32 capacity,                              \
+        const NESQUIK_ALLOCATOR* allocator);                                                \
     LIST_##T* LIST_##T##_create(u32 capacity);                                              \
+    LIST_##T* LIST_##T##_create_allocator(u32 capacity,                                     \
+        const NESQUIK_ALLOCATOR* allocator);                                                \
                                                                                             \
     void LIST_##T##_deinit(LIST_##T* list);                                                 \
     void LIST_##T##_destroy(LIST_##T* list);                                                \
@@ -30,12 +36,19 @@
 
 #define LIST_DEFINE(T)                                                                      \
     u8 LIST_##T##_init(LIST_##T* list, u32 capacity) {                                      \
+        return LIST_##T##_init_allocator(list, capacity, NULL);                             \
+    }                                                                                       \
+                                                                                            \
+    u8 LIST_##T##_init_allocator(LIST_##T* list, u32 capacity,                              \
+        const NESQUIK_ALLOCATOR* allocator) {                                               \
+                                                                                            \
         if (list == NULL) return 0;                                                         \
                                                                                             \
         list->size = 0;                                                                     \
         list->capacity = capacity < LIST_MIN_CAPACITY ? LIST_MIN_CAPACITY : capacity;       \
+        list->allocator = allocator;                                                        \
                                                                                             \
-        list->data = (T*)malloc(sizeof(T) * list->capacity);                                \
+        list->data = (T*)NESQUIK_alloc(allocator, sizeof(T) * list->capacity);              \
         if (list->data == NULL) {                                                           \
             list->capacity = 0;                                                             \
             return 0;                                                                       \
@@ -45,14 +58,20 @@
     }                                                                                       \
                                                                                             \
     LIST_##T* LIST_##T##_create(const u32 capacity) {                                       \
-        LIST_##T* list = (LIST_##T*)malloc(sizeof(LIST_##T));                               \
+        return LIST_##T##_create_allocator(capacity, NULL);                                 \
+    }                                                                                       \
+                                                                                            \
+    LIST_##T* LIST_##T##_create_allocator(const u32 capacity,                               \
+        const NESQUIK_ALLOCATOR* allocator) {                                               \
+                                                                                            \
+        LIST_##T* list = (LIST_##T*)NESQUIK_alloc(allocator, sizeof(LIST_##T));             \
         if (list == NULL) {                                                                 \
             return NULL;                                                                    \
         }                                                                                   \
                                                                                             \
-        const u8 r = LIST_##T##_init(list, capacity);                                       \
+        const u8 r = LIST_##T##_init_allocator(list, capacity, allocator);                  \
         if (r == 0) {                                                                       \
-            free(list);                                                                     \
+            NESQUIK_free(allocator, list);                                                  \
             return NULL;                                                                    \
         }                                                                                   \
                                                                                             \
@@ -65,7 +84,7 @@
         list->size = 0;                                                                     \
         list->capacity = 0;                                                                 \
         if (list->data != NULL) {                                                           \
-            free(list->data);                                                               \
+            NESQUIK_free(list->allocator, list->data);                                      \
             list->data = NULL;                                                              \
         }                                                                                   \
     }                                                                                       \
@@ -73,8 +92,9 @@
     void LIST_##T##_destroy(LIST_##T* list) {                                               \
         if (list == NULL) return;                                                           \
                                                                                             \
+        const NESQUIK_ALLOCATOR* allocator = list->allocator;                               \
         LIST_##T##_deinit(list);                                                            \
-        free(list);                                                                         \
+        NESQUIK_free(allocator, list);                                                      \
     }                                                                                       \
                                                                                             \
     u8 LIST_##T##_grow_capacity(LIST_##T* list) {                                           \
@@ -96,7 +116,7 @@
             }                                                                               \
         }                                                                                   \
                                                                                             \
-        T* data = realloc(list->data, sizeof(T) * capacity);                                \
+        T* data = (T*)NESQUIK_realloc(list->allocator, list->data, sizeof(T) * capacity);   \
         if (data == NULL) {                                                                 \
             return 0;                                                                       \
         }                                                                                   \
@@ -0,0 +1,66 @@
+#ifndef NESQUIK_BLOOM_H
+#define NESQUIK_BLOOM_H
+
+#include "types.h"
+#include "hash/hash.h"
+
+// Blocked Bloom filter over 32-bit hashes: the high hash bits pick one 64-byte block and every probe bit of a
+// key lies inside it, so a lookup costs one cache line. Built for the hashes the containers already store.
+#define BLOOM_BLOCK_BITS            512
+#define BLOOM_BLOCK_WORDS           (BLOOM_BLOCK_BITS / 64)
+#define BLOOM_CACHE_LINE            64
+
+// Probe bits are 9-bit slices of one 64-bit mix of the hash
+#define BLOOM_MAX_HASHES            7
+#define BLOOM_DEFAULT_FALSE_RATE    0.01
+
+typedef struct {
+    u64* blocks;
+    u32 block_count;
+    u8 hashes;
+
+    // What the filter was sized for, the false positive rate degrades past expected keys
+    u32 expected;
+    f64 false_rate;
+} BLOOM;
+
+u8 BLOOM_init(BLOOM* bloom, u32 expected, f64 false_rate);
+BLOOM* BLOOM_create(u32 expected, f64 false_rate);
+
+void BLOOM_deinit(BLOOM* bloom);
+void BLOOM_destroy(BLOOM* bloom);
+void BLOOM_clear(BLOOM* bloom);
+
+static inline const u64* BLOOM_block(const BLOOM* bloom, const u32 hash) {
+    return bloom->blocks + (((u64)hash * bloom->block_count) >> 32) * BLOOM_BLOCK_WORDS;
+}
+
+static inline u64 BLOOM_bits(const u32 hash) {
+    const u64 x = (u64)hash * HASH_WIDE_PRIME_2;
+    return x ^ (x >> 29);
+}
+
+static inline void BLOOM_add_hash(BLOOM* bloom, const u32 hash) {
+    u64* block = (u64*)BLOOM_block(bloom, hash);
+    u64 bits = BLOOM_bits(hash);
+
+    for (u8 i = 0; i < bloom->hashes; i++, bits >>= 9) {
+        const u32 bit = (u32)(bits & (BLOOM_BLOCK_BITS - 1));
+        block[bit >> 6] |= 1ULL << (bit & 63);
+    }
+}
+
+// 0 means the hash was never added, 1 means it may have been
+static inline u8 BLOOM_may_contain_hash(const BLOOM* bloom, const u32 hash) {
+    const u64* block = BLOOM_block(bloom, hash);
+    u64 bits = BLOOM_bits(hash);
+
+    for (u8 i = 0; i < bloom->hashes; i++, bits >>= 9) {
+        const u32 bit = (u32)(bits & (BLOOM_BLOCK_BITS - 1));
+        if ((block[bit >> 6] & (1ULL << (bit & 63))) == 0) return 0;
+    }
+
+    return 1;
+}
+
+#endif //NESQUIK_BLOOM_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef NESQUIK_COUNTMIN_H
+#define NESQUIK_COUNTMIN_H
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "heap/heap.h"
+
+// Count-min sketch with conservative update: depth rows of width saturating counters, a key's estimate is the
+// minimum of its counters and never undercounts. width = e / epsilon and depth = ln(1 / delta) keep the
+// overcount below epsilon * total with probability 1 - delta, whatever the number of distinct keys.
+#define COUNTMIN_DEFAULT_EPSILON    0.001
+#define COUNTMIN_DEFAULT_DELTA      0.01
+
+#define COUNTMIN_MIN_WIDTH          16
+#define COUNTMIN_MAX_DEPTH          16
+
+typedef struct {
+    // depth rows of width counters
+    u32* counters;
+    u32 width;
+    u32 depth;
+
+    // Sum of every count added, saturates like the counters
+    u64 total;
+
+    const NESQUIK_ALLOCATOR* allocator;
+} COUNTMIN;
+
+u8 COUNTMIN_init(COUNTMIN* countmin, f64 epsilon, f64 delta);
+u8 COUNTMIN_init_allocator(COUNTMIN* countmin, f64 epsilon, f64 delta, const NESQUIK_ALLOCATOR* allocator);
+COUNTMIN* COUNTMIN_create(f64 epsilon, f64 delta);
+COUNTMIN* COUNTMIN_create_allocator(f64 epsilon, f64 delta, const NESQUIK_ALLOCATOR* allocator);
+
+void COUNTMIN_deinit(COUNTMIN* countmin);
+void COUNTMIN_destroy(COUNTMIN* countmin);
+void COUNTMIN_clear(COUNTMIN* countmin);
+
+// The hash must be a well mixed 64-bit value, e.g. from HASH_wide32. The add calls return the new estimate.
+u32 COUNTMIN_add_hash(COUNTMIN* countmin, u64 hash, u32 count);
+u32 COUNTMIN_add(COUNTMIN* countmin, const u8* data, u32 size, u32 count);
+u32 COUNTMIN_add_u64(COUNTMIN* countmin, u64 key, u32 count);
+
+u32 COUNTMIN_estimate_hash(const COUNTMIN* countmin, u64 hash);
+u32 COUNTMIN_estimate(const COUNTMIN* countmin, const u8* data, u32 size);
+u32 COUNTMIN_estimate_u64(const COUNTMIN* countmin, u64 key);
+
+// Sums the counters of a sketch of the same shape, the result still never undercounts
+u8 COUNTMIN_merge(COUNTMIN* destination, const COUNTMIN* source);
+
+// Tracked keys to their item slot, under its own key name so it cannot collide with a user's HASHTABLE_u64_u32
+typedef u64 COUNTMIN_KEY;
+HASHTABLE_DECLARE_EX(COUNTMIN_KEY, u32, HASH_u64, HASH_EQUAL)
+
+typedef struct {
+    u64 key;
+    u32 count;
+} COUNTMIN_ITEM;
+
+// The k heaviest keys of a stream in fixed memory: a count-min sketch estimates every key and a min-heap of the
+// k tracked items decides who gets evicted. Heap keys are ~count so the max-heap root holds the smallest count,
+// they are refreshed lazily when the root is challenged since tracked counts only ever grow.
+typedef struct {
+    COUNTMIN sketch;
+    HEAP heap;
+    COUNTMIN_ITEM* items;
+    HASHTABLE_COUNTMIN_KEY_u32 index;
+    u32 k;
+
+    // Shared by the sketch, the heap, the index and the items
+    const NESQUIK_ALLOCATOR* allocator;
+} COUNTMIN_TOPK;
+
+u8 COUNTMIN_TOPK_init(COUNTMIN_TOPK* topk, u32 k, f64 epsilon, f64 delta);
+u8 COUNTMIN_TOPK_init_allocator(COUNTMIN_TOPK* topk, u32 k, f64 epsilon, f64 delta,
+    const NESQUIK_ALLOCATOR* allocator);
+COUNTMIN_TOPK* COUNTMIN_TOPK_create(u32 k, f64 epsilon, f64 delta);
+COUNTMIN_TOPK* COUNTMIN_TOPK_create_allocator(u32 k, f64 epsilon, f64 delta, const NESQUIK_ALLOCATOR* allocator);
+
+void COUNTMIN_TOPK_deinit(COUNTMIN_TOPK* topk);
+void COUNTMIN_TOPK_destroy(COUNTMIN_TOPK* topk);
+
+u8 COUNTMIN_TOPK_add(COUNTMIN_TOPK* topk, u64 key, u32 count);
+u32 COUNTMIN_TOPK_estimate(const COUNTMIN_TOPK* topk, u64 key);
+
+// Writes up to k items heaviest first with fresh estimates, returns how many were written
+u32 COUNTMIN_TOPK_list(const COUNTMIN_TOPK* topk, COUNTMIN_ITEM* out);
+
+#endif //NESQUIK_COUNTMIN_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef NESQUIK_HYPERLOGLOG_H
+#define NESQUIK_HYPERLOGLOG_H
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+
+// Approximate distinct counting in 2^precision one-byte registers, standard error about 1.04 / sqrt(2^precision).
+// A sketch starts sparse, a small table of the registers touched so far, and turns dense once that table would
+// take more than half of the dense registers. Sketches of the same precision merge by taking register maxima.
+#define HYPERLOGLOG_MIN_PRECISION       4
+#define HYPERLOGLOG_MAX_PRECISION       18
+#define HYPERLOGLOG_DEFAULT_PRECISION   12
+
+#define HYPERLOGLOG_REPRESENTATION_SPARSE   0
+#define HYPERLOGLOG_REPRESENTATION_DENSE    1
+
+#define HYPERLOGLOG_SPARSE_MIN_CAPACITY 16
+
+typedef struct {
+    // Dense registers, NULL while sparse
+    u8* registers;
+
+    // Open addressing table of ((index + 1) << 8) | rank, 0 marks an empty slot
+    u32* sparse;
+    u32 sparse_size;
+    u32 sparse_capacity;
+
+    u8 precision;
+    u8 representation;
+    const NESQUIK_ALLOCATOR* allocator;
+} HYPERLOGLOG;
+
+u8 HYPERLOGLOG_init(HYPERLOGLOG* hyperloglog, u8 precision);
+u8 HYPERLOGLOG_init_allocator(HYPERLOGLOG* hyperloglog, u8 precision, const NESQUIK_ALLOCATOR* allocator);
+HYPERLOGLOG* HYPERLOGLOG_create(u8 precision);
+HYPERLOGLOG* HYPERLOGLOG_create_allocator(u8 precision, const NESQUIK_ALLOCATOR* allocator);
+
+void HYPERLOGLOG_deinit(HYPERLOGLOG* hyperloglog);
+void HYPERLOGLOG_destroy(HYPERLOGLOG* hyperloglog);
+void HYPERLOGLOG_clear(HYPERLOGLOG* hyperloglog);
+
+// The hash must be a well mixed 64-bit value, e.g. from HASH_wide32
+u8 HYPERLOGLOG_add_hash(HYPERLOGLOG* hyperloglog, u64 hash);
+u8 HYPERLOGLOG_add(HYPERLOGLOG* hyperloglog, const u8* data, u32 size);
+u8 HYPERLOGLOG_add_u64(HYPERLOGLOG* hyperloglog, u64 key);
+
+u8 HYPERLOGLOG_merge(HYPERLOGLOG* destination, const HYPERLOGLOG* source);
+f64 HYPERLOGLOG_estimate(const HYPERLOGLOG* hyperloglog);
+u32 HYPERLOGLOG_bytes(const HYPERLOGLOG* hyperloglog);
+
+#endif //NESQUIK_HYPERLOGLOG_H
\ No newline at end of file
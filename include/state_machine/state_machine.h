@@ -18,7 +18,8 @@ typedef struct {
 
 typedef STATE* (*TRANSITION_F)(u8* buf, u32 buf_len, void* context);
 
-POINTER_HASHTABLE_DECLARE(STATE, TRANSITION_F)
+// States are interned by STATE_CREATE, so the table keys on their address: no key_size/key_equal calls on a transition
+POINTER_HASHTABLE_DECLARE_IDENTITY(STATE, TRANSITION_F)
 
 typedef struct {
     // The buffer to process
@@ -38,7 +39,4 @@ void STATE_MACHINE_destroy(STATE_MACHINE* state_machine);
 u8 STATE_MACHINE_add_state(STATE_MACHINE* state_machine, STATE* state, TRANSITION_F transition_f);
 STATE* STATE_MACHINE_run(STATE_MACHINE* state_machine, void* context);
 
-u32 STATE_key_size(const STATE* state);
-u8 STATE_key_equal(const STATE* a, const STATE* b);
-
 #endif //NESQUIK_STATE_MACHINE_H
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef NESQUIK_INTERNER_H
+#define NESQUIK_INTERNER_H
+
+#include <string.h>
+
+#include "types.h"
+#include "allocator.h"
+#include "hash/hash.h"
+#include "hash/pointer_hashset.h"
+
+// Bytes of the first arena block, later blocks double up to INTERNER_MAX_BLOCK_SIZE. A string larger than the
+// next block size gets a block of its own.
+#define INTERNER_MIN_BLOCK_SIZE     4096
+#define INTERNER_MAX_BLOCK_SIZE     (1 << 20)
+
+// Header of an interned string, its size bytes and a NUL terminator follow it in the arena. Handles are
+// pointers to it and stay valid until the interner is deinitialized: two handles from the same interner are
+// equal exactly when their strings are. A lookup probe carries the same header over the caller's bytes.
+typedef struct {
+    u32 hash;
+    u32 size;
+    const char* data;
+} INTERNED;
+
+// Keys a POINTER_HASHTABLE by handle without touching the bytes:
+// POINTER_HASHTABLE_DECLARE_EX(INTERNED, V, INTERNED_hash, HASH_EQUAL)
+static inline u32 INTERNED_hash(const INTERNED* string) {
+    return string->hash;
+}
+
+static inline u8 INTERNED_equal(const INTERNED* a, const INTERNED* b) {
+    return a->hash == b->hash && a->size == b->size && memcmp(a->data, b->data, a->size) == 0;
+}
+
+POINTER_HASHSET_DECLARE_EX(INTERNED, INTERNED_hash, INTERNED_equal)
+
+typedef struct INTERNER_BLOCK {
+    struct INTERNER_BLOCK* next;
+    u32 used;
+    u32 capacity;
+} INTERNER_BLOCK;
+
+typedef struct {
+    POINTER_HASHSET_INTERNED strings;
+
+    // Bump arena of headers and bytes, newest block first. Blocks are never moved or freed before deinit.
+    INTERNER_BLOCK* blocks;
+    u32 block_size;
+
+    // Arena bytes handed out, headers and terminators included
+    u64 bytes;
+
+    // Shared by the arena blocks and the string set
+    const NESQUIK_ALLOCATOR* allocator;
+} INTERNER;
+
+u8 INTERNER_init(INTERNER* interner, u32 capacity);
+u8 INTERNER_init_allocator(INTERNER* interner, u32 capacity, const NESQUIK_ALLOCATOR* allocator);
+INTERNER* INTERNER_create(u32 capacity);
+INTERNER* INTERNER_create_allocator(u32 capacity, const NESQUIK_ALLOCATOR* allocator);
+
+void INTERNER_deinit(INTERNER* interner);
+void INTERNER_destroy(INTERNER* interner);
+
+// Returns the handle of the string, copying it into the arena the first time it is seen, NULL on failure
+INTERNED* INTERNER_intern(INTERNER* interner, const char* data, u32 size);
+INTERNED* INTERNER_intern_cstr(INTERNER* interner, const char* string);
+
+// Returns the handle of a string interned before, NULL if there is none, never allocates
+INTERNED* INTERNER_find(const INTERNER* interner, const char* data, u32 size);
+
+static inline u32 INTERNER_size(const INTERNER* interner) {
+    return interner->strings.size;
+}
+
+#endif //NESQUIK_INTERNER_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef NESQUIK_EPOCH_H
+#define NESQUIK_EPOCH_H
+
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "types.h"
+
+// Epoch-based reclamation. Readers announce the global epoch in their own record while they hold pointers
+// into a shared structure, writers retire unlinked memory instead of freeing it. Memory retired in epoch e
+// is freed once the global epoch reached e + 2, by then no reader can still see it.
+#define EPOCH_QUIESCENT         0
+#define EPOCH_DEFAULT_THREADS   64
+
+// Retired pointers gathered before _retire tries to advance the epoch and free them
+#define EPOCH_COLLECT_EVERY     64
+
+#define EPOCH_CACHE_LINE        64
+
+typedef void (*EPOCH_FREE_F)(void* pointer);
+
+// One per thread, each on its own cache line so entering and exiting never touches shared lines
+typedef struct {
+    _Alignas(EPOCH_CACHE_LINE) _Atomic u64 epoch;
+} EPOCH_RECORD;
+
+typedef struct {
+    void* pointer;
+    EPOCH_FREE_F free_f;
+    u64 epoch;
+} EPOCH_RETIRED;
+
+typedef struct {
+    _Alignas(EPOCH_CACHE_LINE) _Atomic u64 global;
+
+    EPOCH_RECORD* records;
+    u32 record_count;
+    _Atomic u32 registered;
+
+    // Only writers touch the retired list, the mutex also guards the indices of records given back by _unregister
+    pthread_mutex_t mutex;
+    u32* free_records;
+    u32 free_count;
+    EPOCH_RETIRED* retired;
+    u32 retired_size;
+    u32 retired_capacity;
+} EPOCH;
+
+u8 EPOCH_init(EPOCH* epoch, u32 max_threads);
+EPOCH* EPOCH_create(u32 max_threads);
+
+// Frees everything still retired, no thread may be inside the epoch any more
+void EPOCH_deinit(EPOCH* epoch);
+void EPOCH_destroy(EPOCH* epoch);
+
+// Hands out the calling thread's record, reusing unregistered ones first, NULL when all max_threads are taken
+EPOCH_RECORD* EPOCH_register(EPOCH* epoch);
+
+// Gives a record back for a later _register, the thread must be outside the epoch and never use it again
+void EPOCH_unregister(EPOCH* epoch, EPOCH_RECORD* record);
+
+void EPOCH_enter(EPOCH* epoch, EPOCH_RECORD* record);
+void EPOCH_exit(EPOCH_RECORD* record);
+
+// 0 when the retired list cannot grow, the pointer was not retired and is still the caller's
+u8 EPOCH_retire(EPOCH* epoch, void* pointer, EPOCH_FREE_F free_f);
+u32 EPOCH_collect(EPOCH* epoch);
+
+// Waits until every thread inside the epoch when it was called has exited, memory unlinked before the call can
+// then be freed directly. The calling thread must be outside the epoch.
+void EPOCH_synchronize(EPOCH* epoch);
+
+#endif //NESQUIK_EPOCH_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef NESQUIK_THREAD_POOL_H
+#define NESQUIK_THREAD_POOL_H
+
+#include <pthread.h>
+
+#include "types.h"
+
+// A task runs once on every worker of a THREAD_POOL_run call, worker is in [0, workers)
+typedef void (*THREAD_POOL_TASK_F)(void* context, u32 worker, u32 workers);
+
+typedef struct THREAD_POOL THREAD_POOL;
+
+typedef struct {
+    THREAD_POOL* pool;
+    pthread_t thread;
+    u32 index;
+} THREAD_POOL_WORKER;
+
+typedef struct THREAD_POOL {
+    // The calling thread is worker 0, so thread_count - 1 threads are spawned
+    THREAD_POOL_WORKER* workers;
+    u32 thread_count;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t work;
+    pthread_cond_t done;
+
+    // The task of the current run, a new generation wakes the workers up
+    THREAD_POOL_TASK_F task;
+    void* context;
+    u64 generation;
+    u32 running;
+    u8 stopping;
+} THREAD_POOL;
+
+u8 THREAD_POOL_init(THREAD_POOL* pool, u32 thread_count);
+THREAD_POOL* THREAD_POOL_create(u32 thread_count);
+
+void THREAD_POOL_deinit(THREAD_POOL* pool);
+void THREAD_POOL_destroy(THREAD_POOL* pool);
+
+// Fork-join: blocks until the task returned on every worker. A NULL pool runs the task inline as the only worker.
+// Runs are not reentrant, a task must not call THREAD_POOL_run on its own pool.
+u8 THREAD_POOL_run(THREAD_POOL* pool, THREAD_POOL_TASK_F task, void* context);
+u32 THREAD_POOL_workers(const THREAD_POOL* pool);
+
+// Start of part out of parts equal slices of [0, count), part == parts gives count
+static inline u32 THREAD_POOL_split(const u32 count, const u32 part, const u32 parts) {
+    return (u32)(((u64)count * part + parts - 1) / parts);
+}
+
+#endif //NESQUIK_THREAD_POOL_H
\ No newline at end of file
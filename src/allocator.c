@@ -0,0 +1,23 @@
+#include "allocator.h"
+
+static void* NESQUIK_ALLOCATOR_libc_alloc(void* context, const size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static void* NESQUIK_ALLOCATOR_libc_realloc(void* context, void* pointer, const size_t size) {
+    (void)context;
+    return realloc(pointer, size);
+}
+
+static void NESQUIK_ALLOCATOR_libc_free(void* context, void* pointer) {
+    (void)context;
+    free(pointer);
+}
+
+const NESQUIK_ALLOCATOR NESQUIK_ALLOCATOR_LIBC = {
+    .alloc = NESQUIK_ALLOCATOR_libc_alloc,
+    .realloc = NESQUIK_ALLOCATOR_libc_realloc,
+    .free = NESQUIK_ALLOCATOR_libc_free,
+    .context = NULL
+};
\ No newline at end of file
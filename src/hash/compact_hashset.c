@@ -0,0 +1,290 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/compact_hashset.h"
+
+#define STORE_HASH 0
+
+HASHSET_DECLARE_COMPACT(u32)
+
+u8 HASHSET_u32_init(HASHSET_u32* hashset, const u32 capacity) {
+    return HASHSET_u32_init_allocator(hashset, capacity, NULL);
+}
+
+u8 HASHSET_u32_init_allocator(HASHSET_u32* hashset, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashset == NULL) return 0;
+
+    hashset->allocator = allocator;
+    hashset->size = 0;
+    hashset->capacity = COMPACT_capacity(capacity);
+    hashset->tombstones = 0;
+
+    const u32 words = COMPACT_status_words(hashset->capacity);
+    hashset->status = (u64*)NESQUIK_alloc(allocator, sizeof(u64) * words);
+    hashset->keys = (u32*)NESQUIK_alloc(allocator, sizeof(u32) * hashset->capacity);
+    hashset->hashes = STORE_HASH ? (u32*)NESQUIK_alloc(allocator, sizeof(u32) * hashset->capacity) : NULL;
+
+    if (hashset->status == NULL || hashset->keys == NULL ||
+        (STORE_HASH && hashset->hashes == NULL)) {
+        HASHSET_u32_deinit(hashset);
+        return 0;
+    }
+
+    memset(hashset->status, 0, sizeof(u64) * words);
+
+    return 1;
+}
+
+HASHSET_u32* HASHSET_u32_create(const u32 capacity) {
+    return HASHSET_u32_create_allocator(capacity, NULL);
+}
+
+HASHSET_u32* HASHSET_u32_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    HASHSET_u32* hashset = (HASHSET_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_u32));
+    if (hashset == NULL) return NULL;
+
+    const u8 r = HASHSET_u32_init_allocator(hashset, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashset);
+        return NULL;
+    }
+
+    return hashset;
+}
+
+void HASHSET_u32_deinit(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+    hashset->size = 0;
+    hashset->capacity = 0;
+    hashset->tombstones = 0;
+
+    NESQUIK_free(hashset->allocator, hashset->status);
+    NESQUIK_free(hashset->allocator, hashset->keys);
+    NESQUIK_free(hashset->allocator, hashset->hashes);
+
+    hashset->status = NULL;
+    hashset->keys = NULL;
+    hashset->hashes = NULL;
+}
+
+void HASHSET_u32_destroy(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
+    HASHSET_u32_deinit(hashset);
+    NESQUIK_free(allocator, hashset);
+}
+
+static u32 HASHSET_u32_slot(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 n = 0; n < hashset->capacity; n++) {
+        const u8 status = COMPACT_status_get(hashset->status, i);
+        if (status == COMPACT_STATUS_EMPTY) break;
+
+        if (status == COMPACT_STATUS_FILLED && (!STORE_HASH || hashset->hashes[i] == hash) &&
+            HASHSET_u32_key_equal(hashset->keys[i], key) == 1) return i;
+
+        i = (i + 1) & mask;
+    }
+
+    return hashset->capacity;
+}
+
+u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
+    if (hashset == NULL) return 0;
+
+    u32 new_capacity = hashset->capacity;
+    if (hashset->size + 1 > COMPACT_MAX_LOAD(hashset->capacity) / 2) {
+        if (hashset->capacity & 0x80000000) return 0;
+        new_capacity = hashset->capacity << 1;
+    }
+
+    HASHSET_u32 new_hashset;
+    const u8 r = HASHSET_u32_init_allocator(&new_hashset, new_capacity, hashset->allocator);
+    if (r == 0) return 0;
+
+    const u32 mask = new_capacity - 1;
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        if (COMPACT_status_get(hashset->status, i) != COMPACT_STATUS_FILLED) continue;
+
+        const u32 hash = STORE_HASH ? hashset->hashes[i] : HASHSET_u32_key_hash(hashset->keys[i]);
+        u32 j = hash & mask;
+        while (COMPACT_status_get(new_hashset.status, j) != COMPACT_STATUS_EMPTY) j = (j + 1) & mask;
+
+        COMPACT_status_set(new_hashset.status, j, COMPACT_STATUS_FILLED);
+        new_hashset.keys[j] = hashset->keys[i];
+        if (STORE_HASH) new_hashset.hashes[j] = hash;
+    }
+
+    new_hashset.size = hashset->size;
+
+    HASHSET_u32_deinit(hashset);
+    *hashset = new_hashset;
+
+    return 1;
+}
+
+u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity == 0) return 0;
+
+    if (hashset->size + hashset->tombstones + 1 > COMPACT_MAX_LOAD(hashset->capacity)) {
+        const u8 r = HASHSET_u32_grow(hashset);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+    u32 found = hashset->capacity;
+
+    for (;;) {
+        const u8 status = COMPACT_status_get(hashset->status, i);
+        if (status == COMPACT_STATUS_EMPTY) {
+            if (found == hashset->capacity) found = i;
+            break;
+        }
+
+        if (status == COMPACT_STATUS_TOMBSTONE) {
+            if (found == hashset->capacity) found = i;
+        }
+        else if ((!STORE_HASH || hashset->hashes[i] == hash) &&
+            HASHSET_u32_key_equal(hashset->keys[i], key) == 1) return 0;
+
+        i = (i + 1) & mask;
+    }
+
+    if (COMPACT_status_get(hashset->status, found) == COMPACT_STATUS_TOMBSTONE) hashset->tombstones--;
+
+    COMPACT_status_set(hashset->status, found, COMPACT_STATUS_FILLED);
+    hashset->keys[found] = key;
+    if (STORE_HASH) hashset->hashes[found] = hash;
+
+    hashset->size++;
+    return 1;
+}
+
+u8 HASHSET_u32_add(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_quick_add(hashset, hash, key);
+}
+
+void HASHSET_u32_remove(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return;
+    if (hashset->capacity == 0) return;
+
+    const u32 i = HASHSET_u32_slot(hashset, HASHSET_u32_key_hash(key), key);
+    if (i == hashset->capacity) return;
+
+    COMPACT_status_set(hashset->status, i, COMPACT_STATUS_TOMBSTONE);
+    hashset->size--;
+    hashset->tombstones++;
+}
+
+u8 HASHSET_u32_contains(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const u32* found = HASHSET_u32_find(hashset, key);
+    if (found == NULL) return 0;
+    return 1;
+}
+
+u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return NULL;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_find_hashed(hashset, hash, key);
+}
+
+u8 HASHSET_u32_contains_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const u32* found = HASHSET_u32_find_hashed(hashset, hash, key);
+    if (found == NULL) return 0;
+    return 1;
+}
+
+u32* HASHSET_u32_find_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return NULL;
+    if (hashset->capacity == 0) return NULL;
+
+    const u32 i = HASHSET_u32_slot(hashset, hash, key);
+    if (i == hashset->capacity) return NULL;
+    return hashset->keys + i;
+}
+
+static inline u32 HASHSET_u32_slot_hash(const HASHSET_u32* hashset, const u32 i) {
+    return STORE_HASH ? hashset->hashes[i] : HASHSET_u32_key_hash(hashset->keys[i]);
+}
+
+HASHSET_u32* HASHSET_u32_union(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(a->capacity + b->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        if (COMPACT_status_get(a->status, ai) == COMPACT_STATUS_FILLED)
+            HASHSET_u32_quick_add(c, HASHSET_u32_slot_hash(a, ai), a->keys[ai]);
+    }
+
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        if (COMPACT_status_get(b->status, bi) == COMPACT_STATUS_FILLED)
+            HASHSET_u32_quick_add(c, HASHSET_u32_slot_hash(b, bi), b->keys[bi]);
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_intersection(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const HASHSET_u32* smaller;
+    const HASHSET_u32* larger;
+    if (a->capacity < b->capacity) {
+        smaller = a;
+        larger = b;
+    }
+    else {
+        smaller = b;
+        larger = a;
+    }
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(smaller->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        if (COMPACT_status_get(smaller->status, i) == COMPACT_STATUS_FILLED) {
+            const u32 hash = HASHSET_u32_slot_hash(smaller, i);
+            if (HASHSET_u32_contains_hashed(larger, hash, smaller->keys[i]) == 1) {
+                HASHSET_u32_quick_add(c, hash, smaller->keys[i]);
+            }
+        }
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_difference(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(a->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        if (COMPACT_status_get(a->status, ai) == COMPACT_STATUS_FILLED) {
+            const u32 hash = HASHSET_u32_slot_hash(a, ai);
+            if (HASHSET_u32_contains_hashed(b, hash, a->keys[ai]) == 0) {
+                HASHSET_u32_quick_add(c, hash, a->keys[ai]);
+            }
+        }
+    }
+
+    return c;
+}
\ No newline at end of file
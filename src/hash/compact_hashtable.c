@@ -0,0 +1,228 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/compact_hashtable.h"
+
+#define STORE_HASH 0
+
+HASHTABLE_DECLARE_COMPACT(u64, u64)
+
+u8 HASHTABLE_u64_u64_init(HASHTABLE_u64_u64* hashtable, const u32 capacity) {
+    return HASHTABLE_u64_u64_init_allocator(hashtable, capacity, NULL);
+}
+
+u8 HASHTABLE_u64_u64_init_allocator(HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    hashtable->allocator = allocator;
+    hashtable->size = 0;
+    hashtable->capacity = COMPACT_capacity(capacity);
+    hashtable->tombstones = 0;
+
+    const u32 words = COMPACT_status_words(hashtable->capacity);
+    hashtable->status = (u64*)NESQUIK_alloc(allocator, sizeof(u64) * words);
+    hashtable->keys = (u64*)NESQUIK_alloc(allocator, sizeof(u64) * hashtable->capacity);
+    hashtable->values = (u64*)NESQUIK_alloc(allocator, sizeof(u64) * hashtable->capacity);
+    hashtable->hashes = STORE_HASH ? (u32*)NESQUIK_alloc(allocator, sizeof(u32) * hashtable->capacity) : NULL;
+
+    if (hashtable->status == NULL || hashtable->keys == NULL || hashtable->values == NULL ||
+        (STORE_HASH && hashtable->hashes == NULL)) {
+        HASHTABLE_u64_u64_deinit(hashtable);
+        return 0;
+    }
+
+    memset(hashtable->status, 0, sizeof(u64) * words);
+
+    return 1;
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create(const u32 capacity) {
+    return HASHTABLE_u64_u64_create_allocator(capacity, NULL);
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    HASHTABLE_u64_u64* hashtable = (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = HASHTABLE_u64_u64_init_allocator(hashtable, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void HASHTABLE_u64_u64_deinit(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+    hashtable->size = 0;
+    hashtable->capacity = 0;
+    hashtable->tombstones = 0;
+
+    NESQUIK_free(hashtable->allocator, hashtable->status);
+    NESQUIK_free(hashtable->allocator, hashtable->keys);
+    NESQUIK_free(hashtable->allocator, hashtable->values);
+    NESQUIK_free(hashtable->allocator, hashtable->hashes);
+
+    hashtable->status = NULL;
+    hashtable->keys = NULL;
+    hashtable->values = NULL;
+    hashtable->hashes = NULL;
+}
+
+void HASHTABLE_u64_u64_destroy(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+static u32 HASHTABLE_u64_u64_slot(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 n = 0; n < hashtable->capacity; n++) {
+        const u8 status = COMPACT_status_get(hashtable->status, i);
+        if (status == COMPACT_STATUS_EMPTY) break;
+
+        if (status == COMPACT_STATUS_FILLED && (!STORE_HASH || hashtable->hashes[i] == hash) &&
+            HASHTABLE_u64_u64_key_equal(hashtable->keys[i], key) == 1) return i;
+
+        i = (i + 1) & mask;
+    }
+
+    return hashtable->capacity;
+}
+
+u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    u32 new_capacity = hashtable->capacity;
+    if (hashtable->size + 1 > COMPACT_MAX_LOAD(hashtable->capacity) / 2) {
+        if (hashtable->capacity & 0x80000000) return 0;
+        new_capacity = hashtable->capacity << 1;
+    }
+
+    HASHTABLE_u64_u64 new_hashtable;
+    const u8 r = HASHTABLE_u64_u64_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);
+    if (r == 0) return 0;
+
+    const u32 mask = new_capacity - 1;
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        if (COMPACT_status_get(hashtable->status, i) != COMPACT_STATUS_FILLED) continue;
+
+        const u32 hash = STORE_HASH ? hashtable->hashes[i] : HASHTABLE_u64_u64_key_hash(hashtable->keys[i]);
+        u32 j = hash & mask;
+        while (COMPACT_status_get(new_hashtable.status, j) != COMPACT_STATUS_EMPTY) j = (j + 1) & mask;
+
+        COMPACT_status_set(new_hashtable.status, j, COMPACT_STATUS_FILLED);
+        new_hashtable.keys[j] = hashtable->keys[i];
+        new_hashtable.values[j] = hashtable->values[i];
+        if (STORE_HASH) new_hashtable.hashes[j] = hash;
+    }
+
+    new_hashtable.size = hashtable->size;
+
+    HASHTABLE_u64_u64_deinit(hashtable);
+    *hashtable = new_hashtable;
+
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity == 0) return 0;
+
+    if (hashtable->size + hashtable->tombstones + 1 > COMPACT_MAX_LOAD(hashtable->capacity)) {
+        const u8 r = HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+    u32 found = hashtable->capacity;
+
+    for (;;) {
+        const u8 status = COMPACT_status_get(hashtable->status, i);
+        if (status == COMPACT_STATUS_EMPTY) {
+            if (found == hashtable->capacity) found = i;
+            break;
+        }
+
+        if (status == COMPACT_STATUS_TOMBSTONE) {
+            if (found == hashtable->capacity) found = i;
+        }
+        else if ((!STORE_HASH || hashtable->hashes[i] == hash) &&
+            HASHTABLE_u64_u64_key_equal(hashtable->keys[i], key) == 1) return 0;
+
+        i = (i + 1) & mask;
+    }
+
+    if (COMPACT_status_get(hashtable->status, found) == COMPACT_STATUS_TOMBSTONE) hashtable->tombstones--;
+
+    COMPACT_status_set(hashtable->status, found, COMPACT_STATUS_FILLED);
+    hashtable->keys[found] = key;
+    hashtable->values[found] = value;
+    if (STORE_HASH) hashtable->hashes[found] = hash;
+
+    hashtable->size++;
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_add(HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
+}
+
+void HASHTABLE_u64_u64_remove(HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return;
+    if (hashtable->capacity == 0) return;
+
+    const u32 i = HASHTABLE_u64_u64_slot(hashtable, HASHTABLE_u64_u64_key_hash(key), key);
+    if (i == hashtable->capacity) return;
+
+    COMPACT_status_set(hashtable->status, i, COMPACT_STATUS_TOMBSTONE);
+    hashtable->size--;
+    hashtable->tombstones++;
+}
+
+u8 HASHTABLE_u64_u64_contains(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const u64* value = HASHTABLE_u64_u64_find(hashtable, key);
+    if (value == NULL) return 0;
+    return 1;
+}
+
+u64* HASHTABLE_u64_u64_find(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 HASHTABLE_u64_u64_contains_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const u64* value = HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (value == NULL) return 0;
+    return 1;
+}
+
+u64* HASHTABLE_u64_u64_find_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    if (hashtable == NULL) return NULL;
+    if (hashtable->capacity == 0) return NULL;
+
+    const u32 i = HASHTABLE_u64_u64_slot(hashtable, hash, key);
+    if (i == hashtable->capacity) return NULL;
+    return hashtable->values + i;
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "hash/hash.h"
+#include "hash/concurrent_hashtable.h"
+
+HASHTABLE_DECLARE(u64, u64)
+CONCURRENT_HASHTABLE_DECLARE(u64, u64)
+
+static inline CONCURRENT_HASHTABLE_SEGMENT_u64_u64* CONCURRENT_HASHTABLE_u64_u64_segment(
+    const CONCURRENT_HASHTABLE_u64_u64* hashtable, const u32 hash) {
+
+    return hashtable->segments + (u32)((u64)hash >> (32 - hashtable->shift));
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_init(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const u32 segments) {
+
+    return CONCURRENT_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, segments, NULL);
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_init_allocator(CONCURRENT_HASHTABLE_u64_u64* hashtable,
+    const u32 capacity,
+    const u32 segments, const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    hashtable->allocator = allocator;
+    hashtable->shift = CONCURRENT_HASHTABLE_shift(segments == 0 ? CONCURRENT_HASHTABLE_DEFAULT_SEGMENTS : segments);
+    hashtable->segment_count = 1u << hashtable->shift;
+
+    hashtable->segments = (CONCURRENT_HASHTABLE_SEGMENT_u64_u64*)aligned_alloc(CONCURRENT_HASHTABLE_CACHE_LINE,
+        sizeof(CONCURRENT_HASHTABLE_SEGMENT_u64_u64) * hashtable->segment_count);
+    if (hashtable->segments == NULL) {
+        hashtable->segment_count = 0;
+        return 0;
+    }
+
+    const u32 segment_capacity = capacity / hashtable->segment_count;
+    for (u32 i = 0; i < hashtable->segment_count; i++) {
+        CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = hashtable->segments + i;
+
+        u8 r = HASHTABLE_u64_u64_init_allocator(&segment->hashtable, segment_capacity, allocator);
+        if (r == 1 && pthread_rwlock_init(&segment->lock, NULL) != 0) {
+            HASHTABLE_u64_u64_deinit(&segment->hashtable);
+            r = 0;
+        }
+
+        if (r == 0) {
+            hashtable->segment_count = i;
+            CONCURRENT_HASHTABLE_u64_u64_deinit(hashtable);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+CONCURRENT_HASHTABLE_u64_u64* CONCURRENT_HASHTABLE_u64_u64_create(const u32 capacity, const u32 segments) {
+    return CONCURRENT_HASHTABLE_u64_u64_create_allocator(capacity, segments, NULL);
+}
+
+CONCURRENT_HASHTABLE_u64_u64* CONCURRENT_HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const u32 segments, const NESQUIK_ALLOCATOR* allocator) {
+
+    CONCURRENT_HASHTABLE_u64_u64* hashtable =
+        (CONCURRENT_HASHTABLE_u64_u64*)NESQUIK_alloc(allocator, sizeof(CONCURRENT_HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = CONCURRENT_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, segments, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void CONCURRENT_HASHTABLE_u64_u64_deinit(CONCURRENT_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    for (u32 i = 0; i < hashtable->segment_count; i++) {
+        CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = hashtable->segments + i;
+        pthread_rwlock_destroy(&segment->lock);
+        HASHTABLE_u64_u64_deinit(&segment->hashtable);
+    }
+
+    free(hashtable->segments);
+    hashtable->segments = NULL;
+    hashtable->segment_count = 0;
+}
+
+void CONCURRENT_HASHTABLE_u64_u64_destroy(CONCURRENT_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    CONCURRENT_HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_add(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = CONCURRENT_HASHTABLE_u64_u64_segment(hashtable, hash);
+
+    pthread_rwlock_wrlock(&segment->lock);
+    const u8 r = HASHTABLE_u64_u64_quick_add(&segment->hashtable, hash, key, value);
+    pthread_rwlock_unlock(&segment->lock);
+
+    return r;
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_upsert(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u64 key,
+    const u64 value) {
+
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = CONCURRENT_HASHTABLE_u64_u64_segment(hashtable, hash);
+
+    pthread_rwlock_wrlock(&segment->lock);
+    const u8 r = HASHTABLE_u64_u64_quick_upsert(&segment->hashtable, hash, key, value);
+    pthread_rwlock_unlock(&segment->lock);
+
+    return r;
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_update(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u64 key,
+    const CONCURRENT_HASHTABLE_UPDATE_F_u64_u64 update_f, void* context) {
+
+    if (hashtable == NULL || update_f == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = CONCURRENT_HASHTABLE_u64_u64_segment(hashtable, hash);
+
+    u8 inserted = 0;
+    pthread_rwlock_wrlock(&segment->lock);
+    u64* value = HASHTABLE_u64_u64_quick_get_or_insert(&segment->hashtable, hash, key, &inserted);
+    if (value != NULL) update_f(value, inserted, context);
+    pthread_rwlock_unlock(&segment->lock);
+
+    return value != NULL;
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_remove(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = CONCURRENT_HASHTABLE_u64_u64_segment(hashtable, hash);
+
+    pthread_rwlock_wrlock(&segment->lock);
+    const u32 size = segment->hashtable.size;
+    HASHTABLE_u64_u64_remove(&segment->hashtable, key);
+    const u8 removed = segment->hashtable.size != size;
+    pthread_rwlock_unlock(&segment->lock);
+
+    return removed;
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_get(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u64 key, u64* value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = CONCURRENT_HASHTABLE_u64_u64_segment(hashtable, hash);
+
+    pthread_rwlock_rdlock(&segment->lock);
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(&segment->hashtable, hash, key);
+    if (entry != NULL && value != NULL) *value = entry->value;
+    pthread_rwlock_unlock(&segment->lock);
+
+    return entry != NULL;
+}
+
+u8 CONCURRENT_HASHTABLE_u64_u64_contains(CONCURRENT_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    return CONCURRENT_HASHTABLE_u64_u64_get(hashtable, key, NULL);
+}
+
+u32 CONCURRENT_HASHTABLE_u64_u64_size(CONCURRENT_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    u32 size = 0;
+    for (u32 i = 0; i < hashtable->segment_count; i++) {
+        CONCURRENT_HASHTABLE_SEGMENT_u64_u64* segment = hashtable->segments + i;
+        pthread_rwlock_rdlock(&segment->lock);
+        size += segment->hashtable.size;
+        pthread_rwlock_unlock(&segment->lock);
+    }
+
+    return size;
+}
\ No newline at end of file
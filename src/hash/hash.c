@@ -1,5 +1,26 @@
 #include "hash/hash.h"
 
+#include <string.h>
+#include <stdatomic.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define HASH_NEON
+#include <arm_neon.h>
+#endif
+
+#define HASH_WIDE_MAX_LANES 4
+
+static const u64 HASH_WIDE_SECRET[HASH_WIDE_MAX_LANES] = {
+    0xBE4BA423396CFEB8ULL, 0x1CAD21F72C81017CULL, 0xDB979083E96DD4DEULL, 0x1F67B3B7A4A44072ULL
+};
+
+static const u64 HASH_WIDE_LANE_SEED[HASH_WIDE_MAX_LANES] = {
+    HASH_WIDE_PRIME_1, HASH_WIDE_PRIME_2, HASH_WIDE_PRIME_3, HASH_WIDE_PRIME_4
+};
+
 u32 HASH_fnv1a(const u8* data, const u32 size) {
     u32 hash = HASH_FNV32_BASIS;
     for (u32 i = 0; i < size; i++) {
@@ -8,4 +29,334 @@ u32 HASH_fnv1a(const u8* data, const u32 size) {
     }
 
     return hash;
+}
+
+static inline u64 HASH_read64(const u8* data) {
+    u64 v;
+    memcpy(&v, data, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline u64 HASH_rotl64(const u64 x, const u32 r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline u64 HASH_wide_round(const u64 acc, const u64 v, const u64 secret) {
+    const u64 k = v ^ secret;
+    return HASH_rotl64(acc + v + (k & 0xFFFFFFFF) * (k >> 32), HASH_WIDE_ROTATE);
+}
+
+static void HASH_wide_init(u64* acc, const u32 lanes) {
+    for (u32 i = 0; i < lanes; i++) acc[i] = HASH_WIDE_LANE_SEED[i];
+}
+
+static void HASH_wide_stripes(u64* acc, const u32 lanes, const u8* data, const u32 n_stripes) {
+    for (u32 s = 0; s < n_stripes; s++) {
+        for (u32 i = 0; i < lanes; i++) {
+            acc[i] = HASH_wide_round(acc[i], HASH_read64(data + 8 * i), HASH_WIDE_SECRET[i]);
+        }
+        data += 8 * lanes;
+    }
+}
+
+// Fold the remaining (less than a stripe) bytes into the lanes and merge them into the final hash
+static u64 HASH_wide_final(u64* acc, const u32 lanes, const u8* tail, const u32 tail_size, const u64 total_size) {
+    const u32 words = tail_size >> 3;
+    for (u32 i = 0; i < words; i++) {
+        acc[i] = HASH_wide_round(acc[i], HASH_read64(tail + 8 * i), HASH_WIDE_SECRET[i]);
+    }
+
+    const u32 rest = tail_size & 7;
+    if (rest != 0) {
+        u64 v = 0;
+        for (u32 i = 0; i < rest; i++) v |= (u64)tail[8 * words + i] << (8 * i);
+        acc[words] = HASH_wide_round(acc[words], v, HASH_WIDE_SECRET[words]);
+    }
+
+    u64 hash = total_size * HASH_WIDE_PRIME_1 + lanes;
+    for (u32 i = 0; i < lanes; i++) {
+        hash ^= acc[i] * HASH_WIDE_PRIME_2;
+        hash = HASH_rotl64(hash, 31) * HASH_WIDE_PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= HASH_WIDE_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_WIDE_PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+static void HASH_wide32_stripes_scalar(u64* acc, const u8* data, const u32 n_stripes) {
+    HASH_wide_stripes(acc, 4, data, n_stripes);
+}
+
+#ifdef HASH_X86
+__attribute__((target("sse2")))
+static void HASH_wide32_stripes_sse2(u64* acc, const u8* data, const u32 n_stripes) {
+    __m128i a0 = _mm_loadu_si128((const __m128i*)acc);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)(acc + 2));
+    const __m128i s0 = _mm_loadu_si128((const __m128i*)HASH_WIDE_SECRET);
+    const __m128i s1 = _mm_loadu_si128((const __m128i*)(HASH_WIDE_SECRET + 2));
+
+    for (u32 i = 0; i < n_stripes; i++) {
+        const __m128i v0 = _mm_loadu_si128((const __m128i*)(data + 32 * i));
+        const __m128i v1 = _mm_loadu_si128((const __m128i*)(data + 32 * i + 16));
+        const __m128i k0 = _mm_xor_si128(v0, s0);
+        const __m128i k1 = _mm_xor_si128(v1, s1);
+
+        a0 = _mm_add_epi64(a0, _mm_add_epi64(v0, _mm_mul_epu32(k0, _mm_srli_epi64(k0, 32))));
+        a1 = _mm_add_epi64(a1, _mm_add_epi64(v1, _mm_mul_epu32(k1, _mm_srli_epi64(k1, 32))));
+        a0 = _mm_or_si128(_mm_slli_epi64(a0, HASH_WIDE_ROTATE), _mm_srli_epi64(a0, 64 - HASH_WIDE_ROTATE));
+        a1 = _mm_or_si128(_mm_slli_epi64(a1, HASH_WIDE_ROTATE), _mm_srli_epi64(a1, 64 - HASH_WIDE_ROTATE));
+    }
+
+    _mm_storeu_si128((__m128i*)acc, a0);
+    _mm_storeu_si128((__m128i*)(acc + 2), a1);
+}
+
+__attribute__((target("avx2")))
+static void HASH_wide32_stripes_avx2(u64* acc, const u8* data, const u32 n_stripes) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)acc);
+    const __m256i s = _mm256_loadu_si256((const __m256i*)HASH_WIDE_SECRET);
+
+    for (u32 i = 0; i < n_stripes; i++) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(data + 32 * i));
+        const __m256i k = _mm256_xor_si256(v, s);
+
+        a = _mm256_add_epi64(a, _mm256_add_epi64(v, _mm256_mul_epu32(k, _mm256_srli_epi64(k, 32))));
+        a = _mm256_or_si256(_mm256_slli_epi64(a, HASH_WIDE_ROTATE), _mm256_srli_epi64(a, 64 - HASH_WIDE_ROTATE));
+    }
+
+    _mm256_storeu_si256((__m256i*)acc, a);
+}
+#endif
+
+#ifdef HASH_NEON
+static void HASH_wide32_stripes_neon(u64* acc, const u8* data, const u32 n_stripes) {
+    uint64x2_t a0 = vld1q_u64(acc);
+    uint64x2_t a1 = vld1q_u64(acc + 2);
+    const uint64x2_t s0 = vld1q_u64(HASH_WIDE_SECRET);
+    const uint64x2_t s1 = vld1q_u64(HASH_WIDE_SECRET + 2);
+
+    for (u32 i = 0; i < n_stripes; i++) {
+        const uint64x2_t v0 = vreinterpretq_u64_u8(vld1q_u8(data + 32 * i));
+        const uint64x2_t v1 = vreinterpretq_u64_u8(vld1q_u8(data + 32 * i + 16));
+        const uint64x2_t k0 = veorq_u64(v0, s0);
+        const uint64x2_t k1 = veorq_u64(v1, s1);
+
+        a0 = vaddq_u64(a0, vaddq_u64(v0, vmull_u32(vmovn_u64(k0), vshrn_n_u64(k0, 32))));
+        a1 = vaddq_u64(a1, vaddq_u64(v1, vmull_u32(vmovn_u64(k1), vshrn_n_u64(k1, 32))));
+        a0 = vorrq_u64(vshlq_n_u64(a0, HASH_WIDE_ROTATE), vshrq_n_u64(a0, 64 - HASH_WIDE_ROTATE));
+        a1 = vorrq_u64(vshlq_n_u64(a1, HASH_WIDE_ROTATE), vshrq_n_u64(a1, 64 - HASH_WIDE_ROTATE));
+    }
+
+    vst1q_u64(acc, a0);
+    vst1q_u64(acc + 2, a1);
+}
+#endif
+
+typedef void (*HASH_STRIPES_F)(u64* acc, const u8* data, u32 n_stripes);
+
+// NULL until the first HASH_wide32 or an explicit HASH_wide_set_kernel picks a kernel. Hashing threads share it,
+// so it is only read and written atomically.
+static _Atomic(HASH_STRIPES_F) HASH_wide32_stripes = NULL;
+
+static u8 HASH_wide_kernel_supported(const u8 kernel) {
+    switch (kernel) {
+        case HASH_KERNEL_SCALAR: return 1;
+#ifdef HASH_X86
+        case HASH_KERNEL_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2") ? 1 : 0;
+        case HASH_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+#ifdef HASH_NEON
+        case HASH_KERNEL_NEON: return 1;
+#endif
+        default: return 0;
+    }
+}
+
+static HASH_STRIPES_F HASH_wide32_stripes_of(const u8 kernel) {
+    switch (kernel) {
+#ifdef HASH_X86
+        case HASH_KERNEL_SSE2: return HASH_wide32_stripes_sse2;
+        case HASH_KERNEL_AVX2: return HASH_wide32_stripes_avx2;
+#endif
+#ifdef HASH_NEON
+        case HASH_KERNEL_NEON: return HASH_wide32_stripes_neon;
+#endif
+        default: return HASH_wide32_stripes_scalar;
+    }
+}
+
+// The widest kernel the CPU supports
+static u8 HASH_wide_best_kernel(void) {
+    if (HASH_wide_kernel_supported(HASH_KERNEL_AVX2) == 1) return HASH_KERNEL_AVX2;
+    if (HASH_wide_kernel_supported(HASH_KERNEL_NEON) == 1) return HASH_KERNEL_NEON;
+    if (HASH_wide_kernel_supported(HASH_KERNEL_SSE2) == 1) return HASH_KERNEL_SSE2;
+    return HASH_KERNEL_SCALAR;
+}
+
+// Resolves the kernel on first use. Racing first calls all install the same one, and an explicit
+// HASH_wide_set_kernel that got there first is kept.
+static HASH_STRIPES_F HASH_wide32_stripes_get(void) {
+    HASH_STRIPES_F stripes = atomic_load_explicit(&HASH_wide32_stripes, memory_order_acquire);
+    if (stripes != NULL) return stripes;
+
+    const HASH_STRIPES_F best = HASH_wide32_stripes_of(HASH_wide_best_kernel());
+    if (atomic_compare_exchange_strong_explicit(&HASH_wide32_stripes, &stripes, best,
+        memory_order_acq_rel, memory_order_acquire)) {
+
+        return best;
+    }
+
+    return stripes;
+}
+
+u8 HASH_wide_set_kernel(const u8 kernel) {
+    if (HASH_wide_kernel_supported(kernel) == 0) return 0;
+
+    atomic_store_explicit(&HASH_wide32_stripes, HASH_wide32_stripes_of(kernel), memory_order_release);
+    return 1;
+}
+
+u8 HASH_wide_kernel(void) {
+    const HASH_STRIPES_F stripes = HASH_wide32_stripes_get();
+
+#ifdef HASH_X86
+    if (stripes == HASH_wide32_stripes_sse2) return HASH_KERNEL_SSE2;
+    if (stripes == HASH_wide32_stripes_avx2) return HASH_KERNEL_AVX2;
+#endif
+#ifdef HASH_NEON
+    if (stripes == HASH_wide32_stripes_neon) return HASH_KERNEL_NEON;
+#endif
+    (void)stripes;
+    return HASH_KERNEL_SCALAR;
+}
+
+u64 HASH_wide8(const u8* data, const u32 size) {
+    u64 acc[1];
+    HASH_wide_init(acc, 1);
+
+    const u32 n_stripes = size >> 3;
+    HASH_wide_stripes(acc, 1, data, n_stripes);
+
+    return HASH_wide_final(acc, 1, data + 8 * n_stripes, size & 7, size);
+}
+
+u64 HASH_wide16(const u8* data, const u32 size) {
+    u64 acc[2];
+    HASH_wide_init(acc, 2);
+
+    const u32 n_stripes = size >> 4;
+    HASH_wide_stripes(acc, 2, data, n_stripes);
+
+    return HASH_wide_final(acc, 2, data + 16 * n_stripes, size & 15, size);
+}
+
+u64 HASH_wide32(const u8* data, const u32 size) {
+    u64 acc[4];
+    HASH_wide_init(acc, 4);
+
+    // Keys shorter than a stripe never pay for the indirect call
+    const u32 n_stripes = size >> 5;
+    if (n_stripes != 0) HASH_wide32_stripes_get()(acc, data, n_stripes);
+
+    return HASH_wide_final(acc, 4, data + 32 * n_stripes, size & 31, size);
+}
+
+u32 HASH_wide(const u8* data, const u32 size) {
+    const u64 hash = HASH_wide32(data, size);
+    return (u32)(hash ^ (hash >> 32));
+}
+
+static u32 HASH_STATE_lanes(const HASH_STATE* state) {
+    switch (state->kind) {
+        case HASH_STATE_WIDE8: return 1;
+        case HASH_STATE_WIDE16: return 2;
+        default: return 4;
+    }
+}
+
+static void HASH_STATE_stripes(const HASH_STATE* state, u64* lanes, const u8* data, const u32 n_stripes) {
+    if (state->kind == HASH_STATE_WIDE32) HASH_wide32_stripes_get()(lanes, data, n_stripes);
+    else HASH_wide_stripes(lanes, HASH_STATE_lanes(state), data, n_stripes);
+}
+
+u8 HASH_STATE_init(HASH_STATE* state, const u8 kind) {
+    if (state == NULL) return 0;
+    if (kind > HASH_STATE_WIDE32) return 0;
+
+    memset(state, 0, sizeof(HASH_STATE));
+    state->kind = kind;
+
+    if (kind == HASH_STATE_FNV1A) state->lanes[0] = HASH_FNV32_BASIS;
+    else HASH_wide_init(state->lanes, HASH_STATE_lanes(state));
+
+    return 1;
+}
+
+void HASH_STATE_update(HASH_STATE* state, const u8* data, u32 size) {
+    if (state == NULL || size == 0) return;
+
+    state->size += size;
+
+    if (state->kind == HASH_STATE_FNV1A) {
+        u32 hash = (u32)state->lanes[0];
+        for (u32 i = 0; i < size; i++) {
+            hash ^= data[i];
+            hash *= HASH_FNV32_PRIME;
+        }
+
+        state->lanes[0] = hash;
+        return;
+    }
+
+    // Stripes are consumed as soon as they are complete, the one shot kernels never see a full stripe in the tail
+    const u32 stripe_size = 8 * HASH_STATE_lanes(state);
+
+    if (state->buffered != 0) {
+        const u32 fill = stripe_size - state->buffered < size ? stripe_size - state->buffered : size;
+        memcpy(state->buffer + state->buffered, data, fill);
+        state->buffered += fill;
+        data += fill;
+        size -= fill;
+
+        if (state->buffered < stripe_size) return;
+
+        HASH_STATE_stripes(state, state->lanes, state->buffer, 1);
+        state->buffered = 0;
+    }
+
+    const u32 n_stripes = size / stripe_size;
+    if (n_stripes != 0) HASH_STATE_stripes(state, state->lanes, data, n_stripes);
+
+    const u32 rest = size - n_stripes * stripe_size;
+    memcpy(state->buffer, data + n_stripes * stripe_size, rest);
+    state->buffered = (u8)rest;
+}
+
+u64 HASH_STATE_final(const HASH_STATE* state) {
+    if (state == NULL) return 0;
+    if (state->kind == HASH_STATE_FNV1A) return state->lanes[0];
+
+    u64 lanes[4];
+    memcpy(lanes, state->lanes, sizeof(lanes));
+
+    return HASH_wide_final(lanes, HASH_STATE_lanes(state), state->buffer, state->buffered, state->size);
+}
+
+u32 HASH_STATE_final32(const HASH_STATE* state) {
+    const u64 hash = HASH_STATE_final(state);
+    if (state == NULL || state->kind == HASH_STATE_FNV1A) return (u32)hash;
+
+    return (u32)(hash ^ (hash >> 32));
 }
\ No newline at end of file
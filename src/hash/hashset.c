@@ -7,30 +7,44 @@
 HASHSET_DECLARE(u32)
 
 u8 HASHSET_u32_init(HASHSET_u32* hashset, const u32 capacity) {
+    return HASHSET_u32_init_allocator(hashset, capacity, NULL);
+}
+
+u8 HASHSET_u32_init_allocator(HASHSET_u32* hashset, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
     if (hashset == NULL) return 0;
 
+    hashset->allocator = allocator;
     hashset->size = 0;
     hashset->capacity = capacity < HASHSET_MIN_CAPACITY ? HASHSET_MIN_CAPACITY : capacity;
     hashset->tombstones = 0;
+    hashset->filter = NULL;
+    hashset->mapped = 0;
 
-    hashset->entries = (HASHSET_ENTRY_u32*)malloc(sizeof(HASHSET_ENTRY_u32) * capacity);
+    hashset->entries = (HASHSET_ENTRY_u32*)NESQUIK_alloc(allocator,
+        sizeof(HASHSET_ENTRY_u32) * hashset->capacity);
     if (hashset->entries == NULL) {
         hashset->capacity = 0;
         return 0;
     }
 
-    memset(hashset->entries, 0, sizeof(HASHSET_ENTRY_u32) * capacity);
+    memset(hashset->entries, 0, sizeof(HASHSET_ENTRY_u32) * hashset->capacity);
 
     return 1;
 }
 
 HASHSET_u32* HASHSET_u32_create(const u32 capacity) {
-    HASHSET_u32* hashset = (HASHSET_u32*)malloc(sizeof(HASHSET_u32));
+    return HASHSET_u32_create_allocator(capacity, NULL);
+}
+
+HASHSET_u32* HASHSET_u32_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    HASHSET_u32* hashset = (HASHSET_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_u32));
     if (hashset == NULL) return NULL;
 
-    const u8 r = HASHSET_u32_init(hashset, capacity);
+    const u8 r = HASHSET_u32_init_allocator(hashset, capacity, allocator);
     if (r == 0) {
-        free(hashset);
+        NESQUIK_free(allocator, hashset);
         return NULL;
     }
 
@@ -39,21 +53,30 @@ HASHSET_u32* HASHSET_u32_create(const u32 capacity) {
 
 void HASHSET_u32_deinit(HASHSET_u32* hashset) {
     if (hashset == NULL) return;
+    if (hashset->mapped == 1) {
+        MAPPED_close(hashset->entries, hashset->capacity, sizeof(HASHSET_ENTRY_u32));
+        hashset->entries = NULL;
+        hashset->mapped = 0;
+    }
+
     hashset->size = 0;
     hashset->capacity = 0;
     hashset->tombstones = 0;
 
     if (hashset->entries != NULL) {
-        free(hashset->entries);
+        NESQUIK_free(hashset->allocator, hashset->entries);
         hashset->entries = NULL;
     }
+
+    HASHSET_u32_detach_filter(hashset);
 }
 
 void HASHSET_u32_destroy(HASHSET_u32* hashset) {
     if (hashset == NULL) return;
 
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
     HASHSET_u32_deinit(hashset);
-    free(hashset);
+    NESQUIK_free(allocator, hashset);
 }
 
 u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
@@ -62,8 +85,22 @@ u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
     u32 new_capacity = (u32)(hashset->capacity * HASHSET_MAX_LOAD_FACTOR / HASHSET_MIN_LOAD_FACTOR);
     new_capacity = (new_capacity > hashset->capacity) ? new_capacity : hashset->capacity;
 
+    return HASHSET_u32_resize(hashset, new_capacity);
+}
+
+static void HASHSET_u32_fill_filter(const HASHSET_u32* hashset, BLOOM* filter) {
+    BLOOM_clear(filter);
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        const HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->status == HASHSET_ENTRY_STATUS_FILLED) BLOOM_add_hash(filter, entry->hash);
+    }
+}
+
+u8 HASHSET_u32_resize(HASHSET_u32* hashset, const u32 new_capacity) {
+    if (hashset == NULL || hashset->mapped == 1) return 0;
+
     HASHSET_u32 new_hashset;
-    u8 r = HASHSET_u32_init(&new_hashset, new_capacity);
+    u8 r = HASHSET_u32_init_allocator(&new_hashset, new_capacity, hashset->allocator);
     if (r == 0) return 0;
 
     for (u32 i = 0; i < hashset->capacity; i++) {
@@ -78,19 +115,157 @@ u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
         }
     }
 
-    free(hashset->entries);
+    NESQUIK_free(hashset->allocator, hashset->entries);
     hashset->entries = new_hashset.entries;
-    hashset->capacity = new_capacity;
+    hashset->capacity = new_hashset.capacity;
     hashset->tombstones = 0;
 
+    if (hashset->filter != NULL && hashset->capacity * HASHSET_MAX_LOAD_FACTOR > hashset->filter->expected)
+        HASHSET_u32_attach_filter(hashset, hashset->filter->false_rate);
+
     return 1;
 }
 
-u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
+u8 HASHSET_u32_rehash(HASHSET_u32* hashset) {
+    if (hashset == NULL || hashset->mapped == 1) return 0;
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->status == HASHSET_ENTRY_STATUS_FILLED) entry->status = HASHSET_ENTRY_STATUS_DISPLACED;
+        else memset(entry, 0, sizeof(HASHSET_ENTRY_u32));
+    }
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        if (hashset->entries[i].status != HASHSET_ENTRY_STATUS_DISPLACED) continue;
+
+        HASHSET_ENTRY_u32 moving = hashset->entries[i];
+        memset(hashset->entries + i, 0, sizeof(HASHSET_ENTRY_u32));
+
+        for (;;) {
+            u32 j = moving.hash % hashset->capacity;
+            while (hashset->entries[j].status == HASHSET_ENTRY_STATUS_FILLED)
+                j = (j + 1) % hashset->capacity;
+
+            const HASHSET_ENTRY_u32 displaced = hashset->entries[j];
+            hashset->entries[j] = moving;
+            hashset->entries[j].status = HASHSET_ENTRY_STATUS_FILLED;
+
+            if (displaced.status == HASHSET_ENTRY_STATUS_EMPTY) break;
+            moving = displaced;
+        }
+    }
+
+    hashset->tombstones = 0;
+    if (hashset->filter != NULL) HASHSET_u32_fill_filter(hashset, hashset->filter);
+    return 1;
+}
+
+u8 HASHSET_u32_reserve(HASHSET_u32* hashset, const u32 n) {
+    if (hashset == NULL) return 0;
+
+    const u32 capacity = (u32)(n / HASHSET_MAX_LOAD_FACTOR) + 1;
+    if (capacity <= hashset->capacity) return 1;
+
+    return HASHSET_u32_resize(hashset, capacity);
+}
+
+u8 HASHSET_u32_shrink_to_fit(HASHSET_u32* hashset) {
+    if (hashset == NULL) return 0;
+
+    u32 capacity = (u32)(hashset->size / HASHSET_MAX_LOAD_FACTOR) + 1;
+    capacity = capacity < HASHSET_MIN_CAPACITY ? HASHSET_MIN_CAPACITY : capacity;
+
+    if (capacity < hashset->capacity) return HASHSET_u32_resize(hashset, capacity);
+    if (hashset->tombstones == 0) return 1;
+    return HASHSET_u32_rehash(hashset);
+}
+
+u8 HASHSET_u32_attach_filter(HASHSET_u32* hashset, const f64 false_rate) {
     if (hashset == NULL) return 0;
 
-    if ((hashset->size + 0.0) / hashset->capacity >= HASHSET_MAX_LOAD_FACTOR) {
-        const u8 r = HASHSET_u32_grow(hashset);
+    const u32 expected = (u32)(hashset->capacity * HASHSET_MAX_LOAD_FACTOR) + 1;
+    BLOOM* filter = BLOOM_create(expected > hashset->size ? expected : hashset->size, false_rate);
+    if (filter == NULL) return 0;
+
+    HASHSET_u32_fill_filter(hashset, filter);
+    BLOOM_destroy(hashset->filter);
+    hashset->filter = filter;
+    return 1;
+}
+
+void HASHSET_u32_detach_filter(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+
+    BLOOM_destroy(hashset->filter);
+    hashset->filter = NULL;
+}
+
+static u64 HASHSET_u32_fingerprint(void) {
+    u64 fingerprint = MAPPED_fingerprint_mix(0, offsetof(HASHSET_ENTRY_u32, status));
+    fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHSET_ENTRY_u32, hash));
+    fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHSET_ENTRY_u32, key));
+
+    u32 key;
+    for (u32 i = 0; i < MAPPED_FINGERPRINT_PROBES; i++) {
+        MAPPED_probe_key(&key, sizeof(u32), i);
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, HASHSET_u32_key_hash(key));
+    }
+
+    return fingerprint;
+}
+
+u8 HASHSET_u32_save(const HASHSET_u32* hashset, const char* path) {
+    if (hashset == NULL || path == NULL) return 0;
+
+    MAPPED_HEADER header;
+    header.kind = MAPPED_KIND_HASHSET;
+    header.entry_size = sizeof(HASHSET_ENTRY_u32);
+    header.key_size = sizeof(u32);
+    header.value_size = 0;
+    header.size = hashset->size;
+    header.capacity = hashset->capacity;
+    header.tombstones = hashset->tombstones;
+    header.fingerprint = HASHSET_u32_fingerprint();
+    return MAPPED_save(path, &header, hashset->entries);
+}
+
+HASHSET_u32* HASHSET_u32_open_mmap(const char* path) {
+    return HASHSET_u32_open_mmap_allocator(path, NULL);
+}
+
+HASHSET_u32* HASHSET_u32_open_mmap_allocator(const char* path, const NESQUIK_ALLOCATOR* allocator) {
+    MAPPED_HEADER header;
+    header.kind = MAPPED_KIND_HASHSET;
+    header.entry_size = sizeof(HASHSET_ENTRY_u32);
+    header.key_size = sizeof(u32);
+    header.value_size = 0;
+    header.fingerprint = HASHSET_u32_fingerprint();
+
+    HASHSET_ENTRY_u32* entries = (HASHSET_ENTRY_u32*)MAPPED_open(path, &header);
+    if (entries == NULL) return NULL;
+
+    HASHSET_u32* hashset = (HASHSET_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_u32));
+    if (hashset == NULL) {
+        MAPPED_close(entries, header.capacity, header.entry_size);
+        return NULL;
+    }
+
+    hashset->entries = entries;
+    hashset->size = header.size;
+    hashset->capacity = header.capacity;
+    hashset->tombstones = header.tombstones;
+    hashset->filter = NULL;
+    hashset->mapped = 1;
+    hashset->allocator = allocator;
+    return hashset;
+}
+
+u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL || hashset->mapped == 1) return 0;
+
+    if ((hashset->size + hashset->tombstones + 0.0) / hashset->capacity >= HASHSET_MAX_LOAD_FACTOR) {
+        const u8 purge = (hashset->size + 0.0) / hashset->capacity < HASHSET_MIN_LOAD_FACTOR;
+        const u8 r = purge == 1 ? HASHSET_u32_rehash(hashset) : HASHSET_u32_grow(hashset);
         if (r == 0) return 0;
     }
 
@@ -101,21 +276,27 @@ u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
         HASHSET_ENTRY_u32* entry = hashset->entries + i;
         const u8 status = entry->status;
 
-        if (status == HASHSET_ENTRY_STATUS_EMPTY || status == HASHSET_ENTRY_STATUS_TOMBSTONE) {
-            found_entry = entry;
+        if (status == HASHSET_ENTRY_STATUS_EMPTY) {
+            if (found_entry == NULL) found_entry = entry;
             break;
         }
 
-        if (entry->key == key) break;
+        if (status == HASHSET_ENTRY_STATUS_TOMBSTONE) {
+            if (found_entry == NULL) found_entry = entry;
+        }
+        else if (entry->hash == hash && HASHSET_u32_key_equal(entry->key, key) == 1) return 0;
+
         i = (i + 1) % hashset->capacity;
     } while (i != hash % hashset->capacity);
 
     if (found_entry == NULL) return 0;
+    if (found_entry->status == HASHSET_ENTRY_STATUS_TOMBSTONE) hashset->tombstones--;
 
     found_entry->status = HASHSET_ENTRY_STATUS_FILLED;
     found_entry->hash = hash;
     found_entry->key = key;
 
+    if (hashset->filter != NULL) BLOOM_add_hash(hashset->filter, hash);
     hashset->size++;
     return 1;
 }
@@ -123,12 +304,12 @@ u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
 u8 HASHSET_u32_add(HASHSET_u32* hashset, const u32 key) {
     if (hashset == NULL) return 0;
 
-    const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));
+    const u32 hash = HASHSET_u32_key_hash(key);
     return HASHSET_u32_quick_add(hashset, hash, key);
 }
 
 void HASHSET_u32_remove(HASHSET_u32* hashset, const u32 key) {
-    if (hashset == NULL) return;
+    if (hashset == NULL || hashset->mapped == 1) return;
 
     HASHSET_ENTRY_u32* entry = HASHSET_u32_find(hashset, key);
     if (entry == NULL) return;
@@ -139,10 +320,6 @@ void HASHSET_u32_remove(HASHSET_u32* hashset, const u32 key) {
     hashset->tombstones++;
 }
 
-u32 HASHSET_u32_hash(const u8* data, const u32 size) {
-    return HASH_fnv1a(data, size);
-}
-
 u8 HASHSET_u32_contains(const HASHSET_u32* hashset, const u32 key) {
     if (hashset == NULL) return 0;
 
@@ -154,8 +331,21 @@ u8 HASHSET_u32_contains(const HASHSET_u32* hashset, const u32 key) {
 HASHSET_ENTRY_u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
     if (hashset == NULL) return NULL;
 
-    // Determine the key_size
-    const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));
+    return HASHSET_u32_find_hashed(hashset, HASHSET_u32_key_hash(key), key);
+}
+
+u8 HASHSET_u32_contains_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find_hashed(hashset, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return NULL;
+    if (hashset->filter != NULL && BLOOM_may_contain_hash(hashset->filter, hash) == 0) return NULL;
+
     u32 i = hash % hashset->capacity;
 
     HASHSET_ENTRY_u32* entry;
@@ -171,7 +361,7 @@ HASHSET_ENTRY_u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
             continue;
         }
 
-        if (entry->key == key) break;
+        if (HASHSET_u32_key_equal(entry->key, key) == 1) break;
         i = (i + 1) % hashset->capacity;
     } while (i != hash % hashset->capacity);
 
@@ -179,10 +369,63 @@ HASHSET_ENTRY_u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
     return NULL;
 }
 
+u32 HASHSET_u32_add_many(HASHSET_u32* hashset, const u32* keys, const u32 n) {
+    if (hashset == NULL || keys == NULL) return 0;
+
+    const u32 capacity = (u32)((hashset->size + (f64)n) / HASHSET_MAX_LOAD_FACTOR) + 1;
+    if (capacity > hashset->capacity) {
+        const u8 r = HASHSET_u32_resize(hashset, capacity);
+        if (r == 0) return 0;
+    }
+
+    u32 hashes[HASHSET_BATCH_SIZE];
+    u32 added = 0;
+
+    for (u32 start = 0; start < n; start += HASHSET_BATCH_SIZE) {
+        const u32 count = n - start < HASHSET_BATCH_SIZE ? n - start : HASHSET_BATCH_SIZE;
+
+        for (u32 i = 0; i < count; i++) {
+            hashes[i] = HASHSET_u32_key_hash(keys[start + i]);
+            HASH_PREFETCH_WRITE(hashset->entries + hashes[i] % hashset->capacity);
+        }
+
+        for (u32 i = 0; i < count; i++)
+            added += HASHSET_u32_quick_add(hashset, hashes[i], keys[start + i]);
+    }
+
+    return added;
+}
+
+u32 HASHSET_u32_find_many(const HASHSET_u32* hashset, const u32* keys, const u32 n,
+    HASHSET_ENTRY_u32** out) {
+
+    if (hashset == NULL || keys == NULL || out == NULL) return 0;
+
+    u32 hashes[HASHSET_BATCH_SIZE];
+    u32 found = 0;
+
+    for (u32 start = 0; start < n; start += HASHSET_BATCH_SIZE) {
+        const u32 count = n - start < HASHSET_BATCH_SIZE ? n - start : HASHSET_BATCH_SIZE;
+
+        for (u32 i = 0; i < count; i++) {
+            hashes[i] = HASHSET_u32_key_hash(keys[start + i]);
+            HASH_PREFETCH(hashset->entries + hashes[i] % hashset->capacity);
+        }
+
+        for (u32 i = 0; i < count; i++) {
+            out[start + i] = HASHSET_u32_find_hashed(hashset, hashes[i], keys[start + i]);
+            if (out[start + i] != NULL) found++;
+        }
+    }
+
+    return found;
+}
+
 HASHSET_u32* HASHSET_u32_union(const HASHSET_u32* a, const HASHSET_u32* b) {
     if (a == NULL || b == NULL) return NULL;
 
-    HASHSET_u32* c = HASHSET_u32_create(a->capacity + b->capacity);
+    const u32 capacity = HASHSET_capacity_for(a->size + (f64)b->size);
+    HASHSET_u32* c = HASHSET_u32_create_allocator(capacity, a->allocator);
     if (c == NULL) return NULL;
 
     for (u32 ai = 0; ai < a->capacity; ai++) {
@@ -214,13 +457,14 @@ HASHSET_u32* HASHSET_u32_intersection(const HASHSET_u32* a, const HASHSET_u32* b
         larger = a;
     }
 
-    HASHSET_u32* c = HASHSET_u32_create(smaller->capacity);
+    const u32 capacity = HASHSET_capacity_for(a->size < b->size ? a->size : b->size);
+    HASHSET_u32* c = HASHSET_u32_create_allocator(capacity, a->allocator);
     if (c == NULL) return NULL;
 
     for (u32 i = 0; i < smaller->capacity; i++) {
         const HASHSET_ENTRY_u32 entry = smaller->entries[i];
         if (entry.status == HASHSET_ENTRY_STATUS_FILLED) {
-            if (HASHSET_u32_contains(larger, entry.key) == 1) {
+            if (HASHSET_u32_contains_hashed(larger, entry.hash, entry.key) == 1) {
                 HASHSET_u32_quick_add(c, entry.hash, entry.key);
             }
         }
@@ -229,20 +473,195 @@ HASHSET_u32* HASHSET_u32_intersection(const HASHSET_u32* a, const HASHSET_u32* b
     return c;
 }
 
-HASHSET_u32* HASHSET_difference(const HASHSET_u32* a, const HASHSET_u32* b) {
+HASHSET_u32* HASHSET_u32_difference(const HASHSET_u32* a, const HASHSET_u32* b) {
     if (a == NULL || b == NULL) return NULL;
 
-    HASHSET_u32* c = HASHSET_u32_create(a->capacity);
+    const u32 capacity = HASHSET_capacity_for(a->size);
+    HASHSET_u32* c = HASHSET_u32_create_allocator(capacity, a->allocator);
     if (c == NULL) return NULL;
 
     for (u32 ai = 0; ai < a->capacity; ai++) {
         const HASHSET_ENTRY_u32 entry = a->entries[ai];
         if (entry.status == HASHSET_ENTRY_STATUS_FILLED) {
-            if (HASHSET_u32_contains(b, entry.key) == 0) {
+            if (HASHSET_u32_contains_hashed(b, entry.hash, entry.key) == 0) {
                 HASHSET_u32_quick_add(c, entry.hash, entry.key);
             }
         }
     }
 
     return c;
+}
+
+static void HASHSET_u32_erase(HASHSET_u32* hashset, HASHSET_ENTRY_u32* entry) {
+    memset(entry, 0, sizeof(HASHSET_ENTRY_u32));
+    entry->status = HASHSET_ENTRY_STATUS_TOMBSTONE;
+    hashset->size--;
+    hashset->tombstones++;
+}
+
+u32 HASHSET_u32_union_into(HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL || a == b) return 0;
+
+    u32 added = 0;
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        const HASHSET_ENTRY_u32* entry = b->entries + bi;
+        if (entry->status == HASHSET_ENTRY_STATUS_FILLED)
+            added += HASHSET_u32_quick_add(a, entry->hash, entry->key);
+    }
+
+    return added;
+}
+
+u32 HASHSET_u32_intersect_inplace(HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL || a == b || a->mapped == 1) return 0;
+
+    u32 removed = 0;
+    for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {
+        HASHSET_ENTRY_u32* entry = a->entries + ai;
+        if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+        if (HASHSET_u32_contains_hashed(b, entry->hash, entry->key) == 1) continue;
+
+        HASHSET_u32_erase(a, entry);
+        removed++;
+    }
+
+    return removed;
+}
+
+u32 HASHSET_u32_subtract_inplace(HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL || a->mapped == 1) return 0;
+
+    u32 removed = 0;
+    if (a != b && b->capacity < a->capacity) {
+        for (u32 bi = 0; bi < b->capacity && a->size > 0; bi++) {
+            const HASHSET_ENTRY_u32* entry = b->entries + bi;
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+
+            HASHSET_ENTRY_u32* found = HASHSET_u32_find_hashed(a, entry->hash, entry->key);
+            if (found == NULL) continue;
+
+            HASHSET_u32_erase(a, found);
+            removed++;
+        }
+
+        return removed;
+    }
+
+    for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {
+        HASHSET_ENTRY_u32* entry = a->entries + ai;
+        if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+        if (a != b && HASHSET_u32_contains_hashed(b, entry->hash, entry->key) == 0) continue;
+
+        HASHSET_u32_erase(a, entry);
+        removed++;
+    }
+
+    return removed;
+}
+
+u32 HASHSET_u32_intersection_size(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return 0;
+    if (a == b) return a->size;
+
+    const HASHSET_u32* smaller = a->capacity < b->capacity ? a : b;
+    const HASHSET_u32* larger = a->capacity < b->capacity ? b : a;
+
+    u32 count = 0;
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        const HASHSET_ENTRY_u32* entry = smaller->entries + i;
+        if (entry->status == HASHSET_ENTRY_STATUS_FILLED)
+            count += HASHSET_u32_contains_hashed(larger, entry->hash, entry->key);
+    }
+
+    return count;
+}
+
+u32 HASHSET_u32_union_size(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return 0;
+
+    return a->size + b->size - HASHSET_u32_intersection_size(a, b);
+}
+
+u32 HASHSET_u32_difference_size(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return 0;
+
+    return a->size - HASHSET_u32_intersection_size(a, b);
+}
+
+void HASHSET_u32_iterate(HASHSET_ITERATOR_u32* iterator, const HASHSET_u32* hashset) {
+    if (iterator == NULL) return;
+
+    iterator->a = hashset;
+    iterator->b = NULL;
+    iterator->index = 0;
+    iterator->mode = HASHSET_ITERATE_ALL;
+}
+
+void HASHSET_u32_iterate_union(HASHSET_ITERATOR_u32* iterator,
+    const HASHSET_u32* a, const HASHSET_u32* b) {
+
+    if (iterator == NULL) return;
+
+    iterator->a = a;
+    iterator->b = b;
+    iterator->index = 0;
+    iterator->mode = a == b ? HASHSET_ITERATE_ALL : HASHSET_ITERATE_UNION;
+    if (b == NULL) iterator->a = NULL;
+}
+
+void HASHSET_u32_iterate_intersection(HASHSET_ITERATOR_u32* iterator,
+    const HASHSET_u32* a, const HASHSET_u32* b) {
+
+    if (iterator == NULL) return;
+
+    iterator->a = a != NULL && b != NULL && b->capacity < a->capacity ? b : a;
+    iterator->b = iterator->a == a ? b : a;
+    iterator->index = 0;
+    iterator->mode = HASHSET_ITERATE_INTERSECTION;
+    if (iterator->b == NULL) iterator->a = NULL;
+}
+
+void HASHSET_u32_iterate_difference(HASHSET_ITERATOR_u32* iterator,
+    const HASHSET_u32* a, const HASHSET_u32* b) {
+
+    if (iterator == NULL) return;
+
+    iterator->a = a == b ? NULL : a;
+    iterator->b = b;
+    iterator->index = 0;
+    iterator->mode = HASHSET_ITERATE_DIFFERENCE;
+    if (b == NULL) iterator->a = NULL;
+}
+
+const HASHSET_ENTRY_u32* HASHSET_u32_next(HASHSET_ITERATOR_u32* iterator) {
+    if (iterator == NULL || iterator->a == NULL) return NULL;
+
+    const HASHSET_u32* a = iterator->a;
+    const HASHSET_u32* b = iterator->b;
+
+    for (; iterator->index < a->capacity; iterator->index++) {
+        const HASHSET_ENTRY_u32* entry = a->entries + iterator->index;
+        if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+
+        if (iterator->mode == HASHSET_ITERATE_INTERSECTION &&
+            HASHSET_u32_contains_hashed(b, entry->hash, entry->key) == 0) continue;
+        if (iterator->mode == HASHSET_ITERATE_DIFFERENCE &&
+            HASHSET_u32_contains_hashed(b, entry->hash, entry->key) == 1) continue;
+
+        iterator->index++;
+        return entry;
+    }
+
+    if (iterator->mode != HASHSET_ITERATE_UNION) return NULL;
+
+    for (; iterator->index - a->capacity < b->capacity; iterator->index++) {
+        const HASHSET_ENTRY_u32* entry = b->entries + (iterator->index - a->capacity);
+        if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+        if (HASHSET_u32_contains_hashed(a, entry->hash, entry->key) == 1) continue;
+
+        iterator->index++;
+        return entry;
+    }
+
+    return NULL;
 }
\ No newline at end of file
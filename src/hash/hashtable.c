@@ -7,32 +7,48 @@
 HASHTABLE_DECLARE(u64, u64)
 
 u8 HASHTABLE_u64_u64_init(HASHTABLE_u64_u64* hashtable, const u32 capacity) {
+    return HASHTABLE_u64_u64_init_allocator(hashtable, capacity, NULL);
+}
+
+u8 HASHTABLE_u64_u64_init_allocator(HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
 
     if (hashtable == NULL) return 0;
 
+    hashtable->allocator = allocator;
     hashtable->size = 0;
     hashtable->capacity = capacity < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : capacity;
     hashtable->tombstones = 0;
+    hashtable->filter = NULL;
+    hashtable->mapped = 0;
 
-    hashtable->entries = (HASHTABLE_ENTRY_u64_u64*)malloc(sizeof(HASHTABLE_ENTRY_u64_u64) * capacity);
+    hashtable->entries = (HASHTABLE_ENTRY_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_ENTRY_u64_u64) *
+        hashtable->capacity);
     if (hashtable->entries == NULL) {
         hashtable->capacity = 0;
         return 0;
     }
 
-    memset(hashtable->entries, 0, sizeof(HASHTABLE_ENTRY_u64_u64) * capacity);
+    memset(hashtable->entries, 0, sizeof(HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
 
     return 1;
 }
 
-HASHTABLE_u64_u64* HASHTABLE_create(const u32 capacity) {
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create(const u32 capacity) {
+    return HASHTABLE_u64_u64_create_allocator(capacity, NULL);
+}
 
-    HASHTABLE_u64_u64* hashtable = (HASHTABLE_u64_u64*)malloc(sizeof(HASHTABLE_u64_u64));
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    HASHTABLE_u64_u64* hashtable = (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_u64_u64));
     if (hashtable == NULL) return NULL;
 
-    const u8 r = HASHTABLE_u64_u64_init(hashtable, capacity);
+    const u8 r = HASHTABLE_u64_u64_init_allocator(hashtable, capacity, allocator);
     if (r == 0) {
-        free(hashtable);
+        NESQUIK_free(allocator, hashtable);
         return NULL;
     }
 
@@ -41,21 +57,30 @@ HASHTABLE_u64_u64* HASHTABLE_create(const u32 capacity) {
 
 void HASHTABLE_u64_u64_deinit(HASHTABLE_u64_u64* hashtable) {
     if (hashtable == NULL) return;
+    if (hashtable->mapped == 1) {
+        MAPPED_close(hashtable->entries, hashtable->capacity, sizeof(HASHTABLE_ENTRY_u64_u64));
+        hashtable->entries = NULL;
+        hashtable->mapped = 0;
+    }
+
     hashtable->size = 0;
     hashtable->capacity = 0;
     hashtable->tombstones = 0;
 
     if (hashtable->entries != NULL) {
-        free(hashtable->entries);
+        NESQUIK_free(hashtable->allocator, hashtable->entries);
         hashtable->entries = NULL;
     }
+
+    HASHTABLE_u64_u64_detach_filter(hashtable);
 }
 
 void HASHTABLE_u64_u64_destroy(HASHTABLE_u64_u64* hashtable) {
     if (hashtable == NULL) return;
 
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
     HASHTABLE_u64_u64_deinit(hashtable);
-    free(hashtable);
+    NESQUIK_free(allocator, hashtable);
 }
 
 u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
@@ -64,8 +89,22 @@ u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
     u32 new_capacity = (u32)(hashtable->capacity * HASHTABLE_MAX_LOAD_FACTOR / HASHTABLE_MIN_LOAD_FACTOR);
     new_capacity = (new_capacity > hashtable->capacity) ? new_capacity : hashtable->capacity;
 
+    return HASHTABLE_u64_u64_resize(hashtable, new_capacity);
+}
+
+static void HASHTABLE_u64_u64_fill_filter(const HASHTABLE_u64_u64* hashtable, BLOOM* filter) {
+    BLOOM_clear(filter);
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        const HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED) BLOOM_add_hash(filter, entry->hash);
+    }
+}
+
+u8 HASHTABLE_u64_u64_resize(HASHTABLE_u64_u64* hashtable, const u32 new_capacity) {
+    if (hashtable == NULL || hashtable->mapped == 1) return 0;
+
     HASHTABLE_u64_u64 new_hashtable;
-    u8 r = HASHTABLE_u64_u64_init(&new_hashtable, new_capacity);
+    u8 r = HASHTABLE_u64_u64_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);
     if (r == 0) return 0;
 
     for (u32 i = 0; i < hashtable->capacity; i++) {
@@ -80,20 +119,164 @@ u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
         }
     }
 
-    free(hashtable->entries);
+    NESQUIK_free(hashtable->allocator, hashtable->entries);
     hashtable->entries = new_hashtable.entries;
-    hashtable->capacity = new_capacity;
+    hashtable->capacity = new_hashtable.capacity;
     hashtable->tombstones = 0;
 
+    if (hashtable->filter != NULL && hashtable->capacity * HASHTABLE_MAX_LOAD_FACTOR > hashtable->filter->expected)
+        HASHTABLE_u64_u64_attach_filter(hashtable, hashtable->filter->false_rate);
+
     return 1;
 }
 
-u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+u8 HASHTABLE_u64_u64_rehash(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL || hashtable->mapped == 1) return 0;
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED) entry->status = HASHTABLE_ENTRY_STATUS_DISPLACED;
+        else memset(entry, 0, sizeof(HASHTABLE_ENTRY_u64_u64));
+    }
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        if (hashtable->entries[i].status != HASHTABLE_ENTRY_STATUS_DISPLACED) continue;
+
+        HASHTABLE_ENTRY_u64_u64 moving = hashtable->entries[i];
+        memset(hashtable->entries + i, 0, sizeof(HASHTABLE_ENTRY_u64_u64));
+
+        for (;;) {
+            u32 j = moving.hash % hashtable->capacity;
+            while (hashtable->entries[j].status == HASHTABLE_ENTRY_STATUS_FILLED)
+                j = (j + 1) % hashtable->capacity;
+
+            const HASHTABLE_ENTRY_u64_u64 displaced = hashtable->entries[j];
+            hashtable->entries[j] = moving;
+            hashtable->entries[j].status = HASHTABLE_ENTRY_STATUS_FILLED;
+
+            if (displaced.status == HASHTABLE_ENTRY_STATUS_EMPTY) break;
+            moving = displaced;
+        }
+    }
+
+    hashtable->tombstones = 0;
+    if (hashtable->filter != NULL) HASHTABLE_u64_u64_fill_filter(hashtable, hashtable->filter);
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_reserve(HASHTABLE_u64_u64* hashtable, const u32 n) {
     if (hashtable == NULL) return 0;
 
-    if ((hashtable->size + 0.0) / hashtable->capacity >= HASHTABLE_MAX_LOAD_FACTOR) {
-        const u8 r = HASHTABLE_u64_u64_grow(hashtable);
-        if (r == 0) return 0;
+    const u32 capacity = (u32)(n / HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    if (capacity <= hashtable->capacity) return 1;
+
+    return HASHTABLE_u64_u64_resize(hashtable, capacity);
+}
+
+u8 HASHTABLE_u64_u64_shrink_to_fit(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    u32 capacity = (u32)(hashtable->size / HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    capacity = capacity < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : capacity;
+
+    if (capacity < hashtable->capacity) return HASHTABLE_u64_u64_resize(hashtable, capacity);
+    if (hashtable->tombstones == 0) return 1;
+    return HASHTABLE_u64_u64_rehash(hashtable);
+}
+
+u8 HASHTABLE_u64_u64_attach_filter(HASHTABLE_u64_u64* hashtable, const f64 false_rate) {
+    if (hashtable == NULL) return 0;
+
+    const u32 expected = (u32)(hashtable->capacity * HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    BLOOM* filter = BLOOM_create(expected > hashtable->size ? expected : hashtable->size, false_rate);
+    if (filter == NULL) return 0;
+
+    HASHTABLE_u64_u64_fill_filter(hashtable, filter);
+    BLOOM_destroy(hashtable->filter);
+    hashtable->filter = filter;
+    return 1;
+}
+
+void HASHTABLE_u64_u64_detach_filter(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    BLOOM_destroy(hashtable->filter);
+    hashtable->filter = NULL;
+}
+
+static u64 HASHTABLE_u64_u64_fingerprint(void) {
+    u64 fingerprint = MAPPED_fingerprint_mix(0, offsetof(HASHTABLE_ENTRY_u64_u64, status));
+    fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHTABLE_ENTRY_u64_u64, hash));
+    fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHTABLE_ENTRY_u64_u64, key));
+    fingerprint = MAPPED_fingerprint_mix(fingerprint, offsetof(HASHTABLE_ENTRY_u64_u64, value));
+
+    u64 key;
+    for (u32 i = 0; i < MAPPED_FINGERPRINT_PROBES; i++) {
+        MAPPED_probe_key(&key, sizeof(u64), i);
+        fingerprint = MAPPED_fingerprint_mix(fingerprint, HASHTABLE_u64_u64_key_hash(key));
+    }
+
+    return fingerprint;
+}
+
+u8 HASHTABLE_u64_u64_save(const HASHTABLE_u64_u64* hashtable, const char* path) {
+    if (hashtable == NULL || path == NULL) return 0;
+
+    MAPPED_HEADER header;
+    header.kind = MAPPED_KIND_HASHTABLE;
+    header.entry_size = sizeof(HASHTABLE_ENTRY_u64_u64);
+    header.key_size = sizeof(u64);
+    header.value_size = sizeof(u64);
+    header.size = hashtable->size;
+    header.capacity = hashtable->capacity;
+    header.tombstones = hashtable->tombstones;
+    header.fingerprint = HASHTABLE_u64_u64_fingerprint();
+    return MAPPED_save(path, &header, hashtable->entries);
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_open_mmap(const char* path) {
+    return HASHTABLE_u64_u64_open_mmap_allocator(path, NULL);
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_open_mmap_allocator(const char* path,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    MAPPED_HEADER header;
+    header.kind = MAPPED_KIND_HASHTABLE;
+    header.entry_size = sizeof(HASHTABLE_ENTRY_u64_u64);
+    header.key_size = sizeof(u64);
+    header.value_size = sizeof(u64);
+    header.fingerprint = HASHTABLE_u64_u64_fingerprint();
+
+    HASHTABLE_ENTRY_u64_u64* entries = (HASHTABLE_ENTRY_u64_u64*)MAPPED_open(path, &header);
+    if (entries == NULL) return NULL;
+
+    HASHTABLE_u64_u64* hashtable =
+        (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator, sizeof(HASHTABLE_u64_u64));
+    if (hashtable == NULL) {
+        MAPPED_close(entries, header.capacity, header.entry_size);
+        return NULL;
+    }
+
+    hashtable->entries = entries;
+    hashtable->size = header.size;
+    hashtable->capacity = header.capacity;
+    hashtable->tombstones = header.tombstones;
+    hashtable->filter = NULL;
+    hashtable->mapped = 1;
+    hashtable->allocator = allocator;
+    return hashtable;
+}
+
+u64* HASHTABLE_u64_u64_quick_get_or_insert(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key,
+    u8* inserted) {
+
+    if (hashtable == NULL || hashtable->mapped == 1) return NULL;
+
+    if ((hashtable->size + hashtable->tombstones + 0.0) / hashtable->capacity >= HASHTABLE_MAX_LOAD_FACTOR) {
+        const u8 purge = (hashtable->size + 0.0) / hashtable->capacity < HASHTABLE_MIN_LOAD_FACTOR;
+        const u8 r = purge == 1 ? HASHTABLE_u64_u64_rehash(hashtable) : HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return NULL;
     }
 
     u32 i = hash % hashtable->capacity;
@@ -103,35 +286,80 @@ u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, con
         HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
         const u8 status = entry->status;
 
-        if (status == HASHTABLE_ENTRY_STATUS_EMPTY || status == HASHTABLE_ENTRY_STATUS_TOMBSTONE) {
-            found_entry = entry;
+        if (status == HASHTABLE_ENTRY_STATUS_EMPTY) {
+            if (found_entry == NULL) found_entry = entry;
             break;
         }
 
-        if (entry->key == key) break;
+        if (status == HASHTABLE_ENTRY_STATUS_TOMBSTONE) {
+            if (found_entry == NULL) found_entry = entry;
+        }
+        else if (entry->hash == hash && HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) {
+            if (inserted != NULL) *inserted = 0;
+            return &entry->value;
+        }
+
         i = (i + 1) % hashtable->capacity;
     } while (i != hash % hashtable->capacity);
 
-    if (found_entry == NULL) return 0;
+    if (found_entry == NULL) return NULL;
+    if (found_entry->status == HASHTABLE_ENTRY_STATUS_TOMBSTONE) hashtable->tombstones--;
 
     found_entry->status = HASHTABLE_ENTRY_STATUS_FILLED;
     found_entry->hash = hash;
     found_entry->key = key;
-    found_entry->value = value;
+    memset(&found_entry->value, 0, sizeof(u64));
 
+    if (hashtable->filter != NULL) BLOOM_add_hash(hashtable->filter, hash);
     hashtable->size++;
+    if (inserted != NULL) *inserted = 1;
+    return &found_entry->value;
+}
+
+u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    u8 inserted;
+    u64* value_slot = HASHTABLE_u64_u64_quick_get_or_insert(hashtable, hash, key, &inserted);
+    if (value_slot == NULL || inserted == 0) return 0;
+
+    *value_slot = value;
     return 1;
 }
 
 u8 HASHTABLE_u64_u64_add(HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
     if (hashtable == NULL) return 0;
 
-    const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
     return HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
 }
 
+u8 HASHTABLE_u64_u64_quick_upsert(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    u64* value_slot = HASHTABLE_u64_u64_quick_get_or_insert(hashtable, hash, key, NULL);
+    if (value_slot == NULL) return 0;
+
+    *value_slot = value;
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_upsert(HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_quick_upsert(hashtable, hash, key, value);
+}
+
+u64* HASHTABLE_u64_u64_get_or_insert(HASHTABLE_u64_u64* hashtable, const u64 key, u8* inserted) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_quick_get_or_insert(hashtable, hash, key, inserted);
+}
+
 void HASHTABLE_u64_u64_remove(HASHTABLE_u64_u64* hashtable, const u64 key) {
-    if (hashtable == NULL) return;
+    if (hashtable == NULL || hashtable->mapped == 1) return;
 
     HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find(hashtable, key);
     if (entry == NULL) return;
@@ -142,10 +370,6 @@ void HASHTABLE_u64_u64_remove(HASHTABLE_u64_u64* hashtable, const u64 key) {
     hashtable->tombstones++;
 }
 
-u32 HASHTABLE_u64_u64_hash(const u8* data, const u32 size) {
-    return HASH_fnv1a(data, size);
-}
-
 u8 HASHTABLE_u64_u64_contains(const HASHTABLE_u64_u64* hashtable, const u64 key) {
     if (hashtable == NULL) return 0;
 
@@ -157,8 +381,24 @@ u8 HASHTABLE_u64_u64_contains(const HASHTABLE_u64_u64* hashtable, const u64 key)
 HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find(const HASHTABLE_u64_u64* hashtable, const u64 key) {
     if (hashtable == NULL) return NULL;
 
-    // Determine the key_size
-    const u32 hash = HASH_fnv1a((u8*)(&key), sizeof(key));
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 HASHTABLE_u64_u64_contains_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find_hashed(const HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+    if (hashtable->filter != NULL && BLOOM_may_contain_hash(hashtable->filter, hash) == 0) return NULL;
+
     u32 i = hash % hashtable->capacity;
 
     HASHTABLE_ENTRY_u64_u64* entry;
@@ -174,10 +414,62 @@ HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find(const HASHTABLE_u64_u64* hashtab
             continue;
         }
 
-        if (entry->key == key) break;
+        if (HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) break;
         i = (i + 1) % hashtable->capacity;
     } while (i != hash % hashtable->capacity);
 
     if (status == HASHTABLE_ENTRY_STATUS_FILLED) return entry;
     return NULL;
+}
+
+u32 HASHTABLE_u64_u64_add_many(HASHTABLE_u64_u64* hashtable, const u64* keys, const u64* values, const u32 n) {
+    if (hashtable == NULL || keys == NULL || values == NULL) return 0;
+
+    const u32 capacity = (u32)((hashtable->size + (f64)n) / HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    if (capacity > hashtable->capacity) {
+        const u8 r = HASHTABLE_u64_u64_resize(hashtable, capacity);
+        if (r == 0) return 0;
+    }
+
+    u32 hashes[HASHTABLE_BATCH_SIZE];
+    u32 added = 0;
+
+    for (u32 start = 0; start < n; start += HASHTABLE_BATCH_SIZE) {
+        const u32 count = n - start < HASHTABLE_BATCH_SIZE ? n - start : HASHTABLE_BATCH_SIZE;
+
+        for (u32 i = 0; i < count; i++) {
+            hashes[i] = HASHTABLE_u64_u64_key_hash(keys[start + i]);
+            HASH_PREFETCH_WRITE(hashtable->entries + hashes[i] % hashtable->capacity);
+        }
+
+        for (u32 i = 0; i < count; i++)
+            added += HASHTABLE_u64_u64_quick_add(hashtable, hashes[i], keys[start + i], values[start + i]);
+    }
+
+    return added;
+}
+
+u32 HASHTABLE_u64_u64_find_many(const HASHTABLE_u64_u64* hashtable, const u64* keys, const u32 n,
+    HASHTABLE_ENTRY_u64_u64** out) {
+
+    if (hashtable == NULL || keys == NULL || out == NULL) return 0;
+
+    u32 hashes[HASHTABLE_BATCH_SIZE];
+    u32 found = 0;
+
+    for (u32 start = 0; start < n; start += HASHTABLE_BATCH_SIZE) {
+        const u32 count = n - start < HASHTABLE_BATCH_SIZE ? n - start : HASHTABLE_BATCH_SIZE;
+
+        for (u32 i = 0; i < count; i++) {
+            hashes[i] = HASHTABLE_u64_u64_key_hash(keys[start + i]);
+            HASH_PREFETCH(hashtable->entries + hashes[i] % hashtable->capacity);
+        }
+
+        for (u32 i = 0; i < count; i++) {
+            out[start + i] = HASHTABLE_u64_u64_find_hashed(hashtable, hashes[i], keys[start + i]);
+            if (out[start + i] != NULL) found++;
+        }
+    }
+
+    return found;
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/incremental_hashtable.h"
+
+HASHTABLE_DECLARE(u64, u64)
+INCREMENTAL_HASHTABLE_DECLARE(u64, u64)
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_init(INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u32 capacity) {
+    return INCREMENTAL_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, NULL);
+}
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_init_allocator(INCREMENTAL_HASHTABLE_u64_u64* hashtable,
+    const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    memset(hashtable, 0, sizeof(INCREMENTAL_HASHTABLE_u64_u64));
+    hashtable->allocator = allocator;
+
+    const u32 new_capacity = capacity < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : capacity;
+    return HASHTABLE_u64_u64_init_allocator(&hashtable->table, new_capacity, allocator);
+}
+
+INCREMENTAL_HASHTABLE_u64_u64* INCREMENTAL_HASHTABLE_u64_u64_create(const u32 capacity) {
+    return INCREMENTAL_HASHTABLE_u64_u64_create_allocator(capacity, NULL);
+}
+
+INCREMENTAL_HASHTABLE_u64_u64* INCREMENTAL_HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    INCREMENTAL_HASHTABLE_u64_u64* hashtable =
+        (INCREMENTAL_HASHTABLE_u64_u64*)NESQUIK_alloc(allocator, sizeof(INCREMENTAL_HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = INCREMENTAL_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void INCREMENTAL_HASHTABLE_u64_u64_deinit(INCREMENTAL_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    HASHTABLE_u64_u64_deinit(&hashtable->table);
+    if (hashtable->migrating == 1) HASHTABLE_u64_u64_deinit(&hashtable->old);
+
+    hashtable->migrated = 0;
+    hashtable->migrating = 0;
+    hashtable->size = 0;
+}
+
+void INCREMENTAL_HASHTABLE_u64_u64_destroy(INCREMENTAL_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    INCREMENTAL_HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_migrate(INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u32 buckets) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->migrating == 0) return 1;
+
+    HASHTABLE_u64_u64* old = &hashtable->old;
+    const u32 end = old->capacity - hashtable->migrated < buckets ? old->capacity : hashtable->migrated + buckets;
+
+    for (; hashtable->migrated < end; hashtable->migrated++) {
+        HASHTABLE_ENTRY_u64_u64* entry = old->entries + hashtable->migrated;
+        if (entry->status != HASHTABLE_ENTRY_STATUS_FILLED) continue;
+
+        const u8 r = HASHTABLE_u64_u64_quick_add(&hashtable->table, entry->hash, entry->key, entry->value);
+        if (r == 0) return 0;
+
+        entry->status = HASHTABLE_ENTRY_STATUS_TOMBSTONE;
+        old->size--;
+        old->tombstones++;
+    }
+
+    if (hashtable->migrated == old->capacity) {
+        HASHTABLE_u64_u64_deinit(old);
+        hashtable->migrated = 0;
+        hashtable->migrating = 0;
+    }
+
+    return 1;
+}
+
+static u8 INCREMENTAL_HASHTABLE_u64_u64_reserve_one(INCREMENTAL_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable->migrating == 1) {
+        const u8 r = INCREMENTAL_HASHTABLE_u64_u64_migrate(hashtable, INCREMENTAL_HASHTABLE_MIGRATE_BUCKETS);
+        if (r == 0) return 0;
+    }
+
+    const HASHTABLE_u64_u64* table = &hashtable->table;
+    if ((table->size + table->tombstones + 0.0) / table->capacity < HASHTABLE_MAX_LOAD_FACTOR) return 1;
+
+    if (hashtable->migrating == 1) {
+        const u8 r = INCREMENTAL_HASHTABLE_u64_u64_migrate(hashtable, hashtable->old.capacity);
+        if (r == 0) return 0;
+    }
+
+    u32 capacity = table->capacity;
+    if ((table->size + 0.0) / table->capacity >= HASHTABLE_MIN_LOAD_FACTOR) {
+        if (capacity & 0x80000000) return 0;
+        capacity <<= 1;
+    }
+
+    HASHTABLE_u64_u64 new_table;
+    const u8 r = HASHTABLE_u64_u64_init_allocator(&new_table, capacity, hashtable->allocator);
+    if (r == 0) return 0;
+
+    hashtable->old = hashtable->table;
+    hashtable->table = new_table;
+    hashtable->migrated = 0;
+    hashtable->migrating = 1;
+
+    return 1;
+}
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_quick_add(INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u32 hash,
+    const u64 key, const u64 value) {
+
+    if (hashtable == NULL) return 0;
+
+    const u8 r = INCREMENTAL_HASHTABLE_u64_u64_reserve_one(hashtable);
+    if (r == 0) return 0;
+
+    if (hashtable->migrating == 1 &&
+        HASHTABLE_u64_u64_contains_hashed(&hashtable->old, hash, key) == 1) return 0;
+
+    const u8 added = HASHTABLE_u64_u64_quick_add(&hashtable->table, hash, key, value);
+    hashtable->size += added;
+    return added;
+}
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_add(INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return INCREMENTAL_HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
+}
+
+void INCREMENTAL_HASHTABLE_u64_u64_remove(INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return;
+
+    INCREMENTAL_HASHTABLE_u64_u64_migrate(hashtable, INCREMENTAL_HASHTABLE_MIGRATE_BUCKETS);
+
+    HASHTABLE_u64_u64_remove(&hashtable->table, key);
+    if (hashtable->migrating == 1) HASHTABLE_u64_u64_remove(&hashtable->old, key);
+
+    hashtable->size = hashtable->table.size + (hashtable->migrating == 1 ? hashtable->old.size : 0);
+}
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_contains(const INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = INCREMENTAL_HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* INCREMENTAL_HASHTABLE_u64_u64_find(const INCREMENTAL_HASHTABLE_u64_u64* hashtable,
+    const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return INCREMENTAL_HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 INCREMENTAL_HASHTABLE_u64_u64_contains_hashed(const INCREMENTAL_HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64 key) {
+
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = INCREMENTAL_HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* INCREMENTAL_HASHTABLE_u64_u64_find_hashed(
+    const INCREMENTAL_HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+
+    HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(&hashtable->table, hash, key);
+    if (entry != NULL || hashtable->migrating == 0) return entry;
+
+    return HASHTABLE_u64_u64_find_hashed(&hashtable->old, hash, key);
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "hash/hash.h"
+#include "hash/lockfree_hashtable.h"
+
+LOCKFREE_HASHTABLE_DECLARE(u64, u64)
+
+static LOCKFREE_HASHTABLE_ARRAY_u64_u64* LOCKFREE_HASHTABLE_u64_u64_array_create(const u32 capacity) {
+    LOCKFREE_HASHTABLE_ARRAY_u64_u64* array = (LOCKFREE_HASHTABLE_ARRAY_u64_u64*)malloc(
+        sizeof(LOCKFREE_HASHTABLE_ARRAY_u64_u64) + sizeof(_Atomic uintptr_t) * capacity);
+    if (array == NULL) return NULL;
+
+    array->capacity = capacity;
+    atomic_init(&array->used, 0);
+    for (u32 i = 0; i < capacity; i++) atomic_init(&array->slots[i], LOCKFREE_HASHTABLE_SLOT_EMPTY);
+
+    return array;
+}
+
+static inline LOCKFREE_HASHTABLE_NODE_u64_u64* LOCKFREE_HASHTABLE_u64_u64_node(const uintptr_t slot) {
+    const uintptr_t pointer = slot & ~LOCKFREE_HASHTABLE_SLOT_FROZEN;
+    if (pointer == LOCKFREE_HASHTABLE_SLOT_EMPTY || pointer == LOCKFREE_HASHTABLE_SLOT_TOMBSTONE) return NULL;
+    return (LOCKFREE_HASHTABLE_NODE_u64_u64*)pointer;
+}
+
+u8 LOCKFREE_HASHTABLE_u64_u64_init(LOCKFREE_HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const u32 max_threads) {
+
+    if (hashtable == NULL) return 0;
+
+    LOCKFREE_HASHTABLE_ARRAY_u64_u64* array =
+        LOCKFREE_HASHTABLE_u64_u64_array_create(LOCKFREE_HASHTABLE_capacity(capacity));
+    if (array == NULL) return 0;
+
+    if (EPOCH_init(&hashtable->epoch, max_threads) == 0) {
+        free(array);
+        return 0;
+    }
+
+    if (pthread_mutex_init(&hashtable->resize_mutex, NULL) != 0) {
+        EPOCH_deinit(&hashtable->epoch);
+        free(array);
+        return 0;
+    }
+
+    atomic_init(&hashtable->array, array);
+    atomic_init(&hashtable->size, 0);
+    return 1;
+}
+
+LOCKFREE_HASHTABLE_u64_u64* LOCKFREE_HASHTABLE_u64_u64_create(const u32 capacity, const u32 max_threads) {
+    LOCKFREE_HASHTABLE_u64_u64* hashtable = (LOCKFREE_HASHTABLE_u64_u64*)aligned_alloc(EPOCH_CACHE_LINE,
+        sizeof(LOCKFREE_HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = LOCKFREE_HASHTABLE_u64_u64_init(hashtable, capacity, max_threads);
+    if (r == 0) {
+        free(hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void LOCKFREE_HASHTABLE_u64_u64_deinit(LOCKFREE_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    LOCKFREE_HASHTABLE_ARRAY_u64_u64* array = atomic_load(&hashtable->array);
+    if (array == NULL) return;
+
+    for (u32 i = 0; i < array->capacity; i++) free(LOCKFREE_HASHTABLE_u64_u64_node(atomic_load(&array->slots[i])));
+    free(array);
+    atomic_store(&hashtable->array, NULL);
+    atomic_store(&hashtable->size, 0);
+
+    EPOCH_deinit(&hashtable->epoch);
+    pthread_mutex_destroy(&hashtable->resize_mutex);
+}
+
+void LOCKFREE_HASHTABLE_u64_u64_destroy(LOCKFREE_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    LOCKFREE_HASHTABLE_u64_u64_deinit(hashtable);
+    free(hashtable);
+}
+
+EPOCH_RECORD* LOCKFREE_HASHTABLE_u64_u64_register(LOCKFREE_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return NULL;
+    return EPOCH_register(&hashtable->epoch);
+}
+
+void LOCKFREE_HASHTABLE_u64_u64_unregister(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record) {
+    if (hashtable == NULL) return;
+    EPOCH_unregister(&hashtable->epoch, record);
+}
+
+static void LOCKFREE_HASHTABLE_u64_u64_reclaim(LOCKFREE_HASHTABLE_u64_u64* hashtable, void* pointer) {
+    if (pointer == NULL) return;
+
+    EPOCH_synchronize(&hashtable->epoch);
+    free(pointer);
+}
+
+static u8 LOCKFREE_HASHTABLE_u64_u64_resize(LOCKFREE_HASHTABLE_u64_u64* hashtable,
+    LOCKFREE_HASHTABLE_ARRAY_u64_u64* old_array) {
+
+    pthread_mutex_lock(&hashtable->resize_mutex);
+    if (atomic_load(&hashtable->array) != old_array) {
+        pthread_mutex_unlock(&hashtable->resize_mutex);
+        return 1;
+    }
+
+    const u32 size = atomic_load(&hashtable->size);
+    const u32 capacity = LOCKFREE_HASHTABLE_capacity(size < 0x40000000 ? size * 2 + 1 : 0x80000000);
+    LOCKFREE_HASHTABLE_ARRAY_u64_u64* new_array = LOCKFREE_HASHTABLE_u64_u64_array_create(capacity);
+    if (new_array == NULL) {
+        pthread_mutex_unlock(&hashtable->resize_mutex);
+        return 0;
+    }
+
+    u32 used = 0;
+    for (u32 i = 0; i < old_array->capacity; i++) {
+        uintptr_t slot = atomic_load(&old_array->slots[i]);
+        while ((slot & LOCKFREE_HASHTABLE_SLOT_FROZEN) == 0 &&
+            atomic_compare_exchange_weak(&old_array->slots[i], &slot, slot | LOCKFREE_HASHTABLE_SLOT_FROZEN) == 0);
+
+        const LOCKFREE_HASHTABLE_NODE_u64_u64* node = LOCKFREE_HASHTABLE_u64_u64_node(slot);
+        if (node == NULL) continue;
+
+        u32 j = node->hash & (capacity - 1);
+        while (atomic_load_explicit(&new_array->slots[j], memory_order_relaxed) != LOCKFREE_HASHTABLE_SLOT_EMPTY)
+            j = (j + 1) & (capacity - 1);
+        atomic_store_explicit(&new_array->slots[j], slot & ~LOCKFREE_HASHTABLE_SLOT_FROZEN, memory_order_relaxed);
+        used++;
+    }
+
+    atomic_store_explicit(&new_array->used, used, memory_order_relaxed);
+    atomic_store_explicit(&hashtable->array, new_array, memory_order_release);
+    pthread_mutex_unlock(&hashtable->resize_mutex);
+
+    if (EPOCH_retire(&hashtable->epoch, old_array, free) == 0)
+        LOCKFREE_HASHTABLE_u64_u64_reclaim(hashtable, old_array);
+    return 1;
+}
+
+static u8 LOCKFREE_HASHTABLE_u64_u64_store(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record,
+    const u64 key, const u64 value, const u8 replace) {
+
+    if (hashtable == NULL || record == NULL) return 0;
+
+    const u32 hash = LOCKFREE_HASHTABLE_u64_u64_key_hash(key);
+    LOCKFREE_HASHTABLE_NODE_u64_u64* node = NULL;
+    void* unretired = NULL;
+
+    u8 r = 2;
+    while (r == 2) {
+        EPOCH_enter(&hashtable->epoch, record);
+        LOCKFREE_HASHTABLE_ARRAY_u64_u64* array = atomic_load_explicit(&hashtable->array, memory_order_acquire);
+        const u32 mask = array->capacity - 1;
+
+        if (atomic_load_explicit(&array->used, memory_order_relaxed) >= LOCKFREE_HASHTABLE_MAX_LOAD(array->capacity)) {
+            EPOCH_exit(record);
+            if (LOCKFREE_HASHTABLE_u64_u64_resize(hashtable, array) == 0) r = 0;
+            continue;
+        }
+
+        if (node == NULL) {
+            node = (LOCKFREE_HASHTABLE_NODE_u64_u64*)malloc(sizeof(LOCKFREE_HASHTABLE_NODE_u64_u64));
+            if (node == NULL) {
+                EPOCH_exit(record);
+                return 0;
+            }
+
+            node->hash = hash;
+            node->key = key;
+            node->value = value;
+        }
+
+        u32 i = hash & mask;
+        u32 probes = 0;
+        while (r == 2 && probes < array->capacity) {
+            uintptr_t slot = atomic_load_explicit(&array->slots[i], memory_order_acquire);
+            if ((slot & LOCKFREE_HASHTABLE_SLOT_FROZEN) != 0) break;
+
+            const LOCKFREE_HASHTABLE_NODE_u64_u64* found = LOCKFREE_HASHTABLE_u64_u64_node(slot);
+            if (slot == LOCKFREE_HASHTABLE_SLOT_EMPTY) {
+                if (atomic_compare_exchange_strong(&array->slots[i], &slot, (uintptr_t)node) == 0) continue;
+
+                atomic_fetch_add_explicit(&array->used, 1, memory_order_relaxed);
+                atomic_fetch_add_explicit(&hashtable->size, 1, memory_order_relaxed);
+                node = NULL;
+                r = 1;
+            }
+            else if (found != NULL && found->hash == hash &&
+                LOCKFREE_HASHTABLE_u64_u64_key_equal(found->key, key) == 1) {
+
+                if (replace == 0) r = 0;
+                else if (atomic_compare_exchange_strong(&array->slots[i], &slot, (uintptr_t)node) == 1) {
+                    if (EPOCH_retire(&hashtable->epoch, (void*)found, free) == 0) unretired = (void*)found;
+                    node = NULL;
+                    r = 1;
+                }
+            }
+            else {
+                i = (i + 1) & mask;
+                probes++;
+            }
+        }
+
+        EPOCH_exit(record);
+        if (r == 2 && LOCKFREE_HASHTABLE_u64_u64_resize(hashtable, array) == 0) r = 0;
+    }
+
+    LOCKFREE_HASHTABLE_u64_u64_reclaim(hashtable, unretired);
+    free(node);
+    return r;
+}
+
+u8 LOCKFREE_HASHTABLE_u64_u64_add(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record,
+    const u64 key, const u64 value) {
+
+    return LOCKFREE_HASHTABLE_u64_u64_store(hashtable, record, key, value, 0);
+}
+
+u8 LOCKFREE_HASHTABLE_u64_u64_upsert(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record,
+    const u64 key, const u64 value) {
+
+    return LOCKFREE_HASHTABLE_u64_u64_store(hashtable, record, key, value, 1);
+}
+
+u8 LOCKFREE_HASHTABLE_u64_u64_remove(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record,
+    const u64 key) {
+
+    if (hashtable == NULL || record == NULL) return 0;
+
+    const u32 hash = LOCKFREE_HASHTABLE_u64_u64_key_hash(key);
+    void* unretired = NULL;
+
+    u8 r = 2;
+    while (r == 2) {
+        EPOCH_enter(&hashtable->epoch, record);
+        LOCKFREE_HASHTABLE_ARRAY_u64_u64* array = atomic_load_explicit(&hashtable->array, memory_order_acquire);
+        const u32 mask = array->capacity - 1;
+
+        u32 i = hash & mask;
+        u32 probes = 0;
+        while (r == 2 && probes < array->capacity) {
+            uintptr_t slot = atomic_load_explicit(&array->slots[i], memory_order_acquire);
+            if ((slot & LOCKFREE_HASHTABLE_SLOT_FROZEN) != 0) break;
+            if (slot == LOCKFREE_HASHTABLE_SLOT_EMPTY) r = 0;
+
+            const LOCKFREE_HASHTABLE_NODE_u64_u64* found = LOCKFREE_HASHTABLE_u64_u64_node(slot);
+            if (found != NULL && found->hash == hash && LOCKFREE_HASHTABLE_u64_u64_key_equal(found->key, key) == 1) {
+                if (atomic_compare_exchange_strong(&array->slots[i], &slot, LOCKFREE_HASHTABLE_SLOT_TOMBSTONE) == 0)
+                    continue;
+
+                atomic_fetch_sub_explicit(&hashtable->size, 1, memory_order_relaxed);
+                if (EPOCH_retire(&hashtable->epoch, (void*)found, free) == 0) unretired = (void*)found;
+                r = 1;
+            }
+
+            i = (i + 1) & mask;
+            probes++;
+        }
+
+        EPOCH_exit(record);
+        if (r == 2 && probes == array->capacity) r = 0;
+        if (r == 2 && LOCKFREE_HASHTABLE_u64_u64_resize(hashtable, array) == 0) r = 0;
+    }
+
+    LOCKFREE_HASHTABLE_u64_u64_reclaim(hashtable, unretired);
+    return r;
+}
+
+u8 LOCKFREE_HASHTABLE_u64_u64_get(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record,
+    const u64 key, u64* value) {
+
+    if (hashtable == NULL || record == NULL) return 0;
+
+    const u32 hash = LOCKFREE_HASHTABLE_u64_u64_key_hash(key);
+
+    EPOCH_enter(&hashtable->epoch, record);
+    const LOCKFREE_HASHTABLE_ARRAY_u64_u64* array = atomic_load_explicit(&hashtable->array, memory_order_acquire);
+    const u32 mask = array->capacity - 1;
+
+    u8 r = 0;
+    u32 i = hash & mask;
+    for (u32 probes = 0; probes < array->capacity; probes++) {
+        const uintptr_t slot = atomic_load_explicit(&array->slots[i], memory_order_acquire);
+        if ((slot & ~LOCKFREE_HASHTABLE_SLOT_FROZEN) == LOCKFREE_HASHTABLE_SLOT_EMPTY) break;
+
+        const LOCKFREE_HASHTABLE_NODE_u64_u64* found = LOCKFREE_HASHTABLE_u64_u64_node(slot);
+        if (found != NULL && found->hash == hash && LOCKFREE_HASHTABLE_u64_u64_key_equal(found->key, key) == 1) {
+            if (value != NULL) *value = found->value;
+            r = 1;
+            break;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    EPOCH_exit(record);
+    return r;
+}
+
+u8 LOCKFREE_HASHTABLE_u64_u64_contains(LOCKFREE_HASHTABLE_u64_u64* hashtable, EPOCH_RECORD* record,
+    const u64 key) {
+
+    return LOCKFREE_HASHTABLE_u64_u64_get(hashtable, record, key, NULL);
+}
+
+u32 LOCKFREE_HASHTABLE_u64_u64_size(LOCKFREE_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+    return atomic_load_explicit(&hashtable->size, memory_order_relaxed);
+}
\ No newline at end of file
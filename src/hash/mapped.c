@@ -0,0 +1,88 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "hash/mapped.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static u64 MAPPED_bytes(const u32 capacity, const u32 entry_size) {
+    return MAPPED_HEADER_SIZE + (u64)capacity * entry_size;
+}
+
+u8 MAPPED_save(const char* path, const MAPPED_HEADER* header, const void* entries) {
+    if (path == NULL || header == NULL || entries == NULL) return 0;
+
+    const size_t length = strlen(path);
+    char* temporary = (char*)malloc(length + 5);
+    if (temporary == NULL) return 0;
+    memcpy(temporary, path, length);
+    memcpy(temporary + length, ".tmp", 5);
+
+    FILE* file = fopen(temporary, "wb");
+    if (file == NULL) {
+        free(temporary);
+        return 0;
+    }
+
+    MAPPED_HEADER image = *header;
+    image.magic = MAPPED_MAGIC;
+    image.version = MAPPED_VERSION;
+    memset(image.reserved, 0, sizeof(image.reserved));
+
+    const size_t bytes = (size_t)header->capacity * header->entry_size;
+    u8 r = fwrite(&image, sizeof(image), 1, file) == 1;
+    r = r && fwrite(entries, 1, bytes, file) == bytes;
+    r = r && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    r = fclose(file) == 0 && r;
+    r = r && rename(temporary, path) == 0;
+
+    if (r == 0) remove(temporary);
+    free(temporary);
+    return r;
+}
+
+void* MAPPED_open(const char* path, MAPPED_HEADER* header) {
+    if (path == NULL || header == NULL) return NULL;
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    MAPPED_HEADER image;
+    u8 r = fstat(fd, &st) == 0 && (u64)st.st_size >= MAPPED_HEADER_SIZE;
+    r = r && pread(fd, &image, sizeof(image), 0) == (ssize_t)sizeof(image);
+
+    r = r && image.magic == MAPPED_MAGIC && image.version == MAPPED_VERSION && image.kind == header->kind;
+    r = r && image.entry_size == header->entry_size && image.key_size == header->key_size;
+    r = r && image.value_size == header->value_size && image.fingerprint == header->fingerprint;
+    r = r && image.capacity != 0 && (u64)image.size + image.tombstones <= image.capacity;
+    r = r && (u64)st.st_size >= MAPPED_bytes(image.capacity, image.entry_size);
+    if (r == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // The mapping keeps the file alive, the descriptor is not needed past this point
+    const size_t bytes = (size_t)MAPPED_bytes(image.capacity, image.entry_size);
+    void* mapping = mmap(NULL, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    *header = image;
+    return (u8*)mapping + MAPPED_HEADER_SIZE;
+}
+
+void MAPPED_close(void* entries, const u32 capacity, const u32 entry_size) {
+    if (entries == NULL) return;
+    munmap((u8*)entries - MAPPED_HEADER_SIZE, (size_t)MAPPED_bytes(capacity, entry_size));
+}
+
+void MAPPED_probe_key(void* key, const u32 size, const u32 probe) {
+    u8* bytes = (u8*)key;
+    for (u32 i = 0; i < size; i++) bytes[i] = (u8)(probe * 0x9D + i * 0x3B + 0x5A);
+}
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/ordered_hashset.h"
+
+HASHSET_DECLARE_ORDERED(u32)
+
+u8 HASHSET_u32_init(HASHSET_u32* hashset, const u32 capacity) {
+    return HASHSET_u32_init_allocator(hashset, capacity, NULL);
+}
+
+u8 HASHSET_u32_init_allocator(HASHSET_u32* hashset, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashset == NULL) return 0;
+
+    hashset->allocator = allocator;
+    hashset->size = 0;
+    hashset->used = 0;
+    hashset->capacity = ORDERED_capacity(capacity);
+    hashset->width = ORDERED_index_width(hashset->capacity);
+
+    hashset->index = NESQUIK_calloc(allocator, hashset->capacity, hashset->width);
+    hashset->entries = (HASHSET_ENTRY_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_ENTRY_u32) *
+        ORDERED_MAX_LOAD(hashset->capacity));
+
+    if (hashset->index == NULL || hashset->entries == NULL) {
+        HASHSET_u32_deinit(hashset);
+        return 0;
+    }
+
+    return 1;
+}
+
+HASHSET_u32* HASHSET_u32_create(const u32 capacity) {
+    return HASHSET_u32_create_allocator(capacity, NULL);
+}
+
+HASHSET_u32* HASHSET_u32_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    HASHSET_u32* hashset = (HASHSET_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_u32));
+    if (hashset == NULL) return NULL;
+
+    const u8 r = HASHSET_u32_init_allocator(hashset, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashset);
+        return NULL;
+    }
+
+    return hashset;
+}
+
+void HASHSET_u32_deinit(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+    hashset->size = 0;
+    hashset->used = 0;
+    hashset->capacity = 0;
+
+    NESQUIK_free(hashset->allocator, hashset->index);
+    NESQUIK_free(hashset->allocator, hashset->entries);
+
+    hashset->index = NULL;
+    hashset->entries = NULL;
+}
+
+void HASHSET_u32_destroy(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
+    HASHSET_u32_deinit(hashset);
+    NESQUIK_free(allocator, hashset);
+}
+
+static u32 HASHSET_u32_bucket(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+
+    for (;;) {
+        const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i);
+        if (slot == ORDERED_INDEX_EMPTY) return hashset->capacity;
+
+        if (slot != ORDERED_INDEX_DELETED) {
+            const HASHSET_ENTRY_u32* entry = hashset->entries + slot - ORDERED_INDEX_OFFSET;
+            if (entry->hash == hash && HASHSET_u32_key_equal(entry->key, key) == 1) return i;
+        }
+
+        i = (i + 1) & mask;
+    }
+}
+
+u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
+    if (hashset == NULL) return 0;
+
+    u32 new_capacity = hashset->capacity;
+    if (hashset->size + 1 > ORDERED_MAX_LOAD(hashset->capacity) / 2) {
+        if (hashset->capacity & 0x80000000) return 0;
+        new_capacity = hashset->capacity << 1;
+    }
+
+    HASHSET_u32 new_hashset;
+    const u8 r = HASHSET_u32_init_allocator(&new_hashset, new_capacity, hashset->allocator);
+    if (r == 0) return 0;
+
+    const u32 mask = new_hashset.capacity - 1;
+    for (u32 i = 0; i < hashset->used; i++) {
+        const HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+
+        u32 j = entry->hash & mask;
+        while (ORDERED_index_get(new_hashset.index, new_hashset.width, j) != ORDERED_INDEX_EMPTY)
+            j = (j + 1) & mask;
+
+        const u32 slot = new_hashset.used++;
+        ORDERED_index_set(new_hashset.index, new_hashset.width, j, slot + ORDERED_INDEX_OFFSET);
+        new_hashset.entries[slot] = *entry;
+    }
+
+    new_hashset.size = hashset->size;
+
+    HASHSET_u32_deinit(hashset);
+    *hashset = new_hashset;
+
+    return 1;
+}
+
+u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity == 0) return 0;
+
+    if (hashset->used + 1 > ORDERED_MAX_LOAD(hashset->capacity)) {
+        const u8 r = HASHSET_u32_grow(hashset);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+    u32 found = hashset->capacity;
+
+    for (;;) {
+        const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i);
+        if (slot == ORDERED_INDEX_EMPTY) {
+            if (found == hashset->capacity) found = i;
+            break;
+        }
+
+        if (slot == ORDERED_INDEX_DELETED) {
+            if (found == hashset->capacity) found = i;
+        }
+        else {
+            const HASHSET_ENTRY_u32* entry = hashset->entries + slot - ORDERED_INDEX_OFFSET;
+            if (entry->hash == hash && HASHSET_u32_key_equal(entry->key, key) == 1) return 0;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    HASHSET_ENTRY_u32* entry = hashset->entries + hashset->used;
+    entry->status = HASHSET_ENTRY_STATUS_FILLED;
+    entry->hash = hash;
+    entry->key = key;
+
+    ORDERED_index_set(hashset->index, hashset->width, found, hashset->used + ORDERED_INDEX_OFFSET);
+    hashset->used++;
+    hashset->size++;
+    return 1;
+}
+
+u8 HASHSET_u32_add(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_quick_add(hashset, hash, key);
+}
+
+void HASHSET_u32_remove(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return;
+    if (hashset->capacity == 0) return;
+
+    const u32 i = HASHSET_u32_bucket(hashset, HASHSET_u32_key_hash(key), key);
+    if (i == hashset->capacity) return;
+
+    const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i) - ORDERED_INDEX_OFFSET;
+    ORDERED_index_set(hashset->index, hashset->width, i, ORDERED_INDEX_DELETED);
+    hashset->entries[slot].status = HASHSET_ENTRY_STATUS_TOMBSTONE;
+    hashset->size--;
+}
+
+u8 HASHSET_u32_contains(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find(hashset, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return NULL;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_find_hashed(hashset, hash, key);
+}
+
+u8 HASHSET_u32_contains_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find_hashed(hashset, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return NULL;
+    if (hashset->capacity == 0) return NULL;
+
+    const u32 i = HASHSET_u32_bucket(hashset, hash, key);
+    if (i == hashset->capacity) return NULL;
+
+    const u32 slot = ORDERED_index_get(hashset->index, hashset->width, i) - ORDERED_INDEX_OFFSET;
+    return hashset->entries + slot;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_next(const HASHSET_u32* hashset, u32* position) {
+    if (hashset == NULL || position == NULL) return NULL;
+
+    while (*position < hashset->used) {
+        HASHSET_ENTRY_u32* entry = hashset->entries + (*position)++;
+        if (entry->status == HASHSET_ENTRY_STATUS_FILLED) return entry;
+    }
+
+    return NULL;
+}
+
+HASHSET_u32* HASHSET_u32_union(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const u32 capacity = (u32)((a->size + (u64)b->size) * 3 / 2) + 1;
+    HASHSET_u32* c = HASHSET_u32_create_allocator(capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    const HASHSET_ENTRY_u32* entry;
+    u32 position = 0;
+    while ((entry = HASHSET_u32_next(a, &position)) != NULL)
+        HASHSET_u32_quick_add(c, entry->hash, entry->key);
+
+    position = 0;
+    while ((entry = HASHSET_u32_next(b, &position)) != NULL)
+        HASHSET_u32_quick_add(c, entry->hash, entry->key);
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_intersection(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(0, a->allocator);
+    if (c == NULL) return NULL;
+
+    const HASHSET_ENTRY_u32* entry;
+    u32 position = 0;
+    while ((entry = HASHSET_u32_next(a, &position)) != NULL) {
+        if (HASHSET_u32_contains_hashed(b, entry->hash, entry->key) == 1)
+            HASHSET_u32_quick_add(c, entry->hash, entry->key);
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_difference(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(0, a->allocator);
+    if (c == NULL) return NULL;
+
+    const HASHSET_ENTRY_u32* entry;
+    u32 position = 0;
+    while ((entry = HASHSET_u32_next(a, &position)) != NULL) {
+        if (HASHSET_u32_contains_hashed(b, entry->hash, entry->key) == 0)
+            HASHSET_u32_quick_add(c, entry->hash, entry->key);
+    }
+
+    return c;
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/ordered_hashtable.h"
+
+HASHTABLE_DECLARE_ORDERED(u64, u64)
+
+u8 HASHTABLE_u64_u64_init(HASHTABLE_u64_u64* hashtable, const u32 capacity) {
+    return HASHTABLE_u64_u64_init_allocator(hashtable, capacity, NULL);
+}
+
+u8 HASHTABLE_u64_u64_init_allocator(HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    hashtable->allocator = allocator;
+    hashtable->size = 0;
+    hashtable->used = 0;
+    hashtable->capacity = ORDERED_capacity(capacity);
+    hashtable->width = ORDERED_index_width(hashtable->capacity);
+
+    hashtable->index = NESQUIK_calloc(allocator, hashtable->capacity, hashtable->width);
+    hashtable->entries = (HASHTABLE_ENTRY_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_ENTRY_u64_u64) *
+        ORDERED_MAX_LOAD(hashtable->capacity));
+
+    if (hashtable->index == NULL || hashtable->entries == NULL) {
+        HASHTABLE_u64_u64_deinit(hashtable);
+        return 0;
+    }
+
+    return 1;
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create(const u32 capacity) {
+    return HASHTABLE_u64_u64_create_allocator(capacity, NULL);
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    HASHTABLE_u64_u64* hashtable = (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = HASHTABLE_u64_u64_init_allocator(hashtable, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void HASHTABLE_u64_u64_deinit(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+    hashtable->size = 0;
+    hashtable->used = 0;
+    hashtable->capacity = 0;
+
+    NESQUIK_free(hashtable->allocator, hashtable->index);
+    NESQUIK_free(hashtable->allocator, hashtable->entries);
+
+    hashtable->index = NULL;
+    hashtable->entries = NULL;
+}
+
+void HASHTABLE_u64_u64_destroy(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+static u32 HASHTABLE_u64_u64_bucket(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+
+    for (;;) {
+        const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i);
+        if (slot == ORDERED_INDEX_EMPTY) return hashtable->capacity;
+
+        if (slot != ORDERED_INDEX_DELETED) {
+            const HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + slot - ORDERED_INDEX_OFFSET;
+            if (entry->hash == hash && HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) return i;
+        }
+
+        i = (i + 1) & mask;
+    }
+}
+
+u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    u32 new_capacity = hashtable->capacity;
+    if (hashtable->size + 1 > ORDERED_MAX_LOAD(hashtable->capacity) / 2) {
+        if (hashtable->capacity & 0x80000000) return 0;
+        new_capacity = hashtable->capacity << 1;
+    }
+
+    HASHTABLE_u64_u64 new_hashtable;
+    const u8 r = HASHTABLE_u64_u64_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);
+    if (r == 0) return 0;
+
+    const u32 mask = new_hashtable.capacity - 1;
+    for (u32 i = 0; i < hashtable->used; i++) {
+        const HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->status != HASHTABLE_ENTRY_STATUS_FILLED) continue;
+
+        u32 j = entry->hash & mask;
+        while (ORDERED_index_get(new_hashtable.index, new_hashtable.width, j) != ORDERED_INDEX_EMPTY)
+            j = (j + 1) & mask;
+
+        const u32 slot = new_hashtable.used++;
+        ORDERED_index_set(new_hashtable.index, new_hashtable.width, j, slot + ORDERED_INDEX_OFFSET);
+        new_hashtable.entries[slot] = *entry;
+    }
+
+    new_hashtable.size = hashtable->size;
+
+    HASHTABLE_u64_u64_deinit(hashtable);
+    *hashtable = new_hashtable;
+
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity == 0) return 0;
+
+    if (hashtable->used + 1 > ORDERED_MAX_LOAD(hashtable->capacity)) {
+        const u8 r = HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+    u32 found = hashtable->capacity;
+
+    for (;;) {
+        const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i);
+        if (slot == ORDERED_INDEX_EMPTY) {
+            if (found == hashtable->capacity) found = i;
+            break;
+        }
+
+        if (slot == ORDERED_INDEX_DELETED) {
+            if (found == hashtable->capacity) found = i;
+        }
+        else {
+            const HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + slot - ORDERED_INDEX_OFFSET;
+            if (entry->hash == hash && HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) return 0;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + hashtable->used;
+    entry->status = HASHTABLE_ENTRY_STATUS_FILLED;
+    entry->hash = hash;
+    entry->key = key;
+    entry->value = value;
+
+    ORDERED_index_set(hashtable->index, hashtable->width, found, hashtable->used + ORDERED_INDEX_OFFSET);
+    hashtable->used++;
+    hashtable->size++;
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_add(HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
+}
+
+void HASHTABLE_u64_u64_remove(HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return;
+    if (hashtable->capacity == 0) return;
+
+    const u32 i = HASHTABLE_u64_u64_bucket(hashtable, HASHTABLE_u64_u64_key_hash(key), key);
+    if (i == hashtable->capacity) return;
+
+    const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i) - ORDERED_INDEX_OFFSET;
+    ORDERED_index_set(hashtable->index, hashtable->width, i, ORDERED_INDEX_DELETED);
+    hashtable->entries[slot].status = HASHTABLE_ENTRY_STATUS_TOMBSTONE;
+    hashtable->size--;
+}
+
+u8 HASHTABLE_u64_u64_contains(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 HASHTABLE_u64_u64_contains_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash,
+    const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+    if (hashtable->capacity == 0) return NULL;
+
+    const u32 i = HASHTABLE_u64_u64_bucket(hashtable, hash, key);
+    if (i == hashtable->capacity) return NULL;
+
+    const u32 slot = ORDERED_index_get(hashtable->index, hashtable->width, i) - ORDERED_INDEX_OFFSET;
+    return hashtable->entries + slot;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_next(const HASHTABLE_u64_u64* hashtable, u32* position) {
+    if (hashtable == NULL || position == NULL) return NULL;
+
+    while (*position < hashtable->used) {
+        HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + (*position)++;
+        if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED) return entry;
+    }
+
+    return NULL;
+}
\ No newline at end of file
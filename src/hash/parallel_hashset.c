@@ -0,0 +1,178 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/parallel_hashset.h"
+
+HASHSET_DECLARE(u32)
+HASHSET_DECLARE_PARALLEL(u32)
+
+static u8 HASHSET_u32_bucket_push(HASHSET_BUCKET_u32* bucket, const HASHSET_ENTRY_u32* entry) {
+    if (bucket->size == bucket->capacity) {
+        u32 capacity = bucket->capacity * 2;
+        capacity = capacity < HASHSET_PARALLEL_BUCKET_MIN_CAPACITY ?
+            HASHSET_PARALLEL_BUCKET_MIN_CAPACITY : capacity;
+
+        HASHSET_ENTRY_u32* entries = (HASHSET_ENTRY_u32*)realloc(bucket->entries,
+            sizeof(HASHSET_ENTRY_u32) * capacity);
+        if (entries == NULL) return 0;
+
+        bucket->entries = entries;
+        bucket->capacity = capacity;
+    }
+
+    bucket->entries[bucket->size++] = *entry;
+    return 1;
+}
+
+static void HASHSET_u32_scatter(void* context, const u32 worker, const u32 workers) {
+    HASHSET_PARALLEL_u32* job = (HASHSET_PARALLEL_u32*)context;
+    HASHSET_BUCKET_u32* buckets = job->buckets + (u64)worker * job->partitions;
+    const u32 capacity = job->result->capacity;
+
+    for (u32 s = 0; s < 2; s++) {
+        const HASHSET_u32* source = job->sources[s];
+        if (source == NULL) continue;
+
+        const u32 begin = THREAD_POOL_split(source->capacity, worker, workers);
+        const u32 end = THREAD_POOL_split(source->capacity, worker + 1, workers);
+        for (u32 i = begin; i < end; i++) {
+            const HASHSET_ENTRY_u32* entry = source->entries + i;
+            if (entry->status != HASHSET_ENTRY_STATUS_FILLED) continue;
+            if (job->filters[s] != NULL &&
+                HASHSET_u32_contains_hashed(job->filters[s], entry->hash, entry->key) != job->keep[s])
+                continue;
+
+            const u32 partition = HASHSET_partition_of(entry->hash % capacity, capacity, job->partitions);
+            if (HASHSET_u32_bucket_push(buckets + partition, entry) == 0) {
+                job->failed[worker] = 1;
+                return;
+            }
+        }
+    }
+}
+
+static void HASHSET_u32_gather(void* context, const u32 worker, const u32 workers) {
+    HASHSET_PARALLEL_u32* job = (HASHSET_PARALLEL_u32*)context;
+    HASHSET_ENTRY_u32* entries = job->result->entries;
+    const u32 capacity = job->result->capacity;
+    const u32 end = THREAD_POOL_split(capacity, worker + 1, job->partitions);
+
+    u32 placed = 0;
+    for (u32 w = 0; w < workers; w++) {
+        const HASHSET_BUCKET_u32* bucket = job->buckets + (u64)w * job->partitions + worker;
+
+        for (u32 e = 0; e < bucket->size; e++) {
+            const HASHSET_ENTRY_u32* entry = bucket->entries + e;
+
+            u32 i = entry->hash % capacity;
+            while (i < end && entries[i].status == HASHSET_ENTRY_STATUS_FILLED) i++;
+
+            if (i == end) {
+                if (HASHSET_u32_bucket_push(job->overflow + worker, entry) == 1) continue;
+                job->failed[worker] = 1;
+                break;
+            }
+
+            entries[i] = *entry;
+            placed++;
+        }
+    }
+
+    job->placed[worker] = placed;
+}
+
+static HASHSET_u32* HASHSET_u32_run_parallel(HASHSET_PARALLEL_u32* job, const u32 size,
+    const NESQUIK_ALLOCATOR* allocator, THREAD_POOL* pool) {
+
+    const u32 workers = THREAD_POOL_workers(pool);
+    job->partitions = workers;
+
+    job->result = HASHSET_u32_create_allocator(HASHSET_capacity_for(size), allocator);
+    if (job->result == NULL) return NULL;
+
+    const u64 bucket_count = (u64)workers * workers;
+    job->buckets = (HASHSET_BUCKET_u32*)calloc(bucket_count, sizeof(HASHSET_BUCKET_u32));
+    job->overflow = (HASHSET_BUCKET_u32*)calloc(workers, sizeof(HASHSET_BUCKET_u32));
+    job->placed = (u32*)calloc(workers, sizeof(u32));
+    job->failed = (u8*)calloc(workers, sizeof(u8));
+
+    u8 failed = job->buckets == NULL || job->overflow == NULL || job->placed == NULL || job->failed == NULL;
+    if (failed == 0) THREAD_POOL_run(pool, HASHSET_u32_scatter, job);
+    for (u32 w = 0; w < workers && failed == 0; w++) failed = job->failed[w];
+
+    if (failed == 0) THREAD_POOL_run(pool, HASHSET_u32_gather, job);
+    for (u32 w = 0; w < workers && failed == 0; w++) failed = job->failed[w];
+
+    if (failed == 0) {
+        for (u32 w = 0; w < workers; w++) job->result->size += job->placed[w];
+
+        for (u32 w = 0; w < workers && failed == 0; w++) {
+            const HASHSET_BUCKET_u32* overflow = job->overflow + w;
+            for (u32 e = 0; e < overflow->size; e++) {
+                const HASHSET_ENTRY_u32* entry = overflow->entries + e;
+                if (HASHSET_u32_quick_add(job->result, entry->hash, entry->key) == 0) failed = 1;
+            }
+        }
+    }
+
+    for (u64 i = 0; job->buckets != NULL && i < bucket_count; i++) free(job->buckets[i].entries);
+    for (u32 w = 0; job->overflow != NULL && w < workers; w++) free(job->overflow[w].entries);
+    free(job->buckets);
+    free(job->overflow);
+    free(job->placed);
+    free(job->failed);
+
+    if (failed == 1) {
+        HASHSET_u32_destroy(job->result);
+        return NULL;
+    }
+
+    return job->result;
+}
+
+HASHSET_u32* HASHSET_u32_union_parallel(const HASHSET_u32* a, const HASHSET_u32* b, THREAD_POOL* pool) {
+    if (a == NULL || b == NULL) return NULL;
+    if (THREAD_POOL_workers(pool) == 1) return HASHSET_u32_union(a, b);
+
+    HASHSET_PARALLEL_u32 job = {
+        .sources = {a, a == b ? NULL : b},
+        .filters = {NULL, a},
+        .keep = {1, 0}
+    };
+
+    return HASHSET_u32_run_parallel(&job, a->size + b->size, a->allocator, pool);
+}
+
+HASHSET_u32* HASHSET_u32_intersection_parallel(const HASHSET_u32* a, const HASHSET_u32* b,
+    THREAD_POOL* pool) {
+
+    if (a == NULL || b == NULL) return NULL;
+    if (THREAD_POOL_workers(pool) == 1) return HASHSET_u32_intersection(a, b);
+
+    const HASHSET_u32* smaller = a->capacity < b->capacity ? a : b;
+    const HASHSET_u32* larger = a->capacity < b->capacity ? b : a;
+
+    HASHSET_PARALLEL_u32 job = {
+        .sources = {smaller, NULL},
+        .filters = {a == b ? NULL : larger, NULL},
+        .keep = {1, 1}
+    };
+
+    return HASHSET_u32_run_parallel(&job, a->size < b->size ? a->size : b->size, a->allocator, pool);
+}
+
+HASHSET_u32* HASHSET_u32_difference_parallel(const HASHSET_u32* a, const HASHSET_u32* b,
+    THREAD_POOL* pool) {
+
+    if (a == NULL || b == NULL) return NULL;
+    if (THREAD_POOL_workers(pool) == 1) return HASHSET_u32_difference(a, b);
+
+    HASHSET_PARALLEL_u32 job = {
+        .sources = {a == b ? NULL : a, NULL},
+        .filters = {b, NULL},
+        .keep = {0, 1}
+    };
+
+    return HASHSET_u32_run_parallel(&job, a->size, a->allocator, pool);
+}
\ No newline at end of file
@@ -7,9 +7,18 @@
 POINTER_HASHSET_DECLARE(u64)
 
 u8 POINTER_HASHSET_u64_init(POINTER_HASHSET_u64* hashset,
-                  const u32 capacity,
-                  u32 (*key_size)(const u64*),
-                  u8 (*key_equal)(const u64*, const u64*)) {
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*)) {
+
+    return POINTER_HASHSET_u64_init_allocator(hashset, capacity, key_size, key_equal, NULL);
+}
+
+u8 POINTER_HASHSET_u64_init_allocator(POINTER_HASHSET_u64* hashset,
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
 
     if (hashset == NULL) return 0;
 
@@ -19,28 +28,38 @@ u8 POINTER_HASHSET_u64_init(POINTER_HASHSET_u64* hashset,
 
     hashset->key_size = key_size;
     hashset->key_equal = key_equal;
+    hashset->allocator = allocator;
 
-    hashset->entries = (POINTER_HASHSET_ENTRY_u64*)malloc(sizeof(POINTER_HASHSET_ENTRY_u64) * capacity);
+    hashset->entries = (POINTER_HASHSET_ENTRY_u64*)NESQUIK_alloc(allocator,
+        sizeof(POINTER_HASHSET_ENTRY_u64) * hashset->capacity);
     if (hashset->entries == NULL) {
         hashset->capacity = 0;
         return 0;
     }
 
-    memset(hashset->entries, 0, sizeof(POINTER_HASHSET_ENTRY_u64) * capacity);
+    memset(hashset->entries, 0, sizeof(POINTER_HASHSET_ENTRY_u64) * hashset->capacity);
 
     return 1;
 }
 
-POINTER_HASHSET_u64* POINTER_HASHSET_create(const u32 capacity,
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_create(const u32 capacity,
     u32 (*key_size)(const u64*),
     u8 (*key_equal)(const u64*, const u64*)) {
 
-    POINTER_HASHSET_u64* hashset = (POINTER_HASHSET_u64*)malloc(sizeof(POINTER_HASHSET_u64));
+    return POINTER_HASHSET_u64_create_allocator(capacity, key_size, key_equal, NULL);
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_create_allocator(const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    POINTER_HASHSET_u64* hashset = (POINTER_HASHSET_u64*)NESQUIK_alloc(allocator, sizeof(POINTER_HASHSET_u64));
     if (hashset == NULL) return NULL;
 
-    const u8 r = POINTER_HASHSET_u64_init(hashset, capacity, key_size, key_equal);
+    const u8 r = POINTER_HASHSET_u64_init_allocator(hashset, capacity, key_size, key_equal, allocator);
     if (r == 0) {
-        free(hashset);
+        NESQUIK_free(allocator, hashset);
         return NULL;
     }
 
@@ -57,7 +76,7 @@ void POINTER_HASHSET_u64_deinit(POINTER_HASHSET_u64* hashset) {
     hashset->key_equal = NULL;
 
     if (hashset->entries != NULL) {
-        free(hashset->entries);
+        NESQUIK_free(hashset->allocator, hashset->entries);
         hashset->entries = NULL;
     }
 }
@@ -65,8 +84,9 @@ void POINTER_HASHSET_u64_deinit(POINTER_HASHSET_u64* hashset) {
 void POINTER_HASHSET_u64_destroy(POINTER_HASHSET_u64* hashset) {
     if (hashset == NULL) return;
 
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
     POINTER_HASHSET_u64_deinit(hashset);
-    free(hashset);
+    NESQUIK_free(allocator, hashset);
 }
 
 u8 POINTER_HASHSET_u64_grow(POINTER_HASHSET_u64* hashset) {
@@ -75,8 +95,15 @@ u8 POINTER_HASHSET_u64_grow(POINTER_HASHSET_u64* hashset) {
     u32 new_capacity = (u32)(hashset->capacity * POINTER_HASHSET_MAX_LOAD_FACTOR / POINTER_HASHSET_MIN_LOAD_FACTOR);
     new_capacity = (new_capacity > hashset->capacity) ? new_capacity : hashset->capacity;
 
+    return POINTER_HASHSET_u64_resize(hashset, new_capacity);
+}
+
+u8 POINTER_HASHSET_u64_resize(POINTER_HASHSET_u64* hashset, const u32 new_capacity) {
+    if (hashset == NULL) return 0;
+
     POINTER_HASHSET_u64 new_hashset;
-    u8 r = POINTER_HASHSET_u64_init(&new_hashset, new_capacity, hashset->key_size, hashset->key_equal);
+    u8 r = POINTER_HASHSET_u64_init_allocator(&new_hashset, new_capacity, hashset->key_size,
+        hashset->key_equal, hashset->allocator);
     if (r == 0) return 0;
 
     for (u32 i = 0; i < hashset->capacity; i++) {
@@ -91,19 +118,73 @@ u8 POINTER_HASHSET_u64_grow(POINTER_HASHSET_u64* hashset) {
         }
     }
 
-    free(hashset->entries);
+    NESQUIK_free(hashset->allocator, hashset->entries);
     hashset->entries = new_hashset.entries;
-    hashset->capacity = new_capacity;
+    hashset->capacity = new_hashset.capacity;
     hashset->tombstones = 0;
 
     return 1;
 }
 
+u8 POINTER_HASHSET_u64_rehash(POINTER_HASHSET_u64* hashset) {
+    if (hashset == NULL) return 0;
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        POINTER_HASHSET_ENTRY_u64* entry = hashset->entries + i;
+        if (entry->status == POINTER_HASHSET_ENTRY_STATUS_FILLED) entry->status = POINTER_HASHSET_ENTRY_STATUS_DISPLACED;
+        else memset(entry, 0, sizeof(POINTER_HASHSET_ENTRY_u64));
+    }
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        if (hashset->entries[i].status != POINTER_HASHSET_ENTRY_STATUS_DISPLACED) continue;
+
+        POINTER_HASHSET_ENTRY_u64 moving = hashset->entries[i];
+        memset(hashset->entries + i, 0, sizeof(POINTER_HASHSET_ENTRY_u64));
+
+        for (;;) {
+            u32 j = moving.hash % hashset->capacity;
+            while (hashset->entries[j].status == POINTER_HASHSET_ENTRY_STATUS_FILLED)
+                j = (j + 1) % hashset->capacity;
+
+            const POINTER_HASHSET_ENTRY_u64 displaced = hashset->entries[j];
+            hashset->entries[j] = moving;
+            hashset->entries[j].status = POINTER_HASHSET_ENTRY_STATUS_FILLED;
+
+            if (displaced.status == POINTER_HASHSET_ENTRY_STATUS_EMPTY) break;
+            moving = displaced;
+        }
+    }
+
+    hashset->tombstones = 0;
+    return 1;
+}
+
+u8 POINTER_HASHSET_u64_reserve(POINTER_HASHSET_u64* hashset, const u32 n) {
+    if (hashset == NULL) return 0;
+
+    const u32 capacity = (u32)(n / POINTER_HASHSET_MAX_LOAD_FACTOR) + 1;
+    if (capacity <= hashset->capacity) return 1;
+
+    return POINTER_HASHSET_u64_resize(hashset, capacity);
+}
+
+u8 POINTER_HASHSET_u64_shrink_to_fit(POINTER_HASHSET_u64* hashset) {
+    if (hashset == NULL) return 0;
+
+    u32 capacity = (u32)(hashset->size / POINTER_HASHSET_MAX_LOAD_FACTOR) + 1;
+    capacity = capacity < POINTER_HASHSET_MIN_CAPACITY ? POINTER_HASHSET_MIN_CAPACITY : capacity;
+
+    if (capacity < hashset->capacity) return POINTER_HASHSET_u64_resize(hashset, capacity);
+    if (hashset->tombstones == 0) return 1;
+    return POINTER_HASHSET_u64_rehash(hashset);
+}
+
 u8 POINTER_HASHSET_u64_quick_add(POINTER_HASHSET_u64* hashset, const u32 hash, u64* key) {
     if (hashset == NULL) return 0;
 
-    if ((hashset->size + 0.0) / hashset->capacity >= POINTER_HASHSET_MAX_LOAD_FACTOR) {
-        const u8 r = POINTER_HASHSET_u64_grow(hashset);
+    if ((hashset->size + hashset->tombstones + 0.0) / hashset->capacity >= POINTER_HASHSET_MAX_LOAD_FACTOR) {
+        const u8 purge = (hashset->size + 0.0) / hashset->capacity < POINTER_HASHSET_MIN_LOAD_FACTOR;
+        const u8 r = purge == 1 ? POINTER_HASHSET_u64_rehash(hashset) : POINTER_HASHSET_u64_grow(hashset);
         if (r == 0) return 0;
     }
 
@@ -114,17 +195,21 @@ u8 POINTER_HASHSET_u64_quick_add(POINTER_HASHSET_u64* hashset, const u32 hash, u
         POINTER_HASHSET_ENTRY_u64* entry = hashset->entries + i;
         const u8 status = entry->status;
 
-        if (status == POINTER_HASHSET_ENTRY_STATUS_EMPTY || status == POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE) {
-            found_entry = entry;
+        if (status == POINTER_HASHSET_ENTRY_STATUS_EMPTY) {
+            if (found_entry == NULL) found_entry = entry;
             break;
         }
 
-        const u8 equal = hashset->key_equal(entry->key, key);
-        if (equal == 1) break;
+        if (status == POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE) {
+            if (found_entry == NULL) found_entry = entry;
+        }
+        else if (entry->hash == hash && POINTER_HASHSET_u64_key_equal(hashset, entry->key, key) == 1) return 0;
+
         i = (i + 1) % hashset->capacity;
     } while (i != hash % hashset->capacity);
 
     if (found_entry == NULL) return 0;
+    if (found_entry->status == POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE) hashset->tombstones--;
 
     found_entry->status = POINTER_HASHSET_ENTRY_STATUS_FILLED;
     found_entry->hash = hash;
@@ -137,8 +222,7 @@ u8 POINTER_HASHSET_u64_quick_add(POINTER_HASHSET_u64* hashset, const u32 hash, u
 u8 POINTER_HASHSET_u64_add(POINTER_HASHSET_u64* hashset, u64* key) {
     if (hashset == NULL) return 0;
 
-    const u32 key_size = hashset->key_size(key);
-    const u32 hash = HASH_fnv1a((u8*)key, key_size);
+    const u32 hash = POINTER_HASHSET_u64_key_hash(hashset, key);
 
     return POINTER_HASHSET_u64_quick_add(hashset, hash, key);
 }
@@ -155,10 +239,6 @@ void POINTER_HASHSET_u64_remove(POINTER_HASHSET_u64* hashset, const u64* key) {
     hashset->tombstones++;
 }
 
-u32 POINTER_HASHSET_u64_hash(const u8* data, const u32 size) {
-    return HASH_fnv1a(data, size);
-}
-
 u8 POINTER_HASHSET_u64_contains(const POINTER_HASHSET_u64* hashset, const u64* key) {
     if (hashset == NULL) return 0;
 
@@ -170,9 +250,23 @@ u8 POINTER_HASHSET_u64_contains(const POINTER_HASHSET_u64* hashset, const u64* k
 POINTER_HASHSET_ENTRY_u64* POINTER_HASHSET_u64_find(const POINTER_HASHSET_u64* hashset, const u64* key) {
     if (hashset == NULL) return NULL;
 
-    // Determine the key_size
-    const u32 key_size = hashset->key_size(key);
-    const u32 hash = HASH_fnv1a((u8*)key, key_size);
+    const u32 hash = POINTER_HASHSET_u64_key_hash(hashset, key);
+
+    return POINTER_HASHSET_u64_find_hashed(hashset, hash, key);
+}
+
+u8 POINTER_HASHSET_u64_contains_hashed(const POINTER_HASHSET_u64* hashset, const u32 hash, const u64* key) {
+    if (hashset == NULL) return 0;
+
+    const POINTER_HASHSET_ENTRY_u64* entry = POINTER_HASHSET_u64_find_hashed(hashset, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+POINTER_HASHSET_ENTRY_u64* POINTER_HASHSET_u64_find_hashed(const POINTER_HASHSET_u64* hashset,
+    const u32 hash, const u64* key) {
+
+    if (hashset == NULL) return NULL;
 
     u32 i = hash % hashset->capacity;
 
@@ -189,11 +283,259 @@ POINTER_HASHSET_ENTRY_u64* POINTER_HASHSET_u64_find(const POINTER_HASHSET_u64* h
             continue;
         }
 
-        const u8 equal = hashset->key_equal(entry->key, key);
+        const u8 equal = POINTER_HASHSET_u64_key_equal(hashset, entry->key, key);
         if (equal == 1) break;
         i = (i + 1) % hashset->capacity;
     } while (i != hash % hashset->capacity);
 
     if (status == POINTER_HASHSET_ENTRY_STATUS_FILLED) return entry;
+    return NULL;
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_union(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const u32 capacity = POINTER_HASHSET_capacity_for(a->size + (f64)b->size);
+    POINTER_HASHSET_u64* c = POINTER_HASHSET_u64_create_allocator(capacity, a->key_size, a->key_equal,
+        a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = a->entries[ai];
+        if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED)
+            POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+    }
+
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = b->entries[bi];
+        if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED)
+            POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+    }
+
+    return c;
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_intersection(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const POINTER_HASHSET_u64* smaller;
+    const POINTER_HASHSET_u64* larger;
+    if (a->capacity < b->capacity) {
+        smaller = a;
+        larger = b;
+    }
+    else {
+        smaller = b;
+        larger = a;
+    }
+
+    const u32 capacity = POINTER_HASHSET_capacity_for(a->size < b->size ? a->size : b->size);
+    POINTER_HASHSET_u64* c = POINTER_HASHSET_u64_create_allocator(capacity, a->key_size, a->key_equal,
+        a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = smaller->entries[i];
+        if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED) {
+            if (POINTER_HASHSET_u64_contains_hashed(larger, entry.hash, entry.key) == 1) {
+                POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+            }
+        }
+    }
+
+    return c;
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_difference(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const u32 capacity = POINTER_HASHSET_capacity_for(a->size);
+    POINTER_HASHSET_u64* c = POINTER_HASHSET_u64_create_allocator(capacity, a->key_size, a->key_equal,
+        a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = a->entries[ai];
+        if (entry.status == POINTER_HASHSET_ENTRY_STATUS_FILLED) {
+            if (POINTER_HASHSET_u64_contains_hashed(b, entry.hash, entry.key) == 0) {
+                POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+            }
+        }
+    }
+
+    return c;
+}
+
+static void POINTER_HASHSET_u64_erase(POINTER_HASHSET_u64* hashset, POINTER_HASHSET_ENTRY_u64* entry) {
+    memset(entry, 0, sizeof(POINTER_HASHSET_ENTRY_u64));
+    entry->status = POINTER_HASHSET_ENTRY_STATUS_TOMBSTONE;
+    hashset->size--;
+    hashset->tombstones++;
+}
+
+u32 POINTER_HASHSET_u64_union_into(POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL || a == b) return 0;
+
+    u32 added = 0;
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        const POINTER_HASHSET_ENTRY_u64* entry = b->entries + bi;
+        if (entry->status == POINTER_HASHSET_ENTRY_STATUS_FILLED)
+            added += POINTER_HASHSET_u64_quick_add(a, entry->hash, entry->key);
+    }
+
+    return added;
+}
+
+u32 POINTER_HASHSET_u64_intersect_inplace(POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL || a == b) return 0;
+
+    u32 removed = 0;
+    for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {
+        POINTER_HASHSET_ENTRY_u64* entry = a->entries + ai;
+        if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;
+        if (POINTER_HASHSET_u64_contains_hashed(b, entry->hash, entry->key) == 1) continue;
+
+        POINTER_HASHSET_u64_erase(a, entry);
+        removed++;
+    }
+
+    return removed;
+}
+
+u32 POINTER_HASHSET_u64_subtract_inplace(POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return 0;
+
+    u32 removed = 0;
+    if (a != b && b->capacity < a->capacity) {
+        for (u32 bi = 0; bi < b->capacity && a->size > 0; bi++) {
+            const POINTER_HASHSET_ENTRY_u64* entry = b->entries + bi;
+            if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;
+
+            POINTER_HASHSET_ENTRY_u64* found = POINTER_HASHSET_u64_find_hashed(a, entry->hash, entry->key);
+            if (found == NULL) continue;
+
+            POINTER_HASHSET_u64_erase(a, found);
+            removed++;
+        }
+
+        return removed;
+    }
+
+    for (u32 ai = 0; ai < a->capacity && a->size > 0; ai++) {
+        POINTER_HASHSET_ENTRY_u64* entry = a->entries + ai;
+        if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;
+        if (a != b && POINTER_HASHSET_u64_contains_hashed(b, entry->hash, entry->key) == 0) continue;
+
+        POINTER_HASHSET_u64_erase(a, entry);
+        removed++;
+    }
+
+    return removed;
+}
+
+u32 POINTER_HASHSET_u64_intersection_size(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return 0;
+    if (a == b) return a->size;
+
+    const POINTER_HASHSET_u64* smaller = a->capacity < b->capacity ? a : b;
+    const POINTER_HASHSET_u64* larger = a->capacity < b->capacity ? b : a;
+
+    u32 count = 0;
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        const POINTER_HASHSET_ENTRY_u64* entry = smaller->entries + i;
+        if (entry->status == POINTER_HASHSET_ENTRY_STATUS_FILLED)
+            count += POINTER_HASHSET_u64_contains_hashed(larger, entry->hash, entry->key);
+    }
+
+    return count;
+}
+
+u32 POINTER_HASHSET_u64_union_size(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return 0;
+
+    return a->size + b->size - POINTER_HASHSET_u64_intersection_size(a, b);
+}
+
+u32 POINTER_HASHSET_u64_difference_size(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return 0;
+
+    return a->size - POINTER_HASHSET_u64_intersection_size(a, b);
+}
+
+void POINTER_HASHSET_u64_iterate(POINTER_HASHSET_ITERATOR_u64* iterator, const POINTER_HASHSET_u64* hashset) {
+    if (iterator == NULL) return;
+
+    iterator->a = hashset;
+    iterator->b = NULL;
+    iterator->index = 0;
+    iterator->mode = POINTER_HASHSET_ITERATE_ALL;
+}
+
+void POINTER_HASHSET_u64_iterate_union(POINTER_HASHSET_ITERATOR_u64* iterator,
+    const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+
+    if (iterator == NULL) return;
+
+    iterator->a = a;
+    iterator->b = b;
+    iterator->index = 0;
+    iterator->mode = a == b ? POINTER_HASHSET_ITERATE_ALL : POINTER_HASHSET_ITERATE_UNION;
+    if (b == NULL) iterator->a = NULL;
+}
+
+void POINTER_HASHSET_u64_iterate_intersection(POINTER_HASHSET_ITERATOR_u64* iterator,
+    const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+
+    if (iterator == NULL) return;
+
+    iterator->a = a != NULL && b != NULL && b->capacity < a->capacity ? b : a;
+    iterator->b = iterator->a == a ? b : a;
+    iterator->index = 0;
+    iterator->mode = POINTER_HASHSET_ITERATE_INTERSECTION;
+    if (iterator->b == NULL) iterator->a = NULL;
+}
+
+void POINTER_HASHSET_u64_iterate_difference(POINTER_HASHSET_ITERATOR_u64* iterator,
+    const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+
+    if (iterator == NULL) return;
+
+    iterator->a = a == b ? NULL : a;
+    iterator->b = b;
+    iterator->index = 0;
+    iterator->mode = POINTER_HASHSET_ITERATE_DIFFERENCE;
+    if (b == NULL) iterator->a = NULL;
+}
+
+const POINTER_HASHSET_ENTRY_u64* POINTER_HASHSET_u64_next(POINTER_HASHSET_ITERATOR_u64* iterator) {
+    if (iterator == NULL || iterator->a == NULL) return NULL;
+
+    const POINTER_HASHSET_u64* a = iterator->a;
+    const POINTER_HASHSET_u64* b = iterator->b;
+
+    for (; iterator->index < a->capacity; iterator->index++) {
+        const POINTER_HASHSET_ENTRY_u64* entry = a->entries + iterator->index;
+        if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;
+
+        if (iterator->mode == POINTER_HASHSET_ITERATE_INTERSECTION &&
+            POINTER_HASHSET_u64_contains_hashed(b, entry->hash, entry->key) == 0) continue;
+        if (iterator->mode == POINTER_HASHSET_ITERATE_DIFFERENCE &&
+            POINTER_HASHSET_u64_contains_hashed(b, entry->hash, entry->key) == 1) continue;
+
+        iterator->index++;
+        return entry;
+    }
+
+    if (iterator->mode != POINTER_HASHSET_ITERATE_UNION) return NULL;
+
+    for (; iterator->index - a->capacity < b->capacity; iterator->index++) {
+        const POINTER_HASHSET_ENTRY_u64* entry = b->entries + (iterator->index - a->capacity);
+        if (entry->status != POINTER_HASHSET_ENTRY_STATUS_FILLED) continue;
+        if (POINTER_HASHSET_u64_contains_hashed(a, entry->hash, entry->key) == 1) continue;
+
+        iterator->index++;
+        return entry;
+    }
+
     return NULL;
 }
\ No newline at end of file
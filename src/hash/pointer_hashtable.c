@@ -7,9 +7,18 @@
 POINTER_HASHTABLE_DECLARE(u64, u64)
 
 u8 POINTER_HASHTABLE_u64_u64_init(POINTER_HASHTABLE_u64_u64* hashtable,
-                  const u32 capacity,
-                  u32 (*key_size)(const u64*),
-                  u8 (*key_equal)(const u64*, const u64*)) {
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*)) {
+
+    return POINTER_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, key_size, key_equal, NULL);
+}
+
+u8 POINTER_HASHTABLE_u64_u64_init_allocator(POINTER_HASHTABLE_u64_u64* hashtable,
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
 
     if (hashtable == NULL) return 0;
 
@@ -19,14 +28,16 @@ u8 POINTER_HASHTABLE_u64_u64_init(POINTER_HASHTABLE_u64_u64* hashtable,
 
     hashtable->key_size = key_size;
     hashtable->key_equal = key_equal;
+    hashtable->allocator = allocator;
 
-    hashtable->entries = (POINTER_HASHTABLE_ENTRY_u64_u64*)malloc(sizeof(POINTER_HASHTABLE_ENTRY_u64_u64) * capacity);
+    hashtable->entries = (POINTER_HASHTABLE_ENTRY_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(POINTER_HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
     if (hashtable->entries == NULL) {
         hashtable->capacity = 0;
         return 0;
     }
 
-    memset(hashtable->entries, 0, sizeof(POINTER_HASHTABLE_ENTRY_u64_u64) * capacity);
+    memset(hashtable->entries, 0, sizeof(POINTER_HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
 
     return 1;
 }
@@ -35,12 +46,22 @@ POINTER_HASHTABLE_u64_u64* POINTER_HASHTABLE_u64_u64_create(const u32 capacity,
     u32 (*key_size)(const u64*),
     u8 (*key_equal)(const u64*, const u64*)) {
 
-    POINTER_HASHTABLE_u64_u64* hashtable = (POINTER_HASHTABLE_u64_u64*)malloc(sizeof(POINTER_HASHTABLE_u64_u64));
+    return POINTER_HASHTABLE_u64_u64_create_allocator(capacity, key_size, key_equal, NULL);
+}
+
+POINTER_HASHTABLE_u64_u64* POINTER_HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    POINTER_HASHTABLE_u64_u64* hashtable = (POINTER_HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(POINTER_HASHTABLE_u64_u64));
     if (hashtable == NULL) return NULL;
 
-    const u8 r = POINTER_HASHTABLE_u64_u64_init(hashtable, capacity, key_size, key_equal);
+    const u8 r = POINTER_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, key_size, key_equal,
+        allocator);
     if (r == 0) {
-        free(hashtable);
+        NESQUIK_free(allocator, hashtable);
         return NULL;
     }
 
@@ -57,7 +78,7 @@ void POINTER_HASHTABLE_u64_u64_deinit(POINTER_HASHTABLE_u64_u64* hashtable) {
     hashtable->key_equal = NULL;
 
     if (hashtable->entries != NULL) {
-        free(hashtable->entries);
+        NESQUIK_free(hashtable->allocator, hashtable->entries);
         hashtable->entries = NULL;
     }
 }
@@ -65,8 +86,9 @@ void POINTER_HASHTABLE_u64_u64_deinit(POINTER_HASHTABLE_u64_u64* hashtable) {
 void POINTER_HASHTABLE_u64_u64_destroy(POINTER_HASHTABLE_u64_u64* hashtable) {
     if (hashtable == NULL) return;
 
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
     POINTER_HASHTABLE_u64_u64_deinit(hashtable);
-    free(hashtable);
+    NESQUIK_free(allocator, hashtable);
 }
 
 u8 POINTER_HASHTABLE_u64_u64_grow(POINTER_HASHTABLE_u64_u64* hashtable) {
@@ -75,8 +97,15 @@ u8 POINTER_HASHTABLE_u64_u64_grow(POINTER_HASHTABLE_u64_u64* hashtable) {
     u32 new_capacity = (u32)(hashtable->capacity * POINTER_HASHTABLE_MAX_LOAD_FACTOR / POINTER_HASHTABLE_MIN_LOAD_FACTOR);
     new_capacity = (new_capacity > hashtable->capacity) ? new_capacity : hashtable->capacity;
 
+    return POINTER_HASHTABLE_u64_u64_resize(hashtable, new_capacity);
+}
+
+u8 POINTER_HASHTABLE_u64_u64_resize(POINTER_HASHTABLE_u64_u64* hashtable, const u32 new_capacity) {
+    if (hashtable == NULL) return 0;
+
     POINTER_HASHTABLE_u64_u64 new_hashtable;
-    u8 r = POINTER_HASHTABLE_u64_u64_init(&new_hashtable, new_capacity, hashtable->key_size, hashtable->key_equal);
+    u8 r = POINTER_HASHTABLE_u64_u64_init_allocator(&new_hashtable, new_capacity, hashtable->key_size,
+        hashtable->key_equal, hashtable->allocator);
     if (r == 0) return 0;
 
     for (u32 i = 0; i < hashtable->capacity; i++) {
@@ -91,20 +120,76 @@ u8 POINTER_HASHTABLE_u64_u64_grow(POINTER_HASHTABLE_u64_u64* hashtable) {
         }
     }
 
-    free(hashtable->entries);
+    NESQUIK_free(hashtable->allocator, hashtable->entries);
     hashtable->entries = new_hashtable.entries;
-    hashtable->capacity = new_capacity;
+    hashtable->capacity = new_hashtable.capacity;
     hashtable->tombstones = 0;
 
     return 1;
 }
 
-u8 POINTER_HASHTABLE_u64_u64_quick_add(POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, u64* key, u64 value) {
+u8 POINTER_HASHTABLE_u64_u64_rehash(POINTER_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        POINTER_HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->status == POINTER_HASHTABLE_ENTRY_STATUS_FILLED) entry->status = POINTER_HASHTABLE_ENTRY_STATUS_DISPLACED;
+        else memset(entry, 0, sizeof(POINTER_HASHTABLE_ENTRY_u64_u64));
+    }
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        if (hashtable->entries[i].status != POINTER_HASHTABLE_ENTRY_STATUS_DISPLACED) continue;
+
+        POINTER_HASHTABLE_ENTRY_u64_u64 moving = hashtable->entries[i];
+        memset(hashtable->entries + i, 0, sizeof(POINTER_HASHTABLE_ENTRY_u64_u64));
+
+        for (;;) {
+            u32 j = moving.hash % hashtable->capacity;
+            while (hashtable->entries[j].status == POINTER_HASHTABLE_ENTRY_STATUS_FILLED)
+                j = (j + 1) % hashtable->capacity;
+
+            const POINTER_HASHTABLE_ENTRY_u64_u64 displaced = hashtable->entries[j];
+            hashtable->entries[j] = moving;
+            hashtable->entries[j].status = POINTER_HASHTABLE_ENTRY_STATUS_FILLED;
+
+            if (displaced.status == POINTER_HASHTABLE_ENTRY_STATUS_EMPTY) break;
+            moving = displaced;
+        }
+    }
+
+    hashtable->tombstones = 0;
+    return 1;
+}
+
+u8 POINTER_HASHTABLE_u64_u64_reserve(POINTER_HASHTABLE_u64_u64* hashtable, const u32 n) {
+    if (hashtable == NULL) return 0;
+
+    const u32 capacity = (u32)(n / POINTER_HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    if (capacity <= hashtable->capacity) return 1;
+
+    return POINTER_HASHTABLE_u64_u64_resize(hashtable, capacity);
+}
+
+u8 POINTER_HASHTABLE_u64_u64_shrink_to_fit(POINTER_HASHTABLE_u64_u64* hashtable) {
     if (hashtable == NULL) return 0;
 
-    if ((hashtable->size + 0.0) / hashtable->capacity >= POINTER_HASHTABLE_MAX_LOAD_FACTOR) {
-        const u8 r = POINTER_HASHTABLE_u64_u64_grow(hashtable);
-        if (r == 0) return 0;
+    u32 capacity = (u32)(hashtable->size / POINTER_HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    capacity = capacity < POINTER_HASHTABLE_MIN_CAPACITY ? POINTER_HASHTABLE_MIN_CAPACITY : capacity;
+
+    if (capacity < hashtable->capacity) return POINTER_HASHTABLE_u64_u64_resize(hashtable, capacity);
+    if (hashtable->tombstones == 0) return 1;
+    return POINTER_HASHTABLE_u64_u64_rehash(hashtable);
+}
+
+u64* POINTER_HASHTABLE_u64_u64_quick_get_or_insert(POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, u64* key,
+    u8* inserted) {
+
+    if (hashtable == NULL) return NULL;
+
+    if ((hashtable->size + hashtable->tombstones + 0.0) / hashtable->capacity >= POINTER_HASHTABLE_MAX_LOAD_FACTOR) {
+        const u8 purge = (hashtable->size + 0.0) / hashtable->capacity < POINTER_HASHTABLE_MIN_LOAD_FACTOR;
+        const u8 r = purge == 1 ? POINTER_HASHTABLE_u64_u64_rehash(hashtable) : POINTER_HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return NULL;
     }
 
     u32 i = hash % hashtable->capacity;
@@ -114,37 +199,79 @@ u8 POINTER_HASHTABLE_u64_u64_quick_add(POINTER_HASHTABLE_u64_u64* hashtable, con
         POINTER_HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
         const u8 status = entry->status;
 
-        if (status == POINTER_HASHTABLE_ENTRY_STATUS_EMPTY || status == POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE) {
-            found_entry = entry;
+        if (status == POINTER_HASHTABLE_ENTRY_STATUS_EMPTY) {
+            if (found_entry == NULL) found_entry = entry;
             break;
         }
 
-        const u8 equal = hashtable->key_equal(entry->key, key);
-        if (equal == 1) break;
+        if (status == POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE) {
+            if (found_entry == NULL) found_entry = entry;
+        }
+        else if (entry->hash == hash && POINTER_HASHTABLE_u64_u64_key_equal(hashtable, entry->key, key) == 1) {
+            if (inserted != NULL) *inserted = 0;
+            return &entry->value;
+        }
+
         i = (i + 1) % hashtable->capacity;
     } while (i != hash % hashtable->capacity);
 
-    if (found_entry == NULL) return 0;
+    if (found_entry == NULL) return NULL;
+    if (found_entry->status == POINTER_HASHTABLE_ENTRY_STATUS_TOMBSTONE) hashtable->tombstones--;
 
     found_entry->status = POINTER_HASHTABLE_ENTRY_STATUS_FILLED;
     found_entry->hash = hash;
     found_entry->key = key;
-    found_entry->value = value;
+    memset(&found_entry->value, 0, sizeof(u64));
 
     hashtable->size++;
+    if (inserted != NULL) *inserted = 1;
+    return &found_entry->value;
+}
+
+u8 POINTER_HASHTABLE_u64_u64_quick_add(POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, u64* key, u64 value) {
+    if (hashtable == NULL) return 0;
+
+    u8 inserted;
+    u64* value_slot = POINTER_HASHTABLE_u64_u64_quick_get_or_insert(hashtable, hash, key, &inserted);
+    if (value_slot == NULL || inserted == 0) return 0;
+
+    *value_slot = value;
     return 1;
 }
 
 u8 POINTER_HASHTABLE_u64_u64_add(POINTER_HASHTABLE_u64_u64* hashtable, u64* key, u64 value) {
     if (hashtable == NULL) return 0;
 
-    const u32 key_size = hashtable->key_size(key);
-    const u32 hash = HASH_fnv1a((u8*)key, key_size);
+    const u32 hash = POINTER_HASHTABLE_u64_u64_key_hash(hashtable, key);
 
     return POINTER_HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
 }
 
-void POINTER_HASHTABLE_remove(POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
+u8 POINTER_HASHTABLE_u64_u64_quick_upsert(POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, u64* key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    u64* value_slot = POINTER_HASHTABLE_u64_u64_quick_get_or_insert(hashtable, hash, key, NULL);
+    if (value_slot == NULL) return 0;
+
+    *value_slot = value;
+    return 1;
+}
+
+u8 POINTER_HASHTABLE_u64_u64_upsert(POINTER_HASHTABLE_u64_u64* hashtable, u64* key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = POINTER_HASHTABLE_u64_u64_key_hash(hashtable, key);
+    return POINTER_HASHTABLE_u64_u64_quick_upsert(hashtable, hash, key, value);
+}
+
+u64* POINTER_HASHTABLE_u64_u64_get_or_insert(POINTER_HASHTABLE_u64_u64* hashtable, u64* key, u8* inserted) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = POINTER_HASHTABLE_u64_u64_key_hash(hashtable, key);
+    return POINTER_HASHTABLE_u64_u64_quick_get_or_insert(hashtable, hash, key, inserted);
+}
+
+void POINTER_HASHTABLE_u64_u64_remove(POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
     if (hashtable == NULL) return;
 
     POINTER_HASHTABLE_ENTRY_u64_u64* entry = POINTER_HASHTABLE_u64_u64_find(hashtable, key);
@@ -156,10 +283,6 @@ void POINTER_HASHTABLE_remove(POINTER_HASHTABLE_u64_u64* hashtable, const u64* k
     hashtable->tombstones++;
 }
 
-u32 POINTER_HASHTABLE_u64_u64_hash(const u8* data, const u32 size) {
-    return HASH_fnv1a(data, size);
-}
-
 u8 POINTER_HASHTABLE_u64_u64_contains(const POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
     if (hashtable == NULL) return 0;
 
@@ -171,9 +294,22 @@ u8 POINTER_HASHTABLE_u64_u64_contains(const POINTER_HASHTABLE_u64_u64* hashtable
 POINTER_HASHTABLE_ENTRY_u64_u64* POINTER_HASHTABLE_u64_u64_find(const POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
     if (hashtable == NULL) return NULL;
 
-    // Determine the key_size
-    const u32 key_size = hashtable->key_size(key);
-    const u32 hash = HASH_fnv1a((u8*)key, key_size);
+    const u32 hash = POINTER_HASHTABLE_u64_u64_key_hash(hashtable, key);
+    return POINTER_HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 POINTER_HASHTABLE_u64_u64_contains_hashed(const POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, const u64* key) {
+    if (hashtable == NULL) return 0;
+
+    const POINTER_HASHTABLE_ENTRY_u64_u64* entry = POINTER_HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+POINTER_HASHTABLE_ENTRY_u64_u64* POINTER_HASHTABLE_u64_u64_find_hashed(const POINTER_HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64* key) {
+
+    if (hashtable == NULL) return NULL;
 
     u32 i = hash % hashtable->capacity;
 
@@ -190,7 +326,7 @@ POINTER_HASHTABLE_ENTRY_u64_u64* POINTER_HASHTABLE_u64_u64_find(const POINTER_HA
             continue;
         }
 
-        const u8 equal = hashtable->key_equal(entry->key, key);
+        const u8 equal = POINTER_HASHTABLE_u64_u64_key_equal(hashtable, entry->key, key);
         if (equal == 1) break;
         i = (i + 1) % hashtable->capacity;
     } while (i != hash % hashtable->capacity);
@@ -0,0 +1,276 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/robin_hashset.h"
+
+HASHSET_DECLARE_ROBIN(u32)
+
+u8 HASHSET_u32_init(HASHSET_u32* hashset, const u32 capacity) {
+    return HASHSET_u32_init_allocator(hashset, capacity, NULL);
+}
+
+u8 HASHSET_u32_init_allocator(HASHSET_u32* hashset, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashset == NULL) return 0;
+
+    hashset->allocator = allocator;
+    hashset->size = 0;
+    hashset->capacity = ROBIN_capacity(capacity);
+    hashset->tombstones = 0;
+
+    hashset->entries = (HASHSET_ENTRY_u32*)NESQUIK_alloc(allocator,
+        sizeof(HASHSET_ENTRY_u32) * hashset->capacity);
+    if (hashset->entries == NULL) {
+        hashset->capacity = 0;
+        return 0;
+    }
+
+    memset(hashset->entries, 0, sizeof(HASHSET_ENTRY_u32) * hashset->capacity);
+
+    return 1;
+}
+
+HASHSET_u32* HASHSET_u32_create(const u32 capacity) {
+    return HASHSET_u32_create_allocator(capacity, NULL);
+}
+
+HASHSET_u32* HASHSET_u32_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    HASHSET_u32* hashset = (HASHSET_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_u32));
+    if (hashset == NULL) return NULL;
+
+    const u8 r = HASHSET_u32_init_allocator(hashset, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashset);
+        return NULL;
+    }
+
+    return hashset;
+}
+
+void HASHSET_u32_deinit(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+    hashset->size = 0;
+    hashset->capacity = 0;
+    hashset->tombstones = 0;
+
+    if (hashset->entries != NULL) {
+        NESQUIK_free(hashset->allocator, hashset->entries);
+        hashset->entries = NULL;
+    }
+}
+
+void HASHSET_u32_destroy(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
+    HASHSET_u32_deinit(hashset);
+    NESQUIK_free(allocator, hashset);
+}
+
+static void HASHSET_u32_place(HASHSET_u32* hashset, HASHSET_ENTRY_u32 incoming) {
+    const u32 mask = hashset->capacity - 1;
+    u32 i = incoming.hash & mask;
+
+    incoming.distance = 1;
+    for (;;) {
+        HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->distance == ROBIN_DISTANCE_EMPTY) {
+            *entry = incoming;
+            return;
+        }
+
+        if (entry->distance < incoming.distance) {
+            const HASHSET_ENTRY_u32 displaced = *entry;
+            *entry = incoming;
+            incoming = displaced;
+        }
+
+        incoming.distance++;
+        i = (i + 1) & mask;
+    }
+}
+
+u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity & 0x80000000) return 0;
+
+    HASHSET_u32 new_hashset;
+    const u8 r = HASHSET_u32_init_allocator(&new_hashset, hashset->capacity << 1, hashset->allocator);
+    if (r == 0) return 0;
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        const HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->distance != ROBIN_DISTANCE_EMPTY) HASHSET_u32_place(&new_hashset, *entry);
+    }
+
+    NESQUIK_free(hashset->allocator, hashset->entries);
+    hashset->entries = new_hashset.entries;
+    hashset->capacity = new_hashset.capacity;
+
+    return 1;
+}
+
+u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity == 0) return 0;
+
+    if (hashset->size + 1 > ROBIN_MAX_LOAD(hashset->capacity)) {
+        const u8 r = HASHSET_u32_grow(hashset);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->distance < distance) break;
+        if (entry->hash == hash && HASHSET_u32_key_equal(entry->key, key) == 1) return 0;
+        i = (i + 1) & mask;
+    }
+
+    HASHSET_ENTRY_u32 incoming;
+    incoming.hash = hash;
+    incoming.key = key;
+    HASHSET_u32_place(hashset, incoming);
+
+    hashset->size++;
+    return 1;
+}
+
+u8 HASHSET_u32_add(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_quick_add(hashset, hash, key);
+}
+
+void HASHSET_u32_remove(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find(hashset, key);
+    if (entry == NULL) return;
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = (u32)(entry - hashset->entries);
+
+    for (;;) {
+        const u32 next = (i + 1) & mask;
+        if (hashset->entries[next].distance <= 1) break;
+
+        hashset->entries[i] = hashset->entries[next];
+        hashset->entries[i].distance--;
+        i = next;
+    }
+
+    hashset->entries[i].distance = ROBIN_DISTANCE_EMPTY;
+    hashset->size--;
+}
+
+u8 HASHSET_u32_contains(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find(hashset, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return NULL;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_find_hashed(hashset, hash, key);
+}
+
+u8 HASHSET_u32_contains_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find_hashed(hashset, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return NULL;
+    if (hashset->capacity == 0) return NULL;
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        if (entry->distance < distance) return NULL;
+        if (entry->hash == hash && HASHSET_u32_key_equal(entry->key, key) == 1) return entry;
+        i = (i + 1) & mask;
+    }
+}
+
+HASHSET_u32* HASHSET_u32_union(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(a->capacity + b->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        const HASHSET_ENTRY_u32 entry = a->entries[ai];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY)
+            HASHSET_u32_quick_add(c, entry.hash, entry.key);
+    }
+
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        const HASHSET_ENTRY_u32 entry = b->entries[bi];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY)
+            HASHSET_u32_quick_add(c, entry.hash, entry.key);
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_intersection(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const HASHSET_u32* smaller;
+    const HASHSET_u32* larger;
+    if (a->capacity < b->capacity) {
+        smaller = a;
+        larger = b;
+    }
+    else {
+        smaller = b;
+        larger = a;
+    }
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(smaller->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        const HASHSET_ENTRY_u32 entry = smaller->entries[i];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY) {
+            if (HASHSET_u32_contains_hashed(larger, entry.hash, entry.key) == 1) {
+                HASHSET_u32_quick_add(c, entry.hash, entry.key);
+            }
+        }
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_difference(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(a->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        const HASHSET_ENTRY_u32 entry = a->entries[ai];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY) {
+            if (HASHSET_u32_contains_hashed(b, entry.hash, entry.key) == 0) {
+                HASHSET_u32_quick_add(c, entry.hash, entry.key);
+            }
+        }
+    }
+
+    return c;
+}
\ No newline at end of file
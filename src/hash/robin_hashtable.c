@@ -0,0 +1,215 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/robin_hashtable.h"
+
+HASHTABLE_DECLARE_ROBIN(u64, u64)
+
+u8 HASHTABLE_u64_u64_init(HASHTABLE_u64_u64* hashtable, const u32 capacity) {
+    return HASHTABLE_u64_u64_init_allocator(hashtable, capacity, NULL);
+}
+
+u8 HASHTABLE_u64_u64_init_allocator(HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    hashtable->allocator = allocator;
+    hashtable->size = 0;
+    hashtable->capacity = ROBIN_capacity(capacity);
+    hashtable->tombstones = 0;
+
+    hashtable->entries = (HASHTABLE_ENTRY_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
+    if (hashtable->entries == NULL) {
+        hashtable->capacity = 0;
+        return 0;
+    }
+
+    memset(hashtable->entries, 0, sizeof(HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
+
+    return 1;
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create(const u32 capacity) {
+    return HASHTABLE_u64_u64_create_allocator(capacity, NULL);
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    HASHTABLE_u64_u64* hashtable = (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = HASHTABLE_u64_u64_init_allocator(hashtable, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void HASHTABLE_u64_u64_deinit(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+    hashtable->size = 0;
+    hashtable->capacity = 0;
+    hashtable->tombstones = 0;
+
+    if (hashtable->entries != NULL) {
+        NESQUIK_free(hashtable->allocator, hashtable->entries);
+        hashtable->entries = NULL;
+    }
+}
+
+void HASHTABLE_u64_u64_destroy(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+static void HASHTABLE_u64_u64_place(HASHTABLE_u64_u64* hashtable, HASHTABLE_ENTRY_u64_u64 incoming) {
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = incoming.hash & mask;
+
+    incoming.distance = 1;
+    for (;;) {
+        HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance == ROBIN_DISTANCE_EMPTY) {
+            *entry = incoming;
+            return;
+        }
+
+        if (entry->distance < incoming.distance) {
+            const HASHTABLE_ENTRY_u64_u64 displaced = *entry;
+            *entry = incoming;
+            incoming = displaced;
+        }
+
+        incoming.distance++;
+        i = (i + 1) & mask;
+    }
+}
+
+u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity & 0x80000000) return 0;
+
+    HASHTABLE_u64_u64 new_hashtable;
+    const u8 r = HASHTABLE_u64_u64_init_allocator(&new_hashtable, hashtable->capacity << 1,
+        hashtable->allocator);
+    if (r == 0) return 0;
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        const HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance != ROBIN_DISTANCE_EMPTY) HASHTABLE_u64_u64_place(&new_hashtable, *entry);
+    }
+
+    NESQUIK_free(hashtable->allocator, hashtable->entries);
+    hashtable->entries = new_hashtable.entries;
+    hashtable->capacity = new_hashtable.capacity;
+
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity == 0) return 0;
+
+    if (hashtable->size + 1 > ROBIN_MAX_LOAD(hashtable->capacity)) {
+        const u8 r = HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance < distance) break;
+        if (entry->hash == hash && HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) return 0;
+        i = (i + 1) & mask;
+    }
+
+    HASHTABLE_ENTRY_u64_u64 incoming;
+    incoming.hash = hash;
+    incoming.key = key;
+    incoming.value = value;
+    HASHTABLE_u64_u64_place(hashtable, incoming);
+
+    hashtable->size++;
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_add(HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
+}
+
+void HASHTABLE_u64_u64_remove(HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return;
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = (u32)(entry - hashtable->entries);
+
+    for (;;) {
+        const u32 next = (i + 1) & mask;
+        if (hashtable->entries[next].distance <= 1) break;
+
+        hashtable->entries[i] = hashtable->entries[next];
+        hashtable->entries[i].distance--;
+        i = next;
+    }
+
+    hashtable->entries[i].distance = ROBIN_DISTANCE_EMPTY;
+    hashtable->size--;
+}
+
+u8 HASHTABLE_u64_u64_contains(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 HASHTABLE_u64_u64_contains_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find_hashed(const HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+    if (hashtable->capacity == 0) return NULL;
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance < distance) return NULL;
+        if (entry->hash == hash && HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) return entry;
+        i = (i + 1) & mask;
+    }
+}
\ No newline at end of file
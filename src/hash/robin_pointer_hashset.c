@@ -0,0 +1,300 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/robin_pointer_hashset.h"
+
+POINTER_HASHSET_DECLARE_ROBIN(u64)
+
+u8 POINTER_HASHSET_u64_init(POINTER_HASHSET_u64* hashset,
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*)) {
+
+    return POINTER_HASHSET_u64_init_allocator(hashset, capacity, key_size, key_equal, NULL);
+}
+
+u8 POINTER_HASHSET_u64_init_allocator(POINTER_HASHSET_u64* hashset,
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashset == NULL) return 0;
+
+    hashset->size = 0;
+    hashset->capacity = ROBIN_capacity(capacity);
+
+    hashset->key_size = key_size;
+    hashset->key_equal = key_equal;
+    hashset->allocator = allocator;
+
+    hashset->entries = (POINTER_HASHSET_ENTRY_u64*)NESQUIK_alloc(allocator,
+        sizeof(POINTER_HASHSET_ENTRY_u64) * hashset->capacity);
+    if (hashset->entries == NULL) {
+        hashset->capacity = 0;
+        return 0;
+    }
+
+    memset(hashset->entries, 0, sizeof(POINTER_HASHSET_ENTRY_u64) * hashset->capacity);
+
+    return 1;
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_create(const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*)) {
+
+    return POINTER_HASHSET_u64_create_allocator(capacity, key_size, key_equal, NULL);
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_create_allocator(const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    POINTER_HASHSET_u64* hashset = (POINTER_HASHSET_u64*)NESQUIK_alloc(allocator, sizeof(POINTER_HASHSET_u64));
+    if (hashset == NULL) return NULL;
+
+    const u8 r = POINTER_HASHSET_u64_init_allocator(hashset, capacity, key_size, key_equal, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashset);
+        return NULL;
+    }
+
+    return hashset;
+}
+
+void POINTER_HASHSET_u64_deinit(POINTER_HASHSET_u64* hashset) {
+    if (hashset == NULL) return;
+    hashset->size = 0;
+    hashset->capacity = 0;
+
+    hashset->key_size = NULL;
+    hashset->key_equal = NULL;
+
+    if (hashset->entries != NULL) {
+        NESQUIK_free(hashset->allocator, hashset->entries);
+        hashset->entries = NULL;
+    }
+}
+
+void POINTER_HASHSET_u64_destroy(POINTER_HASHSET_u64* hashset) {
+    if (hashset == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
+    POINTER_HASHSET_u64_deinit(hashset);
+    NESQUIK_free(allocator, hashset);
+}
+
+static void POINTER_HASHSET_u64_place(POINTER_HASHSET_u64* hashset, POINTER_HASHSET_ENTRY_u64 incoming) {
+    const u32 mask = hashset->capacity - 1;
+    u32 i = incoming.hash & mask;
+
+    incoming.distance = 1;
+    for (;;) {
+        POINTER_HASHSET_ENTRY_u64* entry = hashset->entries + i;
+        if (entry->distance == ROBIN_DISTANCE_EMPTY) {
+            *entry = incoming;
+            return;
+        }
+
+        if (entry->distance < incoming.distance) {
+            const POINTER_HASHSET_ENTRY_u64 displaced = *entry;
+            *entry = incoming;
+            incoming = displaced;
+        }
+
+        incoming.distance++;
+        i = (i + 1) & mask;
+    }
+}
+
+u8 POINTER_HASHSET_u64_grow(POINTER_HASHSET_u64* hashset) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity & 0x80000000) return 0;
+
+    POINTER_HASHSET_u64 new_hashset;
+    const u8 r = POINTER_HASHSET_u64_init_allocator(&new_hashset, hashset->capacity << 1, hashset->key_size,
+        hashset->key_equal, hashset->allocator);
+    if (r == 0) return 0;
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        const POINTER_HASHSET_ENTRY_u64* entry = hashset->entries + i;
+        if (entry->distance != ROBIN_DISTANCE_EMPTY) POINTER_HASHSET_u64_place(&new_hashset, *entry);
+    }
+
+    NESQUIK_free(hashset->allocator, hashset->entries);
+    hashset->entries = new_hashset.entries;
+    hashset->capacity = new_hashset.capacity;
+
+    return 1;
+}
+
+u8 POINTER_HASHSET_u64_quick_add(POINTER_HASHSET_u64* hashset, const u32 hash, u64* key) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity == 0) return 0;
+
+    if (hashset->size + 1 > ROBIN_MAX_LOAD(hashset->capacity)) {
+        const u8 r = POINTER_HASHSET_u64_grow(hashset);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        POINTER_HASHSET_ENTRY_u64* entry = hashset->entries + i;
+        if (entry->distance < distance) break;
+        if (entry->hash == hash && POINTER_HASHSET_u64_key_equal(hashset, entry->key, key) == 1) return 0;
+        i = (i + 1) & mask;
+    }
+
+    POINTER_HASHSET_ENTRY_u64 incoming;
+    incoming.hash = hash;
+    incoming.key = key;
+    POINTER_HASHSET_u64_place(hashset, incoming);
+
+    hashset->size++;
+    return 1;
+}
+
+u8 POINTER_HASHSET_u64_add(POINTER_HASHSET_u64* hashset, u64* key) {
+    if (hashset == NULL) return 0;
+
+    const u32 hash = POINTER_HASHSET_u64_key_hash(hashset, key);
+    return POINTER_HASHSET_u64_quick_add(hashset, hash, key);
+}
+
+void POINTER_HASHSET_u64_remove(POINTER_HASHSET_u64* hashset, const u64* key) {
+    if (hashset == NULL) return;
+
+    const POINTER_HASHSET_ENTRY_u64* entry = POINTER_HASHSET_u64_find(hashset, key);
+    if (entry == NULL) return;
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = (u32)(entry - hashset->entries);
+
+    for (;;) {
+        const u32 next = (i + 1) & mask;
+        if (hashset->entries[next].distance <= 1) break;
+
+        hashset->entries[i] = hashset->entries[next];
+        hashset->entries[i].distance--;
+        i = next;
+    }
+
+    hashset->entries[i].distance = ROBIN_DISTANCE_EMPTY;
+    hashset->size--;
+}
+
+u8 POINTER_HASHSET_u64_contains(const POINTER_HASHSET_u64* hashset, const u64* key) {
+    if (hashset == NULL) return 0;
+
+    const POINTER_HASHSET_ENTRY_u64* entry = POINTER_HASHSET_u64_find(hashset, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+POINTER_HASHSET_ENTRY_u64* POINTER_HASHSET_u64_find(const POINTER_HASHSET_u64* hashset, const u64* key) {
+    if (hashset == NULL) return NULL;
+
+    const u32 hash = POINTER_HASHSET_u64_key_hash(hashset, key);
+    return POINTER_HASHSET_u64_find_hashed(hashset, hash, key);
+}
+
+u8 POINTER_HASHSET_u64_contains_hashed(const POINTER_HASHSET_u64* hashset, const u32 hash, const u64* key) {
+    if (hashset == NULL) return 0;
+
+    const POINTER_HASHSET_ENTRY_u64* entry = POINTER_HASHSET_u64_find_hashed(hashset, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+POINTER_HASHSET_ENTRY_u64* POINTER_HASHSET_u64_find_hashed(const POINTER_HASHSET_u64* hashset,
+    const u32 hash, const u64* key) {
+
+    if (hashset == NULL) return NULL;
+    if (hashset->capacity == 0) return NULL;
+
+    const u32 mask = hashset->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        POINTER_HASHSET_ENTRY_u64* entry = hashset->entries + i;
+        if (entry->distance < distance) return NULL;
+        if (entry->hash == hash && POINTER_HASHSET_u64_key_equal(hashset, entry->key, key) == 1) return entry;
+        i = (i + 1) & mask;
+    }
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_union(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    POINTER_HASHSET_u64* c = POINTER_HASHSET_u64_create_allocator(a->capacity + b->capacity, a->key_size,
+        a->key_equal, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = a->entries[ai];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY)
+            POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+    }
+
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = b->entries[bi];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY)
+            POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+    }
+
+    return c;
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_intersection(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const POINTER_HASHSET_u64* smaller;
+    const POINTER_HASHSET_u64* larger;
+    if (a->capacity < b->capacity) {
+        smaller = a;
+        larger = b;
+    }
+    else {
+        smaller = b;
+        larger = a;
+    }
+
+    POINTER_HASHSET_u64* c = POINTER_HASHSET_u64_create_allocator(smaller->capacity, a->key_size,
+        a->key_equal, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = smaller->entries[i];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY) {
+            if (POINTER_HASHSET_u64_contains_hashed(larger, entry.hash, entry.key) == 1) {
+                POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+            }
+        }
+    }
+
+    return c;
+}
+
+POINTER_HASHSET_u64* POINTER_HASHSET_u64_difference(const POINTER_HASHSET_u64* a, const POINTER_HASHSET_u64* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    POINTER_HASHSET_u64* c = POINTER_HASHSET_u64_create_allocator(a->capacity, a->key_size, a->key_equal,
+        a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        const POINTER_HASHSET_ENTRY_u64 entry = a->entries[ai];
+        if (entry.distance != ROBIN_DISTANCE_EMPTY) {
+            if (POINTER_HASHSET_u64_contains_hashed(b, entry.hash, entry.key) == 0) {
+                POINTER_HASHSET_u64_quick_add(c, entry.hash, entry.key);
+            }
+        }
+    }
+
+    return c;
+}
\ No newline at end of file
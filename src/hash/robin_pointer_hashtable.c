@@ -0,0 +1,232 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/robin_pointer_hashtable.h"
+
+POINTER_HASHTABLE_DECLARE_ROBIN(u64, u64)
+
+u8 POINTER_HASHTABLE_u64_u64_init(POINTER_HASHTABLE_u64_u64* hashtable,
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*)) {
+
+    return POINTER_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, key_size, key_equal, NULL);
+}
+
+u8 POINTER_HASHTABLE_u64_u64_init_allocator(POINTER_HASHTABLE_u64_u64* hashtable,
+    const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    hashtable->size = 0;
+    hashtable->capacity = ROBIN_capacity(capacity);
+
+    hashtable->key_size = key_size;
+    hashtable->key_equal = key_equal;
+    hashtable->allocator = allocator;
+
+    hashtable->entries = (POINTER_HASHTABLE_ENTRY_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(POINTER_HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
+    if (hashtable->entries == NULL) {
+        hashtable->capacity = 0;
+        return 0;
+    }
+
+    memset(hashtable->entries, 0, sizeof(POINTER_HASHTABLE_ENTRY_u64_u64) * hashtable->capacity);
+
+    return 1;
+}
+
+POINTER_HASHTABLE_u64_u64* POINTER_HASHTABLE_u64_u64_create(const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*)) {
+
+    return POINTER_HASHTABLE_u64_u64_create_allocator(capacity, key_size, key_equal, NULL);
+}
+
+POINTER_HASHTABLE_u64_u64* POINTER_HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    u32 (*key_size)(const u64*),
+    u8 (*key_equal)(const u64*, const u64*),
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    POINTER_HASHTABLE_u64_u64* hashtable = (POINTER_HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(POINTER_HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = POINTER_HASHTABLE_u64_u64_init_allocator(hashtable, capacity, key_size, key_equal,
+        allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void POINTER_HASHTABLE_u64_u64_deinit(POINTER_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+    hashtable->size = 0;
+    hashtable->capacity = 0;
+
+    hashtable->key_size = NULL;
+    hashtable->key_equal = NULL;
+
+    if (hashtable->entries != NULL) {
+        NESQUIK_free(hashtable->allocator, hashtable->entries);
+        hashtable->entries = NULL;
+    }
+}
+
+void POINTER_HASHTABLE_u64_u64_destroy(POINTER_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    POINTER_HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+static void POINTER_HASHTABLE_u64_u64_place(POINTER_HASHTABLE_u64_u64* hashtable, POINTER_HASHTABLE_ENTRY_u64_u64 incoming) {
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = incoming.hash & mask;
+
+    incoming.distance = 1;
+    for (;;) {
+        POINTER_HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance == ROBIN_DISTANCE_EMPTY) {
+            *entry = incoming;
+            return;
+        }
+
+        if (entry->distance < incoming.distance) {
+            const POINTER_HASHTABLE_ENTRY_u64_u64 displaced = *entry;
+            *entry = incoming;
+            incoming = displaced;
+        }
+
+        incoming.distance++;
+        i = (i + 1) & mask;
+    }
+}
+
+u8 POINTER_HASHTABLE_u64_u64_grow(POINTER_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity & 0x80000000) return 0;
+
+    POINTER_HASHTABLE_u64_u64 new_hashtable;
+    const u8 r = POINTER_HASHTABLE_u64_u64_init_allocator(&new_hashtable, hashtable->capacity << 1,
+        hashtable->key_size, hashtable->key_equal, hashtable->allocator);
+    if (r == 0) return 0;
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        const POINTER_HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance != ROBIN_DISTANCE_EMPTY) POINTER_HASHTABLE_u64_u64_place(&new_hashtable, *entry);
+    }
+
+    NESQUIK_free(hashtable->allocator, hashtable->entries);
+    hashtable->entries = new_hashtable.entries;
+    hashtable->capacity = new_hashtable.capacity;
+
+    return 1;
+}
+
+u8 POINTER_HASHTABLE_u64_u64_quick_add(POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, u64* key, u64 value) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity == 0) return 0;
+
+    if (hashtable->size + 1 > ROBIN_MAX_LOAD(hashtable->capacity)) {
+        const u8 r = POINTER_HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return 0;
+    }
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        POINTER_HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance < distance) break;
+        if (entry->hash == hash && POINTER_HASHTABLE_u64_u64_key_equal(hashtable, entry->key, key) == 1) return 0;
+        i = (i + 1) & mask;
+    }
+
+    POINTER_HASHTABLE_ENTRY_u64_u64 incoming;
+    incoming.hash = hash;
+    incoming.key = key;
+    incoming.value = value;
+    POINTER_HASHTABLE_u64_u64_place(hashtable, incoming);
+
+    hashtable->size++;
+    return 1;
+}
+
+u8 POINTER_HASHTABLE_u64_u64_add(POINTER_HASHTABLE_u64_u64* hashtable, u64* key, u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = POINTER_HASHTABLE_u64_u64_key_hash(hashtable, key);
+    return POINTER_HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
+}
+
+void POINTER_HASHTABLE_u64_u64_remove(POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
+    if (hashtable == NULL) return;
+
+    const POINTER_HASHTABLE_ENTRY_u64_u64* entry = POINTER_HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return;
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = (u32)(entry - hashtable->entries);
+
+    for (;;) {
+        const u32 next = (i + 1) & mask;
+        if (hashtable->entries[next].distance <= 1) break;
+
+        hashtable->entries[i] = hashtable->entries[next];
+        hashtable->entries[i].distance--;
+        i = next;
+    }
+
+    hashtable->entries[i].distance = ROBIN_DISTANCE_EMPTY;
+    hashtable->size--;
+}
+
+u8 POINTER_HASHTABLE_u64_u64_contains(const POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
+    if (hashtable == NULL) return 0;
+
+    const POINTER_HASHTABLE_ENTRY_u64_u64* entry = POINTER_HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+POINTER_HASHTABLE_ENTRY_u64_u64* POINTER_HASHTABLE_u64_u64_find(const POINTER_HASHTABLE_u64_u64* hashtable, const u64* key) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = POINTER_HASHTABLE_u64_u64_key_hash(hashtable, key);
+    return POINTER_HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 POINTER_HASHTABLE_u64_u64_contains_hashed(const POINTER_HASHTABLE_u64_u64* hashtable, const u32 hash, const u64* key) {
+    if (hashtable == NULL) return 0;
+
+    const POINTER_HASHTABLE_ENTRY_u64_u64* entry = POINTER_HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+POINTER_HASHTABLE_ENTRY_u64_u64* POINTER_HASHTABLE_u64_u64_find_hashed(const POINTER_HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64* key) {
+
+    if (hashtable == NULL) return NULL;
+    if (hashtable->capacity == 0) return NULL;
+
+    const u32 mask = hashtable->capacity - 1;
+    u32 i = hash & mask;
+
+    for (u32 distance = 1; ; distance++) {
+        POINTER_HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        if (entry->distance < distance) return NULL;
+        if (entry->hash == hash && POINTER_HASHTABLE_u64_u64_key_equal(hashtable, entry->key, key) == 1) return entry;
+        i = (i + 1) & mask;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/sharded_hashtable.h"
+
+HASHTABLE_DECLARE(u64, u64)
+SHARDED_HASHTABLE_DECLARE(u64, u64)
+
+typedef struct SHARDED_HASHTABLE_JOB_u64_u64 {
+    SHARDED_HASHTABLE_u64_u64* hashtable;
+    SHARDED_HASHTABLE_ROUTER_u64_u64* routers;
+    const u64* keys;
+    const u64* values;
+    u32 n;
+    u8* failed;
+} SHARDED_HASHTABLE_JOB_u64_u64;
+
+u8 SHARDED_HASHTABLE_u64_u64_init(SHARDED_HASHTABLE_u64_u64* hashtable, const u32 shard_count,
+    const u32 capacity) {
+
+    return SHARDED_HASHTABLE_u64_u64_init_allocator(hashtable, shard_count, capacity, NULL);
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_init_allocator(SHARDED_HASHTABLE_u64_u64* hashtable, const u32 shard_count,
+    const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL || shard_count == 0) return 0;
+
+    hashtable->allocator = allocator;
+    hashtable->shards = (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_u64_u64) * shard_count);
+    if (hashtable->shards == NULL) return 0;
+
+    const u32 shard_capacity = capacity / shard_count;
+    for (u32 i = 0; i < shard_count; i++) {
+        HASHTABLE_u64_u64* shard = hashtable->shards + i;
+        if (HASHTABLE_u64_u64_init_allocator(shard, shard_capacity, allocator) == 1) continue;
+
+        hashtable->shard_count = i;
+        SHARDED_HASHTABLE_u64_u64_deinit(hashtable);
+        return 0;
+    }
+
+    hashtable->shard_count = shard_count;
+    return 1;
+}
+
+SHARDED_HASHTABLE_u64_u64* SHARDED_HASHTABLE_u64_u64_create(const u32 shard_count, const u32 capacity) {
+    return SHARDED_HASHTABLE_u64_u64_create_allocator(shard_count, capacity, NULL);
+}
+
+SHARDED_HASHTABLE_u64_u64* SHARDED_HASHTABLE_u64_u64_create_allocator(const u32 shard_count,
+    const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+
+    SHARDED_HASHTABLE_u64_u64* hashtable =
+        (SHARDED_HASHTABLE_u64_u64*)NESQUIK_alloc(allocator, sizeof(SHARDED_HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = SHARDED_HASHTABLE_u64_u64_init_allocator(hashtable, shard_count, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void SHARDED_HASHTABLE_u64_u64_deinit(SHARDED_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    for (u32 i = 0; i < hashtable->shard_count; i++) HASHTABLE_u64_u64_deinit(hashtable->shards + i);
+    NESQUIK_free(hashtable->allocator, hashtable->shards);
+    hashtable->shards = NULL;
+    hashtable->shard_count = 0;
+}
+
+void SHARDED_HASHTABLE_u64_u64_destroy(SHARDED_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    SHARDED_HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+static void SHARDED_HASHTABLE_u64_u64_place_task(void* context, const u32 worker, const u32 workers) {
+    SHARDED_HASHTABLE_JOB_u64_u64* job = (SHARDED_HASHTABLE_JOB_u64_u64*)context;
+    SHARDED_HASHTABLE_u64_u64* hashtable = job->hashtable;
+
+    for (u32 s = worker; s < hashtable->shard_count; s += workers) {
+        HASHTABLE_u64_u64* shard = hashtable->shards + s;
+        if (HASHTABLE_u64_u64_resize(shard, shard->capacity) == 0) job->failed[worker] = 1;
+    }
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_place(SHARDED_HASHTABLE_u64_u64* hashtable, THREAD_POOL* pool) {
+    if (hashtable == NULL) return 0;
+
+    const u32 workers = THREAD_POOL_workers(pool);
+    SHARDED_HASHTABLE_JOB_u64_u64 job = { .hashtable = hashtable };
+    job.failed = (u8*)calloc(workers, sizeof(u8));
+    if (job.failed == NULL) return 0;
+
+    THREAD_POOL_run(pool, SHARDED_HASHTABLE_u64_u64_place_task, &job);
+
+    u8 r = 1;
+    for (u32 w = 0; w < workers; w++) r = job.failed[w] == 1 ? 0 : r;
+    free(job.failed);
+    return r;
+}
+
+HASHTABLE_u64_u64* SHARDED_HASHTABLE_u64_u64_shard(const SHARDED_HASHTABLE_u64_u64* hashtable,
+    const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return hashtable->shards + SHARDED_HASHTABLE_shard_of(hash, hashtable->shard_count);
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_upsert(SHARDED_HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    HASHTABLE_u64_u64* shard = hashtable->shards + SHARDED_HASHTABLE_shard_of(hash, hashtable->shard_count);
+    return HASHTABLE_u64_u64_quick_upsert(shard, hash, key, value);
+}
+
+void SHARDED_HASHTABLE_u64_u64_remove(SHARDED_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return;
+
+    HASHTABLE_u64_u64_remove(SHARDED_HASHTABLE_u64_u64_shard(hashtable, key), key);
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_contains(const SHARDED_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    return SHARDED_HASHTABLE_u64_u64_find(hashtable, key) != NULL;
+}
+
+HASHTABLE_ENTRY_u64_u64* SHARDED_HASHTABLE_u64_u64_find(const SHARDED_HASHTABLE_u64_u64* hashtable,
+    const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    const HASHTABLE_u64_u64* shard = hashtable->shards + SHARDED_HASHTABLE_shard_of(hash, hashtable->shard_count);
+    return HASHTABLE_u64_u64_find_hashed(shard, hash, key);
+}
+
+u32 SHARDED_HASHTABLE_u64_u64_size(const SHARDED_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    u32 size = 0;
+    for (u32 i = 0; i < hashtable->shard_count; i++) size += hashtable->shards[i].size;
+    return size;
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_router_init(SHARDED_HASHTABLE_ROUTER_u64_u64* router,
+    SHARDED_HASHTABLE_u64_u64* hashtable) {
+
+    if (router == NULL || hashtable == NULL) return 0;
+
+    router->hashtable = hashtable;
+    router->buffers = (SHARDED_HASHTABLE_BUFFER_u64_u64*)calloc(hashtable->shard_count,
+        sizeof(SHARDED_HASHTABLE_BUFFER_u64_u64));
+    if (router->buffers == NULL) return 0;
+
+    return 1;
+}
+
+void SHARDED_HASHTABLE_u64_u64_router_deinit(SHARDED_HASHTABLE_ROUTER_u64_u64* router) {
+    if (router == NULL || router->buffers == NULL) return;
+
+    for (u32 i = 0; i < router->hashtable->shard_count; i++) free(router->buffers[i].items);
+    free(router->buffers);
+    router->buffers = NULL;
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_route(SHARDED_HASHTABLE_ROUTER_u64_u64* router, const u64 key, const u64 value) {
+    if (router == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    SHARDED_HASHTABLE_BUFFER_u64_u64* buffer =
+        router->buffers + SHARDED_HASHTABLE_shard_of(hash, router->hashtable->shard_count);
+
+    if (buffer->size == buffer->capacity) {
+        u32 capacity = buffer->capacity * 2;
+        capacity = capacity < SHARDED_HASHTABLE_BUFFER_MIN_CAPACITY ? SHARDED_HASHTABLE_BUFFER_MIN_CAPACITY : capacity;
+
+        SHARDED_HASHTABLE_ITEM_u64_u64* items = (SHARDED_HASHTABLE_ITEM_u64_u64*)realloc(buffer->items,
+            sizeof(SHARDED_HASHTABLE_ITEM_u64_u64) * capacity);
+        if (items == NULL) return 0;
+
+        buffer->items = items;
+        buffer->capacity = capacity;
+    }
+
+    SHARDED_HASHTABLE_ITEM_u64_u64* item = buffer->items + buffer->size++;
+    item->hash = hash;
+    item->key = key;
+    item->value = value;
+    return 1;
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_drain(SHARDED_HASHTABLE_u64_u64* hashtable, const u32 shard,
+    SHARDED_HASHTABLE_ROUTER_u64_u64* routers, const u32 router_count) {
+
+    if (hashtable == NULL || shard >= hashtable->shard_count) return 0;
+
+    u32 pending = 0;
+    for (u32 r = 0; r < router_count; r++) pending += routers[r].buffers[shard].size;
+
+    HASHTABLE_u64_u64* target = hashtable->shards + shard;
+    if (HASHTABLE_u64_u64_reserve(target, target->size + pending) == 0) return 0;
+
+    for (u32 r = 0; r < router_count; r++) {
+        SHARDED_HASHTABLE_BUFFER_u64_u64* buffer = routers[r].buffers + shard;
+
+        for (u32 i = 0; i < buffer->size; i++) {
+            const SHARDED_HASHTABLE_ITEM_u64_u64* item = buffer->items + i;
+            if (HASHTABLE_u64_u64_quick_upsert(target, item->hash, item->key, item->value) == 0) return 0;
+        }
+
+        buffer->size = 0;
+    }
+
+    return 1;
+}
+
+static void SHARDED_HASHTABLE_u64_u64_route_task(void* context, const u32 worker, const u32 workers) {
+    SHARDED_HASHTABLE_JOB_u64_u64* job = (SHARDED_HASHTABLE_JOB_u64_u64*)context;
+    SHARDED_HASHTABLE_ROUTER_u64_u64* router = job->routers + worker;
+
+    const u32 begin = THREAD_POOL_split(job->n, worker, workers);
+    const u32 end = THREAD_POOL_split(job->n, worker + 1, workers);
+    for (u32 i = begin; i < end; i++) {
+        if (SHARDED_HASHTABLE_u64_u64_route(router, job->keys[i], job->values[i]) == 1) continue;
+
+        job->failed[worker] = 1;
+        return;
+    }
+}
+
+static void SHARDED_HASHTABLE_u64_u64_drain_task(void* context, const u32 worker, const u32 workers) {
+    SHARDED_HASHTABLE_JOB_u64_u64* job = (SHARDED_HASHTABLE_JOB_u64_u64*)context;
+
+    for (u32 s = worker; s < job->hashtable->shard_count; s += workers) {
+        if (SHARDED_HASHTABLE_u64_u64_drain(job->hashtable, s, job->routers, workers) == 0) job->failed[worker] = 1;
+    }
+}
+
+u8 SHARDED_HASHTABLE_u64_u64_ingest(SHARDED_HASHTABLE_u64_u64* hashtable, const u64* keys,
+    const u64* values, const u32 n, THREAD_POOL* pool) {
+
+    if (hashtable == NULL || keys == NULL || values == NULL) return 0;
+
+    const u32 workers = THREAD_POOL_workers(pool);
+    SHARDED_HASHTABLE_JOB_u64_u64 job = { .hashtable = hashtable, .keys = keys, .values = values, .n = n };
+    job.routers = (SHARDED_HASHTABLE_ROUTER_u64_u64*)calloc(workers, sizeof(SHARDED_HASHTABLE_ROUTER_u64_u64));
+    job.failed = (u8*)calloc(workers, sizeof(u8));
+
+    u8 r = job.routers != NULL && job.failed != NULL;
+    for (u32 w = 0; w < workers && r == 1; w++)
+        r = SHARDED_HASHTABLE_u64_u64_router_init(job.routers + w, hashtable);
+
+    if (r == 1) THREAD_POOL_run(pool, SHARDED_HASHTABLE_u64_u64_route_task, &job);
+    for (u32 w = 0; w < workers && r == 1; w++) r = job.failed[w] == 0;
+
+    if (r == 1) THREAD_POOL_run(pool, SHARDED_HASHTABLE_u64_u64_drain_task, &job);
+    for (u32 w = 0; w < workers && r == 1; w++) r = job.failed[w] == 0;
+
+    for (u32 w = 0; job.routers != NULL && w < workers; w++)
+        SHARDED_HASHTABLE_u64_u64_router_deinit(job.routers + w);
+    free(job.routers);
+    free(job.failed);
+    return r;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/shared_hashtable.h"
+
+HASHTABLE_DECLARE(u64, u64)
+SHARED_HASHTABLE_DECLARE(u64, u64)
+
+static inline void SHARED_HASHTABLE_u64_u64_layout(SHARED_MEMORY_HEADER* layout, const u32 capacity) {
+    layout->entry_size = sizeof(HASHTABLE_ENTRY_u64_u64);
+    layout->key_size = sizeof(u64);
+    layout->value_size = sizeof(u64);
+    layout->capacity = capacity;
+}
+
+static inline HASHTABLE_u64_u64 SHARED_HASHTABLE_u64_u64_view(const SHARED_HASHTABLE_u64_u64* hashtable) {
+    HASHTABLE_u64_u64 view;
+    memset(&view, 0, sizeof(view));
+    view.entries = hashtable->entries;
+    view.size = hashtable->header->size;
+    view.capacity = hashtable->header->capacity;
+    view.tombstones = hashtable->header->tombstones;
+    return view;
+}
+
+static inline void SHARED_HASHTABLE_u64_u64_store(SHARED_HASHTABLE_u64_u64* hashtable,
+    const HASHTABLE_u64_u64* view) {
+
+    hashtable->header->size = view->size;
+    hashtable->header->tombstones = view->tombstones;
+}
+
+static SHARED_HASHTABLE_u64_u64* SHARED_HASHTABLE_u64_u64_wrap(SHARED_MEMORY_HEADER* header,
+    const u8 writer) {
+
+    if (header == NULL) return NULL;
+
+    SHARED_HASHTABLE_u64_u64* hashtable =
+        (SHARED_HASHTABLE_u64_u64*)malloc(sizeof(SHARED_HASHTABLE_u64_u64));
+    if (hashtable == NULL) {
+        SHARED_MEMORY_close(header);
+        return NULL;
+    }
+
+    hashtable->header = header;
+    hashtable->entries = (HASHTABLE_ENTRY_u64_u64*)SHARED_MEMORY_entries(header);
+    hashtable->writer = writer;
+    return hashtable;
+}
+
+SHARED_HASHTABLE_u64_u64* SHARED_HASHTABLE_u64_u64_create(const char* name, const u32 capacity) {
+    SHARED_MEMORY_HEADER layout;
+    const u32 slots = (u32)(capacity / HASHTABLE_MAX_LOAD_FACTOR) + 1;
+    SHARED_HASHTABLE_u64_u64_layout(&layout, slots < HASHTABLE_MIN_CAPACITY ? HASHTABLE_MIN_CAPACITY : slots);
+    return SHARED_HASHTABLE_u64_u64_wrap(SHARED_MEMORY_create(name, &layout), 1);
+}
+
+SHARED_HASHTABLE_u64_u64* SHARED_HASHTABLE_u64_u64_open(const char* name) {
+    SHARED_MEMORY_HEADER layout;
+    SHARED_HASHTABLE_u64_u64_layout(&layout, 0);
+    return SHARED_HASHTABLE_u64_u64_wrap((SHARED_MEMORY_HEADER*)SHARED_MEMORY_open(name, &layout), 0);
+}
+
+void SHARED_HASHTABLE_u64_u64_destroy(SHARED_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    SHARED_MEMORY_close(hashtable->header);
+    free(hashtable);
+}
+
+u8 SHARED_HASHTABLE_u64_u64_upsert(SHARED_HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL || hashtable->writer == 0) return 0;
+
+    HASHTABLE_u64_u64 view = SHARED_HASHTABLE_u64_u64_view(hashtable);
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+
+    HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(&view, hash, key);
+    if (entry != NULL) {
+        SHARED_MEMORY_write_begin(hashtable->header);
+        entry->value = value;
+        SHARED_MEMORY_write_end(hashtable->header);
+        return 1;
+    }
+
+    if ((view.size + 1.0) / view.capacity >= HASHTABLE_MAX_LOAD_FACTOR) return 0;
+
+    SHARED_MEMORY_write_begin(hashtable->header);
+    if ((view.size + view.tombstones + 1.0) / view.capacity >= HASHTABLE_MAX_LOAD_FACTOR)
+        HASHTABLE_u64_u64_rehash(&view);
+
+    const u8 r = HASHTABLE_u64_u64_quick_add(&view, hash, key, value);
+    SHARED_HASHTABLE_u64_u64_store(hashtable, &view);
+    SHARED_MEMORY_write_end(hashtable->header);
+    return r;
+}
+
+u8 SHARED_HASHTABLE_u64_u64_remove(SHARED_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL || hashtable->writer == 0) return 0;
+
+    HASHTABLE_u64_u64 view = SHARED_HASHTABLE_u64_u64_view(hashtable);
+    if (HASHTABLE_u64_u64_contains(&view, key) == 0) return 0;
+
+    SHARED_MEMORY_write_begin(hashtable->header);
+    HASHTABLE_u64_u64_remove(&view, key);
+    SHARED_HASHTABLE_u64_u64_store(hashtable, &view);
+    SHARED_MEMORY_write_end(hashtable->header);
+    return 1;
+}
+
+u8 SHARED_HASHTABLE_u64_u64_publish(SHARED_HASHTABLE_u64_u64* hashtable,
+    const HASHTABLE_u64_u64* source) {
+
+    if (hashtable == NULL || source == NULL || hashtable->writer == 0) return 0;
+
+    HASHTABLE_u64_u64 view = SHARED_HASHTABLE_u64_u64_view(hashtable);
+    if ((source->size + 0.0) / view.capacity >= HASHTABLE_MAX_LOAD_FACTOR) return 0;
+
+    SHARED_MEMORY_write_begin(hashtable->header);
+    memset(view.entries, 0, sizeof(HASHTABLE_ENTRY_u64_u64) * view.capacity);
+    view.size = 0;
+    view.tombstones = 0;
+
+    for (u32 i = 0; i < source->capacity; i++) {
+        const HASHTABLE_ENTRY_u64_u64* entry = source->entries + i;
+        if (entry->status == HASHTABLE_ENTRY_STATUS_FILLED)
+            HASHTABLE_u64_u64_quick_add(&view, entry->hash, entry->key, entry->value);
+    }
+
+    SHARED_HASHTABLE_u64_u64_store(hashtable, &view);
+    SHARED_MEMORY_write_end(hashtable->header);
+    return 1;
+}
+
+u8 SHARED_HASHTABLE_u64_u64_get(const SHARED_HASHTABLE_u64_u64* hashtable, const u64 key, u64* value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    for (;;) {
+        const u32 sequence = SHARED_MEMORY_read_begin(hashtable->header);
+        const HASHTABLE_u64_u64 view = SHARED_HASHTABLE_u64_u64_view(hashtable);
+        const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(&view, hash, key);
+
+        u64 found;
+        if (entry != NULL) found = entry->value;
+        if (SHARED_MEMORY_read_retry(hashtable->header, sequence) == 1) continue;
+
+        if (entry != NULL && value != NULL) *value = found;
+        return entry != NULL;
+    }
+}
+
+u8 SHARED_HASHTABLE_u64_u64_contains(const SHARED_HASHTABLE_u64_u64* hashtable, const u64 key) {
+    return SHARED_HASHTABLE_u64_u64_get(hashtable, key, NULL);
+}
+
+u32 SHARED_HASHTABLE_u64_u64_size(const SHARED_HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    for (;;) {
+        const u32 sequence = SHARED_MEMORY_read_begin(hashtable->header);
+        const u32 size = hashtable->header->size;
+        if (SHARED_MEMORY_read_retry(hashtable->header, sequence) == 0) return size;
+    }
+}
\ No newline at end of file
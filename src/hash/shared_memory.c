@@ -0,0 +1,92 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "hash/shared_memory.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static u64 SHARED_MEMORY_align(const u64 n) {
+    return (n + SHARED_MEMORY_CACHE_LINE - 1) & ~(u64)(SHARED_MEMORY_CACHE_LINE - 1);
+}
+
+SHARED_MEMORY_HEADER* SHARED_MEMORY_create(const char* name, const SHARED_MEMORY_HEADER* layout) {
+    if (name == NULL || layout == NULL || layout->capacity == 0) return NULL;
+
+    const u64 entries_offset = SHARED_MEMORY_align(sizeof(SHARED_MEMORY_HEADER));
+    const u64 bytes = entries_offset + (u64)layout->capacity * layout->entry_size;
+
+    shm_unlink(name);
+    const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) return NULL;
+
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, (off_t)bytes) == 0) mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name);
+        return NULL;
+    }
+
+    // The segment comes zeroed, which is an empty table, only the header needs filling in
+    SHARED_MEMORY_HEADER* header = (SHARED_MEMORY_HEADER*)mapping;
+    header->entry_size = layout->entry_size;
+    header->key_size = layout->key_size;
+    header->value_size = layout->value_size;
+    header->capacity = layout->capacity;
+    header->entries_offset = entries_offset;
+    header->bytes = bytes;
+    header->size = 0;
+    header->tombstones = 0;
+    atomic_store_explicit(&header->sequence, 0, memory_order_relaxed);
+
+    header->version = SHARED_MEMORY_VERSION;
+    atomic_thread_fence(memory_order_release);
+    header->magic = SHARED_MEMORY_MAGIC;
+    return header;
+}
+
+const SHARED_MEMORY_HEADER* SHARED_MEMORY_open(const char* name, const SHARED_MEMORY_HEADER* layout) {
+    if (name == NULL || layout == NULL) return NULL;
+
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (u64)st.st_size >= sizeof(SHARED_MEMORY_HEADER))
+        mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    const SHARED_MEMORY_HEADER* header = (const SHARED_MEMORY_HEADER*)mapping;
+    u8 r = header->magic == SHARED_MEMORY_MAGIC && header->version == SHARED_MEMORY_VERSION;
+    r = r && header->entry_size == layout->entry_size && header->key_size == layout->key_size;
+    r = r && header->value_size == layout->value_size && header->capacity != 0;
+    r = r && header->bytes == (u64)st.st_size;
+    if (r == 0) {
+        munmap(mapping, (size_t)st.st_size);
+        return NULL;
+    }
+
+    return header;
+}
+
+void SHARED_MEMORY_close(const SHARED_MEMORY_HEADER* header) {
+    if (header == NULL) return;
+    munmap((void*)header, (size_t)header->bytes);
+}
+
+u8 SHARED_MEMORY_unlink(const char* name) {
+    if (name == NULL) return 0;
+    return shm_unlink(name) == 0;
+}
+
+u32 SHARED_MEMORY_wait(const SHARED_MEMORY_HEADER* header) {
+    u32 sequence;
+    while ((sequence = atomic_load_explicit(&header->sequence, memory_order_acquire)) & 1) sched_yield();
+    return sequence;
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/swiss_hashset.h"
+
+HASHSET_DECLARE_SWISS(u32)
+
+u8 HASHSET_u32_init(HASHSET_u32* hashset, const u32 capacity) {
+    return HASHSET_u32_init_allocator(hashset, capacity, NULL);
+}
+
+u8 HASHSET_u32_init_allocator(HASHSET_u32* hashset, const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    if (hashset == NULL) return 0;
+
+    u32 new_capacity = SWISS_MIN_CAPACITY;
+    while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;
+
+    hashset->allocator = allocator;
+    hashset->size = 0;
+    hashset->capacity = new_capacity;
+    hashset->tombstones = 0;
+    hashset->growth_left = SWISS_MAX_LOAD(new_capacity);
+
+    hashset->control = (u8*)NESQUIK_alloc(allocator, new_capacity);
+    hashset->entries = (HASHSET_ENTRY_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_ENTRY_u32) * new_capacity);
+    if (hashset->control == NULL || hashset->entries == NULL) {
+        NESQUIK_free(allocator, hashset->control);
+        NESQUIK_free(allocator, hashset->entries);
+        hashset->control = NULL;
+        hashset->entries = NULL;
+        hashset->capacity = 0;
+        hashset->growth_left = 0;
+        return 0;
+    }
+
+    memset(hashset->control, SWISS_CONTROL_EMPTY, new_capacity);
+
+    return 1;
+}
+
+HASHSET_u32* HASHSET_u32_create(const u32 capacity) {
+    return HASHSET_u32_create_allocator(capacity, NULL);
+}
+
+HASHSET_u32* HASHSET_u32_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    HASHSET_u32* hashset = (HASHSET_u32*)NESQUIK_alloc(allocator, sizeof(HASHSET_u32));
+    if (hashset == NULL) return NULL;
+
+    const u8 r = HASHSET_u32_init_allocator(hashset, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashset);
+        return NULL;
+    }
+
+    return hashset;
+}
+
+void HASHSET_u32_deinit(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+    hashset->size = 0;
+    hashset->capacity = 0;
+    hashset->tombstones = 0;
+    hashset->growth_left = 0;
+
+    if (hashset->control != NULL) {
+        NESQUIK_free(hashset->allocator, hashset->control);
+        hashset->control = NULL;
+    }
+
+    if (hashset->entries != NULL) {
+        NESQUIK_free(hashset->allocator, hashset->entries);
+        hashset->entries = NULL;
+    }
+}
+
+void HASHSET_u32_destroy(HASHSET_u32* hashset) {
+    if (hashset == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashset->allocator;
+    HASHSET_u32_deinit(hashset);
+    NESQUIK_free(allocator, hashset);
+}
+
+static u32 HASHSET_u32_free_slot(const HASHSET_u32* hashset, const u32 hash) {
+    const u32 group_mask = hashset->capacity / SWISS_GROUP_WIDTH - 1;
+    u32 group = SWISS_H1(hash) & group_mask;
+
+    for (u32 step = 1; ; step++) {
+        const u32 mask = SWISS_GROUP_match_empty_or_deleted(hashset->control + group * SWISS_GROUP_WIDTH);
+        if (mask != 0) return group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);
+        group = (group + step) & group_mask;
+    }
+}
+
+static HASHSET_ENTRY_u32* HASHSET_u32_probe(const HASHSET_u32* hashset,
+    const u32 hash, const u32 key) {
+
+    const u32 group_mask = hashset->capacity / SWISS_GROUP_WIDTH - 1;
+    const u8 h2 = SWISS_H2(hash);
+    u32 group = SWISS_H1(hash) & group_mask;
+
+    for (u32 step = 1; step <= group_mask + 1; step++) {
+        const u8* control = hashset->control + group * SWISS_GROUP_WIDTH;
+
+        u32 mask = SWISS_GROUP_match(control, h2);
+        while (mask != 0) {
+            HASHSET_ENTRY_u32* entry = hashset->entries + group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);
+            if (HASHSET_u32_key_equal(entry->key, key) == 1) return entry;
+            mask &= mask - 1;
+        }
+
+        if (SWISS_GROUP_match_empty(control) != 0) return NULL;
+        group = (group + step) & group_mask;
+    }
+
+    return NULL;
+}
+
+u8 HASHSET_u32_grow(HASHSET_u32* hashset) {
+    if (hashset == NULL) return 0;
+
+    u32 new_capacity = hashset->capacity;
+    if (hashset->size + 1 > SWISS_MAX_LOAD(hashset->capacity) / 2) {
+        if (hashset->capacity & 0x80000000) return 0;
+        new_capacity = hashset->capacity << 1;
+    }
+
+    HASHSET_u32 new_hashset;
+    const u8 r = HASHSET_u32_init_allocator(&new_hashset, new_capacity, hashset->allocator);
+    if (r == 0) return 0;
+
+    for (u32 i = 0; i < hashset->capacity; i++) {
+        if (hashset->control[i] & SWISS_CONTROL_EMPTY) continue;
+
+        const HASHSET_ENTRY_u32* entry = hashset->entries + i;
+        const u32 hash = HASHSET_u32_key_hash(entry->key);
+        const u32 slot = HASHSET_u32_free_slot(&new_hashset, hash);
+
+        new_hashset.control[slot] = SWISS_H2(hash);
+        new_hashset.entries[slot] = *entry;
+    }
+
+    new_hashset.size = hashset->size;
+    new_hashset.growth_left -= hashset->size;
+
+    NESQUIK_free(hashset->allocator, hashset->control);
+    NESQUIK_free(hashset->allocator, hashset->entries);
+    *hashset = new_hashset;
+
+    return 1;
+}
+
+u8 HASHSET_u32_quick_add(HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+    if (hashset->capacity == 0) return 0;
+
+    if (HASHSET_u32_probe(hashset, hash, key) != NULL) return 0;
+
+    u32 slot = HASHSET_u32_free_slot(hashset, hash);
+    if (hashset->control[slot] == SWISS_CONTROL_EMPTY && hashset->growth_left == 0) {
+        const u8 r = HASHSET_u32_grow(hashset);
+        if (r == 0) return 0;
+        slot = HASHSET_u32_free_slot(hashset, hash);
+    }
+
+    if (hashset->control[slot] == SWISS_CONTROL_EMPTY) hashset->growth_left--;
+    else hashset->tombstones--;
+
+    hashset->control[slot] = SWISS_H2(hash);
+    hashset->entries[slot].key = key;
+
+    hashset->size++;
+    return 1;
+}
+
+u8 HASHSET_u32_add(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_quick_add(hashset, hash, key);
+}
+
+void HASHSET_u32_remove(HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find(hashset, key);
+    if (entry == NULL) return;
+
+    const u32 slot = (u32)(entry - hashset->entries);
+    const u8* group = hashset->control + (slot & ~(SWISS_GROUP_WIDTH - 1));
+    if (SWISS_GROUP_match_empty(group) != 0) {
+        hashset->control[slot] = SWISS_CONTROL_EMPTY;
+        hashset->growth_left++;
+    }
+    else {
+        hashset->control[slot] = SWISS_CONTROL_DELETED;
+        hashset->tombstones++;
+    }
+
+    hashset->size--;
+}
+
+u8 HASHSET_u32_contains(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find(hashset, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find(const HASHSET_u32* hashset, const u32 key) {
+    if (hashset == NULL) return NULL;
+
+    const u32 hash = HASHSET_u32_key_hash(key);
+    return HASHSET_u32_find_hashed(hashset, hash, key);
+}
+
+u8 HASHSET_u32_contains_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return 0;
+
+    const HASHSET_ENTRY_u32* entry = HASHSET_u32_find_hashed(hashset, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHSET_ENTRY_u32* HASHSET_u32_find_hashed(const HASHSET_u32* hashset, const u32 hash, const u32 key) {
+    if (hashset == NULL) return NULL;
+    if (hashset->capacity == 0) return NULL;
+
+    return HASHSET_u32_probe(hashset, hash, key);
+}
+
+HASHSET_u32* HASHSET_u32_union(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(a->capacity + b->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        if (a->control[ai] & SWISS_CONTROL_EMPTY) continue;
+        const u32 key = a->entries[ai].key;
+        HASHSET_u32_quick_add(c, HASHSET_u32_key_hash(key), key);
+    }
+
+    for (u32 bi = 0; bi < b->capacity; bi++) {
+        if (b->control[bi] & SWISS_CONTROL_EMPTY) continue;
+        const u32 key = b->entries[bi].key;
+        HASHSET_u32_quick_add(c, HASHSET_u32_key_hash(key), key);
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_intersection(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    const HASHSET_u32* smaller;
+    const HASHSET_u32* larger;
+    if (a->capacity < b->capacity) {
+        smaller = a;
+        larger = b;
+    }
+    else {
+        smaller = b;
+        larger = a;
+    }
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(smaller->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 i = 0; i < smaller->capacity; i++) {
+        if (smaller->control[i] & SWISS_CONTROL_EMPTY) continue;
+        const u32 key = smaller->entries[i].key;
+        const u32 hash = HASHSET_u32_key_hash(key);
+        if (HASHSET_u32_contains_hashed(larger, hash, key) == 1) {
+            HASHSET_u32_quick_add(c, hash, key);
+        }
+    }
+
+    return c;
+}
+
+HASHSET_u32* HASHSET_u32_difference(const HASHSET_u32* a, const HASHSET_u32* b) {
+    if (a == NULL || b == NULL) return NULL;
+
+    HASHSET_u32* c = HASHSET_u32_create_allocator(a->capacity, a->allocator);
+    if (c == NULL) return NULL;
+
+    for (u32 ai = 0; ai < a->capacity; ai++) {
+        if (a->control[ai] & SWISS_CONTROL_EMPTY) continue;
+        const u32 key = a->entries[ai].key;
+        const u32 hash = HASHSET_u32_key_hash(key);
+        if (HASHSET_u32_contains_hashed(b, hash, key) == 0) {
+            HASHSET_u32_quick_add(c, hash, key);
+        }
+    }
+
+    return c;
+}
\ No newline at end of file
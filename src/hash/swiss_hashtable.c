@@ -0,0 +1,241 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "hash/hash.h"
+#include "hash/swiss_hashtable.h"
+
+HASHTABLE_DECLARE_SWISS(u64, u64)
+
+u8 HASHTABLE_u64_u64_init(HASHTABLE_u64_u64* hashtable, const u32 capacity) {
+    return HASHTABLE_u64_u64_init_allocator(hashtable, capacity, NULL);
+}
+
+u8 HASHTABLE_u64_u64_init_allocator(HASHTABLE_u64_u64* hashtable, const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (hashtable == NULL) return 0;
+
+    u32 new_capacity = SWISS_MIN_CAPACITY;
+    while (new_capacity < capacity && new_capacity < 0x80000000) new_capacity <<= 1;
+
+    hashtable->allocator = allocator;
+    hashtable->size = 0;
+    hashtable->capacity = new_capacity;
+    hashtable->tombstones = 0;
+    hashtable->growth_left = SWISS_MAX_LOAD(new_capacity);
+
+    hashtable->control = (u8*)NESQUIK_alloc(allocator, new_capacity);
+    hashtable->entries = (HASHTABLE_ENTRY_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_ENTRY_u64_u64) * new_capacity);
+    if (hashtable->control == NULL || hashtable->entries == NULL) {
+        NESQUIK_free(allocator, hashtable->control);
+        NESQUIK_free(allocator, hashtable->entries);
+        hashtable->control = NULL;
+        hashtable->entries = NULL;
+        hashtable->capacity = 0;
+        hashtable->growth_left = 0;
+        return 0;
+    }
+
+    memset(hashtable->control, SWISS_CONTROL_EMPTY, new_capacity);
+
+    return 1;
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create(const u32 capacity) {
+    return HASHTABLE_u64_u64_create_allocator(capacity, NULL);
+}
+
+HASHTABLE_u64_u64* HASHTABLE_u64_u64_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    HASHTABLE_u64_u64* hashtable = (HASHTABLE_u64_u64*)NESQUIK_alloc(allocator,
+        sizeof(HASHTABLE_u64_u64));
+    if (hashtable == NULL) return NULL;
+
+    const u8 r = HASHTABLE_u64_u64_init_allocator(hashtable, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hashtable);
+        return NULL;
+    }
+
+    return hashtable;
+}
+
+void HASHTABLE_u64_u64_deinit(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+    hashtable->size = 0;
+    hashtable->capacity = 0;
+    hashtable->tombstones = 0;
+    hashtable->growth_left = 0;
+
+    if (hashtable->control != NULL) {
+        NESQUIK_free(hashtable->allocator, hashtable->control);
+        hashtable->control = NULL;
+    }
+
+    if (hashtable->entries != NULL) {
+        NESQUIK_free(hashtable->allocator, hashtable->entries);
+        hashtable->entries = NULL;
+    }
+}
+
+void HASHTABLE_u64_u64_destroy(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hashtable->allocator;
+    HASHTABLE_u64_u64_deinit(hashtable);
+    NESQUIK_free(allocator, hashtable);
+}
+
+static u32 HASHTABLE_u64_u64_free_slot(const HASHTABLE_u64_u64* hashtable, const u32 hash) {
+    const u32 group_mask = hashtable->capacity / SWISS_GROUP_WIDTH - 1;
+    u32 group = SWISS_H1(hash) & group_mask;
+
+    for (u32 step = 1; ; step++) {
+        const u32 mask = SWISS_GROUP_match_empty_or_deleted(hashtable->control + group * SWISS_GROUP_WIDTH);
+        if (mask != 0) return group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);
+        group = (group + step) & group_mask;
+    }
+}
+
+static HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_probe(const HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64 key) {
+
+    const u32 group_mask = hashtable->capacity / SWISS_GROUP_WIDTH - 1;
+    const u8 h2 = SWISS_H2(hash);
+    u32 group = SWISS_H1(hash) & group_mask;
+
+    for (u32 step = 1; step <= group_mask + 1; step++) {
+        const u8* control = hashtable->control + group * SWISS_GROUP_WIDTH;
+
+        u32 mask = SWISS_GROUP_match(control, h2);
+        while (mask != 0) {
+            HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + group * SWISS_GROUP_WIDTH + SWISS_ctz(mask);
+            if (HASHTABLE_u64_u64_key_equal(entry->key, key) == 1) return entry;
+            mask &= mask - 1;
+        }
+
+        if (SWISS_GROUP_match_empty(control) != 0) return NULL;
+        group = (group + step) & group_mask;
+    }
+
+    return NULL;
+}
+
+u8 HASHTABLE_u64_u64_grow(HASHTABLE_u64_u64* hashtable) {
+    if (hashtable == NULL) return 0;
+
+    u32 new_capacity = hashtable->capacity;
+    if (hashtable->size + 1 > SWISS_MAX_LOAD(hashtable->capacity) / 2) {
+        if (hashtable->capacity & 0x80000000) return 0;
+        new_capacity = hashtable->capacity << 1;
+    }
+
+    HASHTABLE_u64_u64 new_hashtable;
+    const u8 r = HASHTABLE_u64_u64_init_allocator(&new_hashtable, new_capacity, hashtable->allocator);
+    if (r == 0) return 0;
+
+    for (u32 i = 0; i < hashtable->capacity; i++) {
+        if (hashtable->control[i] & SWISS_CONTROL_EMPTY) continue;
+
+        const HASHTABLE_ENTRY_u64_u64* entry = hashtable->entries + i;
+        const u32 hash = HASHTABLE_u64_u64_key_hash(entry->key);
+        const u32 slot = HASHTABLE_u64_u64_free_slot(&new_hashtable, hash);
+
+        new_hashtable.control[slot] = SWISS_H2(hash);
+        new_hashtable.entries[slot] = *entry;
+    }
+
+    new_hashtable.size = hashtable->size;
+    new_hashtable.growth_left -= hashtable->size;
+
+    NESQUIK_free(hashtable->allocator, hashtable->control);
+    NESQUIK_free(hashtable->allocator, hashtable->entries);
+    *hashtable = new_hashtable;
+
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_quick_add(HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+    if (hashtable->capacity == 0) return 0;
+
+    if (HASHTABLE_u64_u64_probe(hashtable, hash, key) != NULL) return 0;
+
+    u32 slot = HASHTABLE_u64_u64_free_slot(hashtable, hash);
+    if (hashtable->control[slot] == SWISS_CONTROL_EMPTY && hashtable->growth_left == 0) {
+        const u8 r = HASHTABLE_u64_u64_grow(hashtable);
+        if (r == 0) return 0;
+        slot = HASHTABLE_u64_u64_free_slot(hashtable, hash);
+    }
+
+    if (hashtable->control[slot] == SWISS_CONTROL_EMPTY) hashtable->growth_left--;
+    else hashtable->tombstones--;
+
+    hashtable->control[slot] = SWISS_H2(hash);
+    hashtable->entries[slot].key = key;
+    hashtable->entries[slot].value = value;
+
+    hashtable->size++;
+    return 1;
+}
+
+u8 HASHTABLE_u64_u64_add(HASHTABLE_u64_u64* hashtable, const u64 key, const u64 value) {
+    if (hashtable == NULL) return 0;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_quick_add(hashtable, hash, key, value);
+}
+
+void HASHTABLE_u64_u64_remove(HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return;
+
+    const u32 slot = (u32)(entry - hashtable->entries);
+    const u8* group = hashtable->control + (slot & ~(SWISS_GROUP_WIDTH - 1));
+    if (SWISS_GROUP_match_empty(group) != 0) {
+        hashtable->control[slot] = SWISS_CONTROL_EMPTY;
+        hashtable->growth_left++;
+    }
+    else {
+        hashtable->control[slot] = SWISS_CONTROL_DELETED;
+        hashtable->tombstones++;
+    }
+
+    hashtable->size--;
+}
+
+u8 HASHTABLE_u64_u64_contains(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find(hashtable, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find(const HASHTABLE_u64_u64* hashtable, const u64 key) {
+    if (hashtable == NULL) return NULL;
+
+    const u32 hash = HASHTABLE_u64_u64_key_hash(key);
+    return HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+}
+
+u8 HASHTABLE_u64_u64_contains_hashed(const HASHTABLE_u64_u64* hashtable, const u32 hash, const u64 key) {
+    if (hashtable == NULL) return 0;
+
+    const HASHTABLE_ENTRY_u64_u64* entry = HASHTABLE_u64_u64_find_hashed(hashtable, hash, key);
+    if (entry == NULL) return 0;
+    return 1;
+}
+
+HASHTABLE_ENTRY_u64_u64* HASHTABLE_u64_u64_find_hashed(const HASHTABLE_u64_u64* hashtable,
+    const u32 hash, const u64 key) {
+
+    if (hashtable == NULL) return NULL;
+    if (hashtable->capacity == 0) return NULL;
+
+    return HASHTABLE_u64_u64_probe(hashtable, hash, key);
+}
\ No newline at end of file
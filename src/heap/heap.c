@@ -3,12 +3,17 @@
 #include <stdlib.h>
 
 u8 HEAP_init(HEAP* heap, const u32 capacity) {
+    return HEAP_init_allocator(heap, capacity, NULL);
+}
+
+u8 HEAP_init_allocator(HEAP* heap, const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
     if (heap == NULL) return 0;
 
     heap->size = 0;
     heap->capacity = capacity > HEAP_MIN_CAPACITY ? capacity : HEAP_MIN_CAPACITY;
+    heap->allocator = allocator;
 
-    heap->data = (HEAP_NODE*) malloc(capacity * sizeof(HEAP_NODE));
+    heap->data = (HEAP_NODE*)NESQUIK_alloc(allocator, heap->capacity * sizeof(HEAP_NODE));
     if (heap->data == NULL) {
         heap->capacity = 0;
         return 0;
@@ -18,14 +23,18 @@ u8 HEAP_init(HEAP* heap, const u32 capacity) {
 }
 
 HEAP* HEAP_create(const u32 capacity) {
-    HEAP* heap = (HEAP*)malloc(sizeof(HEAP));
+    return HEAP_create_allocator(capacity, NULL);
+}
+
+HEAP* HEAP_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    HEAP* heap = (HEAP*)NESQUIK_alloc(allocator, sizeof(HEAP));
     if (heap == NULL) {
         return NULL;
     }
 
-    const u8 r = HEAP_init(heap, capacity);
+    const u8 r = HEAP_init_allocator(heap, capacity, allocator);
     if (r == 0) {
-        free(heap);
+        NESQUIK_free(allocator, heap);
         return NULL;
     }
 
@@ -38,7 +47,7 @@ void HEAP_deinit(HEAP* heap) {
     heap->size = 0;
     heap->capacity = 0;
     if (heap->data != NULL) {
-        free(heap->data);
+        NESQUIK_free(heap->allocator, heap->data);
         heap->data = NULL;
     }
 }
@@ -46,29 +55,20 @@ void HEAP_deinit(HEAP* heap) {
 void HEAP_destroy(HEAP* heap) {
     if (heap == NULL) return;
 
+    const NESQUIK_ALLOCATOR* allocator = heap->allocator;
     HEAP_deinit(heap);
-    free(heap);
+    NESQUIK_free(allocator, heap);
 }
 
 u8 HEAP_grow_capacity(HEAP* heap) {
     if (heap == NULL) return 0;
     if (heap->capacity == 0xFFFFFFFF) return 0;
 
-    u32 capacity = 0;
-    if (heap->capacity == 0) {
-        capacity = HEAP_MIN_CAPACITY;
-    }
-    else if (heap->capacity & (1 << 31)) capacity = 0xFFFFFFFF;
-    else {
-        for (s32 i = 30; i >= 0; i--) {
-            if ((1 << i) & capacity) {
-                capacity = 1 << (i + 1);
-                break;
-            }
-        }
-    }
+    u32 capacity = HEAP_MIN_CAPACITY;
+    if (heap->capacity & 0x80000000) capacity = 0xFFFFFFFF;
+    else if (heap->capacity != 0) capacity = heap->capacity << 1;
 
-    HEAP_NODE* data = (HEAP_NODE*)realloc(heap->data, capacity * sizeof(HEAP_NODE));
+    HEAP_NODE* data = (HEAP_NODE*)NESQUIK_realloc(heap->allocator, heap->data, capacity * sizeof(HEAP_NODE));
     if (data == NULL) {
         return 0;
     }
@@ -117,65 +117,44 @@ u8 HEAP_add(HEAP* heap, const u32 key, const char* value) {
     return 1;
 }
 
+static void HEAP_sift_down(const HEAP* heap, u32 ni) {
+    while (1) {
+        const u32 li = 2 * ni + 1;
+        const u32 ri = li + 1;
+        if (li >= heap->size) break;
+
+        u32 ci = li;
+        if (ri < heap->size && heap->data[ri].key > heap->data[li].key) ci = ri;
+        if (heap->data[ni].key >= heap->data[ci].key) break;
+
+        HEAP_swap_nodes(heap, ni, ci);
+        ni = ci;
+    }
+}
+
 u8 HEAP_remove_max(HEAP* heap, HEAP_NODE* result) {
-    if (heap == NULL) return 0;
+    if (heap == NULL || heap->size == 0) return 0;
 
-    HEAP_NODE* max_node = HEAP_max(heap);
-    result->key = max_node->key;
-    result->value = max_node->value;
+    if (result != NULL) *result = heap->data[0];
 
-    max_node->key = heap->data[heap->size - 1].key;
-    max_node->value = heap->data[heap->size - 1].value;
     heap->size--;
+    heap->data[0] = heap->data[heap->size];
+    HEAP_sift_down(heap, 0);
 
-    u32 ni = 0;
-    while (1) {
-        const u32 li = 2 * ni + 1;
-        const u32 ri = (2 * ni) + 2;
-
-        const u8 li_invalid = li >= heap->size || li < ni;
-        const u8 ri_invalid = ri >= heap->size || ri < ni;
+    return 1;
+}
 
-        if (li_invalid && ri_invalid) break;
+u8 HEAP_replace_max(HEAP* heap, const u32 key, const char* value) {
+    if (heap == NULL || heap->size == 0) return 0;
 
-        const u32 nik = heap->data[ni].key;
-        if (li_invalid) {
-            if (heap->data[ri].key > nik) HEAP_swap_nodes(heap, ni, ri);
-        }
-        else if (ri_invalid) {
-            if (heap->data[li].key > nik) HEAP_swap_nodes(heap, ni, li);
-        }
-        else {
-            const u32 rik = heap->data[ri].key;
-            const u32 lik = heap->data[li].key;
-            if (nik >= rik && nik >= lik) break;
-            if (rik > nik) {
-                if (rik >= lik) {
-                    HEAP_swap_nodes(heap, ni, ri);
-                    ni = ri;
-                }
-                else {
-                    HEAP_swap_nodes(heap, ni, li);
-                    ni = li;
-                }
-            }
-            else if (lik > nik) {
-                if (lik >= rik) {
-                    HEAP_swap_nodes(heap, ni, li);
-                    ni = li;
-                }
-                else {
-                    HEAP_swap_nodes(heap, ni, ri);
-                    ni = ri;
-                }
-            }
-        }
-    }
+    heap->data[0].key = key;
+    heap->data[0].value = value;
+    HEAP_sift_down(heap, 0);
 
     return 1;
 }
 
 HEAP_NODE* HEAP_max(const HEAP* heap) {
-    if (heap == NULL) return NULL;
+    if (heap == NULL || heap->size == 0) return NULL;
     return heap->data;
 }
\ No newline at end of file
@@ -5,12 +5,19 @@
 LIST_DECLARE(u8)
 
 u8 LIST_u8_init(LIST_u8* list, u32 capacity) {
+    return LIST_u8_init_allocator(list, capacity, NULL);
+}
+
+u8 LIST_u8_init_allocator(LIST_u8* list, u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
     if (list == NULL) return 0;
 
     list->size = 0;
     list->capacity = capacity < LIST_MIN_CAPACITY ? LIST_MIN_CAPACITY : capacity;
+    list->allocator = allocator;
 
-    list->data = (u8*)malloc(sizeof(u8) * list->capacity);
+    list->data = (u8*)NESQUIK_alloc(allocator, sizeof(u8) * list->capacity);
     if (list->data == NULL) {
         list->capacity = 0;
         return 0;
@@ -20,14 +27,20 @@ u8 LIST_u8_init(LIST_u8* list, u32 capacity) {
 }
 
 LIST_u8* LIST_u8_create(const u32 capacity) {
-    LIST_u8* list = (LIST_u8*)malloc(sizeof(LIST_u8));
+    return LIST_u8_create_allocator(capacity, NULL);
+}
+
+LIST_u8* LIST_u8_create_allocator(const u32 capacity,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    LIST_u8* list = (LIST_u8*)NESQUIK_alloc(allocator, sizeof(LIST_u8));
     if (list == NULL) {
         return NULL;
     }
 
-    const u8 r = LIST_u8_init(list, capacity);
+    const u8 r = LIST_u8_init_allocator(list, capacity, allocator);
     if (r == 0) {
-        free(list);
+        NESQUIK_free(allocator, list);
         return NULL;
     }
 
@@ -40,7 +53,7 @@ void LIST_u8_deinit(LIST_u8* list) {
     list->size = 0;
     list->capacity = 0;
     if (list->data != NULL) {
-        free(list->data);
+        NESQUIK_free(list->allocator, list->data);
         list->data = NULL;
     }
 }
@@ -48,8 +61,9 @@ void LIST_u8_deinit(LIST_u8* list) {
 void LIST_u8_destroy(LIST_u8* list) {
     if (list == NULL) return;
 
+    const NESQUIK_ALLOCATOR* allocator = list->allocator;
     LIST_u8_deinit(list);
-    free(list);
+    NESQUIK_free(allocator, list);
 }
 
 u8 LIST_u8_grow_capacity(LIST_u8* list) {
@@ -71,7 +85,7 @@ u8 LIST_u8_grow_capacity(LIST_u8* list) {
         }
     }
 
-    u8* data = realloc(list->data, sizeof(u8) * capacity);
+    u8* data = (u8*)NESQUIK_realloc(list->allocator, list->data, sizeof(u8) * capacity);
     if (data == NULL) {
         return 0;
     }
@@ -0,0 +1,65 @@
+#include "sketch/bloom.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define BLOOM_LN2 0.6931471805599453
+
+u8 BLOOM_init(BLOOM* bloom, const u32 expected, const f64 false_rate) {
+    if (bloom == NULL) return 0;
+
+    const f64 rate = false_rate > 0 && false_rate < 1 ? false_rate : BLOOM_DEFAULT_FALSE_RATE;
+    const f64 n = expected == 0 ? 1 : expected;
+
+    // Optimal bits per key and probe count of a plain Bloom filter, blocking costs a little on top
+    const f64 bits = -n * log(rate) / (BLOOM_LN2 * BLOOM_LN2);
+    const u32 hashes = (u32)(bits / n * BLOOM_LN2 + 0.5);
+
+    bloom->expected = (u32)n;
+    bloom->false_rate = rate;
+    bloom->hashes = (u8)(hashes < 1 ? 1 : hashes > BLOOM_MAX_HASHES ? BLOOM_MAX_HASHES : hashes);
+    bloom->block_count = (u32)(bits / BLOOM_BLOCK_BITS) + 1;
+
+    bloom->blocks = (u64*)aligned_alloc(BLOOM_CACHE_LINE, (size_t)bloom->block_count * BLOOM_CACHE_LINE);
+    if (bloom->blocks == NULL) {
+        bloom->block_count = 0;
+        return 0;
+    }
+
+    memset(bloom->blocks, 0, (size_t)bloom->block_count * BLOOM_CACHE_LINE);
+    return 1;
+}
+
+BLOOM* BLOOM_create(const u32 expected, const f64 false_rate) {
+    BLOOM* bloom = (BLOOM*)malloc(sizeof(BLOOM));
+    if (bloom == NULL) return NULL;
+
+    const u8 r = BLOOM_init(bloom, expected, false_rate);
+    if (r == 0) {
+        free(bloom);
+        return NULL;
+    }
+
+    return bloom;
+}
+
+void BLOOM_deinit(BLOOM* bloom) {
+    if (bloom == NULL) return;
+
+    free(bloom->blocks);
+    bloom->blocks = NULL;
+    bloom->block_count = 0;
+}
+
+void BLOOM_destroy(BLOOM* bloom) {
+    if (bloom == NULL) return;
+
+    BLOOM_deinit(bloom);
+    free(bloom);
+}
+
+void BLOOM_clear(BLOOM* bloom) {
+    if (bloom == NULL || bloom->blocks == NULL) return;
+    memset(bloom->blocks, 0, (size_t)bloom->block_count * BLOOM_CACHE_LINE);
+}
\ No newline at end of file
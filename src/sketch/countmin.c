@@ -0,0 +1,282 @@
+#include "sketch/countmin.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define COUNTMIN_E 2.718281828459045
+
+HASHTABLE_DEFINE(COUNTMIN_KEY, u32)
+
+// Row i probes h1 + i * h2 (Kirsch-Mitzenmacher), reduced to the width by multiply-shift
+static inline u32 COUNTMIN_column(const COUNTMIN* countmin, const u64 hash, const u32 row) {
+    const u32 h = (u32)hash + row * ((u32)(hash >> 32) | 1);
+    return (u32)(((u64)h * countmin->width) >> 32);
+}
+
+static inline u32 COUNTMIN_saturating_add(const u32 a, const u32 b) {
+    return a > 0xFFFFFFFF - b ? 0xFFFFFFFF : a + b;
+}
+
+u8 COUNTMIN_init(COUNTMIN* countmin, const f64 epsilon, const f64 delta) {
+    return COUNTMIN_init_allocator(countmin, epsilon, delta, NULL);
+}
+
+u8 COUNTMIN_init_allocator(COUNTMIN* countmin, const f64 epsilon, const f64 delta,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (countmin == NULL) return 0;
+
+    const f64 e = epsilon > 0 && epsilon < 1 ? epsilon : COUNTMIN_DEFAULT_EPSILON;
+    const f64 d = delta > 0 && delta < 1 ? delta : COUNTMIN_DEFAULT_DELTA;
+
+    const f64 width = ceil(COUNTMIN_E / e);
+    const f64 depth = ceil(log(1 / d));
+
+    countmin->width = width < COUNTMIN_MIN_WIDTH ? COUNTMIN_MIN_WIDTH : (u32)width;
+    countmin->depth = depth < 1 ? 1 : depth > COUNTMIN_MAX_DEPTH ? COUNTMIN_MAX_DEPTH : (u32)depth;
+    countmin->total = 0;
+    countmin->allocator = allocator;
+
+    countmin->counters = (u32*)NESQUIK_calloc(allocator, (size_t)countmin->width * countmin->depth, sizeof(u32));
+    if (countmin->counters == NULL) {
+        countmin->width = 0;
+        countmin->depth = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+COUNTMIN* COUNTMIN_create(const f64 epsilon, const f64 delta) {
+    return COUNTMIN_create_allocator(epsilon, delta, NULL);
+}
+
+COUNTMIN* COUNTMIN_create_allocator(const f64 epsilon, const f64 delta, const NESQUIK_ALLOCATOR* allocator) {
+    COUNTMIN* countmin = (COUNTMIN*)NESQUIK_alloc(allocator, sizeof(COUNTMIN));
+    if (countmin == NULL) return NULL;
+
+    const u8 r = COUNTMIN_init_allocator(countmin, epsilon, delta, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, countmin);
+        return NULL;
+    }
+
+    return countmin;
+}
+
+void COUNTMIN_deinit(COUNTMIN* countmin) {
+    if (countmin == NULL) return;
+
+    NESQUIK_free(countmin->allocator, countmin->counters);
+    countmin->counters = NULL;
+    countmin->width = 0;
+    countmin->depth = 0;
+    countmin->total = 0;
+}
+
+void COUNTMIN_destroy(COUNTMIN* countmin) {
+    if (countmin == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = countmin->allocator;
+    COUNTMIN_deinit(countmin);
+    NESQUIK_free(allocator, countmin);
+}
+
+void COUNTMIN_clear(COUNTMIN* countmin) {
+    if (countmin == NULL || countmin->counters == NULL) return;
+
+    memset(countmin->counters, 0, (size_t)countmin->width * countmin->depth * sizeof(u32));
+    countmin->total = 0;
+}
+
+u32 COUNTMIN_add_hash(COUNTMIN* countmin, const u64 hash, const u32 count) {
+    if (countmin == NULL || countmin->counters == NULL) return 0;
+
+    // Conservative update: only the counters below the new estimate are raised, to exactly that estimate
+    const u32 estimate = COUNTMIN_saturating_add(COUNTMIN_estimate_hash(countmin, hash), count);
+    for (u32 row = 0; row < countmin->depth; row++) {
+        u32* counter = countmin->counters + (size_t)row * countmin->width + COUNTMIN_column(countmin, hash, row);
+        if (*counter < estimate) *counter = estimate;
+    }
+
+    const u64 total = countmin->total + count;
+    countmin->total = total < countmin->total ? 0xFFFFFFFFFFFFFFFFULL : total;
+    return estimate;
+}
+
+u32 COUNTMIN_add(COUNTMIN* countmin, const u8* data, const u32 size, const u32 count) {
+    return COUNTMIN_add_hash(countmin, HASH_wide32(data, size), count);
+}
+
+// Same hash as _add over the key's bytes, so counts added through either entry point estimate through the other
+u32 COUNTMIN_add_u64(COUNTMIN* countmin, const u64 key, const u32 count) {
+    return COUNTMIN_add(countmin, (const u8*)&key, sizeof(key), count);
+}
+
+u32 COUNTMIN_estimate_hash(const COUNTMIN* countmin, const u64 hash) {
+    if (countmin == NULL || countmin->counters == NULL) return 0;
+
+    u32 estimate = 0xFFFFFFFF;
+    for (u32 row = 0; row < countmin->depth; row++) {
+        const u32 counter = countmin->counters[(size_t)row * countmin->width + COUNTMIN_column(countmin, hash, row)];
+        estimate = counter < estimate ? counter : estimate;
+    }
+
+    return estimate;
+}
+
+u32 COUNTMIN_estimate(const COUNTMIN* countmin, const u8* data, const u32 size) {
+    return COUNTMIN_estimate_hash(countmin, HASH_wide32(data, size));
+}
+
+u32 COUNTMIN_estimate_u64(const COUNTMIN* countmin, const u64 key) {
+    return COUNTMIN_estimate(countmin, (const u8*)&key, sizeof(key));
+}
+
+u8 COUNTMIN_merge(COUNTMIN* destination, const COUNTMIN* source) {
+    if (destination == NULL || source == NULL) return 0;
+    if (destination->counters == NULL || source->counters == NULL) return 0;
+    if (destination->width != source->width || destination->depth != source->depth) return 0;
+
+    const size_t n = (size_t)destination->width * destination->depth;
+    for (size_t i = 0; i < n; i++)
+        destination->counters[i] = COUNTMIN_saturating_add(destination->counters[i], source->counters[i]);
+
+    const u64 total = destination->total + source->total;
+    destination->total = total < destination->total ? 0xFFFFFFFFFFFFFFFFULL : total;
+    return 1;
+}
+
+u8 COUNTMIN_TOPK_init(COUNTMIN_TOPK* topk, const u32 k, const f64 epsilon, const f64 delta) {
+    return COUNTMIN_TOPK_init_allocator(topk, k, epsilon, delta, NULL);
+}
+
+u8 COUNTMIN_TOPK_init_allocator(COUNTMIN_TOPK* topk, const u32 k, const f64 epsilon, const f64 delta,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    if (topk == NULL || k == 0) return 0;
+
+    topk->k = k;
+    topk->allocator = allocator;
+    topk->items = NULL;
+    topk->heap.data = NULL;
+    memset(&topk->index, 0, sizeof(topk->index));
+
+    u8 r = COUNTMIN_init_allocator(&topk->sketch, epsilon, delta, allocator);
+    if (r == 0) return 0;
+
+    // The heap never grows past k. The index holds at most k keys below HASHTABLE_MIN_LOAD_FACTOR, so the
+    // tombstones left by evictions are purged in place and never trigger a grow, memory is fixed from here on
+    topk->items = (COUNTMIN_ITEM*)NESQUIK_alloc(allocator, sizeof(COUNTMIN_ITEM) * k);
+    r = topk->items != NULL && HEAP_init_allocator(&topk->heap, k, allocator);
+    r = r && HASHTABLE_COUNTMIN_KEY_u32_init_allocator(&topk->index, (u32)(k / HASHTABLE_MIN_LOAD_FACTOR) + 1,
+        allocator);
+    if (r == 0) {
+        COUNTMIN_TOPK_deinit(topk);
+        return 0;
+    }
+
+    return 1;
+}
+
+COUNTMIN_TOPK* COUNTMIN_TOPK_create(const u32 k, const f64 epsilon, const f64 delta) {
+    return COUNTMIN_TOPK_create_allocator(k, epsilon, delta, NULL);
+}
+
+COUNTMIN_TOPK* COUNTMIN_TOPK_create_allocator(const u32 k, const f64 epsilon, const f64 delta,
+    const NESQUIK_ALLOCATOR* allocator) {
+
+    COUNTMIN_TOPK* topk = (COUNTMIN_TOPK*)NESQUIK_alloc(allocator, sizeof(COUNTMIN_TOPK));
+    if (topk == NULL) return NULL;
+
+    const u8 r = COUNTMIN_TOPK_init_allocator(topk, k, epsilon, delta, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, topk);
+        return NULL;
+    }
+
+    return topk;
+}
+
+void COUNTMIN_TOPK_deinit(COUNTMIN_TOPK* topk) {
+    if (topk == NULL) return;
+
+    COUNTMIN_deinit(&topk->sketch);
+    HEAP_deinit(&topk->heap);
+    HASHTABLE_COUNTMIN_KEY_u32_deinit(&topk->index);
+    NESQUIK_free(topk->allocator, topk->items);
+    topk->items = NULL;
+    topk->k = 0;
+}
+
+void COUNTMIN_TOPK_destroy(COUNTMIN_TOPK* topk) {
+    if (topk == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = topk->allocator;
+    COUNTMIN_TOPK_deinit(topk);
+    NESQUIK_free(allocator, topk);
+}
+
+u8 COUNTMIN_TOPK_add(COUNTMIN_TOPK* topk, const u64 key, const u32 count) {
+    if (topk == NULL || topk->items == NULL) return 0;
+
+    const u32 estimate = COUNTMIN_add_u64(&topk->sketch, key, count);
+
+    const HASHTABLE_ENTRY_COUNTMIN_KEY_u32* entry = HASHTABLE_COUNTMIN_KEY_u32_find(&topk->index, key);
+    if (entry != NULL) {
+        topk->items[entry->value].count = estimate;
+        return 1;
+    }
+
+    if (topk->heap.size < topk->k) {
+        const u32 slot = topk->heap.size;
+        topk->items[slot].key = key;
+        topk->items[slot].count = estimate;
+        if (HASHTABLE_COUNTMIN_KEY_u32_add(&topk->index, key, slot) == 0) return 0;
+        return HEAP_add(&topk->heap, ~estimate, (const char*)(topk->items + slot));
+    }
+
+    for (;;) {
+        const HEAP_NODE* root = HEAP_max(&topk->heap);
+        COUNTMIN_ITEM* item = (COUNTMIN_ITEM*)root->value;
+
+        // The heap key is a stale lower bound of the item's count, a root at least as heavy keeps its place
+        if (~root->key >= estimate) return 1;
+        if (item->count > ~root->key) {
+            HEAP_replace_max(&topk->heap, ~item->count, root->value);
+            continue;
+        }
+
+        HASHTABLE_COUNTMIN_KEY_u32_remove(&topk->index, item->key);
+        if (HASHTABLE_COUNTMIN_KEY_u32_add(&topk->index, key, (u32)(item - topk->items)) == 0) return 0;
+
+        item->key = key;
+        item->count = estimate;
+        return HEAP_replace_max(&topk->heap, ~estimate, (const char*)item);
+    }
+}
+
+u32 COUNTMIN_TOPK_estimate(const COUNTMIN_TOPK* topk, const u64 key) {
+    if (topk == NULL) return 0;
+    return COUNTMIN_estimate_u64(&topk->sketch, key);
+}
+
+static int COUNTMIN_item_compare(const void* a, const void* b) {
+    const u32 ac = ((const COUNTMIN_ITEM*)a)->count;
+    const u32 bc = ((const COUNTMIN_ITEM*)b)->count;
+    return ac < bc ? 1 : ac > bc ? -1 : 0;
+}
+
+u32 COUNTMIN_TOPK_list(const COUNTMIN_TOPK* topk, COUNTMIN_ITEM* out) {
+    if (topk == NULL || out == NULL || topk->items == NULL) return 0;
+
+    const u32 n = topk->heap.size;
+    for (u32 i = 0; i < n; i++) {
+        out[i].key = topk->items[i].key;
+        out[i].count = COUNTMIN_estimate_u64(&topk->sketch, topk->items[i].key);
+    }
+
+    qsort(out, n, sizeof(COUNTMIN_ITEM), COUNTMIN_item_compare);
+    return n;
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include "sketch/hyperloglog.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HYPERLOGLOG_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define HYPERLOGLOG_NEON
+#include <arm_neon.h>
+#endif
+
+// Highest rank a register can hold, 64 - precision bits of the hash plus one
+#define HYPERLOGLOG_MAX_RANK 64
+
+static inline u32 HYPERLOGLOG_register_count(const HYPERLOGLOG* hyperloglog) {
+    return 1u << hyperloglog->precision;
+}
+
+static inline u32 HYPERLOGLOG_sparse_slot(const u32 index, const u32 capacity) {
+    return (u32)(((u64)index * HASH_WIDE_PRIME_1) >> 32) & (capacity - 1);
+}
+
+u8 HYPERLOGLOG_init(HYPERLOGLOG* hyperloglog, const u8 precision) {
+    return HYPERLOGLOG_init_allocator(hyperloglog, precision, NULL);
+}
+
+u8 HYPERLOGLOG_init_allocator(HYPERLOGLOG* hyperloglog, const u8 precision, const NESQUIK_ALLOCATOR* allocator) {
+    if (hyperloglog == NULL) return 0;
+
+    u8 p = precision == 0 ? HYPERLOGLOG_DEFAULT_PRECISION : precision;
+    p = p < HYPERLOGLOG_MIN_PRECISION ? HYPERLOGLOG_MIN_PRECISION : p;
+    p = p > HYPERLOGLOG_MAX_PRECISION ? HYPERLOGLOG_MAX_PRECISION : p;
+
+    hyperloglog->precision = p;
+    hyperloglog->representation = HYPERLOGLOG_REPRESENTATION_SPARSE;
+    hyperloglog->registers = NULL;
+    hyperloglog->sparse_size = 0;
+    hyperloglog->sparse_capacity = HYPERLOGLOG_SPARSE_MIN_CAPACITY;
+    hyperloglog->allocator = allocator;
+
+    // Low precisions have so few registers that even the smallest sparse table would not save memory
+    if (sizeof(u32) * HYPERLOGLOG_SPARSE_MIN_CAPACITY * 2 > HYPERLOGLOG_register_count(hyperloglog) / 2) {
+        hyperloglog->sparse = NULL;
+        hyperloglog->sparse_capacity = 0;
+        hyperloglog->registers = (u8*)NESQUIK_calloc(allocator, HYPERLOGLOG_register_count(hyperloglog), sizeof(u8));
+        hyperloglog->representation = HYPERLOGLOG_REPRESENTATION_DENSE;
+        return hyperloglog->registers != NULL;
+    }
+
+    hyperloglog->sparse = (u32*)NESQUIK_calloc(allocator, hyperloglog->sparse_capacity, sizeof(u32));
+    if (hyperloglog->sparse == NULL) {
+        hyperloglog->sparse_capacity = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+HYPERLOGLOG* HYPERLOGLOG_create(const u8 precision) {
+    return HYPERLOGLOG_create_allocator(precision, NULL);
+}
+
+HYPERLOGLOG* HYPERLOGLOG_create_allocator(const u8 precision, const NESQUIK_ALLOCATOR* allocator) {
+    HYPERLOGLOG* hyperloglog = (HYPERLOGLOG*)NESQUIK_alloc(allocator, sizeof(HYPERLOGLOG));
+    if (hyperloglog == NULL) return NULL;
+
+    const u8 r = HYPERLOGLOG_init_allocator(hyperloglog, precision, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, hyperloglog);
+        return NULL;
+    }
+
+    return hyperloglog;
+}
+
+void HYPERLOGLOG_deinit(HYPERLOGLOG* hyperloglog) {
+    if (hyperloglog == NULL) return;
+
+    NESQUIK_free(hyperloglog->allocator, hyperloglog->registers);
+    NESQUIK_free(hyperloglog->allocator, hyperloglog->sparse);
+    hyperloglog->registers = NULL;
+    hyperloglog->sparse = NULL;
+    hyperloglog->sparse_size = 0;
+    hyperloglog->sparse_capacity = 0;
+}
+
+void HYPERLOGLOG_destroy(HYPERLOGLOG* hyperloglog) {
+    if (hyperloglog == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = hyperloglog->allocator;
+    HYPERLOGLOG_deinit(hyperloglog);
+    NESQUIK_free(allocator, hyperloglog);
+}
+
+void HYPERLOGLOG_clear(HYPERLOGLOG* hyperloglog) {
+    if (hyperloglog == NULL) return;
+
+    if (hyperloglog->registers != NULL) memset(hyperloglog->registers, 0, HYPERLOGLOG_register_count(hyperloglog));
+    if (hyperloglog->sparse != NULL) memset(hyperloglog->sparse, 0, sizeof(u32) * hyperloglog->sparse_capacity);
+    hyperloglog->sparse_size = 0;
+}
+
+static u8 HYPERLOGLOG_densify(HYPERLOGLOG* hyperloglog) {
+    u8* registers = (u8*)NESQUIK_calloc(hyperloglog->allocator, HYPERLOGLOG_register_count(hyperloglog), sizeof(u8));
+    if (registers == NULL) return 0;
+
+    for (u32 i = 0; i < hyperloglog->sparse_capacity; i++) {
+        const u32 entry = hyperloglog->sparse[i];
+        if (entry != 0) registers[(entry >> 8) - 1] = (u8)(entry & 0xFF);
+    }
+
+    NESQUIK_free(hyperloglog->allocator, hyperloglog->sparse);
+    hyperloglog->sparse = NULL;
+    hyperloglog->sparse_size = 0;
+    hyperloglog->sparse_capacity = 0;
+
+    hyperloglog->registers = registers;
+    hyperloglog->representation = HYPERLOGLOG_REPRESENTATION_DENSE;
+    return 1;
+}
+
+static u8 HYPERLOGLOG_sparse_grow(HYPERLOGLOG* hyperloglog) {
+    const u32 capacity = hyperloglog->sparse_capacity * 2;
+    u32* sparse = (u32*)NESQUIK_calloc(hyperloglog->allocator, capacity, sizeof(u32));
+    if (sparse == NULL) return 0;
+
+    for (u32 i = 0; i < hyperloglog->sparse_capacity; i++) {
+        const u32 entry = hyperloglog->sparse[i];
+        if (entry == 0) continue;
+
+        u32 j = HYPERLOGLOG_sparse_slot(entry >> 8, capacity);
+        while (sparse[j] != 0) j = (j + 1) & (capacity - 1);
+        sparse[j] = entry;
+    }
+
+    NESQUIK_free(hyperloglog->allocator, hyperloglog->sparse);
+    hyperloglog->sparse = sparse;
+    hyperloglog->sparse_capacity = capacity;
+    return 1;
+}
+
+// Raises one register to rank, in whichever representation the sketch is in
+static u8 HYPERLOGLOG_update(HYPERLOGLOG* hyperloglog, const u32 index, const u8 rank) {
+    if (hyperloglog->representation == HYPERLOGLOG_REPRESENTATION_DENSE) {
+        u8* reg = hyperloglog->registers + index;
+        if (*reg < rank) *reg = rank;
+        return 1;
+    }
+
+    const u32 key = index + 1;
+    u32 j = HYPERLOGLOG_sparse_slot(key, hyperloglog->sparse_capacity);
+    while (hyperloglog->sparse[j] != 0 && (hyperloglog->sparse[j] >> 8) != key)
+        j = (j + 1) & (hyperloglog->sparse_capacity - 1);
+
+    u32* entry = hyperloglog->sparse + j;
+    if (*entry != 0) {
+        if ((*entry & 0xFF) < rank) *entry = (key << 8) | rank;
+        return 1;
+    }
+
+    *entry = (key << 8) | rank;
+    hyperloglog->sparse_size++;
+
+    // The table stays at most half full and at most half the size of the dense registers
+    if (hyperloglog->sparse_size * 2 < hyperloglog->sparse_capacity) return 1;
+    if (sizeof(u32) * hyperloglog->sparse_capacity * 2 > HYPERLOGLOG_register_count(hyperloglog) / 2)
+        return HYPERLOGLOG_densify(hyperloglog);
+    return HYPERLOGLOG_sparse_grow(hyperloglog);
+}
+
+u8 HYPERLOGLOG_add_hash(HYPERLOGLOG* hyperloglog, const u64 hash) {
+    if (hyperloglog == NULL) return 0;
+
+    const u8 p = hyperloglog->precision;
+    const u32 index = (u32)(hash >> (64 - p));
+
+    // The guard bit caps the rank at 64 - p + 1 when the remaining bits are all zero
+    const u64 rest = (hash << p) | (1ULL << (p - 1));
+    const u8 rank = (u8)(__builtin_clzll(rest) + 1);
+
+    return HYPERLOGLOG_update(hyperloglog, index, rank);
+}
+
+u8 HYPERLOGLOG_add(HYPERLOGLOG* hyperloglog, const u8* data, const u32 size) {
+    return HYPERLOGLOG_add_hash(hyperloglog, HASH_wide32(data, size));
+}
+
+// Same hash as _add over the key's bytes, so both entry points fill and merge the same registers
+u8 HYPERLOGLOG_add_u64(HYPERLOGLOG* hyperloglog, const u64 key) {
+    return HYPERLOGLOG_add(hyperloglog, (const u8*)&key, sizeof(key));
+}
+
+static void HYPERLOGLOG_max_scalar(u8* destination, const u8* source, const u32 n) {
+    for (u32 i = 0; i < n; i++) destination[i] = destination[i] < source[i] ? source[i] : destination[i];
+}
+
+#ifdef HYPERLOGLOG_X86
+__attribute__((target("sse2")))
+static void HYPERLOGLOG_max_sse2(u8* destination, const u8* source, const u32 n) {
+    for (u32 i = 0; i < n; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(destination + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(source + i));
+        _mm_storeu_si128((__m128i*)(destination + i), _mm_max_epu8(a, b));
+    }
+}
+
+__attribute__((target("avx2")))
+static void HYPERLOGLOG_max_avx2(u8* destination, const u8* source, const u32 n) {
+    for (u32 i = 0; i < n; i += 32) {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(destination + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(source + i));
+        _mm256_storeu_si256((__m256i*)(destination + i), _mm256_max_epu8(a, b));
+    }
+}
+#endif
+
+#ifdef HYPERLOGLOG_NEON
+static void HYPERLOGLOG_max_neon(u8* destination, const u8* source, const u32 n) {
+    for (u32 i = 0; i < n; i += 16) vst1q_u8(destination + i, vmaxq_u8(vld1q_u8(destination + i), vld1q_u8(source + i)));
+}
+#endif
+
+// Register counts are powers of two of at least 16, the SIMD loops need no tail.
+// Follows the kernel the hash layer picked (or was pinned to with HASH_wide_set_kernel).
+static void HYPERLOGLOG_max(u8* destination, const u8* source, const u32 n) {
+    switch (HASH_wide_kernel()) {
+#ifdef HYPERLOGLOG_X86
+        case HASH_KERNEL_AVX2:
+            if (n >= 32) {
+                HYPERLOGLOG_max_avx2(destination, source, n);
+                return;
+            }
+            HYPERLOGLOG_max_sse2(destination, source, n);
+            return;
+        case HASH_KERNEL_SSE2: HYPERLOGLOG_max_sse2(destination, source, n); return;
+#endif
+#ifdef HYPERLOGLOG_NEON
+        case HASH_KERNEL_NEON: HYPERLOGLOG_max_neon(destination, source, n); return;
+#endif
+        default: HYPERLOGLOG_max_scalar(destination, source, n); return;
+    }
+}
+
+u8 HYPERLOGLOG_merge(HYPERLOGLOG* destination, const HYPERLOGLOG* source) {
+    if (destination == NULL || source == NULL) return 0;
+    if (destination->precision != source->precision) return 0;
+    if (destination == source) return 1;
+
+    if (source->representation == HYPERLOGLOG_REPRESENTATION_SPARSE) {
+        for (u32 i = 0; i < source->sparse_capacity; i++) {
+            const u32 entry = source->sparse[i];
+            if (entry == 0) continue;
+            if (HYPERLOGLOG_update(destination, (entry >> 8) - 1, (u8)(entry & 0xFF)) == 0) return 0;
+        }
+
+        return 1;
+    }
+
+    if (destination->representation == HYPERLOGLOG_REPRESENTATION_SPARSE && HYPERLOGLOG_densify(destination) == 0)
+        return 0;
+
+    HYPERLOGLOG_max(destination->registers, source->registers, HYPERLOGLOG_register_count(destination));
+    return 1;
+}
+
+f64 HYPERLOGLOG_estimate(const HYPERLOGLOG* hyperloglog) {
+    if (hyperloglog == NULL) return 0;
+
+    const u32 m = HYPERLOGLOG_register_count(hyperloglog);
+
+    // Sparse sketches have most registers at zero, where linear counting is the accurate estimator
+    if (hyperloglog->representation == HYPERLOGLOG_REPRESENTATION_SPARSE) {
+        const u32 zeros = m - hyperloglog->sparse_size;
+        return m * log((f64)m / zeros);
+    }
+
+    // A histogram of the ranks keeps the register pass a plain byte scan
+    u32 histogram[HYPERLOGLOG_MAX_RANK + 1] = {0};
+    for (u32 i = 0; i < m; i++) histogram[hyperloglog->registers[i]]++;
+
+    f64 sum = 0;
+    for (u32 r = HYPERLOGLOG_MAX_RANK; r > 0; r--) sum = (sum + histogram[r]) * 0.5;
+    sum += histogram[0];
+
+    const f64 alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+    const f64 estimate = alpha * m * m / sum;
+
+    if (estimate <= 2.5 * m && histogram[0] != 0) return m * log((f64)m / histogram[0]);
+    return estimate;
+}
+
+u32 HYPERLOGLOG_bytes(const HYPERLOGLOG* hyperloglog) {
+    if (hyperloglog == NULL) return 0;
+
+    if (hyperloglog->representation == HYPERLOGLOG_REPRESENTATION_DENSE) return HYPERLOGLOG_register_count(hyperloglog);
+    return sizeof(u32) * hyperloglog->sparse_capacity;
+}
\ No newline at end of file
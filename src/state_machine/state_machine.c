@@ -11,8 +11,7 @@ u8 STATE_MACHINE_init(STATE_MACHINE* state_machine, u8* buf, const u32 buf_len)
     state_machine->buf_len = buf_len;
 
     const u8 r = POINTER_HASHTABLE_STATE_TRANSITION_F_init(
-        &(state_machine->state_transition_table), 8,
-        STATE_key_size, STATE_key_equal);
+        &(state_machine->state_transition_table), 8, NULL, NULL);
 
     if (r == 0) return 0;
 
@@ -89,12 +88,4 @@ STATE* STATE_MACHINE_run(STATE_MACHINE* state_machine, void* context) {
     }
 
     return curr_state;
-}
-
-u32 STATE_key_size(const STATE* state) {
-    return sizeof(STATE);
-}
-
-u8 STATE_key_equal(const STATE* a, const STATE* b) {
-    return a->name == b->name && a->type == b->type;
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "string/interner.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+POINTER_HASHSET_DEFINE(INTERNED)
+
+// Arena allocations keep the alignment of the INTERNED headers they start with
+#define INTERNER_ALIGN(size) (((size) + sizeof(void*) - 1) & ~(u64)(sizeof(void*) - 1))
+
+u8 INTERNER_init(INTERNER* interner, const u32 capacity) {
+    return INTERNER_init_allocator(interner, capacity, NULL);
+}
+
+u8 INTERNER_init_allocator(INTERNER* interner, const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    if (interner == NULL) return 0;
+
+    interner->blocks = NULL;
+    interner->block_size = INTERNER_MIN_BLOCK_SIZE;
+    interner->bytes = 0;
+    interner->allocator = allocator;
+
+    const u32 n = (u32)(capacity / POINTER_HASHSET_MAX_LOAD_FACTOR) + 1;
+    return POINTER_HASHSET_INTERNED_init_allocator(&interner->strings, n, NULL, NULL, allocator);
+}
+
+INTERNER* INTERNER_create(const u32 capacity) {
+    return INTERNER_create_allocator(capacity, NULL);
+}
+
+INTERNER* INTERNER_create_allocator(const u32 capacity, const NESQUIK_ALLOCATOR* allocator) {
+    INTERNER* interner = (INTERNER*)NESQUIK_alloc(allocator, sizeof(INTERNER));
+    if (interner == NULL) return NULL;
+
+    const u8 r = INTERNER_init_allocator(interner, capacity, allocator);
+    if (r == 0) {
+        NESQUIK_free(allocator, interner);
+        return NULL;
+    }
+
+    return interner;
+}
+
+void INTERNER_deinit(INTERNER* interner) {
+    if (interner == NULL) return;
+
+    POINTER_HASHSET_INTERNED_deinit(&interner->strings);
+
+    INTERNER_BLOCK* block = interner->blocks;
+    while (block != NULL) {
+        INTERNER_BLOCK* next = block->next;
+        NESQUIK_free(interner->allocator, block);
+        block = next;
+    }
+
+    interner->blocks = NULL;
+    interner->block_size = 0;
+    interner->bytes = 0;
+}
+
+void INTERNER_destroy(INTERNER* interner) {
+    if (interner == NULL) return;
+
+    const NESQUIK_ALLOCATOR* allocator = interner->allocator;
+    INTERNER_deinit(interner);
+    NESQUIK_free(allocator, interner);
+}
+
+static void* INTERNER_allocate(INTERNER* interner, const u64 size) {
+    INTERNER_BLOCK* block = interner->blocks;
+    const u64 header = INTERNER_ALIGN(sizeof(INTERNER_BLOCK));
+
+    if (block == NULL || block->capacity - block->used < size) {
+        const u8 oversized = size > interner->block_size;
+        const u64 capacity = oversized == 1 ? size : interner->block_size;
+        if (capacity > 0xFFFFFFFF) return NULL;
+
+        block = (INTERNER_BLOCK*)NESQUIK_alloc(interner->allocator, header + capacity);
+        if (block == NULL) return NULL;
+
+        block->used = 0;
+        block->capacity = (u32)capacity;
+
+        // An oversized string gets a block of its own behind the current one, which keeps its free tail
+        if (oversized == 1 && interner->blocks != NULL) {
+            block->next = interner->blocks->next;
+            interner->blocks->next = block;
+        } else {
+            block->next = interner->blocks;
+            interner->blocks = block;
+            if (interner->block_size < INTERNER_MAX_BLOCK_SIZE) interner->block_size <<= 1;
+        }
+    }
+
+    void* address = (u8*)block + header + block->used;
+    block->used += (u32)size;
+    interner->bytes += size;
+    return address;
+}
+
+INTERNED* INTERNER_intern(INTERNER* interner, const char* data, const u32 size) {
+    if (interner == NULL || data == NULL) return NULL;
+
+    const INTERNED probe = { .hash = HASH_wide((const u8*)data, size), .size = size, .data = data };
+
+    const POINTER_HASHSET_ENTRY_INTERNED* entry =
+        POINTER_HASHSET_INTERNED_find_hashed(&interner->strings, probe.hash, &probe);
+    if (entry != NULL) return entry->key;
+
+    INTERNED* string = (INTERNED*)INTERNER_allocate(interner, INTERNER_ALIGN(sizeof(INTERNED) + (u64)size + 1));
+    if (string == NULL) return NULL;
+
+    char* bytes = (char*)(string + 1);
+    if (size > 0) memcpy(bytes, data, size);
+    bytes[size] = '\0';
+
+    string->hash = probe.hash;
+    string->size = size;
+    string->data = bytes;
+
+    // On failure the bytes stay in the arena unreferenced until deinit
+    const u8 r = POINTER_HASHSET_INTERNED_quick_add(&interner->strings, string->hash, string);
+    if (r == 0) return NULL;
+
+    return string;
+}
+
+INTERNED* INTERNER_intern_cstr(INTERNER* interner, const char* string) {
+    if (string == NULL) return NULL;
+    return INTERNER_intern(interner, string, (u32)strlen(string));
+}
+
+INTERNED* INTERNER_find(const INTERNER* interner, const char* data, const u32 size) {
+    if (interner == NULL || data == NULL) return NULL;
+
+    const INTERNED probe = { .hash = HASH_wide((const u8*)data, size), .size = size, .data = data };
+
+    const POINTER_HASHSET_ENTRY_INTERNED* entry =
+        POINTER_HASHSET_INTERNED_find_hashed(&interner->strings, probe.hash, &probe);
+    if (entry == NULL) return NULL;
+
+    return entry->key;
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "thread/epoch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+u8 EPOCH_init(EPOCH* epoch, const u32 max_threads) {
+    if (epoch == NULL) return 0;
+
+    epoch->record_count = max_threads == 0 ? EPOCH_DEFAULT_THREADS : max_threads;
+    atomic_init(&epoch->global, 1);
+    atomic_init(&epoch->registered, 0);
+
+    epoch->retired = NULL;
+    epoch->retired_size = 0;
+    epoch->retired_capacity = 0;
+    epoch->free_count = 0;
+
+    epoch->records = (EPOCH_RECORD*)aligned_alloc(EPOCH_CACHE_LINE, sizeof(EPOCH_RECORD) * epoch->record_count);
+    epoch->free_records = (u32*)malloc(sizeof(u32) * epoch->record_count);
+    if (epoch->records == NULL || epoch->free_records == NULL) {
+        free(epoch->records);
+        free(epoch->free_records);
+        epoch->records = NULL;
+        epoch->free_records = NULL;
+        epoch->record_count = 0;
+        return 0;
+    }
+
+    for (u32 i = 0; i < epoch->record_count; i++) atomic_init(&epoch->records[i].epoch, EPOCH_QUIESCENT);
+
+    if (pthread_mutex_init(&epoch->mutex, NULL) != 0) {
+        free(epoch->records);
+        free(epoch->free_records);
+        epoch->records = NULL;
+        epoch->free_records = NULL;
+        epoch->record_count = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+EPOCH* EPOCH_create(const u32 max_threads) {
+    EPOCH* epoch = (EPOCH*)aligned_alloc(EPOCH_CACHE_LINE, sizeof(EPOCH));
+    if (epoch == NULL) return NULL;
+
+    const u8 r = EPOCH_init(epoch, max_threads);
+    if (r == 0) {
+        free(epoch);
+        return NULL;
+    }
+
+    return epoch;
+}
+
+void EPOCH_deinit(EPOCH* epoch) {
+    if (epoch == NULL) return;
+
+    for (u32 i = 0; i < epoch->retired_size; i++) {
+        const EPOCH_RETIRED* retired = epoch->retired + i;
+        retired->free_f(retired->pointer);
+    }
+
+    free(epoch->retired);
+    epoch->retired = NULL;
+    epoch->retired_size = 0;
+    epoch->retired_capacity = 0;
+
+    free(epoch->records);
+    free(epoch->free_records);
+    epoch->records = NULL;
+    epoch->free_records = NULL;
+    epoch->record_count = 0;
+    epoch->free_count = 0;
+
+    pthread_mutex_destroy(&epoch->mutex);
+}
+
+void EPOCH_destroy(EPOCH* epoch) {
+    if (epoch == NULL) return;
+
+    EPOCH_deinit(epoch);
+    free(epoch);
+}
+
+EPOCH_RECORD* EPOCH_register(EPOCH* epoch) {
+    if (epoch == NULL) return NULL;
+
+    pthread_mutex_lock(&epoch->mutex);
+    if (epoch->free_count > 0) {
+        EPOCH_RECORD* record = epoch->records + epoch->free_records[--epoch->free_count];
+        pthread_mutex_unlock(&epoch->mutex);
+        return record;
+    }
+    pthread_mutex_unlock(&epoch->mutex);
+
+    // registered never passes record_count, _advance scans exactly the records ever handed out
+    u32 i = atomic_load(&epoch->registered);
+    do {
+        if (i >= epoch->record_count) return NULL;
+    } while (atomic_compare_exchange_weak(&epoch->registered, &i, i + 1) == 0);
+
+    return epoch->records + i;
+}
+
+void EPOCH_unregister(EPOCH* epoch, EPOCH_RECORD* record) {
+    if (epoch == NULL || record == NULL) return;
+
+    // A quiescent record never holds back the epoch while it waits on the free list
+    atomic_store_explicit(&record->epoch, EPOCH_QUIESCENT, memory_order_release);
+
+    pthread_mutex_lock(&epoch->mutex);
+    epoch->free_records[epoch->free_count++] = (u32)(record - epoch->records);
+    pthread_mutex_unlock(&epoch->mutex);
+}
+
+void EPOCH_enter(EPOCH* epoch, EPOCH_RECORD* record) {
+    // The full fence orders the announcement before every load of the protected structure
+    atomic_store_explicit(&record->epoch, atomic_load_explicit(&epoch->global, memory_order_relaxed),
+        memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void EPOCH_exit(EPOCH_RECORD* record) {
+    atomic_store_explicit(&record->epoch, EPOCH_QUIESCENT, memory_order_release);
+}
+
+static u8 EPOCH_advance(EPOCH* epoch) {
+    atomic_thread_fence(memory_order_seq_cst);
+
+    u64 global = atomic_load(&epoch->global);
+    u32 registered = atomic_load(&epoch->registered);
+    registered = registered < epoch->record_count ? registered : epoch->record_count;
+
+    for (u32 i = 0; i < registered; i++) {
+        const u64 announced = atomic_load(&epoch->records[i].epoch);
+        if (announced != EPOCH_QUIESCENT && announced != global) return 0;
+    }
+
+    return atomic_compare_exchange_strong(&epoch->global, &global, global + 1);
+}
+
+// Called with the mutex held
+static u32 EPOCH_free_ready(EPOCH* epoch) {
+    const u64 global = atomic_load(&epoch->global);
+
+    u32 kept = 0;
+    for (u32 i = 0; i < epoch->retired_size; i++) {
+        const EPOCH_RETIRED retired = epoch->retired[i];
+        if (retired.epoch + 2 <= global) retired.free_f(retired.pointer);
+        else epoch->retired[kept++] = retired;
+    }
+
+    const u32 freed = epoch->retired_size - kept;
+    epoch->retired_size = kept;
+    return freed;
+}
+
+u8 EPOCH_retire(EPOCH* epoch, void* pointer, const EPOCH_FREE_F free_f) {
+    if (epoch == NULL || free_f == NULL) return 0;
+
+    pthread_mutex_lock(&epoch->mutex);
+    if (epoch->retired_size == epoch->retired_capacity) {
+        u32 capacity = epoch->retired_capacity * 2;
+        capacity = capacity < EPOCH_COLLECT_EVERY ? EPOCH_COLLECT_EVERY : capacity;
+
+        EPOCH_RETIRED* retired = (EPOCH_RETIRED*)realloc(epoch->retired, sizeof(EPOCH_RETIRED) * capacity);
+        if (retired == NULL) {
+            pthread_mutex_unlock(&epoch->mutex);
+            return 0;
+        }
+
+        epoch->retired = retired;
+        epoch->retired_capacity = capacity;
+    }
+
+    EPOCH_RETIRED* retired = epoch->retired + epoch->retired_size++;
+    retired->pointer = pointer;
+    retired->free_f = free_f;
+    retired->epoch = atomic_load(&epoch->global);
+
+    if (epoch->retired_size % EPOCH_COLLECT_EVERY == 0) {
+        EPOCH_advance(epoch);
+        EPOCH_free_ready(epoch);
+    }
+
+    pthread_mutex_unlock(&epoch->mutex);
+    return 1;
+}
+
+u32 EPOCH_collect(EPOCH* epoch) {
+    if (epoch == NULL) return 0;
+
+    pthread_mutex_lock(&epoch->mutex);
+    EPOCH_advance(epoch);
+    const u32 freed = EPOCH_free_ready(epoch);
+    pthread_mutex_unlock(&epoch->mutex);
+
+    return freed;
+}
+
+void EPOCH_synchronize(EPOCH* epoch) {
+    if (epoch == NULL) return;
+
+    // Two advances past the current epoch, the same wait a retired pointer goes through before it is freed
+    const u64 target = atomic_load(&epoch->global) + 2;
+    while (atomic_load(&epoch->global) < target) {
+        if (EPOCH_advance(epoch) == 0) sched_yield();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "thread/thread_pool.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+static void* THREAD_POOL_main(void* arg) {
+    const THREAD_POOL_WORKER* worker = (const THREAD_POOL_WORKER*)arg;
+    THREAD_POOL* pool = worker->pool;
+    u64 seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&(pool->mutex));
+        while (pool->stopping == 0 && pool->generation == seen)
+            pthread_cond_wait(&(pool->work), &(pool->mutex));
+
+        if (pool->stopping == 1) {
+            pthread_mutex_unlock(&(pool->mutex));
+            return NULL;
+        }
+
+        seen = pool->generation;
+        const THREAD_POOL_TASK_F task = pool->task;
+        void* context = pool->context;
+        pthread_mutex_unlock(&(pool->mutex));
+
+        task(context, worker->index, pool->thread_count);
+
+        pthread_mutex_lock(&(pool->mutex));
+        pool->running--;
+        if (pool->running == 0) pthread_cond_signal(&(pool->done));
+        pthread_mutex_unlock(&(pool->mutex));
+    }
+}
+
+static void THREAD_POOL_stop(THREAD_POOL* pool, const u32 started) {
+    pthread_mutex_lock(&(pool->mutex));
+    pool->stopping = 1;
+    pthread_cond_broadcast(&(pool->work));
+    pthread_mutex_unlock(&(pool->mutex));
+
+    for (u32 i = 0; i < started; i++) pthread_join(pool->workers[i].thread, NULL);
+}
+
+u8 THREAD_POOL_init(THREAD_POOL* pool, const u32 thread_count) {
+    if (pool == NULL) return 0;
+
+    // 0 asks for one worker per online processor
+    u32 count = thread_count;
+    if (count == 0) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = online > 0 ? (u32)online : 1;
+    }
+
+    pool->thread_count = count;
+    pool->task = NULL;
+    pool->context = NULL;
+    pool->generation = 0;
+    pool->running = 0;
+    pool->stopping = 0;
+
+    pool->workers = NULL;
+    if (count > 1) {
+        pool->workers = (THREAD_POOL_WORKER*)malloc(sizeof(THREAD_POOL_WORKER) * (count - 1));
+        if (pool->workers == NULL) return 0;
+    }
+
+    if (pthread_mutex_init(&(pool->mutex), NULL) != 0) {
+        free(pool->workers);
+        return 0;
+    }
+
+    if (pthread_cond_init(&(pool->work), NULL) != 0 || pthread_cond_init(&(pool->done), NULL) != 0) {
+        pthread_mutex_destroy(&(pool->mutex));
+        free(pool->workers);
+        return 0;
+    }
+
+    for (u32 i = 0; i + 1 < count; i++) {
+        THREAD_POOL_WORKER* worker = pool->workers + i;
+        worker->pool = pool;
+        worker->index = i + 1;
+
+        if (pthread_create(&(worker->thread), NULL, THREAD_POOL_main, worker) != 0) {
+            THREAD_POOL_stop(pool, i);
+            pthread_cond_destroy(&(pool->work));
+            pthread_cond_destroy(&(pool->done));
+            pthread_mutex_destroy(&(pool->mutex));
+            free(pool->workers);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+THREAD_POOL* THREAD_POOL_create(const u32 thread_count) {
+    THREAD_POOL* pool = (THREAD_POOL*)malloc(sizeof(THREAD_POOL));
+    if (pool == NULL) return NULL;
+
+    const u8 r = THREAD_POOL_init(pool, thread_count);
+    if (r == 0) {
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void THREAD_POOL_deinit(THREAD_POOL* pool) {
+    if (pool == NULL) return;
+
+    THREAD_POOL_stop(pool, pool->thread_count - 1);
+    pthread_cond_destroy(&(pool->work));
+    pthread_cond_destroy(&(pool->done));
+    pthread_mutex_destroy(&(pool->mutex));
+
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->thread_count = 0;
+}
+
+void THREAD_POOL_destroy(THREAD_POOL* pool) {
+    if (pool == NULL) return;
+
+    THREAD_POOL_deinit(pool);
+    free(pool);
+}
+
+u8 THREAD_POOL_run(THREAD_POOL* pool, const THREAD_POOL_TASK_F task, void* context) {
+    if (task == NULL) return 0;
+
+    if (pool == NULL || pool->thread_count <= 1) {
+        task(context, 0, 1);
+        return 1;
+    }
+
+    pthread_mutex_lock(&(pool->mutex));
+    pool->task = task;
+    pool->context = context;
+    pool->running = pool->thread_count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&(pool->work));
+    pthread_mutex_unlock(&(pool->mutex));
+
+    task(context, 0, pool->thread_count);
+
+    pthread_mutex_lock(&(pool->mutex));
+    while (pool->running > 0) pthread_cond_wait(&(pool->done), &(pool->mutex));
+    pthread_mutex_unlock(&(pool->mutex));
+
+    return 1;
+}
+
+u32 THREAD_POOL_workers(const THREAD_POOL* pool) {
+    if (pool == NULL || pool->thread_count == 0) return 1;
+    return pool->thread_count;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <pthread.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/concurrent_hashtable.h"
+#include "test.h"
+
+HASHTABLE_DECLARE_EX(u64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE(u64, u64)
+CONCURRENT_HASHTABLE_DECLARE(u64, u64)
+CONCURRENT_HASHTABLE_DEFINE(u64, u64)
+
+#define CONCURRENT_TEST_THREADS     4
+#define CONCURRENT_TEST_SEGMENTS    4
+#define CONCURRENT_TEST_KEYS        40000
+
+// Keys every worker bumps through _update, counted apart from the owned keys
+#define CONCURRENT_TEST_COUNTERS    16
+#define CONCURRENT_TEST_COUNTER_KEY (CONCURRENT_TEST_KEYS + 1)
+
+typedef struct {
+    CONCURRENT_HASHTABLE_u64_u64* hashtable;
+    u32 thread;
+    u32 failures;
+} CONCURRENT_TEST_WORKER;
+
+// What the serial reference holds for a key once every worker is done
+static u8 CONCURRENT_TEST_expected(const u64 key, u64* value) {
+    if (key % 3 == 0) return 0;
+
+    *value = key % 5 == 0 ? key * 7 : key * 3;
+    return 1;
+}
+
+static void CONCURRENT_TEST_increment(u64* value, const u8 inserted, void* context) {
+    (void)context;
+    *value = inserted == 1 ? 1 : *value + 1;
+}
+
+// Each worker owns the keys congruent to its index and reads the keys of its neighbour while they change
+static void* CONCURRENT_TEST_work(void* argument) {
+    CONCURRENT_TEST_WORKER* worker = (CONCURRENT_TEST_WORKER*)argument;
+    CONCURRENT_HASHTABLE_u64_u64* hashtable = worker->hashtable;
+
+    for (u64 key = worker->thread; key < CONCURRENT_TEST_KEYS; key += CONCURRENT_TEST_THREADS) {
+        worker->failures += CONCURRENT_HASHTABLE_u64_u64_add(hashtable, key, key * 3) != 1;
+        if (key % 5 == 0) worker->failures += CONCURRENT_HASHTABLE_u64_u64_upsert(hashtable, key, key * 7) != 1;
+        if (key % 3 == 0) worker->failures += CONCURRENT_HASHTABLE_u64_u64_remove(hashtable, key) != 1;
+
+        const u64 counter = CONCURRENT_TEST_COUNTER_KEY + key % CONCURRENT_TEST_COUNTERS;
+        const u8 updated = CONCURRENT_HASHTABLE_u64_u64_update(hashtable, counter, CONCURRENT_TEST_increment, NULL);
+        worker->failures += updated != 1;
+
+        u64 value;
+        const u64 other = key + 1 < CONCURRENT_TEST_KEYS ? key + 1 : 0;
+        if (CONCURRENT_HASHTABLE_u64_u64_get(hashtable, other, &value) == 1)
+            worker->failures += value != other * 3 && value != other * 7;
+    }
+
+    return NULL;
+}
+
+// Segments start at the minimum capacity, so they grow and purge under the workers
+static int CONCURRENT_TEST_against_reference(void) {
+    CONCURRENT_HASHTABLE_u64_u64 hashtable;
+    TEST_CHECK(CONCURRENT_HASHTABLE_u64_u64_init(&hashtable, 0, CONCURRENT_TEST_SEGMENTS) == 1);
+    const u32 capacity = hashtable.segments[0].hashtable.capacity;
+
+    pthread_t threads[CONCURRENT_TEST_THREADS];
+    CONCURRENT_TEST_WORKER workers[CONCURRENT_TEST_THREADS];
+    for (u32 i = 0; i < CONCURRENT_TEST_THREADS; i++) {
+        workers[i].hashtable = &hashtable;
+        workers[i].thread = i;
+        workers[i].failures = 0;
+        TEST_CHECK(pthread_create(threads + i, NULL, CONCURRENT_TEST_work, workers + i) == 0);
+    }
+
+    for (u32 i = 0; i < CONCURRENT_TEST_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        TEST_CHECK(workers[i].failures == 0);
+    }
+
+    for (u32 i = 0; i < hashtable.segment_count; i++) TEST_CHECK(hashtable.segments[i].hashtable.capacity > capacity);
+
+    u32 size = CONCURRENT_TEST_COUNTERS;
+    for (u64 key = 0; key < CONCURRENT_TEST_KEYS; key++) {
+        u64 expected = 0;
+        u64 value = 0;
+        const u8 present = CONCURRENT_TEST_expected(key, &expected);
+        size += present;
+
+        TEST_CHECK(CONCURRENT_HASHTABLE_u64_u64_get(&hashtable, key, &value) == present);
+        TEST_CHECK(present == 0 || value == expected);
+    }
+
+    // Every owned key bumped one counter once
+    for (u64 i = 0; i < CONCURRENT_TEST_COUNTERS; i++) {
+        u64 value = 0;
+        TEST_CHECK(CONCURRENT_HASHTABLE_u64_u64_get(&hashtable, CONCURRENT_TEST_COUNTER_KEY + i, &value) == 1);
+        TEST_CHECK(value == CONCURRENT_TEST_KEYS / CONCURRENT_TEST_COUNTERS);
+    }
+
+    TEST_CHECK(CONCURRENT_HASHTABLE_u64_u64_size(&hashtable) == size);
+    TEST_CHECK(CONCURRENT_HASHTABLE_u64_u64_remove(&hashtable, 3) == 0);
+
+    CONCURRENT_HASHTABLE_u64_u64_deinit(&hashtable);
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    failed += CONCURRENT_TEST_against_reference();
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
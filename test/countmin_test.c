@@ -0,0 +1,85 @@
+#include "types.h"
+#include "sketch/countmin.h"
+#include "test.h"
+
+// Counts added through the u64 entry points estimate the same through the byte ones, and the other way around
+static int COUNTMIN_TEST_u64_matches_bytes(void) {
+    COUNTMIN countmin;
+    TEST_CHECK(COUNTMIN_init(&countmin, 0.01, 0.01) == 1);
+
+    for (u64 key = 0; key < 1000; key++) {
+        if ((key & 1) == 0) COUNTMIN_add_u64(&countmin, key, (u32)key + 1);
+        else COUNTMIN_add(&countmin, (const u8*)&key, sizeof(key), (u32)key + 1);
+    }
+
+    for (u64 key = 0; key < 1000; key++) {
+        const u32 estimate = COUNTMIN_estimate_u64(&countmin, key);
+        TEST_CHECK(estimate == COUNTMIN_estimate(&countmin, (const u8*)&key, sizeof(key)));
+        TEST_CHECK(estimate >= key + 1);
+    }
+
+    COUNTMIN_deinit(&countmin);
+    return 0;
+}
+
+// TOPK counts through the u64 path, a plain sketch fed the same bytes must agree with it
+static int COUNTMIN_TEST_topk_matches_bytes(void) {
+    COUNTMIN_TOPK topk;
+    TEST_CHECK(COUNTMIN_TOPK_init(&topk, 8, 0.01, 0.01) == 1);
+
+    for (u64 key = 0; key < 64; key++) TEST_CHECK(COUNTMIN_TOPK_add(&topk, key, (u32)key * 10 + 1) == 1);
+
+    for (u64 key = 0; key < 64; key++) {
+        const u32 estimate = COUNTMIN_TOPK_estimate(&topk, key);
+        TEST_CHECK(estimate == COUNTMIN_estimate(&topk.sketch, (const u8*)&key, sizeof(key)));
+        TEST_CHECK(estimate >= key * 10 + 1);
+    }
+
+    COUNTMIN_TOPK_deinit(&topk);
+    return 0;
+}
+
+// Every light key outweighs the lightest tracked one and evicts it, then ten heavy keys must take over the
+// list. The index must absorb all those evictions without growing.
+static int COUNTMIN_TEST_topk_evictions(void) {
+    COUNTMIN_TOPK topk;
+    TEST_CHECK(COUNTMIN_TOPK_init(&topk, 10, 0.001, 0.01) == 1);
+    const u32 capacity = topk.index.capacity;
+
+    for (u64 key = 1000; key < 11000; key++) {
+        TEST_CHECK(COUNTMIN_TOPK_add(&topk, key, (u32)(key - 999)) == 1);
+        TEST_CHECK(topk.index.capacity == capacity);
+    }
+
+    for (u32 round = 0; round < 100; round++) {
+        for (u64 key = 0; key < 10; key++) {
+            TEST_CHECK(COUNTMIN_TOPK_add(&topk, key, 100000 + (u32)key * 20000) == 1);
+            TEST_CHECK(topk.index.capacity == capacity);
+        }
+
+        for (u64 key = 20000; key < 20100; key++) {
+            TEST_CHECK(COUNTMIN_TOPK_add(&topk, key + round * 100, 1000) == 1);
+            TEST_CHECK(topk.index.capacity == capacity);
+        }
+    }
+
+    COUNTMIN_ITEM items[10];
+    TEST_CHECK(COUNTMIN_TOPK_list(&topk, items) == 10);
+
+    // Heavy key i totals 100 * (100000 + i * 20000), so the list holds them heaviest first
+    for (u32 i = 0; i < 10; i++) {
+        TEST_CHECK(items[i].key == 9 - i);
+        TEST_CHECK(items[i].count >= 100 * (100000 + (9 - i) * 20000));
+    }
+
+    COUNTMIN_TOPK_deinit(&topk);
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    failed += COUNTMIN_TEST_u64_matches_bytes();
+    failed += COUNTMIN_TEST_topk_matches_bytes();
+    failed += COUNTMIN_TEST_topk_evictions();
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
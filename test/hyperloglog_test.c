@@ -0,0 +1,61 @@
+#include <string.h>
+
+#include "types.h"
+#include "sketch/hyperloglog.h"
+#include "test.h"
+
+// _add_u64(k) must land in the same register as _add over the key's 8 bytes, sparse and dense
+static int HYPERLOGLOG_TEST_add_u64_matches_add(void) {
+    HYPERLOGLOG a, b;
+    TEST_CHECK(HYPERLOGLOG_init(&a, 10) == 1);
+    TEST_CHECK(HYPERLOGLOG_init(&b, 10) == 1);
+
+    for (u64 key = 0; key < 50; key++) {
+        TEST_CHECK(HYPERLOGLOG_add_u64(&a, key) == 1);
+        TEST_CHECK(HYPERLOGLOG_add(&b, (const u8*)&key, sizeof(key)) == 1);
+    }
+
+    TEST_CHECK(a.representation == HYPERLOGLOG_REPRESENTATION_SPARSE);
+    TEST_CHECK(a.sparse_size == b.sparse_size);
+    TEST_CHECK(memcmp(a.sparse, b.sparse, sizeof(u32) * a.sparse_capacity) == 0);
+
+    for (u64 key = 50; key < 20000; key++) {
+        TEST_CHECK(HYPERLOGLOG_add_u64(&a, key) == 1);
+        TEST_CHECK(HYPERLOGLOG_add(&b, (const u8*)&key, sizeof(key)) == 1);
+    }
+
+    TEST_CHECK(a.representation == HYPERLOGLOG_REPRESENTATION_DENSE);
+    TEST_CHECK(b.representation == HYPERLOGLOG_REPRESENTATION_DENSE);
+    TEST_CHECK(memcmp(a.registers, b.registers, 1u << 10) == 0);
+
+    HYPERLOGLOG_deinit(&a);
+    HYPERLOGLOG_deinit(&b);
+    return 0;
+}
+
+// Keys counted through both entry points and merged are counted once
+static int HYPERLOGLOG_TEST_merge_across_entry_points(void) {
+    HYPERLOGLOG half, all;
+    TEST_CHECK(HYPERLOGLOG_init(&half, 14) == 1);
+    TEST_CHECK(HYPERLOGLOG_init(&all, 14) == 1);
+
+    for (u64 key = 0; key < 100000; key++) {
+        if ((key & 1) == 0) TEST_CHECK(HYPERLOGLOG_add_u64(&half, key) == 1);
+        TEST_CHECK(HYPERLOGLOG_add(&all, (const u8*)&key, sizeof(key)) == 1);
+    }
+
+    const f64 before = HYPERLOGLOG_estimate(&all);
+    TEST_CHECK(HYPERLOGLOG_merge(&all, &half) == 1);
+    TEST_CHECK(HYPERLOGLOG_estimate(&all) == before);
+
+    HYPERLOGLOG_deinit(&half);
+    HYPERLOGLOG_deinit(&all);
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    failed += HYPERLOGLOG_TEST_add_u64_matches_add();
+    failed += HYPERLOGLOG_TEST_merge_across_entry_points();
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
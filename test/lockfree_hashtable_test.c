@@ -0,0 +1,156 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/lockfree_hashtable.h"
+#include "thread/epoch.h"
+#include "test.h"
+
+LOCKFREE_HASHTABLE_DECLARE_EX(u64, u64, HASH_u64, HASH_EQUAL)
+LOCKFREE_HASHTABLE_DEFINE(u64, u64)
+
+#define LOCKFREE_TEST_THREADS   4
+#define LOCKFREE_TEST_KEYS      20000
+
+typedef struct {
+    LOCKFREE_HASHTABLE_u64_u64* hashtable;
+    u64 first;
+    u32 thread;
+} LOCKFREE_TEST_WORKER;
+
+static _Atomic u32 LOCKFREE_TEST_failures = 0;
+
+// What the serial reference holds for a key once every worker is done
+static u8 LOCKFREE_TEST_expected(const u64 key, u64* value) {
+    if (key % 3 == 0) return 0;
+
+    *value = key % 5 == 0 ? key * 7 : key * 3;
+    return 1;
+}
+
+static void LOCKFREE_TEST_check(const u8 condition) {
+    if (condition == 0) atomic_fetch_add(&LOCKFREE_TEST_failures, 1);
+}
+
+// Each worker owns the keys congruent to its index and reads the keys of its neighbour while they change
+static void* LOCKFREE_TEST_work(void* argument) {
+    const LOCKFREE_TEST_WORKER* worker = (const LOCKFREE_TEST_WORKER*)argument;
+    LOCKFREE_HASHTABLE_u64_u64* hashtable = worker->hashtable;
+
+    EPOCH_RECORD* record = LOCKFREE_HASHTABLE_u64_u64_register(hashtable);
+    LOCKFREE_TEST_check(record != NULL);
+    if (record == NULL) return NULL;
+
+    const u64 end = worker->first + LOCKFREE_TEST_KEYS;
+    for (u64 key = worker->first + worker->thread; key < end; key += LOCKFREE_TEST_THREADS) {
+        LOCKFREE_TEST_check(LOCKFREE_HASHTABLE_u64_u64_add(hashtable, record, key, key * 3) == 1);
+        if (key % 5 == 0) LOCKFREE_TEST_check(LOCKFREE_HASHTABLE_u64_u64_upsert(hashtable, record, key, key * 7) == 1);
+        if (key % 3 == 0) LOCKFREE_TEST_check(LOCKFREE_HASHTABLE_u64_u64_remove(hashtable, record, key) == 1);
+
+        u64 value;
+        const u64 other = key + 1 < end ? key + 1 : worker->first;
+        if (LOCKFREE_HASHTABLE_u64_u64_get(hashtable, record, other, &value) == 1)
+            LOCKFREE_TEST_check(value == other * 3 || value == other * 7);
+    }
+
+    for (u64 key = worker->first + worker->thread; key < end; key += LOCKFREE_TEST_THREADS) {
+        u64 expected = 0;
+        u64 value = 0;
+        const u8 present = LOCKFREE_TEST_expected(key, &expected);
+        LOCKFREE_TEST_check(LOCKFREE_HASHTABLE_u64_u64_get(hashtable, record, key, &value) == present);
+        LOCKFREE_TEST_check(present == 0 || value == expected);
+    }
+
+    LOCKFREE_HASHTABLE_u64_u64_unregister(hashtable, record);
+    return NULL;
+}
+
+// Two rounds of workers against a table that starts at the minimum capacity, so it resizes under them. The
+// second round only gets records because the first one gave its records back.
+static int LOCKFREE_TEST_against_reference(void) {
+    LOCKFREE_HASHTABLE_u64_u64 hashtable;
+    TEST_CHECK(LOCKFREE_HASHTABLE_u64_u64_init(&hashtable, 0, LOCKFREE_TEST_THREADS) == 1);
+    const u32 capacity = atomic_load(&hashtable.array)->capacity;
+
+    for (u32 round = 0; round < 2; round++) {
+        pthread_t threads[LOCKFREE_TEST_THREADS];
+        LOCKFREE_TEST_WORKER workers[LOCKFREE_TEST_THREADS];
+
+        for (u32 i = 0; i < LOCKFREE_TEST_THREADS; i++) {
+            workers[i].hashtable = &hashtable;
+            workers[i].first = (u64)round * LOCKFREE_TEST_KEYS;
+            workers[i].thread = i;
+            TEST_CHECK(pthread_create(threads + i, NULL, LOCKFREE_TEST_work, workers + i) == 0);
+        }
+
+        for (u32 i = 0; i < LOCKFREE_TEST_THREADS; i++) pthread_join(threads[i], NULL);
+    }
+
+    TEST_CHECK(atomic_load(&LOCKFREE_TEST_failures) == 0);
+    TEST_CHECK(atomic_load(&hashtable.array)->capacity > capacity);
+
+    EPOCH_RECORD* record = LOCKFREE_HASHTABLE_u64_u64_register(&hashtable);
+    TEST_CHECK(record != NULL);
+
+    u32 size = 0;
+    for (u64 key = 0; key < 2 * LOCKFREE_TEST_KEYS; key++) {
+        u64 expected = 0;
+        u64 value = 0;
+        const u8 present = LOCKFREE_TEST_expected(key, &expected);
+        size += present;
+
+        TEST_CHECK(LOCKFREE_HASHTABLE_u64_u64_get(&hashtable, record, key, &value) == present);
+        TEST_CHECK(present == 0 || value == expected);
+    }
+
+    TEST_CHECK(LOCKFREE_HASHTABLE_u64_u64_size(&hashtable) == size);
+
+    LOCKFREE_HASHTABLE_u64_u64_unregister(&hashtable, record);
+    LOCKFREE_HASHTABLE_u64_u64_deinit(&hashtable);
+    return 0;
+}
+
+static _Atomic u32 LOCKFREE_TEST_freed = 0;
+
+static void LOCKFREE_TEST_free(void* pointer) {
+    atomic_fetch_add(&LOCKFREE_TEST_freed, 1);
+    free(pointer);
+}
+
+// Records come back through _unregister, and retired memory outlives every reader still inside the epoch
+static int LOCKFREE_TEST_epoch(void) {
+    EPOCH epoch;
+    TEST_CHECK(EPOCH_init(&epoch, 2) == 1);
+
+    EPOCH_RECORD* a = EPOCH_register(&epoch);
+    EPOCH_RECORD* b = EPOCH_register(&epoch);
+    TEST_CHECK(a != NULL && b != NULL && a != b);
+    TEST_CHECK(EPOCH_register(&epoch) == NULL);
+
+    EPOCH_unregister(&epoch, a);
+    TEST_CHECK(EPOCH_register(&epoch) == a);
+
+    EPOCH_enter(&epoch, b);
+    for (u32 i = 0; i < 10; i++) TEST_CHECK(EPOCH_retire(&epoch, malloc(16), LOCKFREE_TEST_free) == 1);
+
+    EPOCH_collect(&epoch);
+    EPOCH_collect(&epoch);
+    TEST_CHECK(atomic_load(&LOCKFREE_TEST_freed) == 0);
+
+    EPOCH_exit(b);
+    EPOCH_synchronize(&epoch);
+    EPOCH_collect(&epoch);
+    TEST_CHECK(atomic_load(&LOCKFREE_TEST_freed) == 10);
+
+    EPOCH_deinit(&epoch);
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    failed += LOCKFREE_TEST_against_reference();
+    failed += LOCKFREE_TEST_epoch();
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
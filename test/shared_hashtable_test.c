@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "types.h"
+#include "hash/hash.h"
+#include "hash/hashtable.h"
+#include "hash/shared_hashtable.h"
+#include "test.h"
+
+HASHTABLE_DECLARE_EX(u64, u64, HASH_u64, HASH_EQUAL)
+HASHTABLE_DEFINE(u64, u64)
+SHARED_HASHTABLE_DECLARE(u64, u64)
+SHARED_HASHTABLE_DEFINE(u64, u64)
+
+#define SHARED_TEST_KEYS    4000
+
+// Written last by the writer, a reader that sees it sees every earlier write
+#define SHARED_TEST_DONE    (SHARED_TEST_KEYS + 1)
+
+// The reader process: the initial table, then values the writer may be in the middle of changing, then the
+// final table once the writer is done. The writer waits on ready before it changes anything.
+static int SHARED_TEST_read(const char* name, const int ready) {
+    SHARED_HASHTABLE_u64_u64* hashtable = SHARED_HASHTABLE_u64_u64_open(name);
+    TEST_CHECK(hashtable != NULL);
+
+    for (u64 key = 0; key < SHARED_TEST_KEYS; key++) {
+        u64 value = 0;
+        TEST_CHECK(SHARED_HASHTABLE_u64_u64_get(hashtable, key, &value) == 1);
+        TEST_CHECK(value == key * 2);
+    }
+
+    TEST_CHECK(write(ready, "", 1) == 1);
+    close(ready);
+
+    while (SHARED_HASHTABLE_u64_u64_contains(hashtable, SHARED_TEST_DONE) == 0) {
+        for (u64 key = 0; key < SHARED_TEST_KEYS; key++) {
+            u64 value = 0;
+            if (SHARED_HASHTABLE_u64_u64_get(hashtable, key, &value) == 1)
+                TEST_CHECK(value == key * 2 || (key % 4 != 0 && value == key * 3));
+            else TEST_CHECK(key % 4 == 0);
+        }
+    }
+
+    for (u64 key = 0; key < SHARED_TEST_KEYS; key++) {
+        u64 value = 0;
+        TEST_CHECK(SHARED_HASHTABLE_u64_u64_get(hashtable, key, &value) == (key % 4 != 0));
+        TEST_CHECK(key % 4 == 0 || value == key * 3);
+    }
+
+    TEST_CHECK(SHARED_HASHTABLE_u64_u64_size(hashtable) == SHARED_TEST_KEYS - SHARED_TEST_KEYS / 4 + 1);
+
+    SHARED_HASHTABLE_u64_u64_destroy(hashtable);
+    return 0;
+}
+
+// A forked reader maps the segment by name while this process keeps writing to it
+static int SHARED_TEST_fork(void) {
+    char name[64];
+    snprintf(name, sizeof(name), "/nesquik_shared_test_%d", (int)getpid());
+
+    SHARED_HASHTABLE_u64_u64* hashtable = SHARED_HASHTABLE_u64_u64_create(name, SHARED_TEST_KEYS + 1);
+    TEST_CHECK(hashtable != NULL);
+
+    for (u64 key = 0; key < SHARED_TEST_KEYS; key++)
+        TEST_CHECK(SHARED_HASHTABLE_u64_u64_upsert(hashtable, key, key * 2) == 1);
+
+    int ready[2];
+    TEST_CHECK(pipe(ready) == 0);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(ready[0]);
+        _exit(SHARED_TEST_read(name, ready[1]));
+    }
+    TEST_CHECK(pid > 0);
+
+    char byte;
+    close(ready[1]);
+    TEST_CHECK(read(ready[0], &byte, 1) == 1);
+    close(ready[0]);
+
+    for (u64 key = 0; key < SHARED_TEST_KEYS; key++) {
+        if (key % 4 == 0) TEST_CHECK(SHARED_HASHTABLE_u64_u64_remove(hashtable, key) == 1);
+        else TEST_CHECK(SHARED_HASHTABLE_u64_u64_upsert(hashtable, key, key * 3) == 1);
+    }
+
+    TEST_CHECK(SHARED_HASHTABLE_u64_u64_upsert(hashtable, SHARED_TEST_DONE, 0) == 1);
+
+    int status = 0;
+    TEST_CHECK(waitpid(pid, &status, 0) == pid);
+    TEST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    SHARED_HASHTABLE_u64_u64_destroy(hashtable);
+    TEST_CHECK(SHARED_MEMORY_unlink(name) == 1);
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    failed += SHARED_TEST_fork();
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
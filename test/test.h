@@ -0,0 +1,15 @@
+#ifndef NESQUIK_TEST_H
+#define NESQUIK_TEST_H
+
+#include <stdio.h>
+
+// Fails the enclosing test function, which returns the number of failed checks (0 or 1)
+#define TEST_CHECK(condition)                                                               \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);  \
+            return 1;                                                                       \
+        }                                                                                   \
+    } while (0)
+
+#endif //NESQUIK_TEST_H
\ No newline at end of file